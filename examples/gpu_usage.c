@@ -7,7 +7,9 @@
  * Features:
  * - Detects and initializes the Metrics Discovery API
  * - Enumerates available metric sets and metrics  
- * - Identifies GPU engine utilization metrics (render, blitter, video, enhance)
+ * - Uses the lightweight PMU concurrent group (kernel i915 / xe engine busy
+ *   counters) when available, no OA configuration is needed then
+ * - Otherwise identifies GPU engine utilization metrics (render, blitter, video, enhance)
  * - Supports single snapshot or continuous monitoring
  * - Displays usage in clear format with normalization
  * 
@@ -48,6 +50,12 @@ static IMetricSetLatest* g_metricSet = NULL;
 static void* g_libraryHandle = NULL;
 static volatile int g_running = 1;
 
+// PMU engine busyness, read with an IO stream
+static int g_pmuMode = 0;
+static int g_pmuStreamOpened = 0;
+static uint32_t g_pmuPeriodNs = 1000000000; // 1 s
+static int g_pmuMetricIndex[4] = { -1, -1, -1, -1 }; // render, blitter (copy), video, enhance
+
 // Function pointers for dynamically loaded library
 typedef TCompletionCode (*OpenAdapterGroup_fn)(IAdapterGroupLatest** adapterGroup);
 static OpenAdapterGroup_fn OpenAdapterGroup_func = NULL;
@@ -171,6 +179,54 @@ int InitializeAPI() {
     return 1;
 }
 
+// Find the PMU engine busyness metric set
+int FindPmuMetricSet(uint32_t groupsCount) {
+    const char* metricNames[4] = { "RenderBusy", "CopyBusy", "VideoBusy", "VideoEnhanceBusy" };
+    
+    for (uint32_t groupIdx = 0; groupIdx < groupsCount; groupIdx++) {
+        IConcurrentGroupLatest* group = g_metricsDevice->GetConcurrentGroup(groupIdx);
+        const TConcurrentGroupParamsLatest* groupParams = group ? group->GetParams() : NULL;
+        if (!groupParams || !groupParams->SymbolName || strcmp(groupParams->SymbolName, "PMU") != 0) {
+            continue;
+        }
+        
+        for (uint32_t setIdx = 0; setIdx < groupParams->MetricSetsCount; setIdx++) {
+            IMetricSetLatest* metricSet = group->GetMetricSet(setIdx);
+            const TMetricSetParamsLatest* setParams = metricSet ? metricSet->GetParams() : NULL;
+            if (!setParams || !setParams->SymbolName || strcmp(setParams->SymbolName, "EngineBusy") != 0) {
+                continue;
+            }
+            
+            // Metric indices are valid for IO stream filtering
+            if (metricSet->SetApiFiltering(API_TYPE_IOSTREAM) != CC_OK) {
+                continue;
+            }
+            setParams = metricSet->GetParams();
+            
+            for (uint32_t metricIdx = 0; metricIdx < setParams->MetricsCount; metricIdx++) {
+                IMetricLatest* metric = metricSet->GetMetric(metricIdx);
+                const TMetricParamsLatest* metricParams = metric ? metric->GetParams() : NULL;
+                if (!metricParams || !metricParams->SymbolName) {
+                    continue;
+                }
+                for (int i = 0; i < 4; i++) {
+                    if (strcmp(metricParams->SymbolName, metricNames[i]) == 0) {
+                        g_pmuMetricIndex[i] = (int)metricIdx;
+                    }
+                }
+            }
+            
+            printf("Selected metric set: PMU / %s\n", setParams->SymbolName);
+            g_concurrentGroup = group;
+            g_metricSet = metricSet;
+            g_pmuMode = 1;
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 // Find a metric set that contains GPU utilization metrics
 int FindGpuUtilizationMetricSet() {
     if (!g_metricsDevice) {
@@ -185,6 +241,11 @@ int FindGpuUtilizationMetricSet() {
     
     printf("Device has %u concurrent group(s)\n", deviceParams->ConcurrentGroupsCount);
     
+    // Prefer PMU engine busyness, it doesn't need OA configuration
+    if (FindPmuMetricSet(deviceParams->ConcurrentGroupsCount)) {
+        return 1;
+    }
+    
     // Look through concurrent groups for GPU utilization metrics
     for (uint32_t groupIdx = 0; groupIdx < deviceParams->ConcurrentGroupsCount; groupIdx++) {
         IConcurrentGroupLatest* group = g_metricsDevice->GetConcurrentGroup(groupIdx);
@@ -274,6 +335,53 @@ int FindGpuUtilizationMetricSet() {
     return 0;
 }
 
+// Read GPU utilization from the PMU IO stream, waits for the next sampling period
+int ReadPmuUtilization(GpuUtilization* util) {
+    TCompletionCode result;
+    
+    if (!g_pmuStreamOpened) {
+        uint32_t periodNs = g_pmuPeriodNs;
+        uint32_t bufferSize = 0;
+        result = g_concurrentGroup->OpenIoStream(g_metricSet, 0, &periodNs, &bufferSize);
+        if (result != CC_OK) {
+            fprintf(stderr, "Error: Failed to open PMU stream: %s\n", GetCompletionCodeString(result));
+            return 0;
+        }
+        g_pmuStreamOpened = 1;
+    }
+    
+    const TMetricSetParamsLatest* setParams = g_metricSet->GetParams();
+    const uint32_t reportSize = setParams->MetricsCount + setParams->InformationCount;
+    TTypedValue_1_0 values[32];
+    if (reportSize > sizeof(values) / sizeof(values[0])) {
+        return 0;
+    }
+    
+    // The first sample is only a reference, busyness is calculated between two samples
+    uint32_t reportCount = 0;
+    while (reportCount == 0 && g_running) {
+        reportCount = 1;
+        result = g_concurrentGroup->ReadAndCalculate(2 * (g_pmuPeriodNs / 1000000), 0, &reportCount,
+                                                     values, sizeof(values), NULL, 0);
+        if (result != CC_OK && result != CC_READ_PENDING && result != CC_WAIT_TIMEOUT) {
+            fprintf(stderr, "Error: Failed to read PMU stream: %s\n", GetCompletionCodeString(result));
+            return 0;
+        }
+    }
+    if (reportCount == 0) {
+        return 0;
+    }
+    
+    float* fields[4] = { &util->render, &util->blitter, &util->video, &util->enhance };
+    for (int i = 0; i < 4; i++) {
+        if (g_pmuMetricIndex[i] >= 0) {
+            *fields[i] = values[g_pmuMetricIndex[i]].ValueFloat;
+        }
+    }
+    
+    return 1;
+}
+
 // Read GPU utilization metrics
 int ReadGpuUtilization(GpuUtilization* util) {
     if (!g_metricSet) {
@@ -282,6 +390,19 @@ int ReadGpuUtilization(GpuUtilization* util) {
     
     memset(util, 0, sizeof(GpuUtilization));
     
+    if (g_pmuMode) {
+        if (!ReadPmuUtilization(util)) {
+            return 0;
+        }
+        
+        // Engines run concurrently, total is the busiest one
+        util->total = util->render;
+        if (util->blitter > util->total) util->total = util->blitter;
+        if (util->video > util->total) util->total = util->video;
+        if (util->enhance > util->total) util->total = util->enhance;
+        return 1;
+    }
+    
     // Activate the metric set
     TCompletionCode result = g_metricSet->Activate();
     if (result != CC_OK && result != CC_ALREADY_INITIALIZED) {
@@ -364,7 +485,11 @@ void DisplayGpuUtilization(const GpuUtilization* util) {
 void Cleanup() {
     printf("\nCleaning up resources...\n");
     
-    if (g_metricSet) {
+    if (g_pmuStreamOpened) {
+        g_concurrentGroup->CloseIoStream();
+        g_pmuStreamOpened = 0;
+    }
+    else if (g_metricSet) {
         g_metricSet->Deactivate();
     }
     
@@ -442,6 +567,7 @@ int main(int argc, char* argv[]) {
     
     printf("\nMonitoring GPU usage...\n");
     if (snapshot_mode) {
+        g_pmuPeriodNs = 100000000; // 100 ms
         printf("Mode: Single snapshot\n");
     } else {
         printf("Mode: Continuous (press Ctrl+C to stop)\n");
@@ -463,8 +589,10 @@ int main(int argc, char* argv[]) {
             break;
         }
         
-        // Wait for 1 second
-        sleep(1);
+        // Wait for 1 second, PMU stream reads wait for the sampling period
+        if (!g_pmuMode) {
+            sleep(1);
+        }
         
     } while (g_running);
     
@@ -37,7 +37,7 @@ SPDX-License-Identifier: MIT
 //////////////////////////////////////////////////////////////////////////////////
 // API build number:
 //////////////////////////////////////////////////////////////////////////////////
-#define MD_API_BUILD_NUMBER_CURRENT 181
+#define MD_API_BUILD_NUMBER_CURRENT 197
 
 namespace MetricsDiscovery
 {
@@ -71,7 +71,8 @@ namespace MetricsDiscovery
         MD_API_MINOR_NUMBER_12      = 12, // Add support for Information Set in concurrent group
         MD_API_MINOR_NUMBER_13      = 13, // Extend API to support flexible metric sets
         MD_API_MINOR_NUMBER_14      = 14, // Offline calculation support
-        MD_API_MINOR_NUMBER_CURRENT = MD_API_MINOR_NUMBER_14,
+        MD_API_MINOR_NUMBER_15      = 15, // Lazy adapter enumeration with adapter filter, multi tile IO stream with cross tile aggregation, QueryBeginTimeCpu information, context and report reason filtering, query pool calculation, typed output columns, combined IO stream read and calculation, pollable IO stream with reports callback
+        MD_API_MINOR_NUMBER_CURRENT = MD_API_MINOR_NUMBER_15,
         MD_API_MINOR_NUMBER_CEIL    = 0xFFFFFFFF
     } MD_API_MINOR_VERSION;
 
@@ -109,6 +110,7 @@ namespace MetricsDiscovery
     class IMetricsDevice_1_10;
     class IMetricsDevice_1_11;
     class IMetricsDevice_1_13;
+    class IMetricsDevice_1_15;
 
     //////////////////////////////////////////////////////////////////////////////////
     // Abstract interface for Metrics Device overrides.
@@ -124,6 +126,7 @@ namespace MetricsDiscovery
     class IConcurrentGroup_1_5;
     class IConcurrentGroup_1_11;
     class IConcurrentGroup_1_13;
+    class IConcurrentGroup_1_15;
 
     //////////////////////////////////////////////////////////////////////////////////
     // Abstract interface for the metric sets mapping to different HW configuration
@@ -136,6 +139,7 @@ namespace MetricsDiscovery
     class IMetricSet_1_5;
     class IMetricSet_1_11;
     class IMetricSet_1_13;
+    class IMetricSet_1_15;
 
     //////////////////////////////////////////////////////////////////////////////////
     // Abstract interface for the metric that is sampled.
@@ -499,6 +503,164 @@ namespace MetricsDiscovery
         uint32_t        AdapterCount;
     } TAdapterGroupParams_1_6;
 
+    //////////////////////////////////////////////////////////////////////////////////
+    // Adapter filter types:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef enum EAdapterFilterType
+    {
+        ADAPTER_FILTER_TYPE_NONE      = 0, // All adapters are enumerated
+        ADAPTER_FILTER_TYPE_BDF       = 1, // Only adapter with given PCI domain:bus:device.function
+        ADAPTER_FILTER_TYPE_DEVICE_ID = 2, // Only adapters with given PCI device id
+    } TAdapterFilterType;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Adapter filter used during adapter group creation, fails if the group is already opened:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SAdapterFilter_1_15
+    {
+        TAdapterFilterType Type;
+        uint32_t           DomainNumber;   // ADAPTER_FILTER_TYPE_BDF
+        uint32_t           BusNumber;      // ADAPTER_FILTER_TYPE_BDF
+        uint32_t           DeviceNumber;   // ADAPTER_FILTER_TYPE_BDF
+        uint32_t           FunctionNumber; // ADAPTER_FILTER_TYPE_BDF
+        uint32_t           DeviceId;       // ADAPTER_FILTER_TYPE_DEVICE_ID
+    } TAdapterFilter_1_15;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Cross tile aggregation types:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef enum ETileAggregationType
+    {
+        TILE_AGGREGATION_TYPE_SUM,        // Events and raw counters, summed over tiles
+        TILE_AGGREGATION_TYPE_AVERAGE,    // Ratios (e.g. utilization), averaged over tiles
+        TILE_AGGREGATION_TYPE_MAX,        // Durations, throughputs (e.g. frequency), timestamps and flags
+        TILE_AGGREGATION_TYPE_FIRST_TILE, // Information, taken from the first tile
+        TILE_AGGREGATION_TYPE_LAST
+    } TTileAggregationType;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Global parameters of multi tile IO stream:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SMultiTileIoStreamParams_1_15
+    {
+        uint32_t TilesCount;    // Number of sub devices the stream is opened on
+        uint32_t RawReportSize; // Size of a single raw report, the same for every tile
+        uint32_t NsTimerPeriod; // Sampling period applied on every tile
+        uint32_t OaBufferSize;  // Oa buffer size of a single tile
+    } TMultiTileIoStreamParams_1_15;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Typed output column of a metric or information, see CalculateMetricsToColumns:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SOutputColumn_1_15
+    {
+        TValueType ValueType; // VALUE_TYPE_UINT32, VALUE_TYPE_UINT64, VALUE_TYPE_FLOAT or VALUE_TYPE_BOOL, values are converted
+        void*      Data;      // Value of the first report, nullptr if the metric or information isn't needed
+        uint32_t   Stride;    // Bytes between values of consecutive reports, 0 means the size of the value type
+    } TOutputColumn_1_15;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Callback receiving IO stream reports calculated by ProcessReports, each report
+    // has reportSize values (metrics followed by information):
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef void( MD_STDCALL* TReportsCallback_1_15 )( IConcurrentGroup_1_15* concurrentGroup, const TTypedValue_1_0* reports, uint32_t reportCount, uint32_t reportSize, void* userData );
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // IO stream wake-up modes, see SetIoStreamWakeup. Wake-ups are checked by the kernel
+    // every 5 ms, so a waiting reader is woken up at most 200 times per second:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef enum EIoStreamWakeupMode
+    {
+        IO_STREAM_WAKEUP_MODE_DEFAULT      = 0, // When oa buffer is half full
+        IO_STREAM_WAKEUP_MODE_LATENCY      = 1, // When any report is available, for low latency sampling
+        IO_STREAM_WAKEUP_MODE_THROUGHPUT   = 2, // When oa buffer is three quarters full, for bulk capture with fewest wake-ups
+        IO_STREAM_WAKEUP_MODE_REPORT_COUNT = 3, // When the given number of reports is available
+        IO_STREAM_WAKEUP_MODE_LAST
+    } TIoStreamWakeupMode;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Concurrent group lock timeouts, see SetLockTimeout:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef enum EConcurrentGroupLockTimeout
+    {
+        CONCURRENT_GROUP_LOCK_TIMEOUT_TRY     = 0,          // Fail immediately if the group is locked
+        CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT = 0xFFFFFFFF, // Driver default, on Linux 1 s or MD_CONCURRENT_GROUP_LOCK_TIMEOUT environment variable
+    } TConcurrentGroupLockTimeout;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // IO stream flight recorder trigger types, see SetFlightRecorder:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef enum EFlightRecorderTriggerType
+    {
+        FLIGHT_RECORDER_TRIGGER_TYPE_HIGH_WATERMARK = 0, // Metric value rises above HighWatermark of the metric (USAGE_FLAG_INDICATE only)
+        FLIGHT_RECORDER_TRIGGER_TYPE_LOW_WATERMARK  = 1, // Metric value falls below LowWatermark of the metric (USAGE_FLAG_INDICATE only)
+        FLIGHT_RECORDER_TRIGGER_TYPE_RATE           = 2, // Metric value changes faster than Threshold per second of QueryBeginTime
+        FLIGHT_RECORDER_TRIGGER_TYPE_LAST
+    } TFlightRecorderTriggerType;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // IO stream flight recorder trigger, fires when its condition starts to be met:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SFlightRecorderTrigger_1_15
+    {
+        uint32_t                   MetricIndex; // Metric of the IO stream metric set, with API filtering applied
+        TFlightRecorderTriggerType Type;        //
+        double                     Threshold;   // FLIGHT_RECORDER_TRIGGER_TYPE_RATE only, absolute change of value per second
+    } TFlightRecorderTrigger_1_15;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // IO stream flight recorder parameters, see SetFlightRecorder:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SFlightRecorderParams_1_15
+    {
+        uint32_t                           DurationMs;      // Time span of raw reports kept in the ring
+        const TFlightRecorderTrigger_1_15* Triggers;        // Evaluated on reports calculated by ReadAndCalculate and ProcessReports
+        uint32_t                           TriggersCount;   //
+        uint32_t                           MaxCaptureCount; // Triggered captures written before triggers are disarmed, 0 is unlimited
+        const char*                        CaptureFilePath; // Captures are written to <CaptureFilePath>.<capture index>
+    } TFlightRecorderParams_1_15;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // IO stream flight recorder capture file constants:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef enum EFlightRecorderCapture
+    {
+        FLIGHT_RECORDER_CAPTURE_MAGIC          = 0x5246444D, // "MDFR"
+        FLIGHT_RECORDER_CAPTURE_VERSION        = 1,
+        FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER = 0xFFFFFFFF, // Trigger index of captures written by DumpFlightRecorder
+    } TFlightRecorderCapture;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // IO stream flight recorder capture file header. It's followed by an offline metrics
+    // device with the recorded metric set only (see OpenOfflineMetricsDeviceFromBuffer),
+    // then by raw reports, oldest first:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SFlightRecorderCaptureHeader_1_15
+    {
+        uint32_t Magic;            // FLIGHT_RECORDER_CAPTURE_MAGIC
+        uint32_t Version;          // FLIGHT_RECORDER_CAPTURE_VERSION
+        uint32_t HeaderSize;       // Size of this header
+        uint32_t DeviceBufferSize; // Size of the offline metrics device
+        uint32_t RawReportSize;    //
+        uint32_t ReportCount;      //
+        uint32_t NsTimerPeriod;    // Sampling period of the IO stream
+        uint32_t TriggerIndex;     // Index of the fired trigger or FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER
+        double   TriggerValue;     // Metric value (watermark triggers) or its rate of change (rate triggers) which fired
+    } TFlightRecorderCaptureHeader_1_15;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // Quantile sketch parameters, see IQuantileSketch_1_15:
+    //////////////////////////////////////////////////////////////////////////////////
+    typedef struct SQuantileSketchParams_1_15
+    {
+        double   RelativeAccuracy; // Quantiles are estimated within this relative error, e.g. 0.01 is 1%
+        uint32_t MaxBucketsCount;  // Memory bound of positive and of negative values, 8 bytes per bucket
+        uint64_t Count;            // Number of added values
+        double   Min;              // Exact minimum of added values
+        double   Max;              // Exact maximum of added values
+        double   Sum;              // Sum of added values
+    } TQuantileSketchParams_1_15;
+
     //////////////////////////////////////////////////////////////////////////////////
     // Global parameters of Concurrent Group:
     //////////////////////////////////////////////////////////////////////////////////
@@ -1330,6 +1492,86 @@ namespace MetricsDiscovery
             uint32_t          queryModeMask );
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IQuantileSketch_1_15
+    //
+    // Description:
+    //   Abstract interface for a streaming quantile sketch (DDSketch) of metric values.
+    //   Values are counted in buckets with logarithmic bounds, so every quantile is
+    //   estimated within RelativeAccuracy of the exact one, using memory bounded by
+    //   MaxBucketsCount. If values span more buckets, the lowest magnitude buckets are
+    //   merged, so the guarantee is kept for the upper tail (e.g. p99). Sketches with
+    //   the same RelativeAccuracy are mergeable, e.g. over tiles, intervals or processes.
+    //
+    // New:
+    // - GetParams:                 To get this sketch params, including count, min, max and sum
+    // - Add:                       To add a value, NaN and infinity are rejected
+    // - GetQuantile:               To estimate a quantile (0 to 1) of added values
+    // - Merge:                     To add all values of another sketch with the same RelativeAccuracy
+    // - MergeFromBuffer:           To add all values of a sketch serialized by WriteToBuffer
+    // - WriteToBuffer:             To serialize the sketch, e.g. to ship it off-box. Required size is
+    //                              returned if buffer is nullptr
+    // - Reset:                     To remove all values
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IQuantileSketch_1_15
+    {
+    public:
+        virtual ~IQuantileSketch_1_15();
+        virtual TQuantileSketchParams_1_15* GetParams( void );
+        virtual TCompletionCode             Add( double value );
+        virtual TCompletionCode             GetQuantile( double quantile, double* value );
+        virtual TCompletionCode             Merge( IQuantileSketch_1_15* sketch );
+        virtual TCompletionCode             MergeFromBuffer( const uint8_t* buffer, uint32_t bufferSize );
+        virtual TCompletionCode             WriteToBuffer( uint8_t* buffer, uint32_t* bufferSize );
+        virtual TCompletionCode             Reset( void );
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IMetricSet_1_15
+    //
+    // Description:
+    //   Updated 1.13 version to use with 1.15 interface version.
+    //   Adds an ability to calculate IO stream metrics only for given GPU contexts
+    //   and report reasons.
+    //
+    // New:
+    // - SetContextFilter:          To set GPU context ids (ContextId information values) which reports
+    //                              are calculated. Other reports are skipped before calculation.
+    //                              Filter is removed if contextIdsCount is 0.
+    // - SetReportReasonFilter:     To set report reasons (TReportReason mask) which reports are
+    //                              calculated. Skipped reports are included in the next calculated report.
+    //                              Filter is removed if reportReasonMask is 0.
+    // - CalculateQueryPool:        To calculate many query reports at once. Only given metrics are
+    //                              calculated, optionally as a single report summed over the pool.
+    //                              Read deltas are summed and normalized once, metrics which read values
+    //                              are not deltas (timestamps, raw values) are taken from the last report.
+    // - CalculateMetricsToColumns: To calculate metrics and information as CalculateMetrics does, but
+    //                              write them to typed columns, one per metric and information. Each report
+    //                              is written to the columns as soon as it's calculated, no TTypedValue_1_0
+    //                              reports buffer is written and read again.
+    // - SetQuantileSketches:       To aggregate values of given metrics in quantile sketches, added from
+    //                              every report calculated by CalculateMetrics and CalculateMetricsToColumns.
+    //                              Sketches are removed if metricIndicesCount is 0 or API filtering changes.
+    // - GetQuantileSketch:         To get quantile sketch of a given metric, owned by the metric set.
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IMetricSet_1_15 : public IMetricSet_1_13
+    {
+    public:
+        virtual ~IMetricSet_1_15();
+        virtual TCompletionCode       SetContextFilter( const uint32_t* contextIds, uint32_t contextIdsCount );
+        virtual TCompletionCode       SetReportReasonFilter( uint32_t reportReasonMask );
+        virtual TCompletionCode       CalculateQueryPool( const uint8_t* rawData, uint32_t rawDataSize, const uint32_t* metricIndices, uint32_t metricIndicesCount, bool sumReports, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount );
+        virtual TCompletionCode       CalculateMetricsToColumns( const uint8_t* rawData, uint32_t rawDataSize, const TOutputColumn_1_15* columns, uint32_t columnsCount, uint32_t maxReportCount, uint32_t* outReportCount );
+        virtual TCompletionCode       SetQuantileSketches( const uint32_t* metricIndices, uint32_t metricIndicesCount, double relativeAccuracy, uint32_t maxBucketsCount );
+        virtual IQuantileSketch_1_15* GetQuantileSketch( uint32_t metricIndex );
+    };
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1459,6 +1701,69 @@ namespace MetricsDiscovery
         virtual TCompletionCode         RemoveMetricSet( IMetricSet_1_13* metricSet );
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IConcurrentGroup_1_15
+    //
+    // Description:
+    //   Updated 1.13 version to use with 1.15 interface version.
+    //
+    // Updates:
+    // - GetMetricSet:                  Update to 1.15 interface
+    //
+    // New:
+    // - ReadAndCalculate:              To wait for IO stream reports, read them to an internal buffer and
+    //                                  calculate them with the opened metric set in one call. Results are
+    //                                  written either as CalculateMetrics reports or to typed columns.
+    //                                  No more reports are read than fit to the output.
+    // - GetIoStreamHandle:             To get a pollable handle (file descriptor on Linux) of the opened
+    //                                  IO stream, readable when reports are available. To be used with
+    //                                  poll/epoll based event loops, closed by CloseIoStream.
+    // - SetReportsCallback:            To set a callback receiving reports calculated by ProcessReports.
+    //                                  Callback is removed if nullptr is given.
+    // - ProcessReports:                To read and calculate available reports without waiting and pass
+    //                                  them to the reports callback.
+    // - SetIoStreamWakeup:             To set when a reader waiting for IO stream reports is woken up,
+    //                                  trading latency for CPU usage. Applied by the next OpenIoStream,
+    //                                  Linux only. Report count is used with IO_STREAM_WAKEUP_MODE_REPORT_COUNT.
+    //                                  E.g. for 256 B reports sampled every 10 us to a 16 MB oa buffer
+    //                                  a reader is woken up about 3 times per second by default, 2 times
+    //                                  with throughput mode and 200 times with latency mode.
+    //                                  Each wake-up costs a poll and a read syscall, calculation cost
+    //                                  depends on the report count only, not on the mode.
+    // - SetIoStreamContext:            To limit the next IO stream to a single GPU context, so reports of
+    //                                  other contexts are dropped by the kernel. Takes a DRM file descriptor
+    //                                  owning the context and i915 context handle or Xe exec queue id.
+    //                                  The fd has to be opened on the same device and is duplicated by
+    //                                  OpenIoStream, so it may be closed while the stream is opened.
+    //                                  Negative handle restores system wide stream. Linux only.
+    // - SetFlightRecorder:             To keep the last DurationMs of raw IO stream reports in a preallocated
+    //                                  ring and write it to a capture file when a trigger on calculated
+    //                                  metrics fires (watermarks or rate of change). Applied by the next
+    //                                  OpenIoStream, recorder is disabled if nullptr is given.
+    // - DumpFlightRecorder:            To write the flight recorder ring of the opened IO stream to a capture
+    //                                  file on demand, e.g. when reports are read with ReadIoStream.
+    // - SetLockTimeout:                To set how long OpenIoStream waits for the concurrent group locked
+    //                                  by another process or thread, in milliseconds. See TConcurrentGroupLockTimeout
+    //                                  for try-lock and default timeout.
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IConcurrentGroup_1_15 : public IConcurrentGroup_1_13
+    {
+    public:
+        virtual IMetricSet_1_15* GetMetricSet( uint32_t index );
+        virtual TCompletionCode  ReadAndCalculate( uint32_t milliseconds, uint32_t readFlags, uint32_t* reportCount, TTypedValue_1_0* out, uint32_t outSize, const TOutputColumn_1_15* columns, uint32_t columnsCount );
+        virtual TCompletionCode  GetIoStreamHandle( int64_t* handle );
+        virtual TCompletionCode  SetReportsCallback( TReportsCallback_1_15 callback, void* userData );
+        virtual TCompletionCode  ProcessReports( uint32_t readFlags, uint32_t* reportCount );
+        virtual TCompletionCode  SetIoStreamWakeup( TIoStreamWakeupMode mode, uint32_t reportCount );
+        virtual TCompletionCode  SetIoStreamContext( int64_t drmHandle, uint32_t contextId );
+        virtual TCompletionCode  SetFlightRecorder( const TFlightRecorderParams_1_15* params );
+        virtual TCompletionCode  DumpFlightRecorder( void );
+        virtual TCompletionCode  SetLockTimeout( uint32_t milliseconds );
+    };
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1628,6 +1933,24 @@ namespace MetricsDiscovery
         virtual IConcurrentGroup_1_13* GetConcurrentGroup( uint32_t index );
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IMetricsDevice_1_15
+    //
+    // Description:
+    //   Updated 1.13 version to use with 1.15 interface version.
+    //
+    // Updates:
+    // - GetConcurrentGroup:            Update to 1.15 interface
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IMetricsDevice_1_15 : public IMetricsDevice_1_13
+    {
+    public:
+        virtual IConcurrentGroup_1_15* GetConcurrentGroup( uint32_t index );
+    };
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1805,6 +2128,83 @@ namespace MetricsDiscovery
         virtual const TEngineParams_1_13* GetEngineParams( const uint32_t subDeviceIndex, const uint32_t engineIndex );
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IMultiTileIoStream_1_15
+    //
+    // Description:
+    //   Abstract interface for IO stream opened with the same metric set on all
+    //   sub devices (tiles) of an adapter.
+    //
+    // New:
+    // - GetParams:                     To get this stream params
+    // - GetTileMetricsDevice:          To get metrics sub device of a given tile
+    // - GetTileMetricSet:              To get metric set opened on a given tile
+    // - ReadIoStream:                  To read reports of all tiles, every report is tagged with its tile index
+    // - WaitForReports:                To wait for reports from any tile
+    // - GetAggregationType:            To get how a given metric/information is combined over tiles
+    // - CalculateCardMetrics:          To calculate card level metrics from reports of all tiles,
+    //                                  output layout is the same as of the tile metric set
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IMultiTileIoStream_1_15
+    {
+    public:
+        virtual ~IMultiTileIoStream_1_15();
+        virtual TMultiTileIoStreamParams_1_15* GetParams( void );
+        virtual IMetricsDevice_1_15*           GetTileMetricsDevice( uint32_t tileIndex );
+        virtual IMetricSet_1_15*               GetTileMetricSet( uint32_t tileIndex );
+        virtual TCompletionCode                ReadIoStream( uint32_t* reportsCount, char* reportData, uint32_t* tileIndices, uint32_t readFlags );
+        virtual TCompletionCode                WaitForReports( uint32_t milliseconds );
+        virtual TTileAggregationType           GetAggregationType( uint32_t index );
+        virtual TCompletionCode                CalculateCardMetrics( const char* reportData, uint32_t reportsCount, const uint32_t* tileIndices, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount );
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IAdapter_1_15
+    //
+    // Description:
+    //   Abstract interface for GPU adapter.
+    //
+    // New:
+    // - OpenMetricsSubDevices:         To open all metrics sub devices concurrently
+    // - OpenMultiTileIoStream:         To open IO stream with the same metric set on all sub devices
+    // - CloseMultiTileIoStream:        To close multi tile IO stream
+    // - SetMultiTileIoStreamWakeup:    To set IO stream wake-up (see IConcurrentGroup_1_15::SetIoStreamWakeup)
+    //                                  of all tiles, applied by the next OpenMultiTileIoStream. Tile concurrent
+    //                                  groups get back their own wake-up when the stream is closed.
+    //
+    // Updates:
+    // - OpenMetricsDevice:             Update to 1.15 interface
+    // - OpenMetricsDeviceFromFile:     Update to 1.15 interface
+    // - OpenMetricsSubDevice:          Update to 1.15 interface
+    // - OpenMetricsSubDeviceFromFile:  Update to 1.15 interface
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IAdapter_1_15 : public IAdapter_1_13
+    {
+    public:
+        // Updates.
+        using IAdapter_1_13::OpenMetricsDevice;
+        using IAdapter_1_13::OpenMetricsDeviceFromFile;
+        using IAdapter_1_13::OpenMetricsSubDevice;
+        using IAdapter_1_13::OpenMetricsSubDeviceFromFile;
+
+        virtual TCompletionCode OpenMetricsDevice( IMetricsDevice_1_15** metricsDevice );
+        virtual TCompletionCode OpenMetricsDeviceFromFile( const char* fileName, void* openParams, IMetricsDevice_1_15** metricsDevice );
+        virtual TCompletionCode OpenMetricsSubDevice( const uint32_t subDeviceIndex, IMetricsDevice_1_15** metricsDevice );
+        virtual TCompletionCode OpenMetricsSubDeviceFromFile( const uint32_t subDeviceIndex, const char* fileName, void* openParams, IMetricsDevice_1_15** metricsDevice );
+
+        // New.
+        virtual TCompletionCode OpenMetricsSubDevices( IMetricsDevice_1_15** metricsDevices, uint32_t* metricsDevicesCount );
+        virtual TCompletionCode OpenMultiTileIoStream( const char* concurrentGroupName, const char* metricSetName, uint32_t* nsTimerPeriod, uint32_t* oaBufferSize, IMultiTileIoStream_1_15** ioStream );
+        virtual TCompletionCode CloseMultiTileIoStream( IMultiTileIoStream_1_15* ioStream );
+        virtual TCompletionCode SetMultiTileIoStreamWakeup( TIoStreamWakeupMode mode, uint32_t reportCount );
+    };
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1940,20 +2340,48 @@ namespace MetricsDiscovery
         virtual TCompletionCode SaveMetricsDeviceToBuffer( IMetricsDevice_1_13* metricsDevice, IMetricSet_1_13** metricSets, uint32_t metricSetCount, uint8_t* buffer, uint32_t* bufferSize, const uint32_t minMajorApiVersion, const uint32_t minMinorApiVersion );
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //   IAdapterGroup_1_15
+    //
+    // Description:
+    //   Abstract interface for the GPU adapters root object.
+    //
+    // New:
+    // - CreateQuantileSketch:          To create an empty quantile sketch, e.g. to merge sketches received
+    //                                  from other machines with MergeFromBuffer
+    // - DestroyQuantileSketch:         To destroy a quantile sketch created by CreateQuantileSketch
+    //
+    // Updates:
+    // - GetAdapter:                    Update to 1.15 interface
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    class IAdapterGroup_1_15 : public IAdapterGroup_1_14
+    {
+    public:
+        virtual IAdapter_1_15*  GetAdapter( uint32_t index );
+        virtual TCompletionCode CreateQuantileSketch( double relativeAccuracy, uint32_t maxBucketsCount, IQuantileSketch_1_15** sketch );
+        virtual TCompletionCode DestroyQuantileSketch( IQuantileSketch_1_15* sketch );
+    };
+
     //////////////////////////////////////////////////////////////////////////////////
     // Latest interfaces and typedef structs versions:
     //////////////////////////////////////////////////////////////////////////////////
-    using IAdapterGroupLatest                    = IAdapterGroup_1_14;
-    using IAdapterLatest                         = IAdapter_1_13;
-    using IConcurrentGroupLatest                 = IConcurrentGroup_1_13;
+    using IAdapterGroupLatest                    = IAdapterGroup_1_15;
+    using IAdapterLatest                         = IAdapter_1_15;
+    using IConcurrentGroupLatest                 = IConcurrentGroup_1_15;
     using IEquationLatest                        = IEquation_1_0;
     using IInformationLatest                     = IInformation_1_0;
     using IMetricEnumeratorLatest                = IMetricEnumerator_1_13;
     using IMetricLatest                          = IMetric_1_13;
     using IMetricPrototypeLatest                 = IMetricPrototype_1_13;
-    using IMetricSetLatest                       = IMetricSet_1_13;
-    using IMetricsDeviceLatest                   = IMetricsDevice_1_13;
+    using IMetricSetLatest                       = IMetricSet_1_15;
+    using IMetricsDeviceLatest                   = IMetricsDevice_1_15;
+    using IMultiTileIoStreamLatest               = IMultiTileIoStream_1_15;
     using IOverrideLatest                        = IOverride_1_2;
+    using IQuantileSketchLatest                  = IQuantileSketch_1_15;
+    using TAdapterFilterLatest                   = TAdapterFilter_1_15;
     using TAdapterGroupParamsLatest              = TAdapterGroupParams_1_6;
     using TAdapterIdLatest                       = TAdapterId_1_6;
     using TAdapterIdLuidLatest                   = TAdapterIdLuid_1_6;
@@ -1975,7 +2403,10 @@ namespace MetricsDiscovery
     using TMetricPrototypeParamsLatest           = TMetricPrototypeParams_1_13;
     using TMetricSetParamsLatest                 = TMetricSetParams_1_11;
     using TMetricsDeviceParamsLatest             = TMetricsDeviceParams_1_2;
+    using TMultiTileIoStreamParamsLatest         = TMultiTileIoStreamParams_1_15;
+    using TOutputColumnLatest                    = TOutputColumn_1_15;
     using TOverrideParamsLatest                  = TOverrideParams_1_2;
+    using TQuantileSketchParamsLatest            = TQuantileSketchParams_1_15;
     using TReadParamsLatest                      = TReadParams_1_0;
     using TSetDriverOverrideParamsLatest         = TSetDriverOverrideParams_1_2;
     using TSetFrequencyOverrideParamsLatest      = TSetFrequencyOverrideParams_1_2;
@@ -1992,6 +2423,7 @@ namespace MetricsDiscovery
 
         // [Current] Factory functions
         typedef TCompletionCode( MD_STDCALL* OpenAdapterGroup_fn )( IAdapterGroupLatest** adapterGroup );
+        typedef TCompletionCode( MD_STDCALL* OpenAdapterGroupFiltered_fn )( const TAdapterFilterLatest* filter, IAdapterGroupLatest** adapterGroup );
 
         // [Legacy] Factory functions
         typedef TCompletionCode( MD_STDCALL* OpenMetricsDevice_fn )( IMetricsDeviceLatest** metricsDevice );
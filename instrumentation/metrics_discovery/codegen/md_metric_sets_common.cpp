@@ -18,6 +18,7 @@ SPDX-License-Identifier: MIT
 #include "md_metric.h"
 #include "md_utils.h"
 #include <algorithm>
+#include <string>
 
 namespace MetricsDiscoveryInternal::MetricSets_OcclusionQueryStats
 {
@@ -106,3 +107,111 @@ namespace MetricsDiscoveryInternal::MetricSets_TimestampQuery
     }
 
 } // namespace MetricsDiscoveryInternal::MetricSets_TimestampQuery
+
+namespace MetricsDiscoveryInternal::MetricSets_PMU
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Method:
+    //     AddEngineBusyMetrics
+    //
+    // Description:
+    //     Adds the elapsed time and per engine class busyness metrics of
+    //     a TPmuEngineReport, shared by the PMU and DRM fdinfo metric sets.
+    //
+    // Input:
+    //     CMetricSet& metricSet - metric set to add the metrics to
+    //     const char* busyScope - appended to "have been busy" in descriptions, may be empty
+    //
+    // Output:
+    //     TCompletionCode       - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode AddEngineBusyMetrics( CMetricSet& metricSet, const char* busyScope )
+    {
+        static constexpr struct
+        {
+            const char* SymbolName;
+            const char* ShortName;
+            const char* Engines;
+            const char* ReadEquation;
+        } engineBusyMetrics[] = {
+            { "RenderBusy", "Render Engine Busy", "render engines (RCS)", "qw@0x08" },
+            { "CopyBusy", "Copy Engine Busy", "copy (blitter) engines (BCS)", "qw@0x10" },
+            { "VideoBusy", "Video Engine Busy", "video decode/encode engines (VCS)", "qw@0x18" },
+            { "VideoEnhanceBusy", "Video Enhance Engine Busy", "video enhancement engines (VECS)", "qw@0x20" },
+            { "ComputeBusy", "Compute Engine Busy", "compute engines (CCS)", "qw@0x28" },
+        };
+        static_assert( sizeof( engineBusyMetrics ) / sizeof( engineBusyMetrics[0] ) == PMU_ENGINE_CLASS_COUNT );
+
+        CMetric* metric = metricSet.AddMetric( "GpuTime", "GPU Time Elapsed",
+            "Time elapsed during the measurement.",
+            "GPU", ( METRIC_GROUP_NAME_ID_GPU * 0x1000000 ), USAGE_FLAG_TIER_1 | USAGE_FLAG_OVERVIEW | USAGE_FLAG_SYSTEM, API_TYPE_IOSTREAM,
+            METRIC_TYPE_DURATION, RESULT_UINT64, "ns", 0, 0, HW_UNIT_GPU, nullptr, nullptr, nullptr, 0 );
+        MD_CHECK_PTR( metric );
+        MD_CHECK_CC( metric->SetSnapshotReportReadEquation( "qw@0x00" ) );
+        MD_CHECK_CC( metric->SetSnapshotReportDeltaFunction( "DELTA 64" ) );
+
+        for( uint32_t i = 0; i < PMU_ENGINE_CLASS_COUNT; ++i )
+        {
+            const auto&       engineBusyMetric = engineBusyMetrics[i];
+            const std::string description      = std::string( "The percentage of time in which the " ) + engineBusyMetric.Engines + " have been busy" + busyScope + ", averaged over engine instances.";
+
+            metric = metricSet.AddMetric( engineBusyMetric.SymbolName, engineBusyMetric.ShortName,
+                description.c_str(),
+                "GPU/Engines", ( METRIC_GROUP_NAME_ID_GPU * 0x1000000 ), USAGE_FLAG_TIER_1 | USAGE_FLAG_OVERVIEW | USAGE_FLAG_SYSTEM, API_TYPE_IOSTREAM,
+                METRIC_TYPE_DURATION, RESULT_FLOAT, "percent", 0, 0, HW_UNIT_GPU, nullptr, nullptr, nullptr, i + 1 );
+            MD_CHECK_PTR( metric );
+            MD_CHECK_CC( metric->SetSnapshotReportReadEquation( engineBusyMetric.ReadEquation ) );
+            MD_CHECK_CC( metric->SetNormalizationEquation( "$Self $GpuTime FDIV 100 FMUL" ) );
+            MD_CHECK_CC( metric->SetSnapshotReportDeltaFunction( "DELTA 64" ) );
+            MD_CHECK_CC( metric->SetMaxValueEquation( "100" ) );
+        }
+
+        return CC_OK;
+
+    exception:
+        return CC_ERROR_GENERAL;
+    }
+
+    CEngineBusyMetricSet::CEngineBusyMetricSet( CMetricsDevice& device, CConcurrentGroup* concurrentGroup, const char* symbolicName, const char* shortName, uint32_t apiMask, uint32_t category, uint32_t snapshotReportSize, uint32_t deltaReportSize, TReportType reportType, TByteArrayLatest* platformMask, uint32_t gtMask /*= GT_TYPE_ALL*/, bool isCustom /*= false*/ )
+        : CMetricSet( device, concurrentGroup, symbolicName, shortName, apiMask, category, snapshotReportSize, deltaReportSize, reportType, platformMask, gtMask, isCustom )
+    {
+    }
+
+    TCompletionCode CEngineBusyMetricSet::Initialize()
+    {
+        m_params.InformationCount = m_concurrentGroup->GetInformationCount();
+
+        MD_CHECK_CC( AddEngineBusyMetrics( *this, "" ) );
+        MD_CHECK_CC( RefreshConfigRegisters() );
+
+        return CC_OK;
+
+    exception:
+        return CC_ERROR_GENERAL;
+    }
+
+} // namespace MetricsDiscoveryInternal::MetricSets_PMU
+
+namespace MetricsDiscoveryInternal::MetricSets_FDINFO
+{
+    CClientEngineBusyMetricSet::CClientEngineBusyMetricSet( CMetricsDevice& device, CConcurrentGroup* concurrentGroup, const char* symbolicName, const char* shortName, uint32_t apiMask, uint32_t category, uint32_t snapshotReportSize, uint32_t deltaReportSize, TReportType reportType, TByteArrayLatest* platformMask, uint32_t gtMask /*= GT_TYPE_ALL*/, bool isCustom /*= false*/ )
+        : CMetricSet( device, concurrentGroup, symbolicName, shortName, apiMask, category, snapshotReportSize, deltaReportSize, reportType, platformMask, gtMask, isCustom )
+    {
+    }
+
+    TCompletionCode CClientEngineBusyMetricSet::Initialize()
+    {
+        m_params.InformationCount = m_concurrentGroup->GetInformationCount();
+
+        MD_CHECK_CC( MetricSets_PMU::AddEngineBusyMetrics( *this, " with the sampled DRM clients" ) );
+        MD_CHECK_CC( RefreshConfigRegisters() );
+
+        return CC_OK;
+
+    exception:
+        return CC_ERROR_GENERAL;
+    }
+
+} // namespace MetricsDiscoveryInternal::MetricSets_FDINFO
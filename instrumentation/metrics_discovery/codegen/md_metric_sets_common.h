@@ -44,3 +44,29 @@ namespace MetricsDiscoveryInternal::MetricSets_TimestampQuery
     };
 
 } // namespace MetricsDiscoveryInternal::MetricSets_TimestampQuery
+
+namespace MetricsDiscoveryInternal::MetricSets_PMU
+{
+    TCompletionCode AddEngineBusyMetrics( CMetricSet& metricSet, const char* busyScope );
+
+    class CEngineBusyMetricSet final : public CMetricSet
+    {
+    public:
+        CEngineBusyMetricSet( CMetricsDevice& device, CConcurrentGroup* concurrentGroup, const char* symbolicName, const char* shortName, uint32_t apiMask, uint32_t category, uint32_t snapshotReportSize, uint32_t deltaReportSize, TReportType reportType, TByteArrayLatest* platformMask, uint32_t gtMask = GT_TYPE_ALL, bool isCustom = false );
+
+        TCompletionCode Initialize();
+    };
+
+} // namespace MetricsDiscoveryInternal::MetricSets_PMU
+
+namespace MetricsDiscoveryInternal::MetricSets_FDINFO
+{
+    class CClientEngineBusyMetricSet final : public CMetricSet
+    {
+    public:
+        CClientEngineBusyMetricSet( CMetricsDevice& device, CConcurrentGroup* concurrentGroup, const char* symbolicName, const char* shortName, uint32_t apiMask, uint32_t category, uint32_t snapshotReportSize, uint32_t deltaReportSize, TReportType reportType, TByteArrayLatest* platformMask, uint32_t gtMask = GT_TYPE_ALL, bool isCustom = false );
+
+        TCompletionCode Initialize();
+    };
+
+} // namespace MetricsDiscoveryInternal::MetricSets_FDINFO
@@ -722,6 +722,36 @@ TCompletionCode CreateMetricTree( CMetricsDevice* metricsDevice )
         MD_LOG_A( adapterId, LOG_INFO, "OAMG concurrent group is not supported!" );
     }
 
+    MD_CHECK_CC( SetAllBitsPlatformMask( adapterId, &platformMask ) );
+    concurrentGroup = metricsDevice->AddConcurrentGroup( "PMU", "PMU Engine Metrics", MEASUREMENT_TYPE_SNAPSHOT_IO, &platformMask, isSupported );
+    if( isSupported )
+    {
+        MD_CHECK_PTR( concurrentGroup );
+
+        metricSet = concurrentGroup->AddMetricSetExplicit<MetricSets_PMU::CEngineBusyMetricSet>( "EngineBusy", "Engine Busyness", API_TYPE_IOSTREAM,
+            GPU_GENERIC, sizeof( TPmuEngineReport ), 0, OA_REPORT_TYPE_PMU_ENGINE_SAMPLE, &platformMask, nullptr );
+        MD_CHECK_PTR( metricSet );
+    }
+    else
+    {
+        MD_LOG_A( adapterId, LOG_INFO, "PMU concurrent group is not supported!" );
+    }
+
+    MD_CHECK_CC( SetAllBitsPlatformMask( adapterId, &platformMask ) );
+    concurrentGroup = metricsDevice->AddConcurrentGroup( "FDINFO", "DRM Client Engine Metrics", MEASUREMENT_TYPE_SNAPSHOT_IO, &platformMask, isSupported );
+    if( isSupported )
+    {
+        MD_CHECK_PTR( concurrentGroup );
+
+        metricSet = concurrentGroup->AddMetricSetExplicit<MetricSets_FDINFO::CClientEngineBusyMetricSet>( "ClientEngineBusy", "DRM Client Engine Busyness", API_TYPE_IOSTREAM,
+            GPU_GENERIC, sizeof( TPmuEngineReport ), 0, OA_REPORT_TYPE_PMU_ENGINE_SAMPLE, &platformMask, nullptr );
+        MD_CHECK_PTR( metricSet );
+    }
+    else
+    {
+        MD_LOG_A( adapterId, LOG_INFO, "FDINFO concurrent group is not supported!" );
+    }
+
     MD_CHECK_CC( metricsDevice->AddOverrides() );
     MD_LOG_EXIT_A( adapterId );
     return CC_OK;
@@ -54,6 +54,9 @@ namespace MetricsDiscoveryInternal
     class CConcurrentGroup : public IInternalConcurrentGroup
     {
     public:
+        // API 1.15:
+        virtual TCompletionCode SetLockTimeout( uint32_t milliseconds );
+
         // API 1.13:
         using IConcurrentGroup_1_13::AddMetricSet; // To avoid hiding by 1.13 interface function
 
@@ -108,6 +111,7 @@ namespace MetricsDiscoveryInternal
         // Variables:
         TConcurrentGroupParamsLatest m_params;
         void*                        m_semaphore;
+        uint32_t                     m_lockTimeoutMs; // TConcurrentGroupLockTimeout or milliseconds
 
         std::vector<CMetricSet*> m_setsVector;
         std::list<CMetricSet*>   m_otherSetsList; // List of sets unavailable on current platform
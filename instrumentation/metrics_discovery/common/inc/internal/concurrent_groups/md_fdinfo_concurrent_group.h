@@ -0,0 +1,49 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_fdinfo_concurrent_group.h
+
+//     Abstract:   C++ Metrics Discovery DRM fdinfo concurrent group header
+
+#pragma once
+
+#include "md_pmu_concurrent_group.h"
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFdinfoConcurrentGroup
+    //
+    // Description:
+    //     The engine utilization metrics group of DRM clients based on DRM
+    //     fdinfo usage stats. Unlike OA and PMU, utilization can be attributed
+    //     to a process, given as processId of OpenIoStream (0 for all processes).
+    //     As PMU, it doesn't program any hardware, so custom metric sets aren't
+    //     available.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CFdinfoConcurrentGroup : public CPmuConcurrentGroup
+    {
+    public:
+        // Constructor:
+        CFdinfoConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask );
+
+        CFdinfoConcurrentGroup( const CFdinfoConcurrentGroup& )            = delete; // Delete copy-constructor
+        CFdinfoConcurrentGroup& operator=( const CFdinfoConcurrentGroup& ) = delete; // Delete assignment operator
+
+    public:
+        // Static methods:
+        static bool IsSupported( CMetricsDevice& device );
+        static bool IsValidSymbolName( const char* symbolName );
+    };
+
+} // namespace MetricsDiscoveryInternal
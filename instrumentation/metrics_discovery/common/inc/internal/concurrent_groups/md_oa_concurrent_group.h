@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 #pragma once
 
 #include "md_concurrent_group.h"
+#include "md_flight_recorder.h"
 
 using namespace MetricsDiscovery;
 
@@ -36,6 +37,16 @@ namespace MetricsDiscoveryInternal
     class COAConcurrentGroup : public CConcurrentGroup
     {
     public:
+        // API 1.15:
+        virtual TCompletionCode ReadAndCalculate( uint32_t milliseconds, uint32_t readFlags, uint32_t* reportCount, TTypedValue_1_0* out, uint32_t outSize, const TOutputColumn_1_15* columns, uint32_t columnsCount );
+        virtual TCompletionCode GetIoStreamHandle( int64_t* handle );
+        virtual TCompletionCode SetReportsCallback( TReportsCallback_1_15 callback, void* userData );
+        virtual TCompletionCode ProcessReports( uint32_t readFlags, uint32_t* reportCount );
+        virtual TCompletionCode SetIoStreamWakeup( TIoStreamWakeupMode mode, uint32_t reportCount );
+        virtual TCompletionCode SetIoStreamContext( int64_t drmHandle, uint32_t contextId );
+        virtual TCompletionCode SetFlightRecorder( const TFlightRecorderParams_1_15* params );
+        virtual TCompletionCode DumpFlightRecorder( void );
+
         // API 1.13:
         virtual IMetricEnumerator_1_13* GetMetricEnumerator( void );
         virtual IMetricEnumerator_1_13* GetMetricEnumeratorFromFile( const char* fileName );
@@ -67,6 +78,10 @@ namespace MetricsDiscoveryInternal
         CMetricSet*         GetIoMetricSet();
         TStreamType         GetStreamType() const;
         GTDI_OA_BUFFER_TYPE GetOaBufferType() const;
+        TIoStreamWakeupMode GetIoStreamWakeupMode() const;
+        uint32_t            GetIoStreamWakeupReportCount() const;
+        int64_t             GetIoStreamContextDrmHandle() const;
+        uint32_t            GetIoStreamContextId() const;
 
         void* GetStreamEventHandle();
         void  SetStreamEventHandle( void* streamEventHandle );
@@ -99,6 +114,15 @@ namespace MetricsDiscoveryInternal
         std::vector<CInformation*>      m_ioGpuContextInfoVector;
         std::vector<CMetricEnumerator*> m_metricEnumeratorVector;
         std::vector<TArchEvent*>        m_archEventVector;
+        std::vector<uint8_t>            m_readBuffer;            // Raw reports read by ReadAndCalculate, reused between reads
+        TReportsCallback_1_15           m_reportsCallback;       // Set by SetReportsCallback, called by ProcessReports
+        void*                           m_reportsCallbackData;   //
+        std::vector<TTypedValue_1_0>    m_reportsCallbackBuffer; // Reports calculated by ProcessReports, reused between calls
+        TIoStreamWakeupMode             m_ioStreamWakeupMode;        // Set by SetIoStreamWakeup, applied by OpenIoStream
+        uint32_t                        m_ioStreamWakeupReportCount; //
+        int64_t                         m_ioStreamContextDrmHandle;  // Set by SetIoStreamContext, applied by OpenIoStream, -1 is system wide
+        uint32_t                        m_ioStreamContextId;         //
+        CFlightRecorder                 m_flightRecorder;            // Set by SetFlightRecorder, started by OpenIoStream
 
     protected:
         // Static variables:
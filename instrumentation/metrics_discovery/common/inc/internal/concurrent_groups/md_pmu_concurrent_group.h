@@ -0,0 +1,59 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_pmu_concurrent_group.h
+
+//     Abstract:   C++ Metrics Discovery pmu concurrent group header
+
+#pragma once
+
+#include "md_oa_concurrent_group.h"
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Description:
+    //     The engine busyness metrics group based on kernel PMU (perf events)
+    //     instead of OA. Stores metric sets. It has PMU IO Stream implemented,
+    //     which doesn't program any hardware, so custom metric sets aren't
+    //     available.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CPmuConcurrentGroup : public COAConcurrentGroup
+    {
+    public:
+        // API 1.13:
+        virtual IMetricEnumerator_1_13* GetMetricEnumerator( void ) override;
+        virtual IMetricSet_1_13*        AddMetricSet( const char* symbolName, const char* shortName ) override;
+
+    public:
+        // Constructor:
+        CPmuConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask );
+
+        CPmuConcurrentGroup( const CPmuConcurrentGroup& )            = delete; // Delete copy-constructor
+        CPmuConcurrentGroup& operator=( const CPmuConcurrentGroup& ) = delete; // Delete assignment operator
+
+    protected:
+        // Constructor of groups with other streams sampled in user space:
+        CPmuConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask, const TStreamType streamType );
+
+        virtual TCompletionCode GetStreamTypeFromSamplingType( const TSamplingType samplingType, TStreamType& streamType ) const override;
+
+    public:
+        // Static methods:
+        static bool IsSupported( CMetricsDevice& device );
+        static bool IsValidSymbolName( const char* symbolName );
+    };
+
+} // namespace MetricsDiscoveryInternal
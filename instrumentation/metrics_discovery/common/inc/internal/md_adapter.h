@@ -15,6 +15,8 @@ SPDX-License-Identifier: MIT
 #include "metrics_discovery_internal_api.h"
 #include "md_sub_devices_linux.h"
 
+#include <mutex>
+
 #define MD_METRIC_EXTENSION "MD_METRIC_EXTENSION"
 
 using namespace MetricsDiscovery;
@@ -28,6 +30,7 @@ namespace MetricsDiscoveryInternal
     class CAdapterHandle;
     class CDriverInterface;
     class CMetricsDevice;
+    class CMultiTileIoStream;
 
     //////////////////////////////////////////////////////////////////////////////
     //
@@ -41,6 +44,18 @@ namespace MetricsDiscoveryInternal
     class CAdapter : public IAdapterLatest
     {
     public:
+        // API 1.15:
+        // New.
+        virtual TCompletionCode OpenMetricsSubDevices( IMetricsDevice_1_15** metricsDevices, uint32_t* metricsDevicesCount );
+        virtual TCompletionCode OpenMultiTileIoStream( const char* concurrentGroupName, const char* metricSetName, uint32_t* nsTimerPeriod, uint32_t* oaBufferSize, IMultiTileIoStream_1_15** ioStream );
+        virtual TCompletionCode CloseMultiTileIoStream( IMultiTileIoStream_1_15* ioStream );
+        virtual TCompletionCode SetMultiTileIoStreamWakeup( TIoStreamWakeupMode mode, uint32_t reportCount );
+        // Updates.
+        virtual TCompletionCode OpenMetricsDevice( IMetricsDevice_1_15** metricsDevice );
+        virtual TCompletionCode OpenMetricsDeviceFromFile( const char* fileName, void* openParams, IMetricsDevice_1_15** metricsDevice );
+        virtual TCompletionCode OpenMetricsSubDevice( const uint32_t subDeviceIndex, IMetricsDevice_1_15** metricsDevice );
+        virtual TCompletionCode OpenMetricsSubDeviceFromFile( const uint32_t subDeviceIndex, const char* fileName, void* openParams, IMetricsDevice_1_15** metricsDevice );
+
         // API 1.13:
         // Updates.
         virtual TCompletionCode OpenMetricsDevice( IMetricsDevice_1_13** metricsDevice );
@@ -90,18 +105,24 @@ namespace MetricsDiscoveryInternal
 
         // Non-API:
         TCompletionCode OpenMetricsSubDevice( const uint32_t subDeviceIndex, CMetricsDevice** metricsDevice );
+        TCompletionCode OpenMetricsSubDevices( std::vector<CMetricsDevice*>& metricsDevices );
         TCompletionCode OpenMetricsSubDeviceFromFile( const uint32_t subDeviceIndex, const char* fileName, void* openParams, CMetricsDevice** metricsDevice );
         TCompletionCode CloseMetricsDevice( CMetricsDevice* metricsDevice );
         TCompletionCode SaveMetricsDeviceToFile( const char* fileName, void* saveParams, CMetricsDevice* metricsDevice, const uint32_t minMajorApiVersion, const uint32_t minMinorApiVersion );
 
         TCompletionCode OpenMetricsDeviceByIndex( CMetricsDevice** metricsDevice, const uint32_t subDeviceIndex );
+        TCompletionCode OpenMetricsDevicesByIndex( std::vector<CMetricsDevice*>& metricsDevices, const std::vector<uint32_t>& subDeviceIndices );
         TCompletionCode OpenMetricsDeviceFromFileByIndex( const char* fileName, void* openParams, CMetricsDevice** metricsDevice, const uint32_t subDeviceIndex );
 
-        CDriverInterface* GetDriverInterface();
-        CSubDevices&      GetSubDevices();
+        CDriverInterface*           GetDriverInterface();
+        CSubDevices&                GetSubDevices();
+        const TAdapterParamsLatest& GetEnumeratedParams() const;
 
         uint32_t GetAdapterId() const;
 
+        // Lazy initialization:
+        TCompletionCode Initialize();
+
     private:
         // Driver interface:
         TCompletionCode CreateDriverInterface();
@@ -114,6 +135,7 @@ namespace MetricsDiscoveryInternal
 
         // Metrics device:
         TCompletionCode CreateMetricsDevice( CMetricsDevice** metricsDevice, const uint32_t subDeviceIndex = 0 );
+        TCompletionCode CreateMetricsDevices( std::vector<CMetricsDevice*>& metricsDevices, const std::vector<uint32_t>& subDeviceIndices );
         void            DestroyMetricsDevice( CMetricsDevice* metricsDevice );
 
     private:
@@ -123,12 +145,19 @@ namespace MetricsDiscoveryInternal
         CAdapterHandle*      m_adapterHandle;      // OS adapter handle which the given CAdapter object represents
         CDriverInterface*    m_driverInterface;    // Driver interface for this adapter
         void*                m_openCloseSemaphore; // Semaphore used during metrics device operations
+        std::once_flag       m_initializeFlag;     // Driver interface created and sub devices enumerated once
+        TCompletionCode      m_initializeResult;   // Result of the lazy initialization
 
         // Sub devices.
         CSubDevices            m_subDevices;
         TSubDeviceParamsLatest m_subDeviceParams;
         TEngineParamsLatest    m_engineParams;
 
+        // Multi tile io streams.
+        std::vector<CMultiTileIoStream*> m_multiTileIoStreams;
+        TIoStreamWakeupMode              m_multiTileIoStreamWakeupMode;        // Set by SetMultiTileIoStreamWakeup, applied to all tiles
+        uint32_t                         m_multiTileIoStreamWakeupReportCount; //
+
         CAdapterGroup& m_adapterGroup; // Parent adapter group
     };
 } // namespace MetricsDiscoveryInternal
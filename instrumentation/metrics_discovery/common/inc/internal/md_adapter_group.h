@@ -29,6 +29,7 @@ namespace MetricsDiscoveryInternal
     class CAdapter;
     class CDriverInterfaceOffline;
     class CMetricsDevice;
+    class CQuantileSketch;
 
     //////////////////////////////////////////////////////////////////////////////
     //
@@ -49,13 +50,15 @@ namespace MetricsDiscoveryInternal
         virtual TCompletionCode                  OpenOfflineMetricsDeviceFromBuffer( uint8_t* buffer, uint32_t bufferSize, IMetricsDevice_1_13** metricsDevice );
         virtual TCompletionCode                  CloseOfflineMetricsDevice( IMetricsDevice_1_13* metricsDevice );
         virtual TCompletionCode                  SaveMetricsDeviceToBuffer( IMetricsDevice_1_13* metricsDevice, IMetricSet_1_13** metricSets, uint32_t metricSetCount, uint8_t* buffer, uint32_t* bufferSize, const uint32_t minMajorApiVersion, const uint32_t minMinorApiVersion );
+        virtual TCompletionCode                  CreateQuantileSketch( double relativeAccuracy, uint32_t maxBucketsCount, IQuantileSketchLatest** sketch );
+        virtual TCompletionCode                  DestroyQuantileSketch( IQuantileSketchLatest* sketch );
 
     public:
         // Non-API:
         CAdapter* GetDefaultAdapter();
 
         // Non-API static:
-        static TCompletionCode Open( CAdapterGroup** adapterGroup );
+        static TCompletionCode Open( CAdapterGroup** adapterGroup, const TAdapterFilterLatest* filter = nullptr );
         static bool            IsOpened();
         static CAdapterGroup*  Get();
 
@@ -69,24 +72,28 @@ namespace MetricsDiscoveryInternal
         CAdapterGroup& operator=( const CAdapterGroup& ) = delete; // Delete assignment operator
 
         // Adapter handling:
-        TCompletionCode CreateAdapterTree();
+        TCompletionCode CreateAdapterTree( const TAdapterFilterLatest* filter );
         TCompletionCode AddAdapter( const TAdapterData& adapterData );
         void            CleanupAdapters();
         CAdapter*       ChooseDefaultAdapter();
 
+        // Static:
+        static bool IsAdapterFiltered( const TAdapterParamsLatest& params, const TAdapterFilterLatest* filter );
+
         // Static:
         static TCompletionCode GetOpenCloseSemaphore();
         static TCompletionCode ReleaseOpenCloseSemaphore();
-        static TCompletionCode CreateAdapterGroup( CAdapterGroup** adapterGroup );
+        static TCompletionCode CreateAdapterGroup( CAdapterGroup** adapterGroup, const TAdapterFilterLatest* filter );
 
     private:
         // Variables:
-        TAdapterGroupParamsLatest    m_params;
-        CAdapter*                    m_defaultAdapter;
-        std::vector<CAdapter*>       m_adapterVector;
-        CAdapter*                    m_offlineAdapter;
-        CDriverInterfaceOffline*     m_offlineDriverInterface;
-        std::vector<CMetricsDevice*> m_offlineDevicesVector;
+        TAdapterGroupParamsLatest     m_params;
+        CAdapter*                     m_defaultAdapter;
+        std::vector<CAdapter*>        m_adapterVector;
+        CAdapter*                     m_offlineAdapter;
+        CDriverInterfaceOffline*      m_offlineDriverInterface;
+        std::vector<CMetricsDevice*>  m_offlineDevicesVector;
+        std::vector<CQuantileSketch*> m_quantileSketchesVector;
 
     private:
         // Static Variables:
@@ -0,0 +1,228 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_calculation_kernel.h
+
+//     Abstract:   C++ Metrics Discovery internal metric set calculation kernel header
+
+#pragma once
+
+#include "md_types.h"
+
+#include <map>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Forward declarations:                                                     //
+    ///////////////////////////////////////////////////////////////////////////////
+    class CEquation;
+    class CMetricSet;
+    class CMetricsCalculator;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel operation types, read types go first:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef enum EKernelOperationType
+    {
+        KERNEL_OPERATION_READ_BITFIELD,
+        KERNEL_OPERATION_READ_UINT8,
+        KERNEL_OPERATION_READ_UINT16,
+        KERNEL_OPERATION_READ_UINT32,
+        KERNEL_OPERATION_READ_UINT64,
+        KERNEL_OPERATION_READ_FLOAT,
+        KERNEL_OPERATION_READ_40BIT_CNTR,
+        KERNEL_OPERATION_IMMEDIATE,       // Immediate value or resolved static global symbol
+        KERNEL_OPERATION_GPU_CORE_CLOCKS, // GpuCoreClocks delta read earlier in the same report
+        KERNEL_OPERATION_OPERATION,       // See TEquationOperation enumeration
+        KERNEL_OPERATION_LAST
+    } TKernelOperationType;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel operation, a pre-decoded read equation element:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct SKernelOperation
+    {
+        TKernelOperationType Type;
+        TEquationOperation   Operation;
+        uint32_t             ByteOffset;
+        uint32_t             ByteOffsetExt;
+        uint32_t             BitOffset;
+        uint32_t             BitsCount;
+        uint32_t             FieldIndex; // Used for KERNEL_OPERATION_READ_*, index of the decoded report field
+        TTypedValue_1_0      Value;      // Used for KERNEL_OPERATION_IMMEDIATE
+    } TKernelOperation;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel field, a distinct raw report field read by the metric set:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct SKernelField
+    {
+        uint32_t ByteOffset;
+        uint32_t ByteOffsetExt; // Used for KERNEL_OPERATION_READ_40BIT_CNTR
+        uint32_t BitOffset;     // Used for KERNEL_OPERATION_READ_BITFIELD
+        uint32_t BitsCount;     //
+    } TKernelField;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel field group, consecutive fields of the same read type:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct SKernelFieldGroup
+    {
+        TKernelOperationType Type; // One of KERNEL_OPERATION_READ_* types
+        uint32_t             FieldsOffset;
+        uint32_t             FieldsCount;
+    } TKernelFieldGroup;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel node types:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef enum EKernelNodeType
+    {
+        KERNEL_NODE_CONSTANT,                  // Immediate value, static global symbol or folded operation
+        KERNEL_NODE_GLOBAL_SYMBOL,             // Dynamic global symbol
+        KERNEL_NODE_DELTA_VALUE,               // Read (delta) value of a metric
+        KERNEL_NODE_METRIC_VALUE,              // Normalized value of a preceding metric
+        KERNEL_NODE_PREV_METRIC_VALUE,         // Normalized value of a metric from the previous report
+        KERNEL_NODE_OPERATION,                 // See TEquationOperation enumeration
+        KERNEL_NODE_STD_NORM_GPU_DURATION,     // $Self $GpuCoreClocks FDIV 100 FMUL
+        KERNEL_NODE_STD_NORM_EU_AGGR_DURATION, // $Self $GpuCoreClocks $EuCoresTotalCount UMUL FDIV 100 FMUL
+        KERNEL_NODE_LAST
+    } TKernelNodeType;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel node, a normalization equations DAG node:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct SKernelNode
+    {
+        TKernelNodeType    Type;
+        TEquationOperation Operation;
+        uint32_t           Left;        // Operand nodes, used for KERNEL_NODE_OPERATION
+        uint32_t           Right;       //
+        uint32_t           MetricIndex; // Used for metric value nodes
+        const char*        SymbolName;  // Used for KERNEL_NODE_GLOBAL_SYMBOL
+        TTypedValue_1_0    Value;       // Used for KERNEL_NODE_CONSTANT
+    } TKernelNode;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Kernel metric, operations of a metric read equation and nodes
+    // of its normalization equation:
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct SKernelMetric
+    {
+        uint32_t           OperationsOffset; // Index of the first operation
+        uint32_t           OperationsCount;  // 0 for metrics without a read equation
+        TDeltaFunction_1_0 DeltaFunction;    // DELTA_NS_TIME resolved to DELTA_N_BITS
+        uint32_t           NodesOffset;      // Index of the first node added by the metric
+        uint32_t           NodesCount;       // Nodes to calculate before the result, nodes of preceding metrics are reused
+        uint32_t           ResultNode;       // Node with the normalized value
+        TMetricResultType  ResultType;       //
+    } TKernelMetric;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Description:
+    //     Metric set IO read equations compiled to a flat list of operations.
+    //     Offsets, delta functions and static global symbols are resolved once
+    //     when the kernel is built instead of per metric per report, and the
+    //     stack depth is known up front.
+    //
+    //     Raw report fields read by the set are collected into a field table,
+    //     sorted by read type and offset. A report is decoded to a fixed vector
+    //     of field values in one pass, one loop specialized for the read type
+    //     per field group, and read operations index that vector.
+    //
+    //     Normalization equations of all metrics are compiled to one dependency
+    //     DAG. Equal subexpressions share a node, so they are calculated once
+    //     per report, and operations on constants are folded. Nodes are ordered
+    //     so each metric calculates only the nodes it added.
+    //
+    //     Built lazily for the current metrics of the set (filtered or not) and
+    //     invalidated when they change. Equations using elements the kernel
+    //     doesn't support (e.g. dynamic global symbols in read equations) or
+    //     normalized values of metrics not calculated yet leave the kernel
+    //     invalid, the interpreter is used then.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CCalculationKernel
+    {
+    public:
+        // Constants:
+        static constexpr uint32_t INDEX_NONE = 0xFFFFFFFF;
+
+        // Constructor & Destructor:
+        CCalculationKernel( CMetricSet& metricSet );
+        ~CCalculationKernel() = default;
+
+        CCalculationKernel( const CCalculationKernel& )            = delete; // Delete copy-constructor
+        CCalculationKernel& operator=( const CCalculationKernel& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode Build( CMetricsCalculator& calculator );
+        void            Invalidate();
+        bool            IsBuilt() const;
+        bool            IsValid() const;
+
+        const std::vector<TKernelMetric>&     GetMetrics() const;
+        const std::vector<TKernelOperation>&  GetOperations() const;
+        const std::vector<TKernelNode>&       GetNodes() const;
+        const std::vector<TKernelField>&      GetFields() const;
+        const std::vector<TKernelFieldGroup>& GetFieldGroups() const;
+        uint32_t                              GetGpuCoreClocksIndex() const;
+        uint32_t                              GetStackSize() const;
+
+    private:
+        // Methods:
+        TCompletionCode    BuildReadEquation( CEquation& equation, TKernelMetric& kernelMetric );
+        TCompletionCode    BuildGlobalSymbol( const char* symbolName, TKernelOperation& operation );
+        TDeltaFunction_1_0 ResolveDeltaFunction( const TDeltaFunction_1_0& deltaFunction );
+        void               BuildFields();
+
+        TCompletionCode BuildNormEquation( CEquation& equation, const uint32_t metricIndex, TKernelMetric& kernelMetric, CMetricsCalculator& calculator );
+        uint32_t        AddNode( const TKernelNode& node );
+        uint32_t        AddConstantNode( const TTypedValue_1_0& value );
+        uint32_t        AddValueNode( const TKernelNodeType type, const uint32_t metricIndex );
+        uint32_t        AddGlobalSymbolNode( const char* symbolName );
+        uint32_t        AddOperationNode( const TEquationOperation operation, const uint32_t left, const uint32_t right, CMetricsCalculator& calculator );
+
+    private:
+        // Kernel states:
+        typedef enum EKernelState
+        {
+            KERNEL_STATE_NOT_BUILT,
+            KERNEL_STATE_VALID,
+            KERNEL_STATE_NOT_SUPPORTED,
+        } TKernelState;
+
+        // Node key (type, operation, left, right, metric index, value, symbol) used to find equal nodes:
+        typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint64_t, std::string_view> TKernelNodeKey;
+
+        // Field key (read type, byte offset, byte offset ext, bit offset, bits count) used to find equal fields:
+        typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t> TKernelFieldKey;
+
+        // Variables:
+        CMetricSet&                        m_metricSet;
+        std::vector<TKernelMetric>         m_metrics;
+        std::vector<TKernelOperation>      m_operations;
+        std::vector<TKernelNode>           m_nodes;
+        std::vector<TKernelField>          m_fields;
+        std::vector<TKernelFieldGroup>     m_fieldGroups;
+        std::map<TKernelNodeKey, uint32_t> m_nodeIndices;        // Used only during build
+        uint32_t                           m_gpuCoreClocksIndex; // INDEX_NONE if the set has no GpuCoreClocks
+        uint32_t                           m_stackSize;          // Max stack depth of all read equations
+        TKernelState                       m_state;
+    };
+} // namespace MetricsDiscoveryInternal
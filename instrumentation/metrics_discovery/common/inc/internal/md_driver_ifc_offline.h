@@ -113,7 +113,7 @@ namespace MetricsDiscoveryInternal
         };
 
         // Synchronization:
-        virtual TCompletionCode LockConcurrentGroup( const char* name, void** semaphore )
+        virtual TCompletionCode LockConcurrentGroup( const char* name, const uint32_t timeoutMs, void** semaphore )
         {
             return CC_ERROR_NOT_SUPPORTED;
         };
@@ -143,6 +143,14 @@ namespace MetricsDiscoveryInternal
         {
             return CC_ERROR_NOT_SUPPORTED;
         };
+        virtual TCompletionCode WaitForIoStreamReports( const std::vector<COAConcurrentGroup*>& oaConcurrentGroups, const uint32_t milliseconds )
+        {
+            return CC_ERROR_NOT_SUPPORTED;
+        };
+        virtual TCompletionCode GetIoStreamHandle( COAConcurrentGroup& oaConcurrentGroup, int64_t& handle )
+        {
+            return CC_ERROR_NOT_SUPPORTED;
+        };
         virtual bool IsIoMeasurementInfoAvailable( const TIoMeasurementInfoType ioMeasurementInfoType )
         {
             return false;
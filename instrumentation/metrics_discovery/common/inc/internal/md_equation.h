@@ -15,6 +15,9 @@ SPDX-License-Identifier: MIT
 #include "metrics_discovery_api.h"
 
 #include <cstdio>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 using namespace MetricsDiscovery;
@@ -93,11 +96,63 @@ namespace MetricsDiscoveryInternal
     private:
         // Non-API:
         bool IsLegacyMaskGlobalSymbol( const char* symbolName );
+        bool SolveBooleanEquationElements( bool& isMemoizable );
 
     private:
+        // Equation cache manages references to shared equations.
+        friend class CEquationCache;
+
         // Variables:
         std::vector<CEquationElementInternal> m_elementsVector;
         const char*                           m_equationString;
         CMetricsDevice&                       m_device;
+        uint32_t                              m_referenceCount; // References to a shared equation, 0 if not shared, guarded by the cache mutex
+
+        // Memoized availability:
+        bool     m_booleanResult;
+        bool     m_isBooleanResultValid;
+        uint32_t m_booleanResultGeneration; // Symbol set generation the result was solved for
+    };
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Description:
+    //     Device level intern table of parsed equations. Metric sets share most
+    //     of their equations (GpuTime, GpuCoreClocks, report information etc.),
+    //     so an equation string is parsed once per device and its equation is
+    //     shared with reference counting. Equations with elements that are
+    //     updated per metric set (local counter and metric symbols) aren't shared.
+    //     Shared equations are read only, use MakeEquationUnique before changing
+    //     an equation.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CEquationCache
+    {
+    public:
+        // Constructor & Destructor:
+        CEquationCache( CMetricsDevice& device );
+        ~CEquationCache();
+
+        CEquationCache( const CEquationCache& )            = delete; // Delete copy-constructor
+        CEquationCache& operator=( const CEquationCache& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode GetEquation( const char* equationString, CEquation*& equation );
+        CEquation*      CopyEquation( CEquation* equation );
+        TCompletionCode MakeEquationUnique( CEquation*& equation );
+        void            ReleaseEquation( CEquation*& equation );
+
+    private:
+        // Methods:
+        bool IsShareable( CEquation& equation );
+
+    private:
+        // Variables:
+        CMetricsDevice&                                  m_device;
+        std::unordered_map<std::string_view, CEquation*> m_equations; // Shared equations by equation string
+        std::mutex                                       m_mutex;
     };
 } // namespace MetricsDiscoveryInternal
@@ -0,0 +1,106 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_flight_recorder.h
+
+//     Abstract:   C++ Metrics Discovery internal io stream flight recorder header
+
+#pragma once
+
+#include "md_types.h"
+
+#include <string>
+#include <vector>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Forward declarations:                                                     //
+    ///////////////////////////////////////////////////////////////////////////////
+    class CMetricsDevice;
+    class CMetricSet;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Description:
+    //     Keeps the last raw reports of an io stream in a ring, preallocated when
+    //     the stream is opened, so recording a batch costs at most two copies.
+    //     Triggers are evaluated on calculated reports and fire when their
+    //     condition starts to be met. The ring is then written to a capture file
+    //     together with a description of the device (offline metrics device
+    //     with the recorded metric set), so captures can be calculated offline.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CFlightRecorder
+    {
+    public:
+        // Constructor & Destructor:
+        CFlightRecorder( CMetricsDevice& device );
+        ~CFlightRecorder();
+
+        CFlightRecorder( const CFlightRecorder& )            = delete; // Delete copy-constructor
+        CFlightRecorder& operator=( const CFlightRecorder& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode SetParams( const TFlightRecorderParams_1_15* params );
+        bool            IsEnabled() const;
+        bool            IsStarted() const;
+
+        TCompletionCode Start( CMetricSet& metricSet, const uint32_t nsTimerPeriod );
+        void            Stop();
+        void            Record( const char* reportData, const uint32_t reportCount );
+        TCompletionCode EvaluateTriggers( const TTypedValue_1_0* reports, const uint32_t reportCount, const uint32_t reportSize );
+        TCompletionCode EvaluateTriggers( const TOutputColumn_1_15* columns, const uint32_t columnsCount, const uint32_t reportCount );
+        TCompletionCode Dump( const uint32_t triggerIndex, const double triggerValue );
+
+    private:
+        // Trigger state between batches:
+        typedef struct STrigger
+        {
+            TFlightRecorderTrigger_1_15 Params;
+            double                      Watermark;     // Watermark triggers only, taken from the metric
+            double                      PreviousValue;     // Rate triggers only
+            double                      PreviousTimestamp; // Rate triggers only, gpu timestamp in ns of the previous value
+            bool                        HasPreviousValue;
+            bool                        IsMet; // Condition met by the previous report, the trigger fires again once it's not
+        } TTrigger;
+
+        // Methods:
+        template <typename ValueGetter>
+        TCompletionCode EvaluateTriggers( const uint32_t reportCount, ValueGetter getValue );
+        bool            IsTriggerMet( TTrigger& trigger, const double value, const double timestamp, double& triggerValue );
+
+        static bool GetColumnValue( const TOutputColumn_1_15& column, const uint32_t reportIndex, double& value );
+
+    private:
+        // Variables:
+        CMetricsDevice&       m_device;
+        bool                  m_isEnabled;
+        uint32_t              m_durationMs;
+        uint32_t              m_maxCaptureCount;
+        std::string           m_captureFilePath;
+        std::vector<TTrigger> m_triggers;
+
+        // Valid between Start and Stop:
+        std::vector<uint8_t> m_deviceBuffer; // Offline metrics device written to every capture
+        std::vector<uint8_t> m_ring;         // Raw reports
+        uint32_t             m_rawReportSize;
+        uint32_t             m_nsTimerPeriod;
+        uint32_t             m_timestampIndex; // QueryBeginTime in a calculated report, metrics followed by information
+        uint32_t             m_ringCapacity; // In reports
+        uint32_t             m_ringHead;     // Index of the next report to write
+        uint32_t             m_ringCount;    // Valid reports, oldest at m_ringHead once the ring is full
+        uint32_t             m_captureCount; // Captures written since SetParams, triggered and manual
+        uint32_t             m_triggeredCaptureCount;
+    };
+} // namespace MetricsDiscoveryInternal
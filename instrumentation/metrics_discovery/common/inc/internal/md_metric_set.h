@@ -27,6 +27,7 @@ namespace MetricsDiscoveryInternal
     ///////////////////////////////////////////////////////////////////////////////
     // Forward declarations:                                                     //
     ///////////////////////////////////////////////////////////////////////////////
+    class CCalculationKernel;
     class CCalculationManager;
     class CConcurrentGroup;
     class CEquation;
@@ -34,6 +35,7 @@ namespace MetricsDiscoveryInternal
     class CMetric;
     class CMetricsCalculator;
     class CMetricsDevice;
+    class CQuantileSketch;
     class CRegisterSet;
 
     union SCalculationContext;
@@ -151,6 +153,14 @@ namespace MetricsDiscoveryInternal
     class CMetricSet : public IInternalMetricSet
     {
     public:
+        // API 1.15:
+        virtual TCompletionCode        SetContextFilter( const uint32_t* contextIds, uint32_t contextIdsCount );
+        virtual TCompletionCode        SetReportReasonFilter( uint32_t reportReasonMask );
+        virtual TCompletionCode        CalculateQueryPool( const uint8_t* rawData, uint32_t rawDataSize, const uint32_t* metricIndices, uint32_t metricIndicesCount, bool sumReports, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount );
+        virtual TCompletionCode        CalculateMetricsToColumns( const uint8_t* rawData, uint32_t rawDataSize, const TOutputColumn_1_15* columns, uint32_t columnsCount, uint32_t maxReportCount, uint32_t* outReportCount );
+        virtual TCompletionCode        SetQuantileSketches( const uint32_t* metricIndices, uint32_t metricIndicesCount, double relativeAccuracy, uint32_t maxBucketsCount );
+        virtual IQuantileSketchLatest* GetQuantileSketch( uint32_t metricIndex );
+
         // API 1.13:
         virtual TCompletionCode Open();
         virtual TCompletionCode AddMetric( IMetricPrototype_1_13* metricPrototype );
@@ -253,6 +263,11 @@ namespace MetricsDiscoveryInternal
         CInformation* AddInformation( CInformation* information );
         bool          HasInformation( const char* symbolName );
 
+        TCompletionCode AddCpuTimestampInformation();
+        void            UpdateCpuTimestampIndices();
+
+        void WriteReportToColumns( TTypedValue_1_0* report, uint32_t reportIndex, const TOutputColumn_1_15* columns, uint32_t columnsCount );
+
         TCompletionCode AddComplementaryMetricSet( const char* complementaryMetricSetSymbolicName );
         TCompletionCode AddComplementaryMetricSets( const char* complementarySetsList );
 
@@ -275,6 +290,7 @@ namespace MetricsDiscoveryInternal
 
         CConcurrentGroup*   GetConcurrentGroup();
         CMetricsCalculator* GetMetricsCalculator();
+        CCalculationKernel* GetCalculationKernel();
         CMetricsDevice&     GetMetricsDevice();
         TByteArrayLatest*   GetPlatformMask();
 
@@ -316,6 +332,19 @@ namespace MetricsDiscoveryInternal
         TCompletionCode ValidateCalculateMetricsParams( uint32_t rawDataSize, uint32_t rawReportSize, uint32_t outSize, uint32_t rawReportCount, uint32_t outMaxValuesSize );
         void            InitializeCalculationManager( TMeasurementType measurementType, CCalculationManager** calculationManager, bool init );
         TCompletionCode InitializeCalculationContext( TCalculationContext& context, CCalculationManager* calculationManager, TMeasurementType measurementType, TTypedValue_1_0* out, TTypedValue_1_0* outMaxValues, const uint8_t* rawData, uint32_t rawReportCount, bool init );
+        void            CalculateCpuTimestamps( TTypedValue_1_0* out, const uint32_t outReportCount, const bool updateCorrelation = true );
+
+        // Query pool calculation:
+        bool            IsQueryPoolPlanValid( const uint32_t* metricIndices, uint32_t metricIndicesCount );
+        TCompletionCode PrepareQueryPoolPlan( const uint32_t* metricIndices, uint32_t metricIndicesCount );
+        void            AddQueryPoolDependencies( uint32_t metricIndex, std::vector<bool>& readMetrics, std::vector<bool>& normMetrics );
+
+        // Output columns:
+        bool AreOutputColumnsValid( const TOutputColumn_1_15* columns, uint32_t columnsCount );
+
+        // Quantile sketches:
+        void AddToQuantileSketches( const TTypedValue_1_0* reports, uint32_t reportsCount );
+        void ClearQuantileSketches();
 
         bool AreMetricParamsValid( const char* symbolName, const char* shortName, const char* description, const char* groupName, TMetricType metricType, TMetricResultType resultType, const char* units, THwUnitType hwType, const char* alias );
         bool IsCustomApiMaskValid( const uint32_t apiMask );
@@ -363,6 +392,34 @@ namespace MetricsDiscoveryInternal
         bool                m_isReadRegsCfgSet;       // if true then read regs config will be cleared on Deactivate; determined during Activate
         TPmRegsConfigInfo   m_pmRegsConfigInfo;
         CMetricsCalculator* m_metricsCalculator;
+        CCalculationKernel* m_calculationKernel; // Compiled IO read equations of the current metrics
+
+        // Report filtering:
+        std::vector<uint32_t> m_contextIdFilter;    // Context ids to calculate in IO stream, empty if filtering is disabled
+        uint32_t              m_reportReasonFilter; // Report reasons to calculate in IO stream, 0 if filtering is disabled
+        std::vector<uint32_t> m_reportNumbers;      // Raw report numbers to calculate, reused between calculations
+        std::vector<uint32_t> m_prevReportNumbers;  // Raw report numbers deltas start from, reused between calculations
+
+        // Query pool calculation plan, reused while requested metrics don't change:
+        uint32_t                     m_queryPoolApiMask;     // Api mask the plan was prepared for
+        std::vector<uint32_t>        m_queryPoolMetrics;     // Requested metrics in output order
+        std::vector<uint32_t>        m_queryPoolReadMetrics; // Metrics to read with delta read equations, sorted ascending
+        std::vector<uint32_t>        m_queryPoolLastMetrics; // Metrics to read with non delta read equations, taken from the last report when summed
+        std::vector<uint32_t>        m_queryPoolNormMetrics; // Metrics to normalize, sorted ascending
+        std::vector<TTypedValue_1_0> m_queryPoolDeltaValues; // Read (or summed) values of all metrics
+        std::vector<TTypedValue_1_0> m_queryPoolValues;      // Normalized values of all metrics
+
+        // Output columns calculation, each report is written to columns as soon as it's calculated:
+        std::vector<TTypedValue_1_0> m_columnsReport; // The report being calculated, reused between calculations
+
+        // Cpu timestamps, information indices found on activation, valid while API filtering doesn't change:
+        uint32_t m_gpuTimestampIndex;        // QueryBeginTime, InformationCount if not available
+        uint32_t m_cpuTimestampIndex;        // QueryBeginTimeCpu, InformationCount if not available
+        bool     m_areTimestampIndicesValid; // false if indices have to be found again
+
+        // Quantile sketches of calculated metrics, valid while API filtering doesn't change:
+        std::vector<CQuantileSketch*> m_quantileSketches;      // Indexed by metric, nullptr if not sketched
+        std::vector<uint32_t>         m_quantileSketchMetrics; // Sketched metrics, sorted ascending
 
         // Flexible metric set members:
         bool               m_isOam;
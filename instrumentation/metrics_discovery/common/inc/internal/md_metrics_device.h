@@ -12,7 +12,9 @@ SPDX-License-Identifier: MIT
 
 #pragma once
 
+#include "md_equation.h"
 #include "md_symbol_set.h"
+#include "md_timestamp_correlation.h"
 
 #include <vector>
 
@@ -92,14 +94,16 @@ namespace MetricsDiscoveryInternal
         TCompletionCode   WriteToBuffer( uint8_t* buffer, uint32_t& bufferSize, IMetricSet_1_13** metricSets, uint32_t metricSetCount, const uint32_t minMajorApiVersion, const uint32_t minMinorApiVersion );
         TCompletionCode   OpenFromFile( const char* fileName );
         TCompletionCode   OpenOfflineFromBuffer( uint8_t* buffer, uint32_t bufferSize );
-        TQueryMode        GetQueryMode() const;
-        CConcurrentGroup* GetConcurrentGroupByName( const char* symbolicName );
-        CDriverInterface& GetDriverInterface();
-        CAdapter&         GetAdapter();
-        CSymbolSet&       GetSymbolSet();
-        uint32_t          GetPlatformIndex();
-        bool              IsOpenedFromFile();
-        uint64_t          ConvertGpuTimestampToNs( const uint64_t gpuTimestampTicks, const uint64_t gpuTimestampFrequency );
+        TQueryMode             GetQueryMode() const;
+        CConcurrentGroup*      GetConcurrentGroupByName( const char* symbolicName );
+        CDriverInterface&      GetDriverInterface();
+        CAdapter&              GetAdapter();
+        CSymbolSet&            GetSymbolSet();
+        CEquationCache&        GetEquationCache();
+        CTimestampCorrelation& GetTimestampCorrelation();
+        uint32_t               GetPlatformIndex();
+        bool                   IsOpenedFromFile();
+        uint64_t               ConvertGpuTimestampToNs( const uint64_t gpuTimestampTicks, const uint64_t gpuTimestampFrequency );
 
         // Reference counter.
         uint32_t& GetReferenceCounter();
@@ -112,8 +116,10 @@ namespace MetricsDiscoveryInternal
         // Performance stream.
         int32_t               GetStreamId();
         int32_t               GetStreamConfigId();
+        int32_t               GetStreamContextDrmFd();
         void                  SetStreamId( const int32_t id );
         void                  SetStreamConfigId( const int32_t id );
+        void                  SetStreamContextDrmFd( const int32_t fd );
         std::vector<uint8_t>& GetStreamBuffer();
 
     private:
@@ -136,10 +142,13 @@ namespace MetricsDiscoveryInternal
         CAdapter&                      m_adapter;
         CDriverInterface&              m_driverInterface;
         CSymbolSet                     m_symbolSet;
+        CTimestampCorrelation          m_timestampCorrelation;
+        CEquationCache                 m_equationCache;
 
         // Stream:
         int32_t              m_streamId;
         int32_t              m_streamConfigId;
+        int32_t              m_streamContextDrmFd; // Duplicated DRM fd owning the stream context, -1 if system wide
         std::vector<uint8_t> m_streamBuffer;
 
         // Sub device:
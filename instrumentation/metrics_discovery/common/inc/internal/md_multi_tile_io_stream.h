@@ -0,0 +1,101 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_multi_tile_io_stream.h
+
+//     Abstract:   C++ Metrics Discovery internal multi tile io stream header
+
+#pragma once
+
+#include "md_types.h"
+
+#include <vector>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Forward declarations:                                                     //
+    ///////////////////////////////////////////////////////////////////////////////
+    class CAdapter;
+    class CMetricsDevice;
+    class CMetricSet;
+    class COAConcurrentGroup;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Description:
+    //     Io stream opened with the same metric set on all sub devices (tiles)
+    //     of the adapter. Reports of all tiles are read at once and tagged with
+    //     the sub device index they come from.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CMultiTileIoStream : public IMultiTileIoStreamLatest
+    {
+    public:
+        // API 1.15:
+        virtual TMultiTileIoStreamParamsLatest* GetParams( void );
+        virtual IMetricsDeviceLatest*           GetTileMetricsDevice( uint32_t tileIndex );
+        virtual IMetricSetLatest*               GetTileMetricSet( uint32_t tileIndex );
+        virtual TCompletionCode                 ReadIoStream( uint32_t* reportsCount, char* reportData, uint32_t* tileIndices, uint32_t readFlags );
+        virtual TCompletionCode                 WaitForReports( uint32_t milliseconds );
+        virtual TTileAggregationType            GetAggregationType( uint32_t index );
+        virtual TCompletionCode                 CalculateCardMetrics( const char* reportData, uint32_t reportsCount, const uint32_t* tileIndices, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount );
+
+    public:
+        // Constructor & Destructor:
+        CMultiTileIoStream( CAdapter& adapter );
+        virtual ~CMultiTileIoStream();
+
+        CMultiTileIoStream( const CMultiTileIoStream& )            = delete; // Delete copy-constructor
+        CMultiTileIoStream& operator=( const CMultiTileIoStream& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode Open( const std::vector<CMetricsDevice*>& metricsDevices, const char* concurrentGroupName, const char* metricSetName, const TIoStreamWakeupMode wakeupMode, const uint32_t wakeupReportCount, uint32_t& nsTimerPeriod, uint32_t& oaBufferSize );
+        TCompletionCode Close();
+        CMetricsDevice* GetTileDevice( const uint32_t tileIndex );
+
+    private:
+        // Wake-up of a tile concurrent group before the stream was opened:
+        typedef struct STileWakeup
+        {
+            TIoStreamWakeupMode Mode;
+            uint32_t            ReportCount;
+        } TTileWakeup;
+
+        // Methods:
+        TCompletionCode CalculateTileMetrics( const char* reportData, const uint32_t reportsCount, const uint32_t* tileIndices, const uint32_t valuesCount );
+        uint32_t        AlignTileReports( const uint32_t timestampIndex, const uint32_t valuesCount, TTypedValue_1_0* out, const uint32_t outReportsMax );
+        void            AggregateReport( const std::vector<uint32_t>& tileReports, const uint32_t valuesCount, TTypedValue_1_0* out );
+
+        static TTileAggregationType GetMetricAggregationType( const TMetricType metricType );
+        static void                 AggregateValue( TTypedValue_1_0& out, const TTypedValue_1_0& value, const TTileAggregationType aggregationType );
+        static void                 DivideValue( TTypedValue_1_0& out, const uint32_t divisor );
+
+    private:
+        // Variables:
+        CAdapter&                        m_adapter;
+        TMultiTileIoStreamParamsLatest   m_params;
+        std::vector<CMetricsDevice*>     m_devices;            // Indexed by tile (sub device) index
+        std::vector<CMetricSet*>         m_metricSets;         // Metric set opened on each tile
+        std::vector<COAConcurrentGroup*> m_oaConcurrentGroups; // Concurrent group with opened stream on each tile
+        uint32_t                         m_firstTileToRead;    // Tile read first during the next ReadIoStream
+        std::vector<TTileWakeup>         m_tileWakeups;        // Restored on each tile by Close
+
+        // Cross tile aggregation, kept between CalculateCardMetrics calls.
+        std::vector<TTileAggregationType>         m_aggregationTypes;   // Aggregation type of every metric / information
+        std::vector<std::vector<uint8_t>>         m_tileRawData;        // Raw reports of each tile
+        std::vector<std::vector<TTypedValue_1_0>> m_tileValues;         // Calculated reports of each tile, not aligned ones are kept for the next call
+        std::vector<uint32_t>                     m_tileReportsCount;   // Calculated reports count of each tile
+        uint32_t                                  m_pendingValuesCount; // Values count of a report in m_tileValues
+    };
+} // namespace MetricsDiscoveryInternal
@@ -0,0 +1,106 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_quantile_sketch.h
+
+//     Abstract:   C++ Metrics Discovery internal quantile sketch header
+
+#pragma once
+
+#include "md_types.h"
+
+#include <vector>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Description:
+    //     DDSketch of metric values. A value v is counted in bucket
+    //     ceil( log_gamma( |v| ) ), gamma = ( 1 + a ) / ( 1 - a ), so any value
+    //     of a bucket is within relative accuracy a of the bucket value.
+    //     Positive and negative values have separate dense stores of bucket
+    //     counts, zeros are counted apart. A store spanning more than
+    //     MaxBucketsCount buckets collapses its lowest buckets into one.
+    //
+    //     Serialized sketch (little-endian, doubles as IEEE 754 binary64 bits):
+    //     - uint32_t magic, uint32_t version,
+    //     - double relative accuracy, uint64_t count, uint64_t zero count,
+    //     - double min, double max, double sum,
+    //     - negative then positive store: int32_t min index, uint32_t buckets
+    //       count, uint64_t bucket counts[buckets count].
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CQuantileSketch : public IQuantileSketchLatest
+    {
+    public:
+        // API 1.15:
+        virtual TQuantileSketchParamsLatest* GetParams( void );
+        virtual TCompletionCode              Add( double value );
+        virtual TCompletionCode              GetQuantile( double quantile, double* value );
+        virtual TCompletionCode              Merge( IQuantileSketchLatest* sketch );
+        virtual TCompletionCode              MergeFromBuffer( const uint8_t* buffer, uint32_t bufferSize );
+        virtual TCompletionCode              WriteToBuffer( uint8_t* buffer, uint32_t* bufferSize );
+        virtual TCompletionCode              Reset( void );
+
+    public:
+        // Constructor & Destructor:
+        CQuantileSketch( const uint32_t adapterId, const double relativeAccuracy, const uint32_t maxBucketsCount );
+        virtual ~CQuantileSketch();
+
+        CQuantileSketch( const CQuantileSketch& )            = delete; // Delete copy-constructor
+        CQuantileSketch& operator=( const CQuantileSketch& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        void AddValue( const double value );
+
+        static bool AreParamsValid( const uint32_t adapterId, const double relativeAccuracy, const uint32_t maxBucketsCount );
+
+    private:
+        // Bucket counts, Counts[i] is bucket MinIndex + i:
+        typedef struct SStore
+        {
+            int32_t               MinIndex;
+            std::vector<uint64_t> Counts;
+        } TStore;
+
+        // Methods:
+        void   AddToStore( TStore& store, int32_t index, const uint64_t count );
+        void   MergeStores( const TStore& negative, const TStore& positive, const uint64_t zeroCount, const uint64_t count, const double min, const double max, const double sum );
+        double GetBucketValue( const int32_t index ) const;
+
+        static bool ReadStore( const uint8_t* buffer, const uint32_t bufferSize, uint32_t& bufferOffset, TStore& store );
+        static void WriteStore( const TStore& store, uint8_t* buffer, uint32_t& bufferOffset );
+
+        template <typename T>
+        static void ReadLittleEndian( const uint8_t* buffer, uint32_t& bufferOffset, T& value );
+        template <typename T>
+        static void WriteLittleEndian( const T value, uint8_t* buffer, uint32_t& bufferOffset );
+
+    private:
+        // Constants:
+        static constexpr uint32_t BUFFER_MAGIC          = 0x5351444D; // "MDQS"
+        static constexpr uint32_t BUFFER_VERSION        = 1;
+        static constexpr double   MIN_RELATIVE_ACCURACY = 1e-6; // Keeps bucket indices of all finite values in int32_t
+        static constexpr uint32_t MAX_BUCKETS_COUNT     = 1 << 20;
+
+        // Variables:
+        const uint32_t              m_adapterId;
+        TQuantileSketchParamsLatest m_params;
+        double                      m_gamma;
+        double                      m_logGamma;
+        uint64_t                    m_zeroCount;
+        TStore                      m_negative; // Indexed by magnitude
+        TStore                      m_positive;
+    };
+} // namespace MetricsDiscoveryInternal
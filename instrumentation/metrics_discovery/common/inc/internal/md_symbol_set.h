@@ -49,6 +49,7 @@ namespace MetricsDiscoveryInternal
 
         // Non-API:
         uint32_t        GetSymbolCount();
+        uint32_t        GetGeneration();
         TGlobalSymbol*  GetSymbol( uint32_t index );
         TGlobalSymbol*  GetSymbolByName( std::string_view name );
         TCompletionCode AddSymbol( const char* name, TTypedValueLatest typedValue, TSymbolType symbolType );
@@ -81,6 +82,7 @@ namespace MetricsDiscoveryInternal
         uint32_t                                             m_maxL3Node;
         uint32_t                                             m_maxL3BankPerL3Node;
         uint32_t                                             m_maxCopyEngine;
+        uint32_t                                             m_generation; // Incremented when a symbol is added
 
     private:
         // Static variables:
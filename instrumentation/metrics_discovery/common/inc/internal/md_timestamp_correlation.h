@@ -0,0 +1,89 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_timestamp_correlation.h
+
+//     Abstract:   C++ Metrics Discovery internal gpu / cpu timestamp correlation header
+
+#pragma once
+
+#include "md_types.h"
+
+#include <mutex>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Forward declarations:                                                     //
+    ///////////////////////////////////////////////////////////////////////////////
+    class CMetricsDevice;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Description:
+    //     Maps gpu timestamps to cpu (CLOCK_MONOTONIC) timestamps without a driver
+    //     call per timestamp. (gpu, cpu) timestamp pairs are sampled at most once
+    //     per sampling period and a linear model (offset and drift) is fitted to
+    //     the last samples with least squares.
+    //     Gpu timestamps in ns wrap with the report timestamp width (e.g. 32 bit
+    //     ticks). Samples are extended over wraps, report timestamps are
+    //     converted relative to the latest sample within half of the wrap period.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CTimestampCorrelation
+    {
+    public:
+        // Constructor & Destructor:
+        CTimestampCorrelation( CMetricsDevice& device );
+        ~CTimestampCorrelation() = default;
+
+        CTimestampCorrelation( const CTimestampCorrelation& )            = delete; // Delete copy-constructor
+        CTimestampCorrelation& operator=( const CTimestampCorrelation& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode Update();
+        void            ConvertToCpuTimestamps( TTypedValue_1_0* reports, const uint32_t reportsCount, const uint32_t reportSize, const uint32_t gpuIndex, const uint32_t cpuIndex );
+
+    private:
+        // Methods:
+        TCompletionCode AddSample( const uint64_t nowNs );
+        void            FitModel();
+        uint64_t        GetGpuWrapPeriod();
+
+    private:
+        // Constants:
+        static constexpr uint32_t SAMPLES_COUNT       = 8;
+        static constexpr uint64_t SAMPLING_PERIOD_NS  = 100000000; // 100 ms
+        static constexpr int64_t  MAX_DRIFT_DIVIDER   = 1000;      // Clocks differ less than 1000 ppm between samples
+        static constexpr int64_t  MAX_SAMPLE_ERROR_NS = 10000000;  // 10 ms, latency of a sample
+
+        // Variables:
+        CMetricsDevice& m_device;
+        std::mutex      m_mutex;
+
+        uint64_t m_gpuSamples[SAMPLES_COUNT]; // Gpu timestamps in ns, extended over wraps
+        uint64_t m_cpuSamples[SAMPLES_COUNT]; // Cpu timestamps in ns
+        uint32_t m_samplesCount;              // Valid samples, up to SAMPLES_COUNT
+        uint32_t m_nextSample;                // Ring buffer position
+        uint64_t m_lastSampleNs;              // Cpu time of the last sample
+        uint64_t m_lastGpuSample;             // Gpu timestamp of the last sample as read (wrapped)
+        uint64_t m_gpuWrapNs;                 // Gpu timestamp wrap period in ns, 0 if unknown
+
+        // Model: cpu = m_cpuReference + ( gpu - m_gpuReference ) * m_slope.
+        uint64_t m_gpuReference;        // Extended over wraps
+        uint64_t m_gpuReferenceWrapped; // As reported by the device, report timestamps are compared to it
+        uint64_t m_cpuReference;
+        double   m_slope;
+        bool     m_isValid;
+    };
+} // namespace MetricsDiscoveryInternal
@@ -15,6 +15,7 @@ SPDX-License-Identifier: MIT
 #include "metrics_discovery_api.h"
 
 #include <stack>
+#include <vector>
 
 #define MD_SAVED_REPORT_NUMBER 0xFFFFFFFF
 
@@ -23,6 +24,7 @@ using namespace MetricsDiscovery;
 namespace MetricsDiscoveryInternal
 {
     // Forward declarations //
+    class CCalculationKernel;
     class CMetricsDevice;
     class CMetricSet;
     class CEquation;
@@ -47,9 +49,11 @@ namespace MetricsDiscoveryInternal
         uint32_t       RawReportSize;
 
         // Output
-        TTypedValue_1_0* Out; // Required
-        uint32_t         OutReportCount;
-        TTypedValue_1_0* OutMaxValues;
+        TTypedValue_1_0*          Out; // Required, a single report if output columns are given
+        uint32_t                  OutReportCount;
+        TTypedValue_1_0*          OutMaxValues;
+        const TOutputColumn_1_15* OutColumns; // Typed output columns, each report is written to them when calculated
+        uint32_t                  OutColumnsCount;
 
         // Calculation
         TTypedValue_1_0* DeltaValues; // Required
@@ -68,13 +72,25 @@ namespace MetricsDiscoveryInternal
         int32_t ReportReasonIdx;
 
         // ContextFiltering
-        bool DoContextFiltering; // Required - not supported
+        bool            DoContextFiltering; // Required
+        const uint32_t* ContextIds;         // Context ids to calculate, required for context filtering
+        uint32_t        ContextIdsCount;    // Required for context filtering
+
+        // ReportReasonFiltering
+        uint32_t ReportReasonMask; // Report reasons to calculate (TReportReason), 0 means all
+
+        // ReportFiltering (context and report reason)
+        std::vector<uint32_t>* ReportNumbers;     // Raw report numbers to calculate, required for report filtering
+        std::vector<uint32_t>* PrevReportNumbers; // Raw report numbers to calculate deltas from, required for report filtering
+        uint32_t               ReportIndex;
+        uint32_t               SavedReportNumber; // Raw report number to save for the next calculation
 
         // Calculation
-        const uint8_t* PrevRawDataPtr;
-        uint32_t       PrevRawReportNumber;
-        const uint8_t* LastRawDataPtr;
-        uint32_t       LastRawReportNumber;
+        CCalculationKernel* Kernel; // Compiled equations, null if the interpreter is used
+        const uint8_t*      PrevRawDataPtr;
+        uint32_t            PrevRawReportNumber;
+        const uint8_t*      LastRawDataPtr;
+        uint32_t            LastRawReportNumber;
 
     } TStreamCalculationContext;
 
@@ -135,5 +151,8 @@ namespace MetricsDiscoveryInternal
 
     private:
         int32_t GetInformationIndex( const char* symbolName, CMetricSet* set );
+        void    FindReportsToCalculate( TCalculationContext& context );
+        bool    CalculateNextFilteredReport( TCalculationContext& context );
+        void    CalculateReport( TCalculationContext& context );
     };
 } // namespace MetricsDiscoveryInternal
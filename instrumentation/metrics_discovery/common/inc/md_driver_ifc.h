@@ -126,8 +126,8 @@ namespace MetricsDiscoveryInternal
         virtual uint32_t        GetAdapterId()                                                                                                                                                = 0;
 
         // Synchronization:
-        virtual TCompletionCode LockConcurrentGroup( const char* name, void** semaphore )   = 0;
-        virtual TCompletionCode UnlockConcurrentGroup( const char* name, void** semaphore ) = 0;
+        virtual TCompletionCode LockConcurrentGroup( const char* name, const uint32_t timeoutMs, void** semaphore ) = 0;
+        virtual TCompletionCode UnlockConcurrentGroup( const char* name, void** semaphore )                        = 0;
 
         // Stream:
         virtual TCompletionCode OpenIoStream( COAConcurrentGroup& oaConcurrentGroup, const uint32_t processId, uint32_t& nsTimerPeriod, uint32_t& bufferSize )                                       = 0;
@@ -135,6 +135,8 @@ namespace MetricsDiscoveryInternal
         virtual TCompletionCode CloseIoStream( COAConcurrentGroup& oaConcurrentGroup )                                                                                                               = 0;
         virtual TCompletionCode HandleIoStreamExceptions( COAConcurrentGroup& oaConcurrentGroup, const uint32_t processId, uint32_t& reportCount, const GTDIReadCounterStreamExceptions exceptions ) = 0;
         virtual TCompletionCode WaitForIoStreamReports( COAConcurrentGroup& oaConcurrentGroup, const uint32_t milliseconds )                                                                         = 0;
+        virtual TCompletionCode WaitForIoStreamReports( const std::vector<COAConcurrentGroup*>& oaConcurrentGroups, const uint32_t milliseconds )                                                    = 0;
+        virtual TCompletionCode GetIoStreamHandle( COAConcurrentGroup& oaConcurrentGroup, int64_t& handle )                                                                                          = 0;
         virtual bool            IsIoMeasurementInfoAvailable( const TIoMeasurementInfoType ioMeasurementInfoType )                                                                                   = 0;
         virtual bool            IsStreamTypeSupported( const TStreamType streamType )                                                                                                                = 0;
 
@@ -32,6 +32,8 @@ extern "C"
 
     DllExport TCompletionCode OpenAdapterGroup( IAdapterGroupLatest** adapterGroup );
 
+    DllExport TCompletionCode OpenAdapterGroupFiltered( const TAdapterFilterLatest* filter, IAdapterGroupLatest** adapterGroup );
+
     // Note: when changing IMetricsDevice version in params remember about OGL PerfQuery - it needs to be changed too
     DllExport TCompletionCode OpenMetricsDevice( IMetricsDeviceLatest** metricsDevice );
 
@@ -14,6 +14,7 @@ SPDX-License-Identifier: MIT
 #pragma once
 
 #include "md_adapter.h"
+#include "md_calculation_kernel.h"
 #include "md_metrics_device.h"
 #include "md_metric_set.h"
 #include "md_metric.h"
@@ -22,9 +23,11 @@ SPDX-License-Identifier: MIT
 #include "md_types.h"
 #include "md_utils.h"
 
+#include <cmath>
 #include <cstring>
 #include <limits>
 #include <stack>
+#include <vector>
 
 namespace MetricsDiscoveryInternal
 {
@@ -39,6 +42,9 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     class CMetricsCalculator
     {
+        // Constant folding of normalization equations uses CalculateEquationElemOperation.
+        friend class CCalculationKernel;
+
     public:
         //////////////////////////////////////////////////////////////////////////////
         //
@@ -60,6 +66,11 @@ namespace MetricsDiscoveryInternal
             : m_readEquationStack{}
             , m_readEquationAndDeltaStack{}
             , m_normalizationEquationStack{}
+            , m_kernelStack()
+            , m_kernelNodeValues()
+            , m_kernelFieldsLast()
+            , m_kernelFieldsPrev()
+            , m_kernelFieldsReport( nullptr )
             , m_device( metricsDevice )
             , m_gpuCoreClocks( 0 )
             , m_euCoresCount( 0 )
@@ -144,7 +155,8 @@ namespace MetricsDiscoveryInternal
         //////////////////////////////////////////////////////////////////////////////
         inline void Reset( uint32_t rawReportSize = 0, uint32_t metricsAndInformationCount = 0 )
         {
-            m_gpuCoreClocks = 0;
+            m_gpuCoreClocks      = 0;
+            m_kernelFieldsReport = nullptr;
 
             if( m_savedReportSize != rawReportSize && rawReportSize > 0 )
             {
@@ -288,6 +300,244 @@ namespace MetricsDiscoveryInternal
             return CC_OK;
         }
 
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     ReadMetricsFromIoReport
+        //
+        // Description:
+        //     Reads metrics from prev and last raw reports using a compiled calculation
+        //     kernel of the metric set. Gives the same results as the interpreter,
+        //     without decoding read equations per metric per report. Reports are
+        //     decoded to field vectors first, and fields of the last report are reused
+        //     when it becomes the previous report of the next calculation.
+        //
+        // Input:
+        //     const uint8_t*            rawRaportLast - (IN) last (next) single raw report
+        //     const uint8_t*            rawRaportPrev - (IN) previous single raw report
+        //     TTypedValue_1_0*          outValues     - (OUT) read metric values
+        //     const CCalculationKernel& kernel        - valid calculation kernel of the metric set
+        //
+        // Output:
+        //     TCompletionCode - *CC_OK* means success
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TCompletionCode ReadMetricsFromIoReport( const uint8_t* rawRaportLast, const uint8_t* rawRaportPrev, TTypedValue_1_0* outValues, const CCalculationKernel& kernel )
+        {
+            const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+            MD_CHECK_PTR_RET_A( adapterId, rawRaportLast, CC_ERROR_INVALID_PARAMETER );
+            MD_CHECK_PTR_RET_A( adapterId, rawRaportPrev, CC_ERROR_INVALID_PARAMETER );
+            MD_CHECK_PTR_RET_A( adapterId, outValues, CC_ERROR_INVALID_PARAMETER );
+
+            m_gpuCoreClocks = 0;
+
+            if( m_kernelStack.size() < kernel.GetStackSize() )
+            {
+                m_kernelStack.resize( kernel.GetStackSize() );
+            }
+
+            const size_t fieldsCount = kernel.GetFields().size();
+
+            if( m_kernelFieldsLast.size() < fieldsCount )
+            {
+                m_kernelFieldsLast.resize( fieldsCount );
+                m_kernelFieldsPrev.resize( fieldsCount );
+                m_kernelFieldsReport = nullptr;
+            }
+
+            if( rawRaportPrev == m_kernelFieldsReport )
+            {
+                m_kernelFieldsLast.swap( m_kernelFieldsPrev );
+            }
+            else
+            {
+                DecodeReport( rawRaportPrev, kernel, m_kernelFieldsPrev.data() );
+            }
+
+            DecodeReport( rawRaportLast, kernel, m_kernelFieldsLast.data() );
+            m_kernelFieldsReport = rawRaportLast;
+
+            const uint64_t*         fieldsLast         = m_kernelFieldsLast.data();
+            const uint64_t*         fieldsPrev         = m_kernelFieldsPrev.data();
+            const auto&             metrics            = kernel.GetMetrics();
+            const TKernelOperation* operations         = kernel.GetOperations().data();
+            TTypedValue_1_0*        stack              = m_kernelStack.data();
+            const uint32_t          metricsCount       = static_cast<uint32_t>( metrics.size() );
+            const uint32_t          gpuCoreClocksIndex = kernel.GetGpuCoreClocksIndex();
+
+            for( uint32_t i = 0; i < metricsCount; ++i )
+            {
+                const TKernelMetric& metric = metrics[i];
+
+                if( metric.OperationsCount == 0 )
+                {
+                    outValues[i].ValueType   = VALUE_TYPE_UINT64;
+                    outValues[i].ValueUInt64 = 0ULL;
+                }
+                else if( metric.OperationsCount == 1 )
+                {
+                    // Most read equations are a single read.
+                    outValues[i] = CalculateKernelOperation( operations[metric.OperationsOffset], metric.DeltaFunction, fieldsLast, fieldsPrev );
+                }
+                else
+                {
+                    // Stack usage is validated when the kernel is built.
+                    uint32_t top = 0;
+
+                    for( uint32_t j = metric.OperationsOffset; j < metric.OperationsOffset + metric.OperationsCount; ++j )
+                    {
+                        const TKernelOperation& operation = operations[j];
+
+                        if( operation.Type == KERNEL_OPERATION_OPERATION )
+                        {
+                            --top;
+                            stack[top - 1] = CalculateEquationElemOperation( operation.Operation, stack[top - 1], stack[top] );
+                        }
+                        else
+                        {
+                            stack[top++] = CalculateKernelOperation( operation, metric.DeltaFunction, fieldsLast, fieldsPrev );
+                        }
+                    }
+
+                    outValues[i] = stack[0];
+                }
+
+                if( i == gpuCoreClocksIndex )
+                {
+                    m_gpuCoreClocks = outValues[i].ValueUInt64;
+                }
+            }
+
+            return CC_OK;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     NormalizeMetrics
+        //
+        // Description:
+        //     Normalizes metrics using a compiled calculation kernel of the metric set.
+        //     Nodes shared by normalization equations are calculated once.
+        //
+        // Input:
+        //     TTypedValue_1_0*          deltaValues - (IN) previously read metric delta values
+        //     TTypedValue_1_0*          outValues   - (OUT) output normalized metric values
+        //     const CCalculationKernel& kernel      - valid calculation kernel of the metric set
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline void NormalizeMetrics( TTypedValue_1_0* deltaValues, TTypedValue_1_0* outValues, const CCalculationKernel& kernel )
+        {
+            const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+            if( !deltaValues || !outValues )
+            {
+                MD_ASSERT_A( adapterId, deltaValues != nullptr );
+                MD_ASSERT_A( adapterId, outValues != nullptr );
+                MD_LOG_A( adapterId, LOG_ERROR, "error: nullptr params" );
+                return;
+            }
+
+            const auto&        nodes        = kernel.GetNodes();
+            const auto&        metrics      = kernel.GetMetrics();
+            const uint32_t     metricsCount = static_cast<uint32_t>( metrics.size() );
+            const TKernelNode* nodesData    = nodes.data();
+
+            if( m_kernelNodeValues.size() < nodes.size() )
+            {
+                m_kernelNodeValues.resize( nodes.size() );
+            }
+
+            TTypedValue_1_0* nodeValues = m_kernelNodeValues.data();
+
+            for( uint32_t i = 0; i < metricsCount; ++i )
+            {
+                const TKernelMetric& metric = metrics[i];
+
+                for( uint32_t j = metric.NodesOffset; j < metric.NodesOffset + metric.NodesCount; ++j )
+                {
+                    nodeValues[j] = CalculateKernelNode( nodesData[j], nodeValues, deltaValues, outValues );
+                }
+
+                outValues[i] = nodeValues[metric.ResultNode];
+
+                ConvertToResultType( outValues[i], metric.ResultType );
+            }
+        }
+
+#if defined( _DEBUG )
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     VerifyKernelResults
+        //
+        // Description:
+        //     Debug build only. Calculates the same reports with the equation
+        //     interpreter and asserts that values read and normalized by the
+        //     calculation kernel are equal. Floats may differ by rounding only.
+        //
+        // Input:
+        //     const uint8_t*         rawRaportLast - (IN) last (next) single raw report
+        //     const uint8_t*         rawRaportPrev - (IN) previous single raw report
+        //     const TTypedValue_1_0* deltaValues   - (IN) metric values read by the kernel
+        //     const TTypedValue_1_0* outValues     - (IN) metric values normalized by the kernel
+        //     CMetricSet&            metricSet     - MetricSet for calculations
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline void VerifyKernelResults( const uint8_t* rawRaportLast, const uint8_t* rawRaportPrev, const TTypedValue_1_0* deltaValues, const TTypedValue_1_0* outValues, CMetricSet& metricSet )
+        {
+            const uint32_t adapterId     = m_device.GetAdapter().GetAdapterId();
+            const uint32_t metricsCount  = metricSet.GetParams()->MetricsCount;
+            const uint64_t gpuCoreClocks = m_gpuCoreClocks;
+
+            std::vector<TTypedValue_1_0> interpreterDeltaValues( metricsCount );
+            std::vector<TTypedValue_1_0> interpreterOutValues( metricsCount );
+
+            ReadMetricsFromIoReport( rawRaportLast, rawRaportPrev, interpreterDeltaValues.data(), metricSet );
+            NormalizeMetrics( interpreterDeltaValues.data(), interpreterOutValues.data(), metricSet );
+
+            m_gpuCoreClocks = gpuCoreClocks;
+
+            auto isEqual = []( const TTypedValue_1_0& kernelValue, const TTypedValue_1_0& interpreterValue )
+            {
+                if( kernelValue.ValueType != interpreterValue.ValueType )
+                {
+                    return false;
+                }
+
+                if( kernelValue.ValueType == VALUE_TYPE_FLOAT )
+                {
+                    const double kernelDouble      = kernelValue.ValueFloat;
+                    const double interpreterDouble = interpreterValue.ValueFloat;
+
+                    return std::fabs( kernelDouble - interpreterDouble ) <= 1e-5 * std::max( { std::fabs( kernelDouble ), std::fabs( interpreterDouble ), 1.0 } );
+                }
+
+                return GetTypedValueAsDouble( kernelValue ) == GetTypedValueAsDouble( interpreterValue ) &&
+                    ( kernelValue.ValueType != VALUE_TYPE_UINT64 || kernelValue.ValueUInt64 == interpreterValue.ValueUInt64 );
+            };
+
+            for( uint32_t i = 0; i < metricsCount; ++i )
+            {
+                if( !isEqual( deltaValues[i], interpreterDeltaValues[i] ) || !isEqual( outValues[i], interpreterOutValues[i] ) )
+                {
+                    MD_LOG_A( adapterId, LOG_ERROR, "error: calculation kernel differs from interpreter, metric: %s", metricSet.GetMetricExplicit( i )->GetParams()->SymbolName );
+                    MD_ASSERT_A( adapterId, false );
+                }
+            }
+        }
+#endif
+
         //////////////////////////////////////////////////////////////////////////////
         //
         // Class:
@@ -323,50 +573,119 @@ namespace MetricsDiscoveryInternal
                 auto metric = metricSet.GetMetricExplicit( i );
                 MD_CHECK_PTR_RET_A( adapterId, metric, MD_EMPTY );
 
-                auto& metricParams = *metric->GetParams();
+                NormalizeMetric( *metric->GetParams(), deltaValues, outValues, i );
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     ReadMetricsFromQueryReport
+        //
+        // Description:
+        //     Reads only the given metrics from a single query report. Values of
+        //     other metrics are left unchanged. If accumulate is true, read values
+        //     are added to the output values, so deltas of many query reports may
+        //     be summed before a single normalization.
+        //
+        // Input:
+        //     const uint8_t*               rawReport     - (IN) single raw report
+        //     TTypedValue_1_0*             outValues     - (IN/OUT) read metric values
+        //     CMetricSet&                  metricSet     - metric set for which the calculation will be conducted
+        //     const std::vector<uint32_t>& metricIndices - indices of metrics to read
+        //     const bool                   accumulate    - if true, read values are added to output values
+        //
+        // Output:
+        //     TCompletionCode - *CC_OK* means success
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TCompletionCode ReadMetricsFromQueryReport( const uint8_t* rawReport, TTypedValue_1_0* outValues, CMetricSet& metricSet, const std::vector<uint32_t>& metricIndices, const bool accumulate )
+        {
+            const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
 
-                outValues[i] = metricParams.NormEquation
-                    ? CalculateLocalNormalizationEquation( static_cast<CEquation&>( *( metricParams.NormEquation ) ), deltaValues, outValues, i )
-                    : deltaValues[i];
+            MD_CHECK_PTR_RET_A( adapterId, rawReport, CC_ERROR_INVALID_PARAMETER );
+            MD_CHECK_PTR_RET_A( adapterId, outValues, CC_ERROR_INVALID_PARAMETER );
 
-                switch( metricParams.ResultType )
-                {
-                    case RESULT_UINT32:
-                        if( outValues[i].ValueType != VALUE_TYPE_UINT32 )
-                        {
-                            outValues[i].ValueUInt32 = CastToUInt32( outValues[i] );
-                            outValues[i].ValueType   = VALUE_TYPE_UINT32;
-                        }
-                        break;
+            if( !accumulate )
+            {
+                m_gpuCoreClocks = 0;
+            }
 
-                    case RESULT_UINT64:
-                        if( outValues[i].ValueType != VALUE_TYPE_UINT64 )
-                        {
-                            outValues[i].ValueUInt64 = CastToUInt64( outValues[i] );
-                            outValues[i].ValueType   = VALUE_TYPE_UINT64;
-                        }
-                        break;
+            for( const uint32_t i : metricIndices )
+            {
+                auto metric = metricSet.GetMetricExplicit( i );
+                MD_CHECK_PTR_RET_A( adapterId, metric, CC_ERROR_GENERAL );
 
-                    case RESULT_FLOAT:
-                        if( outValues[i].ValueType != VALUE_TYPE_FLOAT )
-                        {
-                            outValues[i].ValueFloat = CastToFloat( outValues[i] );
-                            outValues[i].ValueType  = VALUE_TYPE_FLOAT;
-                        }
-                        break;
+                auto&           metricParams = *metric->GetParams();
+                TTypedValue_1_0 value        = {};
 
-                    case RESULT_BOOL:
-                        if( outValues[i].ValueType != VALUE_TYPE_BOOL )
-                        {
-                            outValues[i].ValueBool = CastToBoolean( outValues[i] );
-                            outValues[i].ValueType = VALUE_TYPE_BOOL;
-                        }
-                        break;
+                value.ValueType = VALUE_TYPE_UINT64;
 
-                    default:
-                        MD_ASSERT_A( adapterId, false );
+                if( metricParams.QueryReadEquation )
+                {
+                    value = CalculateReadEquation( static_cast<CEquation&>( *( metricParams.QueryReadEquation ) ), rawReport );
+                }
+
+                if( accumulate )
+                {
+                    AddTypedValue( outValues[i], value );
+                }
+                else
+                {
+                    outValues[i] = value;
+                }
+
+                if( std::string_view( metricParams.SymbolName ) == "GpuCoreClocks" )
+                {
+                    m_gpuCoreClocks = outValues[i].ValueUInt64;
                 }
             }
+
+            return CC_OK;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     NormalizeMetrics
+        //
+        // Description:
+        //     Normalizes only the given metrics using previously read data. Indices
+        //     have to be sorted ascending and include all metrics referenced by
+        //     normalization equations of the given ones.
+        //
+        // Input:
+        //     TTypedValue_1_0*             deltaValues   - (IN) previously read metric delta values
+        //     TTypedValue_1_0*             outValues     - (OUT) output normalized metric values
+        //     CMetricSet&                  metricSet     - MetricSet for calculations
+        //     const std::vector<uint32_t>& metricIndices - indices of metrics to normalize
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline void NormalizeMetrics( TTypedValue_1_0* deltaValues, TTypedValue_1_0* outValues, CMetricSet& metricSet, const std::vector<uint32_t>& metricIndices )
+        {
+            const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+            if( !deltaValues || !outValues )
+            {
+                MD_ASSERT_A( adapterId, deltaValues != nullptr );
+                MD_ASSERT_A( adapterId, outValues != nullptr );
+                MD_LOG_A( adapterId, LOG_ERROR, "error: nullptr params" );
+                return;
+            }
+
+            for( const uint32_t i : metricIndices )
+            {
+                auto metric = metricSet.GetMetricExplicit( i );
+                MD_CHECK_PTR_RET_A( adapterId, metric, MD_EMPTY );
+
+                NormalizeMetric( *metric->GetParams(), deltaValues, outValues, i );
+            }
         }
 
         //////////////////////////////////////////////////////////////////////////////
@@ -983,37 +1302,167 @@ namespace MetricsDiscoveryInternal
         //     CMetricsCalculator
         //
         // Method:
-        //     CalculateDeltaFunction
+        //     NormalizeMetric
         //
         // Description:
-        //     Calculates the given delta function.
+        //     Normalizes a single metric and casts it to the metric result type.
         //
         // Input:
-        //     TDeltaFunction_1_0     deltaFunction  - delta function to be calculated
-        //     const TTypedValue_1_0& lastValue     - (IN) last (next) value
-        //     const TTypedValue_1_0& previousValue - (IN) previous value
-        //
-        // Output:
-        //     TTypedValue_1_0 - output calculated delta value
+        //     const TMetricParamsLatest& metricParams - params of the metric to normalize
+        //     TTypedValue_1_0*           deltaValues  - (IN) previously read metric delta values
+        //     TTypedValue_1_0*           outValues    - (OUT) output normalized metric values
+        //     const uint32_t             metricIndex  - index of the metric
         //
         //////////////////////////////////////////////////////////////////////////////
-        inline TTypedValue_1_0 CalculateDeltaFunction(
-            TDeltaFunction_1_0     deltaFunction,
-            const TTypedValue_1_0& lastValue,
-            const TTypedValue_1_0& previousValue )
+        inline void NormalizeMetric( const TMetricParamsLatest& metricParams, TTypedValue_1_0* deltaValues, TTypedValue_1_0* outValues, const uint32_t metricIndex )
         {
-            TTypedValue_1_0 typedValue = {};
+            const uint32_t i = metricIndex;
 
-            switch( deltaFunction.FunctionType )
-            {
-                case DELTA_BOOL_OR:
-                    typedValue.ValueUInt64 = ( ( lastValue.ValueUInt64 | previousValue.ValueUInt64 ) != 0 ) ? 1ULL : 0ULL;
-                    typedValue.ValueType   = VALUE_TYPE_UINT64;
-                    return typedValue;
+            outValues[i] = metricParams.NormEquation
+                ? CalculateLocalNormalizationEquation( static_cast<CEquation&>( *( metricParams.NormEquation ) ), deltaValues, outValues, i )
+                : deltaValues[i];
 
-                case DELTA_BOOL_XOR:
-                    typedValue.ValueUInt64 = ( ( lastValue.ValueUInt64 ^ previousValue.ValueUInt64 ) != 0 ) ? 1ULL : 0ULL;
-                    typedValue.ValueType   = VALUE_TYPE_UINT64;
+            ConvertToResultType( outValues[i], metricParams.ResultType );
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     ConvertToResultType
+        //
+        // Description:
+        //     Casts a normalized value to the metric result type.
+        //
+        // Input:
+        //     TTypedValue_1_0&        value      - (IN/OUT) normalized value
+        //     const TMetricResultType resultType - metric result type
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline void ConvertToResultType( TTypedValue_1_0& value, const TMetricResultType resultType )
+        {
+            switch( resultType )
+            {
+                case RESULT_UINT32:
+                    if( value.ValueType != VALUE_TYPE_UINT32 )
+                    {
+                        value.ValueUInt32 = CastToUInt32( value );
+                        value.ValueType   = VALUE_TYPE_UINT32;
+                    }
+                    break;
+
+                case RESULT_UINT64:
+                    if( value.ValueType != VALUE_TYPE_UINT64 )
+                    {
+                        value.ValueUInt64 = CastToUInt64( value );
+                        value.ValueType   = VALUE_TYPE_UINT64;
+                    }
+                    break;
+
+                case RESULT_FLOAT:
+                    if( value.ValueType != VALUE_TYPE_FLOAT )
+                    {
+                        value.ValueFloat = CastToFloat( value );
+                        value.ValueType  = VALUE_TYPE_FLOAT;
+                    }
+                    break;
+
+                case RESULT_BOOL:
+                    if( value.ValueType != VALUE_TYPE_BOOL )
+                    {
+                        value.ValueBool = CastToBoolean( value );
+                        value.ValueType = VALUE_TYPE_BOOL;
+                    }
+                    break;
+
+                default:
+                    MD_ASSERT_A( m_device.GetAdapter().GetAdapterId(), false );
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     AddTypedValue
+        //
+        // Description:
+        //     Adds a value to a sum of the same type. Booleans are or'ed.
+        //
+        // Input:
+        //     TTypedValue_1_0&       sum   - (IN/OUT) sum
+        //     const TTypedValue_1_0& value - (IN) value to add
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline void AddTypedValue( TTypedValue_1_0& sum, const TTypedValue_1_0& value )
+        {
+            switch( value.ValueType )
+            {
+                case VALUE_TYPE_UINT32:
+                    sum.ValueUInt32 = CastToUInt32( sum ) + value.ValueUInt32;
+                    break;
+
+                case VALUE_TYPE_UINT64:
+                    sum.ValueUInt64 = CastToUInt64( sum ) + value.ValueUInt64;
+                    break;
+
+                case VALUE_TYPE_FLOAT:
+                    sum.ValueFloat = CastToFloat( sum ) + value.ValueFloat;
+                    break;
+
+                case VALUE_TYPE_BOOL:
+                    sum.ValueBool = CastToBoolean( sum ) || value.ValueBool;
+                    break;
+
+                default:
+                    MD_ASSERT_A( m_device.GetAdapter().GetAdapterId(), false );
+                    return;
+            }
+
+            sum.ValueType = value.ValueType;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     CalculateDeltaFunction
+        //
+        // Description:
+        //     Calculates the given delta function.
+        //
+        // Input:
+        //     TDeltaFunction_1_0     deltaFunction  - delta function to be calculated
+        //     const TTypedValue_1_0& lastValue     - (IN) last (next) value
+        //     const TTypedValue_1_0& previousValue - (IN) previous value
+        //
+        // Output:
+        //     TTypedValue_1_0 - output calculated delta value
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TTypedValue_1_0 CalculateDeltaFunction(
+            TDeltaFunction_1_0     deltaFunction,
+            const TTypedValue_1_0& lastValue,
+            const TTypedValue_1_0& previousValue )
+        {
+            TTypedValue_1_0 typedValue = {};
+
+            switch( deltaFunction.FunctionType )
+            {
+                case DELTA_BOOL_OR:
+                    typedValue.ValueUInt64 = ( ( lastValue.ValueUInt64 | previousValue.ValueUInt64 ) != 0 ) ? 1ULL : 0ULL;
+                    typedValue.ValueType   = VALUE_TYPE_UINT64;
+                    return typedValue;
+
+                case DELTA_BOOL_XOR:
+                    typedValue.ValueUInt64 = ( ( lastValue.ValueUInt64 ^ previousValue.ValueUInt64 ) != 0 ) ? 1ULL : 0ULL;
+                    typedValue.ValueType   = VALUE_TYPE_UINT64;
                     return typedValue;
 
                 case DELTA_GET_LAST:
@@ -1546,6 +1995,201 @@ namespace MetricsDiscoveryInternal
             return typedValue;
         }
 
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     DecodeReport
+        //
+        // Description:
+        //     Decodes report fields read by a calculation kernel. Each field group
+        //     is decoded by a loop specialized for its read type.
+        //
+        // Input:
+        //     const uint8_t*            rawReport - (IN) single raw report
+        //     const CCalculationKernel& kernel    - valid calculation kernel of the metric set
+        //     uint64_t*                 outFields - (OUT) decoded fields
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline void DecodeReport( const uint8_t* rawReport, const CCalculationKernel& kernel, uint64_t* outFields )
+        {
+            const TKernelField* fields = kernel.GetFields().data();
+
+            for( const auto& group : kernel.GetFieldGroups() )
+            {
+                const TKernelField* groupFields    = fields + group.FieldsOffset;
+                uint64_t*           groupOutFields = outFields + group.FieldsOffset;
+
+                switch( group.Type )
+                {
+                    case KERNEL_OPERATION_READ_BITFIELD:
+                        DecodeFields<KERNEL_OPERATION_READ_BITFIELD>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    case KERNEL_OPERATION_READ_UINT8:
+                        DecodeFields<KERNEL_OPERATION_READ_UINT8>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    case KERNEL_OPERATION_READ_UINT16:
+                        DecodeFields<KERNEL_OPERATION_READ_UINT16>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    case KERNEL_OPERATION_READ_UINT32:
+                        DecodeFields<KERNEL_OPERATION_READ_UINT32>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    case KERNEL_OPERATION_READ_UINT64:
+                        DecodeFields<KERNEL_OPERATION_READ_UINT64>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    case KERNEL_OPERATION_READ_FLOAT:
+                        DecodeFields<KERNEL_OPERATION_READ_FLOAT>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    case KERNEL_OPERATION_READ_40BIT_CNTR:
+                        DecodeFields<KERNEL_OPERATION_READ_40BIT_CNTR>( rawReport, groupFields, group.FieldsCount, groupOutFields );
+                        break;
+
+                    default:
+                        MD_ASSERT_A( m_device.GetAdapter().GetAdapterId(), false );
+                        break;
+                }
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     DecodeFields
+        //
+        // Description:
+        //     Decodes report fields of the given read type. Field parameters are
+        //     validated when the kernel is built. Floats are stored as their bits.
+        //
+        // Input:
+        //     const uint8_t*      rawReport   - (IN) single raw report
+        //     const TKernelField* fields      - (IN) fields to decode
+        //     const uint32_t      fieldsCount - fields count
+        //     uint64_t*           outFields   - (OUT) decoded fields
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        template <TKernelOperationType ReadType>
+        inline void DecodeFields( const uint8_t* rawReport, const TKernelField* fields, const uint32_t fieldsCount, uint64_t* outFields )
+        {
+            for( uint32_t i = 0; i < fieldsCount; ++i )
+            {
+                const TKernelField& field = fields[i];
+                const uint8_t*      data  = rawReport + field.ByteOffset;
+
+                if constexpr( ReadType == KERNEL_OPERATION_READ_BITFIELD )
+                {
+                    const uint32_t mask = MD_BITMASK_RANGE( field.BitOffset, field.BitOffset + field.BitsCount - 1 );
+                    outFields[i]        = static_cast<uint64_t>( ( *reinterpret_cast<const uint32_t*>( data ) & mask ) >> field.BitOffset );
+                }
+                else if constexpr( ReadType == KERNEL_OPERATION_READ_UINT8 )
+                {
+                    outFields[i] = *data;
+                }
+                else if constexpr( ReadType == KERNEL_OPERATION_READ_UINT16 )
+                {
+                    outFields[i] = *reinterpret_cast<const uint16_t*>( data );
+                }
+                else if constexpr( ReadType == KERNEL_OPERATION_READ_UINT32 || ReadType == KERNEL_OPERATION_READ_FLOAT )
+                {
+                    outFields[i] = *reinterpret_cast<const uint32_t*>( data );
+                }
+                else if constexpr( ReadType == KERNEL_OPERATION_READ_UINT64 )
+                {
+                    outFields[i] = *reinterpret_cast<const uint64_t*>( data );
+                }
+                else if constexpr( ReadType == KERNEL_OPERATION_READ_40BIT_CNTR )
+                {
+                    TLargeInteger largeValue;
+                    largeValue.u.LowPart  = *reinterpret_cast<const uint32_t*>( data );
+                    largeValue.u.HighPart = static_cast<int32_t>( *( rawReport + field.ByteOffsetExt ) );
+                    outFields[i]          = static_cast<uint64_t>( largeValue.QuadPart );
+                }
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     CalculateKernelOperation
+        //
+        // Description:
+        //     Calculates a value pushing kernel operation. Reads are followed by
+        //     the delta function, as in CalculateReadEquationAndDelta.
+        //
+        // Input:
+        //     const TKernelOperation&   operation     - kernel operation, not KERNEL_OPERATION_OPERATION
+        //     const TDeltaFunction_1_0& deltaFunction - resolved delta function of the metric
+        //     const uint64_t*           fieldsLast    - (IN) decoded fields of the last (next) report
+        //     const uint64_t*           fieldsPrev    - (IN) decoded fields of the previous report
+        //
+        // Output:
+        //     TTypedValue_1_0 - output value
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TTypedValue_1_0 CalculateKernelOperation(
+            const TKernelOperation&   operation,
+            const TDeltaFunction_1_0& deltaFunction,
+            const uint64_t*           fieldsLast,
+            const uint64_t*           fieldsPrev )
+        {
+            TTypedValue_1_0 typedValuePrev = {};
+            TTypedValue_1_0 typedValueLast = {};
+
+            typedValuePrev.ValueType = VALUE_TYPE_UINT64;
+            typedValueLast.ValueType = VALUE_TYPE_UINT64;
+
+            switch( operation.Type )
+            {
+                case KERNEL_OPERATION_READ_BITFIELD:
+                case KERNEL_OPERATION_READ_UINT8:
+                case KERNEL_OPERATION_READ_UINT16:
+                case KERNEL_OPERATION_READ_UINT32:
+                case KERNEL_OPERATION_READ_UINT64:
+                case KERNEL_OPERATION_READ_40BIT_CNTR:
+                    typedValuePrev.ValueUInt64 = fieldsPrev[operation.FieldIndex];
+                    typedValueLast.ValueUInt64 = fieldsLast[operation.FieldIndex];
+                    break;
+
+                case KERNEL_OPERATION_READ_FLOAT:
+                {
+                    const uint32_t bitsPrev = static_cast<uint32_t>( fieldsPrev[operation.FieldIndex] );
+                    const uint32_t bitsLast = static_cast<uint32_t>( fieldsLast[operation.FieldIndex] );
+
+                    std::memcpy( &typedValuePrev.ValueFloat, &bitsPrev, sizeof( float ) );
+                    std::memcpy( &typedValueLast.ValueFloat, &bitsLast, sizeof( float ) );
+                    typedValuePrev.ValueType = VALUE_TYPE_FLOAT;
+                    typedValueLast.ValueType = VALUE_TYPE_FLOAT;
+                    break;
+                }
+
+                case KERNEL_OPERATION_IMMEDIATE:
+                    return operation.Value;
+
+                case KERNEL_OPERATION_GPU_CORE_CLOCKS:
+                    typedValueLast.ValueUInt64 = m_gpuCoreClocks;
+                    return typedValueLast;
+
+                default:
+                    MD_ASSERT_A( m_device.GetAdapter().GetAdapterId(), false );
+                    return typedValueLast;
+            }
+
+            return CalculateDeltaFunction( deltaFunction, typedValueLast, typedValuePrev );
+        }
+
         //////////////////////////////////////////////////////////////////////////////
         //
         // Class:
@@ -1703,47 +2347,13 @@ namespace MetricsDiscoveryInternal
                         // equation stack should be empty
                         MD_ASSERT_A( adapterId, algorithmCheck == 0 );
 
-                        // compute $Self $gpuCoreClocks FDIV 100 FMUL
-                        if( m_gpuCoreClocks != 0 )
-                        {
-                            const float self          = CastToFloat( deltaValues[metricIndex] );
-                            const float gpuCoreClocks = static_cast<float>( m_gpuCoreClocks );
-
-                            typedValue.ValueFloat = 100.0f * self / gpuCoreClocks;
-                            typedValue.ValueType  = VALUE_TYPE_FLOAT;
-                            return typedValue;
-                        }
-                        else
-                        {
-                            // Warning: GpuCoreClocks is 0
-                            typedValue.ValueFloat = 0.0f;
-                            typedValue.ValueType  = VALUE_TYPE_FLOAT;
-                            return typedValue;
-                        }
+                        return CalculateStdNormGpuDuration( deltaValues[metricIndex] );
 
                     case EQUATION_ELEM_STD_NORM_EU_AGGR_DURATION:
                         // equation stack should be empty
                         MD_ASSERT_A( adapterId, algorithmCheck == 0 );
-                        // m_euCoresCount is needed here
-                        MD_ASSERT_A( adapterId, m_euCoresCount != 0 );
 
-                        // compute $Self $gpuCoreClocks $EUsCount UMUL FDIV 100 FMUL
-                        if( m_gpuCoreClocks != 0 && m_euCoresCount != 0 )
-                        {
-                            const float self          = CastToFloat( deltaValues[metricIndex] );
-                            const float gpuCoreClocks = static_cast<float>( m_gpuCoreClocks * m_euCoresCount );
-
-                            typedValue.ValueFloat = 100.0f * self / gpuCoreClocks;
-                            typedValue.ValueType  = VALUE_TYPE_FLOAT;
-                            return typedValue;
-                        }
-                        else
-                        {
-                            // Warning: GpuCoreClocks or euCoresCount is 0
-                            typedValue.ValueFloat = 0.0f;
-                            typedValue.ValueType  = VALUE_TYPE_FLOAT;
-                            return typedValue;
-                        }
+                        return CalculateStdNormEuAggrDuration( deltaValues[metricIndex] );
 
                     default:
                         break;
@@ -1766,6 +2376,147 @@ namespace MetricsDiscoveryInternal
             return typedValue;
         }
 
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     CalculateStdNormGpuDuration
+        //
+        // Description:
+        //     Calculates $Self $GpuCoreClocks FDIV 100 FMUL standard normalization.
+        //
+        // Input:
+        //     const TTypedValue_1_0& self - (IN) metric delta value
+        //
+        // Output:
+        //     TTypedValue_1_0 - output normalized value
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TTypedValue_1_0 CalculateStdNormGpuDuration( const TTypedValue_1_0& self )
+        {
+            TTypedValue_1_0 typedValue = {};
+            typedValue.ValueType       = VALUE_TYPE_FLOAT;
+            typedValue.ValueFloat      = 0.0f;
+
+            if( m_gpuCoreClocks != 0 )
+            {
+                const float gpuCoreClocks = static_cast<float>( m_gpuCoreClocks );
+
+                typedValue.ValueFloat = 100.0f * CastToFloat( self ) / gpuCoreClocks;
+            }
+            // else warning: GpuCoreClocks is 0
+
+            return typedValue;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     CalculateStdNormEuAggrDuration
+        //
+        // Description:
+        //     Calculates $Self $GpuCoreClocks $EuCoresTotalCount UMUL FDIV 100 FMUL
+        //     standard normalization.
+        //
+        // Input:
+        //     const TTypedValue_1_0& self - (IN) metric delta value
+        //
+        // Output:
+        //     TTypedValue_1_0 - output normalized value
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TTypedValue_1_0 CalculateStdNormEuAggrDuration( const TTypedValue_1_0& self )
+        {
+            // m_euCoresCount is needed here
+            MD_ASSERT_A( m_device.GetAdapter().GetAdapterId(), m_euCoresCount != 0 );
+
+            TTypedValue_1_0 typedValue = {};
+            typedValue.ValueType       = VALUE_TYPE_FLOAT;
+            typedValue.ValueFloat      = 0.0f;
+
+            if( m_gpuCoreClocks != 0 && m_euCoresCount != 0 )
+            {
+                const float gpuCoreClocks = static_cast<float>( m_gpuCoreClocks * m_euCoresCount );
+
+                typedValue.ValueFloat = 100.0f * CastToFloat( self ) / gpuCoreClocks;
+            }
+            // else warning: GpuCoreClocks or euCoresCount is 0
+
+            return typedValue;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //
+        // Class:
+        //     CMetricsCalculator
+        //
+        // Method:
+        //     CalculateKernelNode
+        //
+        // Description:
+        //     Calculates a normalization DAG node. Operand nodes have to be
+        //     calculated before.
+        //
+        // Input:
+        //     const TKernelNode&     node        - DAG node
+        //     const TTypedValue_1_0* nodeValues  - (IN) so far calculated node values
+        //     const TTypedValue_1_0* deltaValues - (IN) read metric delta values
+        //     const TTypedValue_1_0* outValues   - (IN) so far normalized values
+        //
+        // Output:
+        //     TTypedValue_1_0 - output node value
+        //
+        //////////////////////////////////////////////////////////////////////////////
+        inline TTypedValue_1_0 CalculateKernelNode(
+            const TKernelNode&     node,
+            const TTypedValue_1_0* nodeValues,
+            const TTypedValue_1_0* deltaValues,
+            const TTypedValue_1_0* outValues )
+        {
+            TTypedValue_1_0 typedValue = {};
+            typedValue.ValueType       = VALUE_TYPE_UINT64;
+            typedValue.ValueUInt64     = 0ULL;
+
+            switch( node.Type )
+            {
+                case KERNEL_NODE_CONSTANT:
+                    return node.Value;
+
+                case KERNEL_NODE_GLOBAL_SYMBOL:
+                {
+                    TTypedValue_1_0* pValue = GetGlobalSymbolValue( node.SymbolName );
+                    return pValue ? *pValue : typedValue;
+                }
+
+                case KERNEL_NODE_DELTA_VALUE:
+                    return deltaValues[node.MetricIndex];
+
+                case KERNEL_NODE_METRIC_VALUE:
+                    return outValues[node.MetricIndex];
+
+                case KERNEL_NODE_PREV_METRIC_VALUE:
+                    return m_prevValues ? m_prevValues[node.MetricIndex] : typedValue;
+
+                case KERNEL_NODE_OPERATION:
+                    return CalculateEquationElemOperation( node.Operation, nodeValues[node.Left], nodeValues[node.Right] );
+
+                case KERNEL_NODE_STD_NORM_GPU_DURATION:
+                    return CalculateStdNormGpuDuration( deltaValues[node.MetricIndex] );
+
+                case KERNEL_NODE_STD_NORM_EU_AGGR_DURATION:
+                    return CalculateStdNormEuAggrDuration( deltaValues[node.MetricIndex] );
+
+                default:
+                    MD_ASSERT_A( m_device.GetAdapter().GetAdapterId(), false );
+                    return typedValue;
+            }
+        }
+
         //////////////////////////////////////////////////////////////////////////////
         //
         // Class:
@@ -2002,17 +2753,22 @@ namespace MetricsDiscoveryInternal
         }
 
     private:
-        std::stack<TTypedValue_1_0> m_readEquationStack;
-        std::stack<TTypedValue_1_0> m_readEquationAndDeltaStack;
-        std::stack<TTypedValue_1_0> m_normalizationEquationStack;
-        CMetricsDevice&             m_device;
-        uint64_t                    m_gpuCoreClocks;
-        uint32_t                    m_euCoresCount;
-        uint8_t*                    m_savedReport;
-        uint32_t                    m_savedReportSize;
-        uint64_t                    m_contextIdPrev;
-        bool                        m_savedReportPresent;
-        TTypedValue_1_0*            m_prevValues;
-        uint32_t                    m_prevValuesCount;
+        std::stack<TTypedValue_1_0>  m_readEquationStack;
+        std::stack<TTypedValue_1_0>  m_readEquationAndDeltaStack;
+        std::stack<TTypedValue_1_0>  m_normalizationEquationStack;
+        std::vector<TTypedValue_1_0> m_kernelStack;
+        std::vector<TTypedValue_1_0> m_kernelNodeValues;
+        std::vector<uint64_t>        m_kernelFieldsLast;   // Decoded fields of the last report
+        std::vector<uint64_t>        m_kernelFieldsPrev;   // Decoded fields of the previous report
+        const uint8_t*               m_kernelFieldsReport; // Report decoded to m_kernelFieldsLast
+        CMetricsDevice&              m_device;
+        uint64_t                     m_gpuCoreClocks;
+        uint32_t                     m_euCoresCount;
+        uint8_t*                     m_savedReport;
+        uint32_t                     m_savedReportSize;
+        uint64_t                     m_contextIdPrev;
+        bool                         m_savedReportPresent;
+        TTypedValue_1_0*             m_prevValues;
+        uint32_t                     m_prevValuesCount;
     };
 } // namespace MetricsDiscoveryInternal
@@ -49,6 +49,7 @@ namespace MetricsDiscoveryInternal
         OA_REPORT_TYPE_640B_PEC64LL_NOA16 = 10,
         OA_REPORT_TYPE_192B_MPEC8LL_NOA16 = 2 << GTDI_REPORT_TYPE_OAM_SHIFT,
         OA_REPORT_TYPE_128B_MPEC8_NOA16   = 3 << GTDI_REPORT_TYPE_OAM_SHIFT,
+        OA_REPORT_TYPE_PMU_ENGINE_SAMPLE, // TPmuEngineReport of PMU and DRM fdinfo streams, not an OA format
         // ...
         OA_REPORT_TYPE_LAST,
     } TReportType;
@@ -62,9 +63,35 @@ namespace MetricsDiscoveryInternal
         STREAM_TYPE_SYS,
         STREAM_TYPE_BB,
         STREAM_TYPE_OAM,
+        STREAM_TYPE_PMU,
+        STREAM_TYPE_FDINFO,
         // ...
     } TStreamType;
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // Engine classes sampled by the PMU stream:                                 //
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef enum EPmuEngineClass
+    {
+        PMU_ENGINE_CLASS_RENDER = 0,
+        PMU_ENGINE_CLASS_COPY,
+        PMU_ENGINE_CLASS_VIDEO,
+        PMU_ENGINE_CLASS_VIDEO_ENHANCE,
+        PMU_ENGINE_CLASS_COMPUTE,
+        // ...
+        PMU_ENGINE_CLASS_COUNT
+    } TPmuEngineClass;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // PMU and DRM fdinfo stream raw report, all values are cumulative since    //
+    // the stream open. Busy time is averaged over engine instances of a class. //
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct SPmuEngineReport
+    {
+        uint64_t ElapsedNs;                      // qw@0x00
+        uint64_t BusyNs[PMU_ENGINE_CLASS_COUNT]; // qw@0x08 + 8 * engine class
+    } TPmuEngineReport;
+
     ///////////////////////////////////////////////////////////////////////////////
     // Override types:                                                           //
     ///////////////////////////////////////////////////////////////////////////////
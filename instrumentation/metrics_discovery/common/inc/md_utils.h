@@ -184,6 +184,41 @@ namespace MetricsDiscoveryInternal
             : 0;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Group:
+    //     Metrics Discovery Utils
+    //
+    // Function:
+    //     GetTypedValueAsDouble
+    //
+    // Description:
+    //     Converts a numeric typed value to double.
+    //
+    // Input:
+    //     const TTypedValue_1_0& value - typed value
+    //
+    // Output:
+    //     double                       - value, 0 for not numeric types
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    inline double GetTypedValueAsDouble( const TTypedValue_1_0& value )
+    {
+        switch( value.ValueType )
+        {
+            case VALUE_TYPE_UINT32:
+                return static_cast<double>( value.ValueUInt32 );
+            case VALUE_TYPE_UINT64:
+                return static_cast<double>( value.ValueUInt64 );
+            case VALUE_TYPE_FLOAT:
+                return static_cast<double>( value.ValueFloat );
+            case VALUE_TYPE_BOOL:
+                return value.ValueBool ? 1.0 : 0.0;
+            default:
+                return 0.0;
+        }
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Group:
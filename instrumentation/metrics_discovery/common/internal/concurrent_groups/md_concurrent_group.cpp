@@ -42,6 +42,34 @@ namespace MetricsDiscoveryInternal
         return &m_params;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroup
+    //
+    // Method:
+    //     SetLockTimeout
+    //
+    // Description:
+    //     Sets how long Lock waits for the concurrent group locked by another
+    //     process or thread. Applied by the next Lock.
+    //
+    // Input:
+    //     uint32_t milliseconds - timeout in milliseconds, CONCURRENT_GROUP_LOCK_TIMEOUT_TRY
+    //                             or CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT
+    //
+    // Output:
+    //     TCompletionCode       - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CConcurrentGroup::SetLockTimeout( uint32_t milliseconds )
+    {
+        m_lockTimeoutMs = milliseconds;
+
+        MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_DEBUG, "concurrent group lock timeout: %u", milliseconds );
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -255,6 +283,7 @@ namespace MetricsDiscoveryInternal
     CConcurrentGroup::CConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask )
         : m_params{}
         , m_semaphore( nullptr )
+        , m_lockTimeoutMs( CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT )
         , m_setsVector()
         , m_otherSetsList()
         , m_informationVector()
@@ -547,7 +576,8 @@ namespace MetricsDiscoveryInternal
     //     Lock
     //
     // Description:
-    //     Creates a semaphore on the concurrent group. Waits 1s if needed.
+    //     Creates a semaphore on the concurrent group. Waits up to the timeout
+    //     set with SetLockTimeout (driver specific by default) if needed.
     //     Adapter BDF numbers are added to the semaphore name so different
     //     adapters won't block each other.
     //
@@ -568,7 +598,7 @@ namespace MetricsDiscoveryInternal
             CDriverInterface& driverInterface = m_device.GetDriverInterface();
 
             // 3. Lock concurrent group
-            ret = driverInterface.LockConcurrentGroup( semaphoreName, &m_semaphore );
+            ret = driverInterface.LockConcurrentGroup( semaphoreName, m_lockTimeoutMs, &m_semaphore );
         }
 
         return ret;
@@ -730,7 +760,7 @@ namespace MetricsDiscoveryInternal
 
         MD_CHECK_PTR_RET_A( adapterId, set, nullptr );
 
-        if( set->Initialize() != CC_OK )
+        if( set->Initialize() != CC_OK || set->AddCpuTimestampInformation() != CC_OK )
         {
             MD_LOG_A( adapterId, LOG_ERROR, "Error initializing metrics" );
             MD_SAFE_DELETE( set );
@@ -1076,7 +1106,8 @@ namespace MetricsDiscoveryInternal
     // Description:
     //     Creates semaphore name for the need of lock / unlock concurrent group
     //     calls. Adapter BDF numbers are added to the name so different adapters
-    //     won't block each other.
+    //     won't block each other. Sub device index is added for sub devices other
+    //     than the root one, so streams on different tiles can be opened together.
     //
     // Input:
     //     char*  name     - buffer for the name
@@ -1091,11 +1122,15 @@ namespace MetricsDiscoveryInternal
         const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
         MD_ASSERT_A( adapterId, name != nullptr );
 
-        // Create a semaphore name: "<CcgSymbolName>_<BusNumber>_<DeviceNumber>_<FunctionNumber>"
+        // Create a semaphore name: "<CcgSymbolName>_<BusNumber>_<DeviceNumber>_<FunctionNumber>[_<SubDeviceIndex>]"
         const TAdapterParams_1_9* adapterParams = m_device.GetAdapter().GetParams();
         MD_CHECK_PTR_RET_A( adapterId, adapterParams, CC_ERROR_GENERAL );
 
-        int32_t neededSize = snprintf( name, size, "%s_%u_%u_%u", m_params.SymbolName, adapterParams->BusNumber, adapterParams->DeviceNumber, adapterParams->FunctionNumber );
+        const uint32_t subDeviceIndex = m_device.GetSubDeviceIndex();
+
+        int32_t neededSize = ( subDeviceIndex == MD_ROOT_DEVICE_INDEX )
+            ? snprintf( name, size, "%s_%u_%u_%u", m_params.SymbolName, adapterParams->BusNumber, adapterParams->DeviceNumber, adapterParams->FunctionNumber )
+            : snprintf( name, size, "%s_%u_%u_%u_%u", m_params.SymbolName, adapterParams->BusNumber, adapterParams->DeviceNumber, adapterParams->FunctionNumber, subDeviceIndex );
 
         // If snprintf failed or buffer size was too small
         if( neededSize < 0 || neededSize >= (int32_t) size )
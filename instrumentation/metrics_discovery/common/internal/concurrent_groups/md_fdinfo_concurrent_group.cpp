@@ -0,0 +1,92 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_fdinfo_concurrent_group.cpp
+
+//     Abstract:   C++ Metrics Discovery DRM fdinfo concurrent group implementation
+
+#include "md_fdinfo_concurrent_group.h"
+#include "md_adapter.h"
+#include "md_metrics_device.h"
+#include "md_driver_ifc.h"
+#include "md_utils.h"
+
+#include <cstring>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFdinfoConcurrentGroup
+    //
+    // Method:
+    //     CFdinfoConcurrentGroup constructor
+    //
+    // Description:
+    //     Constructor.
+    //
+    // Input:
+    //     CMetricsDevice& device                 - parent metrics device
+    //     const char*     name                   - concurrent group name
+    //     const char*     description            - concurrent group description
+    //     const uint32_t  measurementTypeMask    - measurement type mask
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CFdinfoConcurrentGroup::CFdinfoConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask )
+        : CPmuConcurrentGroup( device, name, description, measurementTypeMask, STREAM_TYPE_FDINFO )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFdinfoConcurrentGroup
+    //
+    // Method:
+    //     IsSupported
+    //
+    // Description:
+    //     Checks if DRM client usage stats are exposed by the kernel driver.
+    //
+    // Input:
+    //     CMetricsDevice& device - metrics device
+    //
+    // Output:
+    //     bool                   - true if supported
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CFdinfoConcurrentGroup::IsSupported( CMetricsDevice& device )
+    {
+        return device.GetDriverInterface().IsStreamTypeSupported( STREAM_TYPE_FDINFO );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFdinfoConcurrentGroup
+    //
+    // Method:
+    //     IsValidSymbolName
+    //
+    // Description:
+    //     Checks if DRM fdinfo concurrent group symbol name is valid.
+    //
+    // Input:
+    //     const char* symbolName - concurrent group symbol name
+    //
+    // Output:
+    //     bool                   - true if valid
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CFdinfoConcurrentGroup::IsValidSymbolName( const char* symbolName )
+    {
+        return strcmp( symbolName, "FDINFO" ) == 0;
+    }
+
+} // namespace MetricsDiscoveryInternal
@@ -293,7 +293,8 @@ namespace MetricsDiscoveryInternal
         const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
         MD_LOG_ENTER_A( adapterId );
 
-        if( processId != 0 )
+        // Only DRM fdinfo stream can be limited to a process.
+        if( processId != 0 && m_streamType != STREAM_TYPE_FDINFO )
         {
             return CC_ERROR_NOT_SUPPORTED;
         }
@@ -309,6 +310,15 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_CC_RET_A( adapterId, ret );
         MD_LOG_A( adapterId, LOG_DEBUG, "Stream opened using type: %u", m_streamType );
 
+        ret = m_flightRecorder.Start( *m_ioMetricSet, *nsTimerPeriod );
+        if( ret != CC_OK )
+        {
+            driverInterface.CloseIoStream( *this );
+            m_ioMetricSet = nullptr;
+            MD_LOG_EXIT_A( adapterId );
+            return ret;
+        }
+
         m_processId            = processId;
         m_contextTagsEnabled   = m_ioMetricSet->HasInformation( "ContextId" );
         CMetricsCalculator* mc = m_ioMetricSet->GetMetricsCalculator();
@@ -384,6 +394,8 @@ namespace MetricsDiscoveryInternal
             SetIoMeasurementInfoPredefined( IO_MEASUREMENT_INFO_BUFFER_OVERFLOW, exceptions.BufferOverflow, index );
             SetIoMeasurementInfoPredefined( IO_MEASUREMENT_INFO_BUFFER_OVERRUN, exceptions.BufferOverrun, index );
             SetIoMeasurementInfoPredefined( IO_MEASUREMENT_INFO_COUNTERS_OVERFLOW, exceptions.CountersOverflow, index );
+
+            m_flightRecorder.Record( reportData, *reportCount );
         }
 
         return ret;
@@ -421,6 +433,8 @@ namespace MetricsDiscoveryInternal
             return ret;
         }
 
+        m_flightRecorder.Stop();
+
         // m_processId is not cleared after close to define if context filtering was used.
         // Stream reopen will override m_processId
         m_ioMetricSet = nullptr;
@@ -454,6 +468,426 @@ namespace MetricsDiscoveryInternal
         return driverInterface.WaitForIoStreamReports( *this, milliseconds );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     ReadAndCalculate
+    //
+    // Description:
+    //     Waits for reports from IO Stream, reads them to an internal buffer, reused
+    //     between reads, and calculates them with the opened metric set. Results are
+    //     written either as CalculateMetrics reports to 'out' or to typed 'columns'
+    //     (see CalculateMetricsToColumns), exactly one of them has to be given.
+    //     Returns *CC_WAIT_TIMEOUT* if no reports came within the timeout and
+    //     *CC_READ_PENDING* if not all data was read.
+    //
+    // Input:
+    //     uint32_t                  milliseconds - number of milliseconds to wait, 0 reads without waiting
+    //     uint32_t                  readFlags    - read flags (see TIoReadFlag enum), 0 is ok
+    //     uint32_t*                 reportCount  - (in/out) max number of reports to read, clamped to reports
+    //                                              fitting to out / calculated reports
+    //     TTypedValue_1_0*          out          - (out) calculated reports, nullptr if columns are used
+    //     uint32_t                  outSize      - size of out in bytes
+    //     const TOutputColumn_1_15* columns      - output columns, nullptr if out is used
+    //     uint32_t                  columnsCount - number of output columns
+    //
+    // Output:
+    //     TCompletionCode                        - result of operation (*CC_OK* or *CC_READ_PENDING* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::ReadAndCalculate( uint32_t milliseconds, uint32_t readFlags, uint32_t* reportCount, TTypedValue_1_0* out, uint32_t outSize, const TOutputColumn_1_15* columns, uint32_t columnsCount )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        MD_CHECK_PTR_RET_A( adapterId, reportCount, CC_ERROR_INVALID_PARAMETER );
+
+        uint32_t maxReportCount = *reportCount;
+        *reportCount            = 0;
+
+        if( m_ioMetricSet == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+        if( ( out == nullptr ) == ( columns == nullptr ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: either out or columns has to be given, out: %p, columns: %p", out, columns );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( maxReportCount == 0 )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "0 reports to read" );
+            return CC_OK;
+        }
+
+        // Reports read from the stream are consumed, so only as many are read as fit to out.
+        if( out != nullptr )
+        {
+            const TMetricSetParamsLatest* params        = m_ioMetricSet->GetParams();
+            const uint32_t                outReportSize = ( params->MetricsCount + params->InformationCount ) * sizeof( TTypedValue_1_0 );
+
+            if( outReportSize != 0 )
+            {
+                if( outSize % outReportSize != 0 || outSize < outReportSize )
+                {
+                    MD_LOG_A( adapterId, LOG_ERROR, "error: invalid out size: %u, out report size: %u", outSize, outReportSize );
+                    return CC_ERROR_INVALID_PARAMETER;
+                }
+
+                maxReportCount = std::min( maxReportCount, outSize / outReportSize );
+            }
+        }
+
+        const uint32_t rawReportSize = m_ioMetricSet->GetParams()->RawReportSize;
+        const uint64_t readSize      = static_cast<uint64_t>( maxReportCount ) * rawReportSize;
+        if( rawReportSize == 0 || readSize > UINT32_MAX )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid read size, reports: %u, raw report size: %u", maxReportCount, rawReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        if( milliseconds != 0 )
+        {
+            const TCompletionCode waitRet = WaitForReports( milliseconds );
+            if( waitRet != CC_OK )
+            {
+                MD_LOG_A( adapterId, LOG_DEBUG, "no reports to read, wait result: %u", waitRet );
+                return waitRet;
+            }
+        }
+
+        // Resizing keeps the capacity, so the buffer is allocated only when it grows.
+        m_readBuffer.resize( static_cast<size_t>( readSize ) );
+
+        uint32_t              readCount = maxReportCount;
+        const TCompletionCode readRet   = ReadIoStream( &readCount, reinterpret_cast<char*>( m_readBuffer.data() ), readFlags );
+        if( readRet != CC_OK && readRet != CC_READ_PENDING )
+        {
+            return readRet;
+        }
+        if( readCount == 0 )
+        {
+            return readRet;
+        }
+
+        const uint32_t  rawDataSize = readCount * rawReportSize;
+        TCompletionCode ret         = ( columns != nullptr )
+                    ? m_ioMetricSet->CalculateMetricsToColumns( m_readBuffer.data(), rawDataSize, columns, columnsCount, maxReportCount, reportCount )
+                    : m_ioMetricSet->CalculateMetrics( m_readBuffer.data(), rawDataSize, out, outSize, reportCount, nullptr, 0 );
+        MD_CHECK_CC_RET_A( adapterId, ret );
+
+        // Failed capture doesn't fail the read, calculated reports are still valid.
+        if( m_flightRecorder.IsStarted() )
+        {
+            const TMetricSetParamsLatest* params = m_ioMetricSet->GetParams();
+
+            ret = ( columns != nullptr )
+                ? m_flightRecorder.EvaluateTriggers( columns, columnsCount, *reportCount )
+                : m_flightRecorder.EvaluateTriggers( out, *reportCount, params->MetricsCount + params->InformationCount );
+            if( ret != CC_OK )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder capture failed: %u", ret );
+            }
+        }
+
+        return readRet;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     GetIoStreamHandle
+    //
+    // Description:
+    //     Returns a pollable handle of the opened IO Stream (file descriptor on Linux),
+    //     signaled when reports are available. Allows waiting for reports in the user
+    //     event loop instead of WaitForReports.
+    //
+    // Input:
+    //     int64_t*        handle - (out) IO Stream handle
+    //
+    // Output:
+    //     TCompletionCode        - result of operation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::GetIoStreamHandle( int64_t* handle )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        MD_CHECK_PTR_RET_A( adapterId, handle, CC_ERROR_INVALID_PARAMETER );
+
+        if( m_ioMetricSet == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        return m_device.GetDriverInterface().GetIoStreamHandle( *this, *handle );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     SetReportsCallback
+    //
+    // Description:
+    //     Sets a callback receiving reports calculated by ProcessReports.
+    //     Callback is removed if nullptr is given.
+    //
+    // Input:
+    //     TReportsCallback_1_15 callback - reports callback
+    //     void*                 userData - passed to the callback
+    //
+    // Output:
+    //     TCompletionCode                - result of operation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::SetReportsCallback( TReportsCallback_1_15 callback, void* userData )
+    {
+        m_reportsCallback     = callback;
+        m_reportsCallbackData = ( callback != nullptr ) ? userData : nullptr;
+
+        if( callback == nullptr )
+        {
+            m_reportsCallbackBuffer.clear();
+            m_reportsCallbackBuffer.shrink_to_fit();
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     ProcessReports
+    //
+    // Description:
+    //     Reads available reports without waiting, calculates them to an internal
+    //     buffer, reused between calls, and passes them to the reports callback in
+    //     one batch. Meant to be called when the IO Stream handle is signaled.
+    //     The callback isn't called if no reports were calculated.
+    //
+    // Input:
+    //     uint32_t        readFlags   - read flags (see TIoReadFlag enum), 0 is ok
+    //     uint32_t*       reportCount - (in/out) max number of reports to read / calculated reports
+    //
+    // Output:
+    //     TCompletionCode             - result of operation (*CC_OK* or *CC_READ_PENDING* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::ProcessReports( uint32_t readFlags, uint32_t* reportCount )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        MD_CHECK_PTR_RET_A( adapterId, reportCount, CC_ERROR_INVALID_PARAMETER );
+
+        const uint32_t maxReportCount = *reportCount;
+        *reportCount                  = 0;
+
+        if( m_reportsCallback == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: reports callback not set" );
+            return CC_ERROR_GENERAL;
+        }
+        if( m_ioMetricSet == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        const TMetricSetParamsLatest* params     = m_ioMetricSet->GetParams();
+        const uint32_t                reportSize = params->MetricsCount + params->InformationCount;
+        const uint64_t                outCount   = static_cast<uint64_t>( maxReportCount ) * reportSize;
+        if( outCount * sizeof( TTypedValue_1_0 ) > UINT32_MAX )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: too many reports to process: %u", maxReportCount );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        m_reportsCallbackBuffer.resize( static_cast<size_t>( outCount ) );
+
+        const uint32_t  outSize = static_cast<uint32_t>( outCount * sizeof( TTypedValue_1_0 ) );
+        uint32_t        count   = maxReportCount;
+        TCompletionCode ret     = ReadAndCalculate( 0, readFlags, &count, m_reportsCallbackBuffer.data(), outSize, nullptr, 0 );
+        if( ret != CC_OK && ret != CC_READ_PENDING )
+        {
+            return ret;
+        }
+
+        if( count != 0 )
+        {
+            m_reportsCallback( this, m_reportsCallbackBuffer.data(), count, reportSize, m_reportsCallbackData );
+        }
+
+        *reportCount = count;
+        return ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     SetIoStreamWakeup
+    //
+    // Description:
+    //     Sets when a reader waiting for reports is woken up. Applied by the next
+    //     OpenIoStream, change is disallowed if stream is already opened.
+    //
+    // Input:
+    //     TIoStreamWakeupMode mode        - wake-up mode
+    //     uint32_t            reportCount - number of reports, used with IO_STREAM_WAKEUP_MODE_REPORT_COUNT
+    //
+    // Output:
+    //     TCompletionCode                 - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::SetIoStreamWakeup( TIoStreamWakeupMode mode, uint32_t reportCount )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( mode >= IO_STREAM_WAKEUP_MODE_LAST )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid wake-up mode: %u", mode );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( mode == IO_STREAM_WAKEUP_MODE_REPORT_COUNT && reportCount == 0 )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: wake-up report count cannot be 0" );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( m_ioMetricSet != nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "Failed to set IoStream wake-up, stream already opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        m_ioStreamWakeupMode        = mode;
+        m_ioStreamWakeupReportCount = ( mode == IO_STREAM_WAKEUP_MODE_REPORT_COUNT ) ? reportCount : 0;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "Stream wake-up mode: %u, report count: %u", m_ioStreamWakeupMode, m_ioStreamWakeupReportCount );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     SetIoStreamContext
+    //
+    // Description:
+    //     Limits the next IO Stream to a single GPU context, reports of other contexts
+    //     are dropped by the kernel. Change is disallowed if stream is already opened.
+    //     The DRM fd is checked and duplicated by the driver interface on OpenIoStream.
+    //
+    // Input:
+    //     int64_t  drmHandle - DRM file descriptor owning the context, negative means system wide stream
+    //     uint32_t contextId - i915 context handle or XE exec queue id
+    //
+    // Output:
+    //     TCompletionCode    - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::SetIoStreamContext( int64_t drmHandle, uint32_t contextId )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( drmHandle > INT32_MAX )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid drm handle" );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( m_ioMetricSet != nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "Failed to set IoStream context, stream already opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        m_ioStreamContextDrmHandle = ( drmHandle < 0 ) ? -1 : drmHandle;
+        m_ioStreamContextId        = ( drmHandle < 0 ) ? 0 : contextId;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "Stream context: %u, drm handle: %d", m_ioStreamContextId, static_cast<int32_t>( m_ioStreamContextDrmHandle ) );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     SetFlightRecorder
+    //
+    // Description:
+    //     Sets the IO Stream flight recorder, applied by the next OpenIoStream.
+    //     Raw reports of the last DurationMs are kept in a ring and written to
+    //     a capture file when a trigger fires. Recorder is disabled if nullptr
+    //     is given. Change is disallowed if stream is already opened.
+    //
+    // Input:
+    //     const TFlightRecorderParams_1_15* params - recorder parameters, may be nullptr
+    //
+    // Output:
+    //     TCompletionCode                          - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::SetFlightRecorder( const TFlightRecorderParams_1_15* params )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( m_ioMetricSet != nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "Failed to set IoStream flight recorder, stream already opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        return m_flightRecorder.SetParams( params );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     DumpFlightRecorder
+    //
+    // Description:
+    //     Writes the flight recorder ring of the opened IO Stream to the next
+    //     capture file, regardless of triggers.
+    //
+    // Output:
+    //     TCompletionCode - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode COAConcurrentGroup::DumpFlightRecorder( void )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( m_ioMetricSet == nullptr || !m_flightRecorder.IsStarted() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: stream with flight recorder not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        return m_flightRecorder.Dump( FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER, 0.0 );
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -727,6 +1161,9 @@ namespace MetricsDiscoveryInternal
 
         m_ioMetricSet = metricSetInternal;
 
+        // Found once per stream instead of per calculation, API filtering changes find them again.
+        m_ioMetricSet->UpdateCpuTimestampIndices();
+
         return CC_OK;
     }
 
@@ -820,6 +1257,86 @@ namespace MetricsDiscoveryInternal
         return m_oaBufferType;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     GetIoStreamWakeupMode
+    //
+    // Description:
+    //     Returns IO Stream wake-up mode.
+    //
+    // Output:
+    //     TIoStreamWakeupMode - wake-up mode
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TIoStreamWakeupMode COAConcurrentGroup::GetIoStreamWakeupMode() const
+    {
+        return m_ioStreamWakeupMode;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     GetIoStreamWakeupReportCount
+    //
+    // Description:
+    //     Returns IO Stream wake-up report count, used with IO_STREAM_WAKEUP_MODE_REPORT_COUNT.
+    //
+    // Output:
+    //     uint32_t - number of reports
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t COAConcurrentGroup::GetIoStreamWakeupReportCount() const
+    {
+        return m_ioStreamWakeupReportCount;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     GetIoStreamContextDrmHandle
+    //
+    // Description:
+    //     Returns DRM file descriptor owning the IO Stream context.
+    //
+    // Output:
+    //     int64_t - DRM file descriptor, -1 means system wide stream
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    int64_t COAConcurrentGroup::GetIoStreamContextDrmHandle() const
+    {
+        return m_ioStreamContextDrmHandle;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     COAConcurrentGroup
+    //
+    // Method:
+    //     GetIoStreamContextId
+    //
+    // Description:
+    //     Returns IO Stream context, i915 context handle or XE exec queue id.
+    //
+    // Output:
+    //     uint32_t - context id
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t COAConcurrentGroup::GetIoStreamContextId() const
+    {
+        return m_ioStreamContextId;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -909,6 +1426,15 @@ namespace MetricsDiscoveryInternal
         , m_ioGpuContextInfoVector()
         , m_metricEnumeratorVector{ new( std::nothrow ) CMetricEnumerator( *this ) }
         , m_archEventVector()
+        , m_readBuffer()
+        , m_reportsCallback( nullptr )
+        , m_reportsCallbackData( nullptr )
+        , m_reportsCallbackBuffer()
+        , m_ioStreamWakeupMode( IO_STREAM_WAKEUP_MODE_DEFAULT )
+        , m_ioStreamWakeupReportCount( 0 )
+        , m_ioStreamContextDrmHandle( -1 )
+        , m_ioStreamContextId( 0 )
+        , m_flightRecorder( device )
     {
         AddIoMeasurementInfoPredefined();
         m_params.IoMeasurementInformationCount = static_cast<uint32_t>( m_ioMeasurementInfoVector.size() );
@@ -0,0 +1,187 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_pmu_concurrent_group.cpp
+
+//     Abstract:   C++ Metrics Discovery pmu concurrent group implementation
+
+#include "md_pmu_concurrent_group.h"
+#include "md_adapter.h"
+#include "md_metrics_device.h"
+#include "md_driver_ifc.h"
+#include "md_utils.h"
+
+#include <cstring>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     GetMetricEnumerator
+    //
+    // Description:
+    //     Metric enumerator isn't available, PMU metrics can't be programmed.
+    //
+    // Output:
+    //     IMetricEnumerator_1_13* - nullptr
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    IMetricEnumerator_1_13* CPmuConcurrentGroup::GetMetricEnumerator( void )
+    {
+        MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_DEBUG, "Metric enumerator is not available for %s concurrent group", m_params.SymbolName );
+        return nullptr;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     AddMetricSet
+    //
+    // Description:
+    //     Custom metric sets aren't available, PMU metrics can't be programmed.
+    //
+    // Input:
+    //     const char* symbolName - metric set symbol name.
+    //     const char* shortName  - metric set short name.
+    //
+    // Output:
+    //     IMetricSet_1_13*       - nullptr
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    IMetricSet_1_13* CPmuConcurrentGroup::AddMetricSet( [[maybe_unused]] const char* symbolName, [[maybe_unused]] const char* shortName )
+    {
+        MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_ERROR, "ERROR: Custom metric sets are not supported for %s concurrent group", m_params.SymbolName );
+        return nullptr;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     CPmuConcurrentGroup constructor
+    //
+    // Description:
+    //     Constructor.
+    //
+    // Input:
+    //     CMetricsDevice& device                 - parent metrics device
+    //     const char*     name                   - concurrent group name
+    //     const char*     description            - concurrent group description
+    //     const uint32_t  measurementTypeMask    - measurement type mask
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CPmuConcurrentGroup::CPmuConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask )
+        : CPmuConcurrentGroup( device, name, description, measurementTypeMask, STREAM_TYPE_PMU )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     CPmuConcurrentGroup constructor
+    //
+    // Description:
+    //     Constructor of groups with other streams sampled in user space, which
+    //     don't program any hardware either.
+    //
+    // Input:
+    //     CMetricsDevice&   device              - parent metrics device
+    //     const char*       name                - concurrent group name
+    //     const char*       description         - concurrent group description
+    //     const uint32_t    measurementTypeMask - measurement type mask
+    //     const TStreamType streamType          - stream type
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CPmuConcurrentGroup::CPmuConcurrentGroup( CMetricsDevice& device, const char* name, const char* description, const uint32_t measurementTypeMask, const TStreamType streamType )
+        : COAConcurrentGroup( device, name, description, measurementTypeMask, streamType, GTDI_OA_BUFFER_TYPE_DEFAULT )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     GetStreamTypeFromSamplingType
+    //
+    // Description:
+    //     PMU stream is the only one available, there's no sampling type to change to.
+    //
+    // Input:
+    //     const TSamplingType samplingTyp - sampling type
+    //     TStreamType&        streamType  - (out) stream type
+    //
+    // Output:
+    //     TCompletionCode                 - *CC_ERROR_NOT_SUPPORTED*
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CPmuConcurrentGroup::GetStreamTypeFromSamplingType( [[maybe_unused]] const TSamplingType samplingType, [[maybe_unused]] TStreamType& streamType ) const
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     IsSupported
+    //
+    // Description:
+    //     Checks if engine busyness PMU is exposed by the kernel driver.
+    //
+    // Input:
+    //     CMetricsDevice& device - metrics device
+    //
+    // Output:
+    //     bool                   - true if supported
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CPmuConcurrentGroup::IsSupported( CMetricsDevice& device )
+    {
+        return device.GetDriverInterface().IsStreamTypeSupported( STREAM_TYPE_PMU );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuConcurrentGroup
+    //
+    // Method:
+    //     IsValidSymbolName
+    //
+    // Description:
+    //     Checks if PMU concurrent group symbol name is valid.
+    //
+    // Input:
+    //     const char* symbolName - concurrent group symbol name
+    //
+    // Output:
+    //     bool                   - true if valid
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CPmuConcurrentGroup::IsValidSymbolName( const char* symbolName )
+    {
+        return strcmp( symbolName, "PMU" ) == 0;
+    }
+
+} // namespace MetricsDiscoveryInternal
@@ -12,12 +12,17 @@ SPDX-License-Identifier: MIT
 
 #include "md_adapter.h"
 #include "md_metrics_device.h"
+#include "md_multi_tile_io_stream.h"
 
 #include "md_driver_ifc.h"
 #include "md_metrics.h"
 #include "md_types.h"
 #include "md_utils.h"
 
+#include <algorithm>
+#include <thread>
+#include <system_error>
+
 namespace MetricsDiscoveryInternal
 {
     //////////////////////////////////////////////////////////////////////////////
@@ -32,6 +37,7 @@ namespace MetricsDiscoveryInternal
     //     Constructor.
     //     Adapter object becomes owner of the adapter handle (CAdapterHandle object) and
     //     params memory (strings).
+    //     Driver interface is not created here, see Initialize.
     //
     // Input:
     //     CAdapterGroup&              adapterGroup  - parent adapter group object
@@ -45,21 +51,16 @@ namespace MetricsDiscoveryInternal
         , m_adapterHandle( &adapterHandle )
         , m_driverInterface( nullptr )
         , m_openCloseSemaphore( nullptr )
+        , m_initializeFlag()
+        , m_initializeResult( CC_ERROR_GENERAL )
         , m_subDevices( *this )
         , m_subDeviceParams{}
         , m_engineParams{}
+        , m_multiTileIoStreams()
+        , m_multiTileIoStreamWakeupMode( IO_STREAM_WAKEUP_MODE_DEFAULT )
+        , m_multiTileIoStreamWakeupReportCount( 0 )
         , m_adapterGroup( adapterGroup )
     {
-        if( CreateDriverInterface() == CC_OK )
-        {
-            // Initialize sub device information.
-            m_subDevices.Enumerate();
-            m_subDevices.GetAdapterParams( m_params );
-        }
-        else
-        {
-            MD_LOG( LOG_ERROR, "Failed to create driver interface for an adapter" );
-        }
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -83,9 +84,14 @@ namespace MetricsDiscoveryInternal
         , m_adapterHandle( nullptr )
         , m_driverInterface( nullptr )
         , m_openCloseSemaphore( nullptr )
+        , m_initializeFlag()
+        , m_initializeResult( CC_ERROR_GENERAL )
         , m_subDevices( *this )
         , m_subDeviceParams{}
         , m_engineParams{}
+        , m_multiTileIoStreams()
+        , m_multiTileIoStreamWakeupMode( IO_STREAM_WAKEUP_MODE_DEFAULT )
+        , m_multiTileIoStreamWakeupReportCount( 0 )
         , m_adapterGroup( adapterGroup )
     {
         MD_LOG( LOG_INFO, "Offline adapter" );
@@ -105,6 +111,11 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     CAdapter::~CAdapter()
     {
+        for( auto& ioStream : m_multiTileIoStreams )
+        {
+            MD_SAFE_DELETE( ioStream );
+        }
+
         MD_SAFE_DELETE_ARRAY( m_params.ShortName );
 
         MD_SAFE_DELETE( m_driverInterface );
@@ -125,7 +136,9 @@ namespace MetricsDiscoveryInternal
     //     GetParams
     //
     // Description:
-    //     Returns adapter params.
+    //     Returns adapter params. Sub devices count is filled during adapter
+    //     enumeration without opening the adapter, it's corrected if sub
+    //     devices enumerated at adapter initialization differ.
     //
     // Output:
     //     const TAdapterParams_1_9* - adapter params
@@ -156,6 +169,8 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     const TSubDeviceParams_1_9* CAdapter::GetSubDeviceParams( const uint32_t subDeviceIndex )
     {
+        Initialize();
+
         return ( m_subDevices.GetSubDeviceParams( subDeviceIndex, m_subDeviceParams ) == CC_OK )
             ? &m_subDeviceParams
             : nullptr;
@@ -182,6 +197,8 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     const TEngineParamsLatest* CAdapter::GetEngineParams( const uint32_t subDeviceIndex, const uint32_t engineIndex )
     {
+        Initialize();
+
         return ( m_subDevices.GetEngineParams( subDeviceIndex, engineIndex, m_engineParams ) == CC_OK )
             ? &m_engineParams
             : nullptr;
@@ -207,6 +224,27 @@ namespace MetricsDiscoveryInternal
         return m_subDevices;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     GetEnumeratedParams
+    //
+    // Description:
+    //     Returns adapter params known from adapter enumeration, without
+    //     initializing the adapter.
+    //
+    // Output:
+    //     const TAdapterParamsLatest& - adapter params
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    const TAdapterParamsLatest& CAdapter::GetEnumeratedParams() const
+    {
+        return m_params;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -322,7 +360,13 @@ namespace MetricsDiscoveryInternal
         MD_LOG_ENTER_A( m_adapterId );
         MD_CHECK_PTR_RET_A( m_adapterId, metricsDevice, CC_ERROR_INVALID_PARAMETER );
 
-        TCompletionCode retVal = CC_OK;
+        TCompletionCode retVal = Initialize();
+        if( retVal != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return retVal;
+        }
 
         // if MD_METRIC_EXTENSION environment var is set, OpenMetricsDeviceFromFileByIndex instead
         const char* metricFilename = iu_dupenv_s( MD_METRIC_EXTENSION );
@@ -380,6 +424,116 @@ namespace MetricsDiscoveryInternal
         return retVal;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsDevicesByIndex
+    //
+    // Description:
+    //     Opens several metrics devices with given sub device indices or retrieves
+    //     instances opened before. Missing devices are created concurrently, see
+    //     CreateMetricsDevices. All calls are reference counted. On failure devices
+    //     retrieved or opened so far are returned and have to be closed.
+    //
+    // Input:
+    //     std::vector<CMetricsDevice*>& metricsDevices   - [out] created / retrieved metrics devices, in indices order
+    //     const std::vector<uint32_t>&  subDeviceIndices - indices of sub devices to create
+    //
+    // Output:
+    //     TCompletionCode                                - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsDevicesByIndex( std::vector<CMetricsDevice*>& metricsDevices, const std::vector<uint32_t>& subDeviceIndices )
+    {
+        MD_LOG_ENTER_A( m_adapterId );
+
+        TCompletionCode retVal = Initialize();
+        if( retVal != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return retVal;
+        }
+
+        metricsDevices.assign( subDeviceIndices.size(), nullptr );
+
+        // if MD_METRIC_EXTENSION environment var is set, open devices one by one
+        // so the extension file is handled by OpenMetricsDeviceByIndex
+        const char* metricFilename = iu_dupenv_s( MD_METRIC_EXTENSION );
+        if( metricFilename != nullptr )
+        {
+            free( (void*) metricFilename );
+
+            for( uint32_t i = 0; i < subDeviceIndices.size() && retVal == CC_OK; ++i )
+            {
+                retVal = OpenMetricsDeviceByIndex( &metricsDevices[i], subDeviceIndices[i] );
+                retVal = ( retVal == CC_ALREADY_INITIALIZED ) ? CC_OK : retVal;
+            }
+
+            MD_LOG_EXIT_A( m_adapterId );
+            return retVal;
+        }
+
+        // 1. Obtain semaphore
+        retVal = GetOpenCloseSemaphore();
+        if( retVal != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Get semaphore failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return retVal;
+        }
+
+        // 2. Return existing metrics device objects
+        std::vector<uint32_t> indicesToCreate;
+        std::vector<uint32_t> positionsToCreate;
+
+        for( uint32_t i = 0; i < subDeviceIndices.size(); ++i )
+        {
+            if( CMetricsDevice* device = m_subDevices.GetDevice( subDeviceIndices[i] );
+                device )
+            {
+                metricsDevices[i] = device;
+                ++device->GetReferenceCounter();
+            }
+            else
+            {
+                indicesToCreate.push_back( subDeviceIndices[i] );
+                positionsToCreate.push_back( i );
+            }
+        }
+
+        // 3. Create missing metrics device objects
+        if( !indicesToCreate.empty() )
+        {
+            std::vector<CMetricsDevice*> createdDevices;
+
+            retVal = CreateMetricsDevices( createdDevices, indicesToCreate );
+            if( retVal == CC_OK )
+            {
+                for( uint32_t i = 0; i < createdDevices.size(); ++i )
+                {
+                    ++createdDevices[i]->GetReferenceCounter();
+
+                    if( indicesToCreate[i] == MD_ROOT_DEVICE_INDEX )
+                    {
+                        m_subDevices.SetRootDevice( createdDevices[i] );
+                    }
+
+                    metricsDevices[positionsToCreate[i]] = createdDevices[i];
+                }
+            }
+        }
+
+        // 4. Release semaphore
+        ReleaseOpenCloseSemaphore();
+
+        MD_LOG_EXIT_A( m_adapterId );
+        return retVal;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -480,6 +634,31 @@ namespace MetricsDiscoveryInternal
         return OpenMetricsDeviceByIndex( (CMetricsDevice**) metricsDevice, MD_ROOT_DEVICE_INDEX );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsDevice
+    //
+    // Description:
+    //     Opens metrics device or retrieves an instance opened before. Only one
+    //     instance per adapter may exist. All OpenMetricsDevice() calls are
+    //     reference counted.
+    //
+    // Input:
+    //     IMetricsDevice_1_15** metricsDevice - [out] created / retrieved metrics device
+    //
+    // Output:
+    //     TCompletionCode                     - CC_OK or CC_ALREADY_INITIALIZED means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsDevice( IMetricsDevice_1_15** metricsDevice )
+    {
+        return OpenMetricsDeviceByIndex( (CMetricsDevice**) metricsDevice, MD_ROOT_DEVICE_INDEX );
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -509,8 +688,16 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_PTR_RET_A( m_adapterId, fileName, CC_ERROR_INVALID_PARAMETER );
         MD_CHECK_PTR_RET_A( m_adapterId, metricsDevice, CC_ERROR_INVALID_PARAMETER );
 
+        TCompletionCode retVal = Initialize();
+        if( retVal != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return retVal;
+        }
+
         // 1. Obtain semaphore
-        TCompletionCode retVal = GetOpenCloseSemaphore();
+        retVal = GetOpenCloseSemaphore();
         if( retVal != CC_OK )
         {
             MD_LOG_A( m_adapterId, LOG_ERROR, "Get semaphore failed" );
@@ -671,6 +858,33 @@ namespace MetricsDiscoveryInternal
         return OpenMetricsDeviceFromFileByIndex( fileName, openParams, (CMetricsDevice**) metricsDevice, MD_ROOT_DEVICE_INDEX );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsDeviceFromFile
+    //
+    // Description:
+    //     Opens metrics device or uses an instance opened before (just like OpenMetricsDevice),
+    //     then loads custom metric sets / metrics from a file and merged them into the 'standard'
+    //     metrics device.
+    //
+    // Input:
+    //     const char*           fileName       - custom metric file
+    //     void*                 openParams     - open params
+    //     IMetricsDevice_1_15** metricsDevice  - [out] created / retrieved metrics device
+    //
+    // Output:
+    //     TCompletionCode                      - CC_OK or CC_ALREADY_INITIALIZED means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsDeviceFromFile( const char* fileName, void* openParams, IMetricsDevice_1_15** metricsDevice )
+    {
+        return OpenMetricsDeviceFromFileByIndex( fileName, openParams, (CMetricsDevice**) metricsDevice, MD_ROOT_DEVICE_INDEX );
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -695,10 +909,17 @@ namespace MetricsDiscoveryInternal
         MD_LOG_ENTER_A( m_adapterId );
         MD_CHECK_PTR_RET_A( m_adapterId, metricsDevice, CC_ERROR_INVALID_PARAMETER );
 
-        const bool      isFirstDevice        = subDeviceIndex == 0;
-        const bool      isValidIndex         = isFirstDevice || ( subDeviceIndex < m_params.SubDevicesCount );
-        const bool      isSubDeviceSupported = m_subDevices.IsSupported();
-        TCompletionCode result               = CC_OK;
+        TCompletionCode result = Initialize();
+        if( result != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return result;
+        }
+
+        const bool isFirstDevice        = subDeviceIndex == 0;
+        const bool isValidIndex         = isFirstDevice || ( subDeviceIndex < m_params.SubDevicesCount );
+        const bool isSubDeviceSupported = m_subDevices.IsSupported();
 
         // Check sub device support (first device is always supported).
         if( !isFirstDevice && !isSubDeviceSupported )
@@ -832,6 +1053,340 @@ namespace MetricsDiscoveryInternal
         return OpenMetricsSubDevice( subDeviceIndex, (CMetricsDevice**) metricsDevice );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsSubDevice
+    //
+    // Description:
+    //     Opens metrics sub device or retrieves an instance opened before.
+    //
+    // Input:
+    //     const uint32_t          subDeviceIndex - sub device index to create
+    //     IMetricsDevice_1_15**   metricsDevice  - [out] created / retrieved metrics sub device
+    //
+    // Output:
+    //     TCompletionCode                        - CC_OK or CC_ALREADY_INITIALIZED means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsSubDevice( const uint32_t subDeviceIndex, IMetricsDevice_1_15** metricsDevice )
+    {
+        return OpenMetricsSubDevice( subDeviceIndex, (CMetricsDevice**) metricsDevice );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsSubDevices
+    //
+    // Description:
+    //     Opens all metrics sub devices or retrieves instances opened before.
+    //     Sub devices which are not opened yet are created concurrently.
+    //     Each returned device has to be closed with CloseMetricsDevice.
+    //
+    // Input:
+    //     IMetricsDevice_1_15** metricsDevices      - [out] array for opened metrics sub devices, indexed by sub device index
+    //     uint32_t*             metricsDevicesCount - (in/out) array size / opened metrics sub devices count
+    //
+    // Output:
+    //     TCompletionCode                           - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsSubDevices( IMetricsDevice_1_15** metricsDevices, uint32_t* metricsDevicesCount )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, metricsDevices, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( m_adapterId, metricsDevicesCount, CC_ERROR_INVALID_PARAMETER );
+
+        TCompletionCode result = Initialize();
+        if( result != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            return result;
+        }
+
+        // Adapter without sub devices is opened as a single one.
+        const uint32_t subDevicesCount = std::max<uint32_t>( m_params.SubDevicesCount, 1 );
+
+        if( *metricsDevicesCount < subDevicesCount )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Metrics devices array too small, required size: %u", subDevicesCount );
+            *metricsDevicesCount = subDevicesCount;
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        std::vector<CMetricsDevice*> devices;
+
+        result = OpenMetricsSubDevices( devices );
+        MD_CHECK_CC_RET_A( m_adapterId, result );
+
+        for( uint32_t i = 0; i < devices.size(); ++i )
+        {
+            metricsDevices[i] = devices[i];
+        }
+
+        *metricsDevicesCount = devices.size();
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsSubDevices
+    //
+    // Description:
+    //     Opens all metrics sub devices or retrieves instances opened before.
+    //     Sub devices which are not opened yet are created concurrently.
+    //     Nothing stays opened on failure.
+    //
+    // Input:
+    //     std::vector<CMetricsDevice*>& metricsDevices - [out] opened metrics sub devices, indexed by sub device index
+    //
+    // Output:
+    //     TCompletionCode                              - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsSubDevices( std::vector<CMetricsDevice*>& metricsDevices )
+    {
+        MD_LOG_ENTER_A( m_adapterId );
+
+        TCompletionCode result = Initialize();
+        if( result != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return result;
+        }
+
+        // Adapter without sub devices is opened as a single one.
+        const uint32_t subDevicesCount = std::max<uint32_t>( m_params.SubDevicesCount, 1 );
+
+        if( subDevicesCount > 1 && !m_subDevices.IsSupported() )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Sub devices are not supported" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        std::vector<uint32_t>        indicesToOpen;
+        std::vector<CMetricsDevice*> openedDevices;
+
+        metricsDevices.assign( subDevicesCount, nullptr );
+
+        // 1. Retrieve sub devices opened before.
+        for( uint32_t i = 0; i < subDevicesCount; ++i )
+        {
+            if( CMetricsDevice* device = m_subDevices.GetDevice( i );
+                device )
+            {
+                ++device->GetReferenceCounter();
+                metricsDevices[i] = device;
+            }
+            else
+            {
+                indicesToOpen.push_back( i );
+            }
+        }
+
+        // 2. Open the remaining ones at once.
+        if( !indicesToOpen.empty() )
+        {
+            result = m_subDevices.OpenDevices( indicesToOpen, openedDevices );
+
+            for( uint32_t i = 0; i < openedDevices.size(); ++i )
+            {
+                metricsDevices[indicesToOpen[i]] = openedDevices[i];
+            }
+        }
+
+        // 3. Release all sub devices if any of them failed.
+        if( result != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Opening sub devices failed" );
+
+            for( auto device : metricsDevices )
+            {
+                if( device )
+                {
+                    CloseMetricsDevice( device );
+                }
+            }
+
+            metricsDevices.clear();
+        }
+
+        MD_LOG_EXIT_A( m_adapterId );
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMultiTileIoStream
+    //
+    // Description:
+    //     Opens all metrics sub devices and io stream with the same metric set
+    //     and wake-up on the oa unit of every sub device (tile). Returned stream
+    //     reads reports of all tiles at once, see CMultiTileIoStream.
+    //
+    // Input:
+    //     const char*               concurrentGroupName - oa concurrent group symbol name
+    //     const char*               metricSetName       - metric set symbol name
+    //     uint32_t*                 nsTimerPeriod       - (in/out) sampling period
+    //     uint32_t*                 oaBufferSize        - (in/out) oa buffer size of a single tile
+    //     IMultiTileIoStream_1_15** ioStream            - [out] opened multi tile io stream
+    //
+    // Output:
+    //     TCompletionCode                               - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMultiTileIoStream( const char* concurrentGroupName, const char* metricSetName, uint32_t* nsTimerPeriod, uint32_t* oaBufferSize, IMultiTileIoStream_1_15** ioStream )
+    {
+        MD_LOG_ENTER_A( m_adapterId );
+        MD_CHECK_PTR_RET_A( m_adapterId, concurrentGroupName, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( m_adapterId, metricSetName, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( m_adapterId, nsTimerPeriod, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( m_adapterId, oaBufferSize, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( m_adapterId, ioStream, CC_ERROR_INVALID_PARAMETER );
+
+        // 1. Open all sub devices
+        std::vector<CMetricsDevice*> devices;
+
+        TCompletionCode ret = OpenMetricsSubDevices( devices );
+        if( ret != CC_OK )
+        {
+            MD_LOG_EXIT_A( m_adapterId );
+            return ret;
+        }
+
+        // 2. Open io stream on every sub device
+        CMultiTileIoStream* stream = new( std::nothrow ) CMultiTileIoStream( *this );
+
+        ret = ( stream != nullptr )
+            ? stream->Open( devices, concurrentGroupName, metricSetName, m_multiTileIoStreamWakeupMode, m_multiTileIoStreamWakeupReportCount, *nsTimerPeriod, *oaBufferSize )
+            : CC_ERROR_NO_MEMORY;
+
+        if( ret != CC_OK )
+        {
+            MD_SAFE_DELETE( stream );
+
+            for( auto device : devices )
+            {
+                CloseMetricsDevice( device );
+            }
+
+            MD_LOG_EXIT_A( m_adapterId );
+            return ret;
+        }
+
+        m_multiTileIoStreams.push_back( stream );
+        *ioStream = stream;
+
+        MD_LOG_EXIT_A( m_adapterId );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     CloseMultiTileIoStream
+    //
+    // Description:
+    //     Closes io streams of all tiles and metrics sub devices opened
+    //     by OpenMultiTileIoStream.
+    //
+    // Input:
+    //     IMultiTileIoStream_1_15* ioStream - multi tile io stream to close
+    //
+    // Output:
+    //     TCompletionCode                   - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::CloseMultiTileIoStream( IMultiTileIoStream_1_15* ioStream )
+    {
+        MD_LOG_ENTER_A( m_adapterId );
+        MD_CHECK_PTR_RET_A( m_adapterId, ioStream, CC_ERROR_INVALID_PARAMETER );
+
+        auto stream = std::find( m_multiTileIoStreams.begin(), m_multiTileIoStreams.end(), static_cast<CMultiTileIoStream*>( ioStream ) );
+        if( stream == m_multiTileIoStreams.end() )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Pointers mismatch" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        CMultiTileIoStream* multiTileIoStream = *stream;
+        m_multiTileIoStreams.erase( stream );
+
+        // 1. Close streams of all tiles
+        TCompletionCode ret = multiTileIoStream->Close();
+
+        // 2. Close metrics sub devices
+        CMetricsDevice* device = nullptr;
+        for( uint32_t i = 0; ( device = multiTileIoStream->GetTileDevice( i ) ) != nullptr; ++i )
+        {
+            CloseMetricsDevice( device );
+        }
+
+        MD_SAFE_DELETE( multiTileIoStream );
+
+        MD_LOG_EXIT_A( m_adapterId );
+        return ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     SetMultiTileIoStreamWakeup
+    //
+    // Description:
+    //     Sets IO stream wake-up of all tiles, applied by the next OpenMultiTileIoStream.
+    //     See COAConcurrentGroup::SetIoStreamWakeup.
+    //
+    // Input:
+    //     TIoStreamWakeupMode mode        - wake-up mode
+    //     uint32_t            reportCount - number of reports, used with IO_STREAM_WAKEUP_MODE_REPORT_COUNT
+    //
+    // Output:
+    //     TCompletionCode                 - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::SetMultiTileIoStreamWakeup( TIoStreamWakeupMode mode, uint32_t reportCount )
+    {
+        if( mode >= IO_STREAM_WAKEUP_MODE_LAST )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: invalid wake-up mode: %u", mode );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( mode == IO_STREAM_WAKEUP_MODE_REPORT_COUNT && reportCount == 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: wake-up report count cannot be 0" );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        m_multiTileIoStreamWakeupMode        = mode;
+        m_multiTileIoStreamWakeupReportCount = ( mode == IO_STREAM_WAKEUP_MODE_REPORT_COUNT ) ? reportCount : 0;
+
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -861,10 +1416,17 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_PTR_RET_A( m_adapterId, fileName, CC_ERROR_INVALID_PARAMETER );
         MD_CHECK_PTR_RET_A( m_adapterId, metricsDevice, CC_ERROR_INVALID_PARAMETER );
 
-        const bool      isFirstDevice        = subDeviceIndex == 0;
-        const bool      isValidIndex         = isFirstDevice || ( subDeviceIndex < m_params.SubDevicesCount );
-        const bool      isSubDeviceSupported = m_subDevices.IsSupported();
-        TCompletionCode result               = CC_OK;
+        TCompletionCode result = Initialize();
+        if( result != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Adapter initialization failed" );
+            MD_LOG_EXIT_A( m_adapterId );
+            return result;
+        }
+
+        const bool isFirstDevice        = subDeviceIndex == 0;
+        const bool isValidIndex         = isFirstDevice || ( subDeviceIndex < m_params.SubDevicesCount );
+        const bool isSubDeviceSupported = m_subDevices.IsSupported();
 
         // Check sub device support (first device is always supported).
         if( !isFirstDevice && !isSubDeviceSupported )
@@ -1014,6 +1576,34 @@ namespace MetricsDiscoveryInternal
         return OpenMetricsSubDeviceFromFile( subDeviceIndex, fileName, openParams, (CMetricsDevice**) metricsDevice );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     OpenMetricsSubDeviceFromFile
+    //
+    // Description:
+    //     Opens metrics device or uses an instance opened before (just like OpenMetricsDevice),
+    //     then loads custom metric sets / metrics from a file and merged them into the 'standard'
+    //     metrics device.
+    //
+    // Input:
+    //     const uint32_t             subDeviceIndex  - sub device index to create
+    //     const char*                fileName        - custom metric file
+    //     void*                      openParams      - open params
+    //     IMetricsDevice_1_15**      metricsDevice   - [out] created / retrieved metrics device
+    //
+    // Output:
+    //     TCompletionCode                            - CC_OK or CC_ALREADY_INITIALIZED means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::OpenMetricsSubDeviceFromFile( const uint32_t subDeviceIndex, const char* fileName, void* openParams, IMetricsDevice_1_15** metricsDevice )
+    {
+        return OpenMetricsSubDeviceFromFile( subDeviceIndex, fileName, openParams, (CMetricsDevice**) metricsDevice );
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1258,6 +1848,60 @@ namespace MetricsDiscoveryInternal
         return m_driverInterface;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     Initialize
+    //
+    // Description:
+    //     Creates driver interface and enumerates sub devices on first use.
+    //     Adapter enumeration does not open the adapter, so adapters which are
+    //     never used do not pay for kernel queries. Threads using the adapter
+    //     for the first time at once wait for a single initialization, its
+    //     result is kept. Offline adapter has nothing to initialize.
+    //
+    // Output:
+    //     TCompletionCode - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::Initialize()
+    {
+        std::call_once( m_initializeFlag, [this]()
+            {
+                if( m_adapterHandle == nullptr )
+                {
+                    m_initializeResult = CC_OK;
+                    return;
+                }
+
+                m_initializeResult = CreateDriverInterface();
+                if( m_initializeResult != CC_OK )
+                {
+                    MD_LOG( LOG_ERROR, "Failed to create driver interface for an adapter" );
+                    return;
+                }
+
+                // Initialize sub device information.
+                m_subDevices.Enumerate();
+
+                TAdapterParams_1_9 params = m_params;
+                m_subDevices.GetAdapterParams( params );
+
+                if( params.SubDevicesCount != m_params.SubDevicesCount )
+                {
+                    MD_LOG_A( m_adapterId, LOG_WARNING, "Sub devices count %u differs from enumerated %u", params.SubDevicesCount, m_params.SubDevicesCount );
+                    m_params.SubDevicesCount = params.SubDevicesCount;
+                }
+
+                MD_LOG_A( m_adapterId, LOG_INFO, "Adapter %s - initialized", m_params.ShortName );
+            } );
+
+        return m_initializeResult;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1427,6 +2071,131 @@ namespace MetricsDiscoveryInternal
         return retVal;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapter
+    //
+    // Method:
+    //     CreateMetricsDevices
+    //
+    // Description:
+    //     Creates several metrics devices for given sub devices. Metric trees are
+    //     populated concurrently, one thread per sub device. Driver interface is
+    //     shared and serializes device info queries. All devices are destroyed
+    //     if any of them fails.
+    //
+    // Input:
+    //     std::vector<CMetricsDevice*>& metricsDevices   - [out] created metrics devices, in indices order
+    //     const std::vector<uint32_t>&  subDeviceIndices - indices of sub devices to create
+    //
+    // Output:
+    //     TCompletionCode                                - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapter::CreateMetricsDevices( std::vector<CMetricsDevice*>& metricsDevices, const std::vector<uint32_t>& subDeviceIndices )
+    {
+        const uint32_t devicesCount = subDeviceIndices.size();
+
+        metricsDevices.assign( devicesCount, nullptr );
+
+        if( devicesCount == 0 )
+        {
+            return CC_OK;
+        }
+
+        // 1. Create driver interface
+        TCompletionCode retVal = CreateDriverInterface();
+        if( retVal != CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "Failed to get driver interface" );
+            return retVal;
+        }
+        MD_CHECK_PTR_RET_A( m_adapterId, m_driverInterface, CC_ERROR_GENERAL );
+
+        // 2. Enable instrumentation support if needed, once per device like in CreateMetricsDevice
+        for( uint32_t i = 0; i < devicesCount; ++i )
+        {
+            retVal = EnableDriverSupport( true );
+            if( retVal != CC_OK )
+            {
+                for( uint32_t j = 0; j < i; ++j )
+                {
+                    EnableDriverSupport( false );
+                }
+
+                DestroyDriverInterface();
+                return retVal;
+            }
+        }
+
+        // 3. Create metrics device objects and populate metric trees
+        std::vector<TCompletionCode> results( devicesCount, CC_OK );
+        std::vector<std::thread>     workers;
+
+        auto createDevice = [&]( const uint32_t index )
+        {
+            CMetricsDevice* device = new( std::nothrow ) CMetricsDevice( *this, *m_driverInterface, subDeviceIndices[index] );
+            if( !device )
+            {
+                results[index] = CC_ERROR_NO_MEMORY;
+                return;
+            }
+
+            results[index] = CreateMetricTree( device );
+            if( results[index] != CC_OK )
+            {
+                MD_SAFE_DELETE( device );
+            }
+
+            metricsDevices[index] = device;
+        };
+
+        // The last device is created on the calling thread. If a thread
+        // cannot be started, its device is created on the calling thread too.
+        workers.reserve( devicesCount - 1 );
+        for( uint32_t i = 0; i < devicesCount - 1; ++i )
+        {
+            try
+            {
+                workers.emplace_back( createDevice, i );
+            }
+            catch( const std::system_error& )
+            {
+                createDevice( i );
+            }
+        }
+
+        createDevice( devicesCount - 1 );
+
+        for( auto& worker : workers )
+        {
+            worker.join();
+        }
+
+        MD_LOG_A( m_adapterId, LOG_DEBUG, "Metrics devices created concurrently: %u", devicesCount );
+
+        // 4. Destroy all devices if any of them failed
+        auto failed = std::find_if( results.begin(), results.end(), []( const TCompletionCode result )
+            { return result != CC_OK; } );
+
+        if( failed != results.end() )
+        {
+            retVal = *failed;
+
+            for( auto& device : metricsDevices )
+            {
+                MD_SAFE_DELETE( device );
+                EnableDriverSupport( false );
+            }
+
+            metricsDevices.clear();
+            DestroyDriverInterface();
+        }
+
+        return retVal;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
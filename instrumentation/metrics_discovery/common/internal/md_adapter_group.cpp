@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 #include "md_adapter_group.h"
 #include "md_adapter.h"
 #include "md_metrics_device.h"
+#include "md_quantile_sketch.h"
 
 #include "md_driver_ifc.h"
 #include "md_driver_ifc_offline.h"
@@ -39,6 +40,7 @@ namespace MetricsDiscoveryInternal
         , m_offlineAdapter( nullptr )
         , m_offlineDriverInterface( nullptr )
         , m_offlineDevicesVector()
+        , m_quantileSketchesVector()
     {
         m_params.Version.MajorNumber = MD_API_MAJOR_NUMBER_CURRENT;
         m_params.Version.MinorNumber = MD_API_MINOR_NUMBER_CURRENT;
@@ -62,6 +64,7 @@ namespace MetricsDiscoveryInternal
         CleanupAdapters();
 
         ClearVector( m_offlineDevicesVector );
+        ClearVector( m_quantileSketchesVector );
         MD_SAFE_DELETE( m_offlineDriverInterface );
         MD_SAFE_DELETE( m_offlineAdapter );
     }
@@ -96,6 +99,8 @@ namespace MetricsDiscoveryInternal
     //
     // Description:
     //    Returns chosen adapter or null if index doesn't exist.
+    //    The adapter is not initialized here, its params are enumerated ones.
+    //    It's initialized when the first metrics device is opened on it.
     //
     // Input:
     //     uint32_t index - index of a chosen adapter
@@ -183,14 +188,18 @@ namespace MetricsDiscoveryInternal
     //     opened before. Only one instance of adapter group may be created, all
     //     Open() calls are reference counted.
     //
+    //     Adapter filter is used only when the adapter group is created,
+    //     a filter given for an already opened group is an error.
+    //
     // Input:
-    //     CAdapterGroup** adapterGroup - [out] created / retrieved adapter group
+    //     CAdapterGroup**             adapterGroup - [out] created / retrieved adapter group
+    //     const TAdapterFilterLatest* filter       - [optional] adapter filter
     //
     // Output:
-    //     TCompletionCode              - CC_OK or CC_ALREADY_INITIALIZED means success
+    //     TCompletionCode                          - CC_OK or CC_ALREADY_INITIALIZED means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CAdapterGroup::Open( CAdapterGroup** adapterGroup )
+    TCompletionCode CAdapterGroup::Open( CAdapterGroup** adapterGroup, const TAdapterFilterLatest* filter /* = nullptr */ )
     {
         MD_LOG_ENTER();
         MD_CHECK_PTR_RET( adapterGroup, CC_ERROR_INVALID_PARAMETER );
@@ -203,7 +212,12 @@ namespace MetricsDiscoveryInternal
             return retVal;
         }
 
-        if( m_adapterGroup )
+        if( m_adapterGroup && filter && filter->Type != ADAPTER_FILTER_TYPE_NONE )
+        {
+            MD_LOG( LOG_ERROR, "ERROR: Adapter group already opened, adapter filter cannot be applied" );
+            retVal = CC_ERROR_INVALID_PARAMETER;
+        }
+        else if( m_adapterGroup )
         {
             *adapterGroup = m_adapterGroup;
             retVal        = CC_ALREADY_INITIALIZED;
@@ -214,7 +228,7 @@ namespace MetricsDiscoveryInternal
             // Read global debug log settings
             CDriverInterface::ReadDebugLogSettings();
 
-            retVal = CreateAdapterGroup( adapterGroup );
+            retVal = CreateAdapterGroup( adapterGroup, filter );
             if( retVal == CC_OK )
             {
                 m_agRefCounter++;
@@ -368,6 +382,80 @@ namespace MetricsDiscoveryInternal
         return device->WriteToBuffer( buffer, *bufferSize, metricSets, metricSetCount, minMajorApiVersion, minMinorApiVersion );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapterGroup
+    //
+    // Method:
+    //     CreateQuantileSketch
+    //
+    // Description:
+    //     Creates an empty quantile sketch, not bound to any metric set. It may be used
+    //     to merge sketches, e.g. received from other processes with MergeFromBuffer.
+    //
+    // Input:
+    //     double                  relativeAccuracy - relative accuracy of quantiles
+    //     uint32_t                maxBucketsCount  - max buckets count of a sketch store
+    //     IQuantileSketchLatest** sketch           - [out] created quantile sketch
+    //
+    // Output:
+    //     TCompletionCode                          - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapterGroup::CreateQuantileSketch( double relativeAccuracy, uint32_t maxBucketsCount, IQuantileSketchLatest** sketch )
+    {
+        MD_CHECK_PTR_RET( sketch, CC_ERROR_INVALID_PARAMETER );
+
+        if( !CQuantileSketch::AreParamsValid( IU_ADAPTER_ID_UNKNOWN, relativeAccuracy, maxBucketsCount ) )
+        {
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        auto quantileSketch = new( std::nothrow ) CQuantileSketch( IU_ADAPTER_ID_UNKNOWN, relativeAccuracy, maxBucketsCount );
+        MD_CHECK_PTR_RET( quantileSketch, CC_ERROR_NO_MEMORY );
+
+        m_quantileSketchesVector.push_back( quantileSketch );
+        *sketch = quantileSketch;
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapterGroup
+    //
+    // Method:
+    //     DestroyQuantileSketch
+    //
+    // Description:
+    //     Destroys a quantile sketch created by CreateQuantileSketch.
+    //
+    // Input:
+    //     IQuantileSketchLatest* sketch - a pointer to quantile sketch to destroy
+    //
+    // Output:
+    //     TCompletionCode               - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapterGroup::DestroyQuantileSketch( IQuantileSketchLatest* sketch )
+    {
+        auto sketchIterator = std::find( m_quantileSketchesVector.begin(), m_quantileSketchesVector.end(), sketch );
+
+        if( sketchIterator == m_quantileSketchesVector.end() )
+        {
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        auto quantileSketch = *sketchIterator;
+
+        MD_SAFE_DELETE( quantileSketch );
+        m_quantileSketchesVector.erase( sketchIterator );
+
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -461,20 +549,21 @@ namespace MetricsDiscoveryInternal
     //     adapter enumeration.
     //
     // Input:
-    //     CAdapterGroup** adapterGroup - [optional] created adapter group
+    //     CAdapterGroup**             adapterGroup - [optional] created adapter group
+    //     const TAdapterFilterLatest* filter       - [optional] adapter filter
     //
     // Output:
-    //     TCompletionCode              - CC_OK if success
+    //     TCompletionCode                          - CC_OK if success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CAdapterGroup::CreateAdapterGroup( CAdapterGroup** adapterGroup )
+    TCompletionCode CAdapterGroup::CreateAdapterGroup( CAdapterGroup** adapterGroup, const TAdapterFilterLatest* filter )
     {
         MD_ASSERT( m_adapterGroup == nullptr );
 
         m_adapterGroup = new( std::nothrow ) CAdapterGroup();
         MD_CHECK_PTR_RET( m_adapterGroup, CC_ERROR_NO_MEMORY );
 
-        TCompletionCode ret = m_adapterGroup->CreateAdapterTree();
+        TCompletionCode ret = m_adapterGroup->CreateAdapterTree( filter );
         if( ret != CC_OK )
         {
             MD_SAFE_DELETE( m_adapterGroup );
@@ -521,12 +610,19 @@ namespace MetricsDiscoveryInternal
     // Description:
     //     Creates the whole adapter tree. Includes available adapter discovery,
     //     creating adapter objects and filling their data.
+    //     Adapters not matching the filter are dropped before any adapter object
+    //     is created for them. Adapters are not initialized here, so an adapter
+    //     which fails to initialize is still listed and an attempt to open
+    //     a metrics device on it returns an error.
+    //
+    // Input:
+    //     const TAdapterFilterLatest* filter - [optional] adapter filter
     //
     // Output:
-    //     TCompletionCode - CC_OK means success
+    //     TCompletionCode                    - CC_OK means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CAdapterGroup::CreateAdapterTree()
+    TCompletionCode CAdapterGroup::CreateAdapterTree( const TAdapterFilterLatest* filter )
     {
         MD_LOG_ENTER();
 
@@ -537,8 +633,17 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_CC_RET( ret );
 
         // 2. Create adapter objects
-        for( const auto& adapterData : availableAdapters )
+        for( auto& adapterData : availableAdapters )
         {
+            if( IsAdapterFiltered( adapterData.Params, filter ) )
+            {
+                MD_LOG( LOG_DEBUG, "Adapter %s - filtered out", adapterData.Params.ShortName );
+
+                MD_SAFE_DELETE_ARRAY( adapterData.Params.ShortName );
+                MD_SAFE_DELETE( adapterData.Handle );
+                continue;
+            }
+
             ret = AddAdapter( adapterData );
             if( ret != CC_OK )
             {
@@ -553,7 +658,7 @@ namespace MetricsDiscoveryInternal
         if( ret == CC_OK )
         {
             m_defaultAdapter = ChooseDefaultAdapter();
-            MD_LOG( LOG_INFO, "Default adapter: %s", m_defaultAdapter ? m_defaultAdapter->GetParams()->ShortName : "None" );
+            MD_LOG( LOG_INFO, "Default adapter: %s", m_defaultAdapter ? m_defaultAdapter->GetEnumeratedParams().ShortName : "None" );
         }
 
         MD_LOG_EXIT();
@@ -591,13 +696,12 @@ namespace MetricsDiscoveryInternal
         m_adapterVector.push_back( adapter );
         m_params.AdapterCount = static_cast<uint32_t>( m_adapterVector.size() );
 
-        const TAdapterParamsLatest* adapterParams = adapter->GetParams();
-        const uint32_t              adapterId     = adapter->GetAdapterId();
+        // Adapter is initialized on first use, so adapter id is not known yet.
+        const TAdapterParamsLatest& adapterParams = adapter->GetEnumeratedParams();
 
-        MD_LOG_A( adapterId, LOG_INFO, "Adapter %s - added", adapterParams->ShortName );
-        MD_LOG_A( adapterId, LOG_INFO, "Platform ID: %u", adapterParams->Platform );
-        MD_LOG_A( adapterId, LOG_INFO, "Device ID: %x", adapterParams->DeviceId );
-        MD_LOG_A( adapterId, LOG_INFO, "Adapter ID: %u", adapterId );
+        MD_LOG( LOG_INFO, "Adapter %s - added", adapterParams.ShortName );
+        MD_LOG( LOG_INFO, "Platform ID: %u", adapterParams.Platform );
+        MD_LOG( LOG_INFO, "Device ID: %x", adapterParams.DeviceId );
 
         return CC_OK;
     }
@@ -653,7 +757,7 @@ namespace MetricsDiscoveryInternal
         // 2. Change to discrete GPU if exists
         for( auto& adapter : m_adapterVector )
         {
-            if( adapter && adapter->GetParams()->Type == ADAPTER_TYPE_DISCRETE )
+            if( adapter && adapter->GetEnumeratedParams().Type == ADAPTER_TYPE_DISCRETE )
             {
                 defaultAdapter = adapter;
                 break;
@@ -662,4 +766,50 @@ namespace MetricsDiscoveryInternal
 
         return defaultAdapter;
     }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapterGroup
+    //
+    // Method:
+    //     IsAdapterFiltered
+    //
+    // Description:
+    //     Checks whether the adapter should be skipped during adapter tree creation.
+    //
+    // Input:
+    //     const TAdapterParamsLatest& params - adapter params
+    //     const TAdapterFilterLatest* filter - [optional] adapter filter
+    //
+    // Output:
+    //     bool                               - true if adapter does not match the filter
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CAdapterGroup::IsAdapterFiltered( const TAdapterParamsLatest& params, const TAdapterFilterLatest* filter )
+    {
+        if( filter == nullptr )
+        {
+            return false;
+        }
+
+        switch( filter->Type )
+        {
+            case ADAPTER_FILTER_TYPE_NONE:
+                return false;
+
+            case ADAPTER_FILTER_TYPE_BDF:
+                return params.DomainNumber != filter->DomainNumber ||
+                    params.BusNumber != filter->BusNumber ||
+                    params.DeviceNumber != filter->DeviceNumber ||
+                    params.FunctionNumber != filter->FunctionNumber;
+
+            case ADAPTER_FILTER_TYPE_DEVICE_ID:
+                return params.DeviceId != filter->DeviceId;
+
+            default:
+                MD_LOG( LOG_WARNING, "Unknown adapter filter type: %u", filter->Type );
+                return false;
+        }
+    }
 } // namespace MetricsDiscoveryInternal
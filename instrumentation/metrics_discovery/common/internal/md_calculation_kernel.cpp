@@ -0,0 +1,956 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_calculation_kernel.cpp
+
+//     Abstract:   C++ Metrics Discovery internal metric set calculation kernel implementation
+
+#include "md_calculation_kernel.h"
+#include "md_adapter.h"
+#include "md_equation.h"
+#include "md_metric.h"
+#include "md_metric_set.h"
+#include "md_metrics_calculator.h"
+#include "md_metrics_device.h"
+#include "md_symbol_set.h"
+
+#include "md_utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     CCalculationKernel constructor
+    //
+    // Description:
+    //     Constructor.
+    //
+    // Input:
+    //     CMetricSet& metricSet - parent metric set
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CCalculationKernel::CCalculationKernel( CMetricSet& metricSet )
+        : m_metricSet( metricSet )
+        , m_metrics()
+        , m_operations()
+        , m_nodes()
+        , m_fields()
+        , m_fieldGroups()
+        , m_nodeIndices()
+        , m_gpuCoreClocksIndex( INDEX_NONE )
+        , m_stackSize( 0 )
+        , m_state( KERNEL_STATE_NOT_BUILT )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     Build
+    //
+    // Description:
+    //     Compiles IO read and normalization equations of the current metric set
+    //     metrics. The kernel is marked as not supported if any equation can't be
+    //     compiled, so the build isn't retried until the kernel is invalidated.
+    //
+    // Input:
+    //     CMetricsCalculator& calculator - metric set calculator, used for constant folding
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CCalculationKernel::Build( CMetricsCalculator& calculator )
+    {
+        const uint32_t adapterId = m_metricSet.GetMetricsDevice().GetAdapter().GetAdapterId();
+
+        Invalidate();
+        m_state = KERNEL_STATE_NOT_SUPPORTED;
+
+        const uint32_t metricsCount = m_metricSet.GetParams()->MetricsCount;
+        m_metrics.reserve( metricsCount );
+
+        for( uint32_t i = 0; i < metricsCount; ++i )
+        {
+            CMetric* metric = m_metricSet.GetMetricExplicit( i );
+            MD_CHECK_PTR_RET_A( adapterId, metric, CC_ERROR_GENERAL );
+
+            const auto&   metricParams = *metric->GetParams();
+            TKernelMetric kernelMetric = {};
+
+            kernelMetric.OperationsOffset = static_cast<uint32_t>( m_operations.size() );
+            kernelMetric.DeltaFunction    = ResolveDeltaFunction( metricParams.DeltaFunction );
+
+            kernelMetric.NodesOffset      = static_cast<uint32_t>( m_nodes.size() );
+            kernelMetric.ResultType       = metricParams.ResultType;
+
+            TCompletionCode ret = CC_OK;
+
+            if( metricParams.IoReadEquation )
+            {
+                ret = BuildReadEquation( static_cast<CEquation&>( *metricParams.IoReadEquation ), kernelMetric );
+            }
+
+            if( ret == CC_OK && metricParams.NormEquation )
+            {
+                ret = BuildNormEquation( static_cast<CEquation&>( *metricParams.NormEquation ), i, kernelMetric, calculator );
+            }
+            else if( ret == CC_OK )
+            {
+                kernelMetric.ResultNode = AddValueNode( KERNEL_NODE_DELTA_VALUE, i );
+            }
+
+            kernelMetric.NodesCount = static_cast<uint32_t>( m_nodes.size() ) - kernelMetric.NodesOffset;
+
+            if( ret != CC_OK )
+            {
+                MD_LOG_A( adapterId, LOG_DEBUG, "Calculation kernel not supported, metric: %s", metricParams.SymbolName );
+
+                Invalidate();
+                m_state = KERNEL_STATE_NOT_SUPPORTED;
+                return ret;
+            }
+
+            if( m_gpuCoreClocksIndex == INDEX_NONE && std::string_view( metricParams.SymbolName ) == "GpuCoreClocks" )
+            {
+                m_gpuCoreClocksIndex = i;
+            }
+
+            m_metrics.push_back( kernelMetric );
+        }
+
+        BuildFields();
+
+        m_nodeIndices.clear();
+        m_state = KERNEL_STATE_VALID;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "Calculation kernel built, metrics: %u, operations: %zu, fields: %zu, nodes: %zu, stack size: %u", metricsCount, m_operations.size(), m_fields.size(), m_nodes.size(), m_stackSize );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     Invalidate
+    //
+    // Description:
+    //     Clears the kernel, it will be built again before the next use.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CCalculationKernel::Invalidate()
+    {
+        m_metrics.clear();
+        m_operations.clear();
+        m_nodes.clear();
+        m_fields.clear();
+        m_fieldGroups.clear();
+        m_nodeIndices.clear();
+        m_gpuCoreClocksIndex = INDEX_NONE;
+        m_stackSize          = 0;
+        m_state              = KERNEL_STATE_NOT_BUILT;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     IsBuilt
+    //
+    // Description:
+    //     Returns true if the kernel was built, successfully or not.
+    //
+    // Output:
+    //     bool - true if the kernel was built
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CCalculationKernel::IsBuilt() const
+    {
+        return m_state != KERNEL_STATE_NOT_BUILT;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     IsValid
+    //
+    // Description:
+    //     Returns true if the kernel can be used for calculations.
+    //
+    // Output:
+    //     bool - true if the kernel is valid
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CCalculationKernel::IsValid() const
+    {
+        return m_state == KERNEL_STATE_VALID;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetMetrics
+    //
+    // Description:
+    //     Returns compiled metrics, one per metric set metric.
+    //
+    // Output:
+    //     const std::vector<TKernelMetric>& - compiled metrics
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    const std::vector<TKernelMetric>& CCalculationKernel::GetMetrics() const
+    {
+        return m_metrics;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetOperations
+    //
+    // Description:
+    //     Returns compiled operations of all metrics.
+    //
+    // Output:
+    //     const std::vector<TKernelOperation>& - compiled operations
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    const std::vector<TKernelOperation>& CCalculationKernel::GetOperations() const
+    {
+        return m_operations;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetNodes
+    //
+    // Description:
+    //     Returns normalization equations DAG nodes. Operands of a node always
+    //     precede it.
+    //
+    // Output:
+    //     const std::vector<TKernelNode>& - DAG nodes
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    const std::vector<TKernelNode>& CCalculationKernel::GetNodes() const
+    {
+        return m_nodes;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetFields
+    //
+    // Description:
+    //     Returns distinct raw report fields read by the metric set, in decoding order.
+    //
+    // Output:
+    //     const std::vector<TKernelField>& - report fields
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    const std::vector<TKernelField>& CCalculationKernel::GetFields() const
+    {
+        return m_fields;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetFieldGroups
+    //
+    // Description:
+    //     Returns report field groups, each of them is decoded by one loop
+    //     specialized for its read type.
+    //
+    // Output:
+    //     const std::vector<TKernelFieldGroup>& - report field groups
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    const std::vector<TKernelFieldGroup>& CCalculationKernel::GetFieldGroups() const
+    {
+        return m_fieldGroups;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetGpuCoreClocksIndex
+    //
+    // Description:
+    //     Returns GpuCoreClocks metric index.
+    //
+    // Output:
+    //     uint32_t - GpuCoreClocks metric index, INDEX_NONE if not present
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::GetGpuCoreClocksIndex() const
+    {
+        return m_gpuCoreClocksIndex;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     GetStackSize
+    //
+    // Description:
+    //     Returns max stack depth needed to calculate any of the read equations.
+    //
+    // Output:
+    //     uint32_t - stack size
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::GetStackSize() const
+    {
+        return m_stackSize;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     BuildReadEquation
+    //
+    // Description:
+    //     Compiles a read equation to kernel operations. Validates the equation
+    //     stack usage, so it doesn't have to be checked during calculations.
+    //
+    // Input:
+    //     CEquation&     equation     - read equation to compile
+    //     TKernelMetric& kernelMetric - (IN/OUT) kernel metric, operations count is updated
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success,
+    //                       *CC_ERROR_NOT_SUPPORTED* if the equation can't be compiled
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CCalculationKernel::BuildReadEquation( CEquation& equation, TKernelMetric& kernelMetric )
+    {
+        auto&    device = m_metricSet.GetMetricsDevice();
+        uint32_t depth  = 0;
+
+        for( const auto& element : equation.GetElementsVector() )
+        {
+            TKernelOperation operation = {};
+
+            operation.ByteOffset    = element.ReadParams.ByteOffset;
+            operation.ByteOffsetExt = element.ReadParams.ByteOffsetExt;
+            operation.BitOffset     = element.ReadParams.BitOffset;
+            operation.BitsCount     = element.ReadParams.BitsCount;
+
+            switch( element.Type )
+            {
+                case EQUATION_ELEM_RD_BITFIELD:
+                    // Invalid bitfields are reported by the interpreter.
+                    if( operation.BitsCount == 0 || operation.BitsCount > 32 || operation.BitOffset + operation.BitsCount > 32 )
+                    {
+                        return CC_ERROR_NOT_SUPPORTED;
+                    }
+
+                    operation.Type = KERNEL_OPERATION_READ_BITFIELD;
+                    break;
+
+                case EQUATION_ELEM_RD_UINT8:
+                    operation.Type = KERNEL_OPERATION_READ_UINT8;
+                    break;
+
+                case EQUATION_ELEM_RD_UINT16:
+                    operation.Type = KERNEL_OPERATION_READ_UINT16;
+                    break;
+
+                case EQUATION_ELEM_RD_UINT32:
+                    operation.Type = KERNEL_OPERATION_READ_UINT32;
+                    break;
+
+                case EQUATION_ELEM_RD_UINT64:
+                    operation.Type = KERNEL_OPERATION_READ_UINT64;
+                    break;
+
+                case EQUATION_ELEM_RD_FLOAT:
+                    operation.Type = KERNEL_OPERATION_READ_FLOAT;
+                    break;
+
+                case EQUATION_ELEM_RD_40BIT_CNTR:
+                    operation.Type = KERNEL_OPERATION_READ_40BIT_CNTR;
+                    break;
+
+                case EQUATION_ELEM_IMM_UINT64:
+                    operation.Type              = KERNEL_OPERATION_IMMEDIATE;
+                    operation.Value.ValueUInt64 = element.ImmediateUInt64;
+                    operation.Value.ValueType   = VALUE_TYPE_UINT64;
+                    break;
+
+                case EQUATION_ELEM_IMM_FLOAT:
+                    operation.Type             = KERNEL_OPERATION_IMMEDIATE;
+                    operation.Value.ValueFloat = element.ImmediateFloat;
+                    operation.Value.ValueType  = VALUE_TYPE_FLOAT;
+                    break;
+
+                case EQUATION_ELEM_GLOBAL_SYMBOL:
+                    if( BuildGlobalSymbol( element.SymbolName, operation ) != CC_OK )
+                    {
+                        return CC_ERROR_NOT_SUPPORTED;
+                    }
+                    break;
+
+                case EQUATION_ELEM_OPERATION:
+                    if( depth < 2 )
+                    {
+                        return CC_ERROR_NOT_SUPPORTED;
+                    }
+
+                    operation.Type      = KERNEL_OPERATION_OPERATION;
+                    operation.Operation = element.Operation;
+                    break;
+
+                case EQUATION_ELEM_LOCAL_COUNTER_SYMBOL:
+                    if( element.SymbolName != nullptr && std::string_view( element.SymbolName ) == "GpuCoreClocks" )
+                    {
+                        operation.Type = KERNEL_OPERATION_GPU_CORE_CLOCKS;
+                        break;
+                    }
+
+                    if( element.SymbolName != nullptr &&
+                        IsPlatformMatch( device.GetPlatformIndex(), GENERATION_ACM, GENERATION_PVC, GENERATION_MTL, GENERATION_ARL ) &&
+                        strstr( element.SymbolName, "GtSlice" ) != nullptr )
+                    {
+                        // Exception for missing global symbols (GtSlice[X]XeCore[Y]) in read equations.
+                        operation.Type              = KERNEL_OPERATION_IMMEDIATE;
+                        operation.Value.ValueUInt64 = 0ULL;
+                        operation.Value.ValueType   = VALUE_TYPE_UINT64;
+                        break;
+                    }
+
+                    return CC_ERROR_NOT_SUPPORTED;
+
+                default:
+                    return CC_ERROR_NOT_SUPPORTED;
+            }
+
+            // Operations pop two values and push the result, other kernel operations push one value.
+            depth       = ( operation.Type == KERNEL_OPERATION_OPERATION ) ? depth - 1 : depth + 1;
+            m_stackSize = ( std::max )( m_stackSize, depth );
+
+            m_operations.push_back( operation );
+        }
+
+        // Only the result should be left on the stack.
+        if( depth != 1 )
+        {
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        kernelMetric.OperationsCount = static_cast<uint32_t>( m_operations.size() ) - kernelMetric.OperationsOffset;
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     BuildFields
+    //
+    // Description:
+    //     Collects distinct report fields of all read operations into the field
+    //     table. Fields are sorted by read type and offset, so each read type is
+    //     a single group decoded in report order. Read operations get indices
+    //     of their fields.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CCalculationKernel::BuildFields()
+    {
+        std::map<TKernelFieldKey, uint32_t> fieldIndices;
+
+        const auto isRead = []( const TKernelOperation& operation )
+        {
+            return operation.Type <= KERNEL_OPERATION_READ_40BIT_CNTR; // Read types go first
+        };
+
+        const auto getKey = []( const TKernelOperation& operation )
+        {
+            // Unused parameters are zeroed, so equal fields have equal keys.
+            const bool isBitfield = operation.Type == KERNEL_OPERATION_READ_BITFIELD;
+            const bool is40Bit    = operation.Type == KERNEL_OPERATION_READ_40BIT_CNTR;
+
+            return TKernelFieldKey(
+                static_cast<uint32_t>( operation.Type ),
+                operation.ByteOffset,
+                is40Bit ? operation.ByteOffsetExt : 0,
+                isBitfield ? operation.BitOffset : 0,
+                isBitfield ? operation.BitsCount : 0 );
+        };
+
+        for( const auto& operation : m_operations )
+        {
+            if( isRead( operation ) )
+            {
+                fieldIndices.emplace( getKey( operation ), 0 );
+            }
+        }
+
+        m_fields.reserve( fieldIndices.size() );
+
+        for( auto& fieldIndex : fieldIndices )
+        {
+            const auto& [type, byteOffset, byteOffsetExt, bitOffset, bitsCount] = fieldIndex.first;
+            const auto operationType = static_cast<TKernelOperationType>( type );
+
+            fieldIndex.second = static_cast<uint32_t>( m_fields.size() );
+
+            if( m_fieldGroups.empty() || m_fieldGroups.back().Type != operationType )
+            {
+                m_fieldGroups.push_back( { operationType, fieldIndex.second, 0 } );
+            }
+
+            m_fields.push_back( { byteOffset, byteOffsetExt, bitOffset, bitsCount } );
+            m_fieldGroups.back().FieldsCount++;
+        }
+
+        for( auto& operation : m_operations )
+        {
+            if( isRead( operation ) )
+            {
+                operation.FieldIndex = fieldIndices[getKey( operation )];
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     BuildGlobalSymbol
+    //
+    // Description:
+    //     Resolves a global symbol to an immediate value. Dynamic symbols have to
+    //     be redetected on each read, so they aren't supported.
+    //
+    // Input:
+    //     const char*       symbolName - global symbol name
+    //     TKernelOperation& operation  - (OUT) immediate kernel operation
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success,
+    //                       *CC_ERROR_NOT_SUPPORTED* for dynamic symbols
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CCalculationKernel::BuildGlobalSymbol( const char* symbolName, TKernelOperation& operation )
+    {
+        TGlobalSymbol* symbol = ( symbolName != nullptr )
+            ? m_metricSet.GetMetricsDevice().GetSymbolSet().GetSymbolByName( symbolName )
+            : nullptr;
+
+        if( symbol != nullptr && symbol->symbolType == SYMBOL_TYPE_DYNAMIC )
+        {
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        operation.Type = KERNEL_OPERATION_IMMEDIATE;
+
+        if( symbol != nullptr )
+        {
+            operation.Value = symbol->symbol.SymbolTypedValue;
+        }
+        else
+        {
+            // Same as in the interpreter, missing symbols are read as 0.
+            operation.Value.ValueUInt64 = 0ULL;
+            operation.Value.ValueType   = VALUE_TYPE_UINT64;
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     ResolveDeltaFunction
+    //
+    // Description:
+    //     As delta is calculated when reading operands, DELTA_NS_TIME works as
+    //     a normal DELTA_32 or DELTA_56 depending on the platform.
+    //
+    // Input:
+    //     const TDeltaFunction_1_0& deltaFunction - metric delta function
+    //
+    // Output:
+    //     TDeltaFunction_1_0 - delta function to use during reading
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TDeltaFunction_1_0 CCalculationKernel::ResolveDeltaFunction( const TDeltaFunction_1_0& deltaFunction )
+    {
+        if( deltaFunction.FunctionType != DELTA_NS_TIME )
+        {
+            return deltaFunction;
+        }
+
+        TDeltaFunction_1_0 readDeltaFunction = {};
+        readDeltaFunction.FunctionType       = DELTA_N_BITS;
+
+        switch( m_metricSet.GetMetricsDevice().GetPlatformIndex() )
+        {
+            case GENERATION_BMG:
+            case GENERATION_LNL:
+            case GENERATION_PTL:
+                readDeltaFunction.BitsCount = 56;
+                break;
+            default:
+                readDeltaFunction.BitsCount = 32;
+                break;
+        }
+
+        return readDeltaFunction;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     BuildNormEquation
+    //
+    // Description:
+    //     Compiles a normalization equation to DAG nodes, gives the same results
+    //     as CalculateLocalNormalizationEquation. Fails if the equation uses
+    //     a normalized value of a metric that isn't calculated yet (the metric
+    //     itself or a following one), as the result would depend on the output
+    //     buffer contents.
+    //
+    // Input:
+    //     CEquation&          equation     - normalization equation to compile
+    //     const uint32_t      metricIndex  - index of the metric
+    //     TKernelMetric&      kernelMetric - (IN/OUT) kernel metric, result node is updated
+    //     CMetricsCalculator& calculator   - metric set calculator, used for constant folding
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success,
+    //                       *CC_ERROR_NOT_SUPPORTED* if the equation can't be compiled
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CCalculationKernel::BuildNormEquation( CEquation& equation, const uint32_t metricIndex, TKernelMetric& kernelMetric, CMetricsCalculator& calculator )
+    {
+        const uint32_t        adapterId = m_metricSet.GetMetricsDevice().GetAdapter().GetAdapterId();
+        TTypedValue_1_0       zero      = {};
+        std::vector<uint32_t> stack;
+
+        zero.ValueType   = VALUE_TYPE_UINT64;
+        zero.ValueUInt64 = 0ULL;
+
+        for( const auto& element : equation.GetElementsVector() )
+        {
+            const int32_t index = element.MetricIndexInternal;
+
+            switch( element.Type )
+            {
+                case EQUATION_ELEM_IMM_UINT64:
+                {
+                    TTypedValue_1_0 value = {};
+                    value.ValueType       = VALUE_TYPE_UINT64;
+                    value.ValueUInt64     = element.ImmediateUInt64;
+                    stack.push_back( AddConstantNode( value ) );
+                    break;
+                }
+
+                case EQUATION_ELEM_IMM_FLOAT:
+                {
+                    TTypedValue_1_0 value = {};
+                    value.ValueType       = VALUE_TYPE_FLOAT;
+                    value.ValueFloat      = element.ImmediateFloat;
+                    stack.push_back( AddConstantNode( value ) );
+                    break;
+                }
+
+                case EQUATION_ELEM_SELF_COUNTER_VALUE:
+                    stack.push_back( AddValueNode( KERNEL_NODE_DELTA_VALUE, metricIndex ) );
+                    break;
+
+                case EQUATION_ELEM_LOCAL_COUNTER_SYMBOL:
+                    stack.push_back( index >= 0 ? AddValueNode( KERNEL_NODE_DELTA_VALUE, index ) : AddConstantNode( zero ) );
+                    break;
+
+                case EQUATION_ELEM_LOCAL_METRIC_SYMBOL:
+                    if( index >= static_cast<int32_t>( metricIndex ) )
+                    {
+                        MD_LOG_A( adapterId, LOG_DEBUG, "Normalization equation uses metric not calculated yet: %s", element.SymbolName );
+                        return CC_ERROR_NOT_SUPPORTED;
+                    }
+
+                    stack.push_back( index >= 0 ? AddValueNode( KERNEL_NODE_METRIC_VALUE, index ) : AddConstantNode( zero ) );
+                    break;
+
+                case EQUATION_ELEM_PREV_METRIC_SYMBOL:
+                    stack.push_back( index >= 0 ? AddValueNode( KERNEL_NODE_PREV_METRIC_VALUE, index ) : AddConstantNode( zero ) );
+                    break;
+
+                case EQUATION_ELEM_GLOBAL_SYMBOL:
+                    stack.push_back( AddGlobalSymbolNode( element.SymbolName ) );
+                    break;
+
+                case EQUATION_ELEM_OPERATION:
+                {
+                    if( stack.size() < 2 )
+                    {
+                        return CC_ERROR_NOT_SUPPORTED;
+                    }
+
+                    const uint32_t right = stack.back();
+                    stack.pop_back();
+                    const uint32_t left = stack.back();
+                    stack.pop_back();
+
+                    stack.push_back( AddOperationNode( element.Operation, left, right, calculator ) );
+                    break;
+                }
+
+                case EQUATION_ELEM_STD_NORM_GPU_DURATION:
+                case EQUATION_ELEM_STD_NORM_EU_AGGR_DURATION:
+                    // Standard normalizations are the whole equation.
+                    kernelMetric.ResultNode = AddValueNode(
+                        ( element.Type == EQUATION_ELEM_STD_NORM_GPU_DURATION ) ? KERNEL_NODE_STD_NORM_GPU_DURATION : KERNEL_NODE_STD_NORM_EU_AGGR_DURATION,
+                        metricIndex );
+                    return CC_OK;
+
+                default:
+                    // Reads and other elements are ignored, as in the interpreter.
+                    break;
+            }
+        }
+
+        // Only the result should be left on the stack, otherwise the result is 0.
+        kernelMetric.ResultNode = ( stack.size() == 1 ) ? stack.back() : AddConstantNode( zero );
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     AddNode
+    //
+    // Description:
+    //     Adds a DAG node or returns an equal node added before.
+    //
+    // Input:
+    //     const TKernelNode& node - node to add
+    //
+    // Output:
+    //     uint32_t - node index
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::AddNode( const TKernelNode& node )
+    {
+        const TKernelNodeKey key(
+            node.Type,
+            ( node.Type == KERNEL_NODE_CONSTANT ) ? static_cast<uint32_t>( node.Value.ValueType ) : static_cast<uint32_t>( node.Operation ),
+            node.Left,
+            node.Right,
+            node.MetricIndex,
+            node.Value.ValueUInt64,
+            ( node.SymbolName != nullptr ) ? std::string_view( node.SymbolName ) : std::string_view() );
+
+        const auto found = m_nodeIndices.find( key );
+        if( found != m_nodeIndices.end() )
+        {
+            return found->second;
+        }
+
+        const uint32_t index = static_cast<uint32_t>( m_nodes.size() );
+
+        m_nodes.push_back( node );
+        m_nodeIndices.emplace( key, index );
+
+        return index;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     AddConstantNode
+    //
+    // Description:
+    //     Adds a constant DAG node.
+    //
+    // Input:
+    //     const TTypedValue_1_0& value - constant value
+    //
+    // Output:
+    //     uint32_t - node index
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::AddConstantNode( const TTypedValue_1_0& value )
+    {
+        TKernelNode node = {};
+
+        node.Type  = KERNEL_NODE_CONSTANT;
+        node.Value = value;
+
+        return AddNode( node );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     AddValueNode
+    //
+    // Description:
+    //     Adds a DAG node reading a value of a metric.
+    //
+    // Input:
+    //     const TKernelNodeType type        - metric value node type
+    //     const uint32_t        metricIndex - metric index
+    //
+    // Output:
+    //     uint32_t - node index
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::AddValueNode( const TKernelNodeType type, const uint32_t metricIndex )
+    {
+        TKernelNode node = {};
+
+        node.Type        = type;
+        node.MetricIndex = metricIndex;
+
+        return AddNode( node );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     AddGlobalSymbolNode
+    //
+    // Description:
+    //     Adds a DAG node for a global symbol. Static symbols are constants,
+    //     dynamic ones are redetected once per report.
+    //
+    // Input:
+    //     const char* symbolName - global symbol name
+    //
+    // Output:
+    //     uint32_t - node index
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::AddGlobalSymbolNode( const char* symbolName )
+    {
+        TKernelOperation operation = {};
+
+        if( BuildGlobalSymbol( symbolName, operation ) == CC_OK )
+        {
+            return AddConstantNode( operation.Value );
+        }
+
+        TKernelNode node = {};
+
+        node.Type       = KERNEL_NODE_GLOBAL_SYMBOL;
+        node.SymbolName = symbolName;
+
+        return AddNode( node );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CCalculationKernel
+    //
+    // Method:
+    //     AddOperationNode
+    //
+    // Description:
+    //     Adds an operation DAG node. Operations on constants are calculated
+    //     right away.
+    //
+    // Input:
+    //     const TEquationOperation operation  - operation
+    //     const uint32_t           left       - left operand node
+    //     const uint32_t           right      - right operand node
+    //     CMetricsCalculator&      calculator - metric set calculator
+    //
+    // Output:
+    //     uint32_t - node index
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CCalculationKernel::AddOperationNode( const TEquationOperation operation, const uint32_t left, const uint32_t right, CMetricsCalculator& calculator )
+    {
+        if( m_nodes[left].Type == KERNEL_NODE_CONSTANT && m_nodes[right].Type == KERNEL_NODE_CONSTANT )
+        {
+            return AddConstantNode( calculator.CalculateEquationElemOperation( operation, m_nodes[left].Value, m_nodes[right].Value ) );
+        }
+
+        TKernelNode node = {};
+
+        node.Type      = KERNEL_NODE_OPERATION;
+        node.Operation = operation;
+        node.Left      = left;
+        node.Right     = right;
+
+        return AddNode( node );
+    }
+} // namespace MetricsDiscoveryInternal
@@ -87,6 +87,10 @@ namespace MetricsDiscovery
     {
         return nullptr;
     }
+    IConcurrentGroup_1_15* IMetricsDevice_1_15::GetConcurrentGroup( [[maybe_unused]] uint32_t index )
+    {
+        return nullptr;
+    }
 
     // Override interface.
     IOverride_1_2::~IOverride_1_2()
@@ -177,6 +181,46 @@ namespace MetricsDiscovery
     {
         return CC_ERROR_NOT_SUPPORTED;
     }
+    IMetricSet_1_15* IConcurrentGroup_1_15::GetMetricSet( [[maybe_unused]] uint32_t index )
+    {
+        return nullptr;
+    }
+    TCompletionCode IConcurrentGroup_1_15::ReadAndCalculate( [[maybe_unused]] uint32_t milliseconds, [[maybe_unused]] uint32_t readFlags, [[maybe_unused]] uint32_t* reportCount, [[maybe_unused]] TTypedValue_1_0* out, [[maybe_unused]] uint32_t outSize, [[maybe_unused]] const TOutputColumn_1_15* columns, [[maybe_unused]] uint32_t columnsCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::GetIoStreamHandle( [[maybe_unused]] int64_t* handle )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::SetReportsCallback( [[maybe_unused]] TReportsCallback_1_15 callback, [[maybe_unused]] void* userData )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::ProcessReports( [[maybe_unused]] uint32_t readFlags, [[maybe_unused]] uint32_t* reportCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::SetIoStreamWakeup( [[maybe_unused]] TIoStreamWakeupMode mode, [[maybe_unused]] uint32_t reportCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::SetIoStreamContext( [[maybe_unused]] int64_t drmHandle, [[maybe_unused]] uint32_t contextId )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::SetFlightRecorder( [[maybe_unused]] const TFlightRecorderParams_1_15* params )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::DumpFlightRecorder( void )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IConcurrentGroup_1_15::SetLockTimeout( [[maybe_unused]] uint32_t milliseconds )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
 
     // Metric Set interface.
     IMetricSet_1_0::~IMetricSet_1_0()
@@ -274,6 +318,33 @@ namespace MetricsDiscovery
     {
         return nullptr;
     }
+    IMetricSet_1_15::~IMetricSet_1_15()
+    {
+    }
+    TCompletionCode IMetricSet_1_15::SetContextFilter( [[maybe_unused]] const uint32_t* contextIds, [[maybe_unused]] uint32_t contextIdsCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IMetricSet_1_15::SetReportReasonFilter( [[maybe_unused]] uint32_t reportReasonMask )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IMetricSet_1_15::CalculateQueryPool( [[maybe_unused]] const uint8_t* rawData, [[maybe_unused]] uint32_t rawDataSize, [[maybe_unused]] const uint32_t* metricIndices, [[maybe_unused]] uint32_t metricIndicesCount, [[maybe_unused]] bool sumReports, [[maybe_unused]] TTypedValue_1_0* out, [[maybe_unused]] uint32_t outSize, [[maybe_unused]] uint32_t* outReportCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IMetricSet_1_15::CalculateMetricsToColumns( [[maybe_unused]] const uint8_t* rawData, [[maybe_unused]] uint32_t rawDataSize, [[maybe_unused]] const TOutputColumn_1_15* columns, [[maybe_unused]] uint32_t columnsCount, [[maybe_unused]] uint32_t maxReportCount, [[maybe_unused]] uint32_t* outReportCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IMetricSet_1_15::SetQuantileSketches( [[maybe_unused]] const uint32_t* metricIndices, [[maybe_unused]] uint32_t metricIndicesCount, [[maybe_unused]] double relativeAccuracy, [[maybe_unused]] uint32_t maxBucketsCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    IQuantileSketch_1_15* IMetricSet_1_15::GetQuantileSketch( [[maybe_unused]] uint32_t metricIndex )
+    {
+        return nullptr;
+    }
 
     // Metric interface.
     IMetric_1_0::~IMetric_1_0()
@@ -410,6 +481,18 @@ namespace MetricsDiscovery
     {
         return CC_ERROR_NOT_SUPPORTED;
     }
+    IAdapter_1_15* IAdapterGroup_1_15::GetAdapter( [[maybe_unused]] uint32_t index )
+    {
+        return nullptr;
+    }
+    TCompletionCode IAdapterGroup_1_15::CreateQuantileSketch( [[maybe_unused]] double relativeAccuracy, [[maybe_unused]] uint32_t maxBucketsCount, [[maybe_unused]] IQuantileSketch_1_15** sketch )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapterGroup_1_15::DestroyQuantileSketch( [[maybe_unused]] IQuantileSketch_1_15* sketch )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
 
     // Adapter interface.
     IAdapter_1_6::~IAdapter_1_6()
@@ -519,4 +602,102 @@ namespace MetricsDiscovery
     {
         return nullptr;
     }
+    TCompletionCode IAdapter_1_15::OpenMetricsDevice( [[maybe_unused]] IMetricsDevice_1_15** metricsDevice )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::OpenMetricsDeviceFromFile( [[maybe_unused]] const char* fileName, [[maybe_unused]] void* openParams, [[maybe_unused]] IMetricsDevice_1_15** metricsDevice )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::OpenMetricsSubDevice( [[maybe_unused]] const uint32_t subDeviceIndex, [[maybe_unused]] IMetricsDevice_1_15** metricsDevice )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::OpenMetricsSubDeviceFromFile( [[maybe_unused]] const uint32_t subDeviceIndex, [[maybe_unused]] const char* fileName, [[maybe_unused]] void* openParams, [[maybe_unused]] IMetricsDevice_1_15** metricsDevice )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::OpenMetricsSubDevices( [[maybe_unused]] IMetricsDevice_1_15** metricsDevices, [[maybe_unused]] uint32_t* metricsDevicesCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::OpenMultiTileIoStream( [[maybe_unused]] const char* concurrentGroupName, [[maybe_unused]] const char* metricSetName, [[maybe_unused]] uint32_t* nsTimerPeriod, [[maybe_unused]] uint32_t* oaBufferSize, [[maybe_unused]] IMultiTileIoStream_1_15** ioStream )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::CloseMultiTileIoStream( [[maybe_unused]] IMultiTileIoStream_1_15* ioStream )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IAdapter_1_15::SetMultiTileIoStreamWakeup( [[maybe_unused]] TIoStreamWakeupMode mode, [[maybe_unused]] uint32_t reportCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+
+    // Multi tile IO stream interface.
+    IMultiTileIoStream_1_15::~IMultiTileIoStream_1_15()
+    {
+    }
+    TMultiTileIoStreamParams_1_15* IMultiTileIoStream_1_15::GetParams( void )
+    {
+        return nullptr;
+    }
+    IMetricsDevice_1_15* IMultiTileIoStream_1_15::GetTileMetricsDevice( [[maybe_unused]] uint32_t tileIndex )
+    {
+        return nullptr;
+    }
+    IMetricSet_1_15* IMultiTileIoStream_1_15::GetTileMetricSet( [[maybe_unused]] uint32_t tileIndex )
+    {
+        return nullptr;
+    }
+    TCompletionCode IMultiTileIoStream_1_15::ReadIoStream( [[maybe_unused]] uint32_t* reportsCount, [[maybe_unused]] char* reportData, [[maybe_unused]] uint32_t* tileIndices, [[maybe_unused]] uint32_t readFlags )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IMultiTileIoStream_1_15::WaitForReports( [[maybe_unused]] uint32_t milliseconds )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TTileAggregationType IMultiTileIoStream_1_15::GetAggregationType( [[maybe_unused]] uint32_t index )
+    {
+        return TILE_AGGREGATION_TYPE_LAST;
+    }
+    TCompletionCode IMultiTileIoStream_1_15::CalculateCardMetrics( [[maybe_unused]] const char* reportData, [[maybe_unused]] uint32_t reportsCount, [[maybe_unused]] const uint32_t* tileIndices, [[maybe_unused]] TTypedValue_1_0* out, [[maybe_unused]] uint32_t outSize, [[maybe_unused]] uint32_t* outReportCount )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+
+    // Quantile sketch interface.
+    IQuantileSketch_1_15::~IQuantileSketch_1_15()
+    {
+    }
+    TQuantileSketchParams_1_15* IQuantileSketch_1_15::GetParams( void )
+    {
+        return nullptr;
+    }
+    TCompletionCode IQuantileSketch_1_15::Add( [[maybe_unused]] double value )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IQuantileSketch_1_15::GetQuantile( [[maybe_unused]] double quantile, [[maybe_unused]] double* value )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IQuantileSketch_1_15::Merge( [[maybe_unused]] IQuantileSketch_1_15* sketch )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IQuantileSketch_1_15::MergeFromBuffer( [[maybe_unused]] const uint8_t* buffer, [[maybe_unused]] uint32_t bufferSize )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IQuantileSketch_1_15::WriteToBuffer( [[maybe_unused]] uint8_t* buffer, [[maybe_unused]] uint32_t* bufferSize )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
+    TCompletionCode IQuantileSketch_1_15::Reset( void )
+    {
+        return CC_ERROR_NOT_SUPPORTED;
+    }
 } // namespace MetricsDiscovery
@@ -331,6 +331,10 @@ namespace MetricsDiscoveryInternal
         : m_elementsVector()
         , m_equationString( nullptr )
         , m_device( device )
+        , m_referenceCount( 0 )
+        , m_booleanResult( false )
+        , m_isBooleanResultValid( false )
+        , m_booleanResultGeneration( 0 )
     {
     }
 
@@ -350,6 +354,10 @@ namespace MetricsDiscoveryInternal
         : m_elementsVector( other.m_elementsVector )
         , m_equationString( GetCopiedCString( other.m_equationString, other.m_device.GetAdapter().GetAdapterId() ) )
         , m_device( other.m_device )
+        , m_referenceCount( 0 ) // The copy isn't shared
+        , m_booleanResult( false )
+        , m_isBooleanResultValid( false )
+        , m_booleanResultGeneration( 0 )
     {
     }
 
@@ -425,13 +433,54 @@ namespace MetricsDiscoveryInternal
     //     SolveBooleanEquation
     //
     // Description:
-    //     Used only for availability equations.
+    //     Used only for availability equations. The result is memoized for
+    //     the current symbol set generation, so an equation shared by many
+    //     metrics, information and metric sets is solved once per device.
+    //     Results depending on dynamic symbols aren't memoized.
     //
     // Output:
     //     bool    -   result of the solved boolean equation
     //
     //////////////////////////////////////////////////////////////////////////////
     bool CEquation::SolveBooleanEquation( void )
+    {
+        const uint32_t generation = m_device.GetSymbolSet().GetGeneration();
+
+        if( m_isBooleanResultValid && m_booleanResultGeneration == generation )
+        {
+            return m_booleanResult;
+        }
+
+        bool       isMemoizable = true;
+        const bool result       = SolveBooleanEquationElements( isMemoizable );
+
+        m_booleanResult           = result;
+        m_isBooleanResultValid    = isMemoizable;
+        m_booleanResultGeneration = generation;
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquation
+    //
+    // Method:
+    //     SolveBooleanEquationElements
+    //
+    // Description:
+    //     Solves the availability equation elements.
+    //
+    // Input:
+    //     bool& isMemoizable - (OUT) set to false if the result depends on
+    //                          a dynamic symbol
+    //
+    // Output:
+    //     bool               - result of the solved boolean equation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CEquation::SolveBooleanEquationElements( bool& isMemoizable )
     {
         const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
 
@@ -480,6 +529,15 @@ namespace MetricsDiscoveryInternal
 
                 case EQUATION_ELEM_GLOBAL_SYMBOL:
                 {
+                    const auto symbol = ( element.SymbolName != nullptr )
+                        ? m_device.GetSymbolSet().GetSymbolByName( element.SymbolName )
+                        : nullptr;
+
+                    if( symbol != nullptr && symbol->symbolType == SYMBOL_TYPE_DYNAMIC )
+                    {
+                        isMemoizable = false;
+                    }
+
                     if( const auto pValue = m_device.GetGlobalSymbolValueByName( element.SymbolName );
                         pValue )
                     {
@@ -1068,4 +1126,267 @@ namespace MetricsDiscoveryInternal
 
         return false;
     }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     CEquationCache constructor
+    //
+    // Description:
+    //     Constructor.
+    //
+    // Input:
+    //     CMetricsDevice& device - parent metric device
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CEquationCache::CEquationCache( CMetricsDevice& device )
+        : m_device( device )
+        , m_equations()
+        , m_mutex()
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     CEquationCache destructor
+    //
+    // Description:
+    //     Deletes shared equations that are still referenced.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CEquationCache::~CEquationCache()
+    {
+        for( auto& equation : m_equations )
+        {
+            MD_SAFE_DELETE( equation.second );
+        }
+
+        m_equations.clear();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     GetEquation
+    //
+    // Description:
+    //     Returns an equation for the given equation string. Reuses an equal shared
+    //     equation if available, otherwise parses the equation string.
+    //
+    // Input:
+    //     const char* equationString - equation string, can't be empty
+    //     CEquation*& equation       - (OUT) equation, has to be released with ReleaseEquation
+    //
+    // Output:
+    //     TCompletionCode            - result of the operation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CEquationCache::GetEquation( const char* equationString, CEquation*& equation )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        MD_CHECK_PTR_RET_A( adapterId, equationString, CC_ERROR_INVALID_PARAMETER );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        const auto found = m_equations.find( equationString );
+        if( found != m_equations.end() )
+        {
+            equation = found->second;
+            equation->m_referenceCount++;
+            return CC_OK;
+        }
+
+        equation = new( std::nothrow ) CEquation( m_device );
+        MD_CHECK_PTR_RET_A( adapterId, equation, CC_ERROR_NO_MEMORY );
+
+        if( !equation->ParseEquationString( equationString ) )
+        {
+            MD_SAFE_DELETE( equation );
+            return CC_ERROR_GENERAL;
+        }
+
+        if( IsShareable( *equation ) )
+        {
+            // Key points to the equation's own copy of the string.
+            equation->m_referenceCount = 1;
+            m_equations.emplace( equation->m_equationString, equation );
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     CopyEquation
+    //
+    // Description:
+    //     Returns a copy of the equation. Shared equations are referenced again
+    //     instead of being copied.
+    //
+    // Input:
+    //     CEquation* equation - equation to copy, can be null
+    //
+    // Output:
+    //     CEquation*          - equation copy, has to be released with ReleaseEquation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CEquation* CEquationCache::CopyEquation( CEquation* equation )
+    {
+        if( equation == nullptr )
+        {
+            return nullptr;
+        }
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        if( equation->m_referenceCount == 0 )
+        {
+            lock.unlock();
+            return new( std::nothrow ) CEquation( *equation );
+        }
+
+        equation->m_referenceCount++;
+        return equation;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     MakeEquationUnique
+    //
+    // Description:
+    //     Replaces a shared equation with its own copy, so it can be changed.
+    //
+    // Input:
+    //     CEquation*& equation - (IN/OUT) equation
+    //
+    // Output:
+    //     TCompletionCode      - result of the operation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CEquationCache::MakeEquationUnique( CEquation*& equation )
+    {
+        if( equation == nullptr )
+        {
+            return CC_OK;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( equation->m_referenceCount == 0 )
+            {
+                return CC_OK;
+            }
+        }
+
+        CEquation* copy = new( std::nothrow ) CEquation( *equation );
+        MD_CHECK_PTR_RET_A( m_device.GetAdapter().GetAdapterId(), copy, CC_ERROR_NO_MEMORY );
+
+        ReleaseEquation( equation );
+        equation = copy;
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     ReleaseEquation
+    //
+    // Description:
+    //     Releases an equation. Shared equations are deleted when the last
+    //     reference is released.
+    //
+    // Input:
+    //     CEquation*& equation - (IN/OUT) equation to release, set to null
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CEquationCache::ReleaseEquation( CEquation*& equation )
+    {
+        if( equation == nullptr )
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( equation->m_referenceCount == 0 )
+        {
+            MD_SAFE_DELETE( equation );
+            return;
+        }
+
+        if( --equation->m_referenceCount == 0 )
+        {
+            m_equations.erase( equation->m_equationString );
+            MD_SAFE_DELETE( equation );
+        }
+
+        equation = nullptr;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CEquationCache
+    //
+    // Method:
+    //     IsShareable
+    //
+    // Description:
+    //     Checks if the equation can be shared. Metric indices of local symbols
+    //     are set per metric set, so equations using them can't be shared.
+    //
+    // Input:
+    //     CEquation& equation - parsed equation
+    //
+    // Output:
+    //     bool                - true if the equation can be shared
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CEquationCache::IsShareable( CEquation& equation )
+    {
+        if( equation.m_equationString == nullptr )
+        {
+            return false;
+        }
+
+        for( const auto& element : equation.GetElementsVector() )
+        {
+            switch( element.Type )
+            {
+                case EQUATION_ELEM_LOCAL_COUNTER_SYMBOL:
+                case EQUATION_ELEM_LOCAL_METRIC_SYMBOL:
+                case EQUATION_ELEM_PREV_METRIC_SYMBOL:
+                    return false;
+
+                default:
+                    break;
+            }
+        }
+
+        return true;
+    }
 } // namespace MetricsDiscoveryInternal
@@ -0,0 +1,708 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_flight_recorder.cpp
+
+//     Abstract:   C++ Metrics Discovery internal io stream flight recorder implementation
+
+#include "md_flight_recorder.h"
+#include "md_adapter.h"
+#include "md_metrics_device.h"
+#include "md_metric_set.h"
+
+#include "md_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     CFlightRecorder constructor
+    //
+    // Description:
+    //     Constructor. Recorder is disabled until SetParams.
+    //
+    // Input:
+    //     CMetricsDevice& device - parent metrics device
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CFlightRecorder::CFlightRecorder( CMetricsDevice& device )
+        : m_device( device )
+        , m_isEnabled( false )
+        , m_durationMs( 0 )
+        , m_maxCaptureCount( 0 )
+        , m_captureFilePath()
+        , m_triggers()
+        , m_deviceBuffer()
+        , m_ring()
+        , m_rawReportSize( 0 )
+        , m_nsTimerPeriod( 0 )
+        , m_timestampIndex( 0 )
+        , m_ringCapacity( 0 )
+        , m_ringHead( 0 )
+        , m_ringCount( 0 )
+        , m_captureCount( 0 )
+        , m_triggeredCaptureCount( 0 )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     CFlightRecorder destructor
+    //
+    // Description:
+    //     Deallocates memory.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CFlightRecorder::~CFlightRecorder()
+    {
+        Stop();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     SetParams
+    //
+    // Description:
+    //     Copies recorder parameters, applied by the next Start. Recorder is
+    //     disabled if nullptr is given. Triggers are validated against the
+    //     metric set in Start.
+    //
+    // Input:
+    //     const TFlightRecorderParams_1_15* params - recorder parameters, may be nullptr
+    //
+    // Output:
+    //     TCompletionCode                          - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CFlightRecorder::SetParams( const TFlightRecorderParams_1_15* params )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( params == nullptr )
+        {
+            m_isEnabled = false;
+            m_triggers.clear();
+            m_captureFilePath.clear();
+            MD_LOG_A( adapterId, LOG_DEBUG, "Flight recorder disabled" );
+            return CC_OK;
+        }
+
+        MD_CHECK_PTR_RET_A( adapterId, params->CaptureFilePath, CC_ERROR_INVALID_PARAMETER );
+
+        if( params->DurationMs == 0 || params->CaptureFilePath[0] == '\0' )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid flight recorder duration: %u ms or capture file path", params->DurationMs );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( params->TriggersCount != 0 && params->Triggers == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder triggers not given, count: %u", params->TriggersCount );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        std::vector<TTrigger> triggers( params->TriggersCount, TTrigger{} );
+        for( uint32_t i = 0; i < params->TriggersCount; ++i )
+        {
+            const auto& trigger = params->Triggers[i];
+
+            if( trigger.Type >= FLIGHT_RECORDER_TRIGGER_TYPE_LAST )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: invalid flight recorder trigger type: %u, trigger: %u", trigger.Type, i );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+            if( trigger.Type == FLIGHT_RECORDER_TRIGGER_TYPE_RATE && !( trigger.Threshold > 0.0 ) )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: invalid flight recorder rate threshold, trigger: %u", i );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+
+            triggers[i].Params = trigger;
+        }
+
+        m_isEnabled             = true;
+        m_durationMs            = params->DurationMs;
+        m_maxCaptureCount       = params->MaxCaptureCount;
+        m_captureFilePath       = params->CaptureFilePath;
+        m_triggers              = std::move( triggers );
+        m_captureCount          = 0;
+        m_triggeredCaptureCount = 0;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "Flight recorder duration: %u ms, triggers: %u, capture file path: %s", m_durationMs, params->TriggersCount, m_captureFilePath.c_str() );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     IsEnabled
+    //
+    // Description:
+    //     Returns true if recorder parameters are set.
+    //
+    // Output:
+    //     bool - true if enabled
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CFlightRecorder::IsEnabled() const
+    {
+        return m_isEnabled;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     IsStarted
+    //
+    // Description:
+    //     Returns true if the ring is allocated, i.e. between Start and Stop.
+    //
+    // Output:
+    //     bool - true if started
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CFlightRecorder::IsStarted() const
+    {
+        return m_ringCapacity != 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     Start
+    //
+    // Description:
+    //     Validates triggers against the metric set with API filtering applied,
+    //     writes the device description and allocates the ring for the recorder
+    //     duration at the given sampling period. Watermark triggers need metrics
+    //     with USAGE_FLAG_INDICATE, rate triggers need QueryBeginTime information.
+    //
+    // Input:
+    //     CMetricSet&    metricSet     - metric set of the opened io stream
+    //     const uint32_t nsTimerPeriod - sampling period of the opened io stream
+    //
+    // Output:
+    //     TCompletionCode              - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CFlightRecorder::Start( CMetricSet& metricSet, const uint32_t nsTimerPeriod )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( !m_isEnabled )
+        {
+            return CC_OK;
+        }
+
+        const TMetricSetParamsLatest* params = metricSet.GetParams();
+        if( params->RawReportSize == 0 || nsTimerPeriod == 0 )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder needs periodic raw reports, raw report size: %u, period: %u ns", params->RawReportSize, nsTimerPeriod );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        // Rate triggers divide value changes by gpu timestamp deltas, reports
+        // aren't exactly a sampling period apart.
+        uint32_t timestampIndex = params->MetricsCount + params->InformationCount;
+        for( uint32_t i = 0; i < params->InformationCount; ++i )
+        {
+            if( strcmp( metricSet.GetInformation( i )->GetParams()->SymbolName, "QueryBeginTime" ) == 0 )
+            {
+                timestampIndex = params->MetricsCount + i;
+                break;
+            }
+        }
+
+        for( uint32_t i = 0; i < m_triggers.size(); ++i )
+        {
+            auto&          trigger = m_triggers[i];
+            IMetricLatest* metric  = metricSet.GetMetric( trigger.Params.MetricIndex );
+            if( metric == nullptr )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: invalid flight recorder trigger metric: %u, trigger: %u", trigger.Params.MetricIndex, i );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+
+            // Watermarks are signed, stored as unsigned in metric params.
+            const TMetricParamsLatest* metricParams = metric->GetParams();
+            switch( trigger.Params.Type )
+            {
+                case FLIGHT_RECORDER_TRIGGER_TYPE_HIGH_WATERMARK:
+                    trigger.Watermark = static_cast<double>( static_cast<int64_t>( metricParams->HighWatermark ) );
+                    break;
+                case FLIGHT_RECORDER_TRIGGER_TYPE_LOW_WATERMARK:
+                    trigger.Watermark = static_cast<double>( static_cast<int64_t>( metricParams->LowWatermark ) );
+                    break;
+                default:
+                    break;
+            }
+            if( trigger.Params.Type != FLIGHT_RECORDER_TRIGGER_TYPE_RATE && !( metricParams->UsageFlagsMask & USAGE_FLAG_INDICATE ) )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder trigger metric %s has no watermarks, trigger: %u", metricParams->SymbolName, i );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+            if( trigger.Params.Type == FLIGHT_RECORDER_TRIGGER_TYPE_RATE && timestampIndex == params->MetricsCount + params->InformationCount )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder rate trigger needs QueryBeginTime information, trigger: %u", i );
+                return CC_ERROR_NOT_SUPPORTED;
+            }
+
+            trigger.HasPreviousValue = false;
+            trigger.IsMet            = false;
+        }
+
+        const uint64_t ringCapacity = ( static_cast<uint64_t>( m_durationMs ) * 1000000 + nsTimerPeriod - 1 ) / nsTimerPeriod;
+        const uint64_t ringSize     = ringCapacity * params->RawReportSize;
+        if( ringSize > UINT32_MAX )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder ring too big, duration: %u ms, period: %u ns", m_durationMs, nsTimerPeriod );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        // Device description is written once, so captures cost only file writes.
+        IMetricSet_1_13* metricSets[] = { &metricSet };
+        uint32_t         bufferSize   = 0;
+
+        TCompletionCode ret = m_device.WriteToBuffer( nullptr, bufferSize, metricSets, 1, MD_API_MAJOR_NUMBER_1, MD_API_MINOR_NUMBER_14 );
+        MD_CHECK_CC_RET_A( adapterId, ret );
+
+        m_deviceBuffer.resize( bufferSize );
+
+        ret = m_device.WriteToBuffer( m_deviceBuffer.data(), bufferSize, metricSets, 1, MD_API_MAJOR_NUMBER_1, MD_API_MINOR_NUMBER_14 );
+        if( ret != CC_OK )
+        {
+            Stop();
+            return ret;
+        }
+
+        m_ring.resize( static_cast<size_t>( ringSize ) );
+        m_rawReportSize = params->RawReportSize;
+        m_nsTimerPeriod  = nsTimerPeriod;
+        m_timestampIndex = timestampIndex;
+        m_ringCapacity   = static_cast<uint32_t>( ringCapacity );
+        m_ringHead       = 0;
+        m_ringCount      = 0;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "Flight recorder started, ring: %u reports, %u bytes", m_ringCapacity, static_cast<uint32_t>( ringSize ) );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     Stop
+    //
+    // Description:
+    //     Releases the ring and the device description. Parameters are kept.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CFlightRecorder::Stop()
+    {
+        m_ring.clear();
+        m_ring.shrink_to_fit();
+        m_deviceBuffer.clear();
+        m_deviceBuffer.shrink_to_fit();
+
+        m_ringCapacity = 0;
+        m_ringHead     = 0;
+        m_ringCount    = 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     Record
+    //
+    // Description:
+    //     Copies raw reports to the ring, overwriting the oldest ones. Only
+    //     the last ring capacity reports are copied from bigger batches.
+    //
+    // Input:
+    //     const char*    reportData  - raw reports
+    //     const uint32_t reportCount - raw reports count
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CFlightRecorder::Record( const char* reportData, const uint32_t reportCount )
+    {
+        if( !IsStarted() || reportCount == 0 )
+        {
+            return;
+        }
+
+        const uint32_t count = std::min( reportCount, m_ringCapacity );
+        const char*    data  = reportData + static_cast<size_t>( reportCount - count ) * m_rawReportSize;
+
+        const uint32_t firstCount = std::min( count, m_ringCapacity - m_ringHead );
+        memcpy( m_ring.data() + static_cast<size_t>( m_ringHead ) * m_rawReportSize, data, static_cast<size_t>( firstCount ) * m_rawReportSize );
+        memcpy( m_ring.data(), data + static_cast<size_t>( firstCount ) * m_rawReportSize, static_cast<size_t>( count - firstCount ) * m_rawReportSize );
+
+        m_ringHead  = ( m_ringHead + count ) % m_ringCapacity;
+        m_ringCount = std::min( m_ringCount + count, m_ringCapacity );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     EvaluateTriggers
+    //
+    // Description:
+    //     Evaluates triggers on each calculated report of a batch and writes
+    //     a single capture if any of them fired, after the whole batch, so the
+    //     capture includes it. Triggers are disarmed once MaxCaptureCount
+    //     triggered captures are written. Rate triggers are skipped if gpu
+    //     timestamps aren't available.
+    //
+    // Input:
+    //     const uint32_t reportCount - calculated reports count
+    //     ValueGetter    getValue    - gets value of a metric or information in a report, returns false if not available
+    //
+    // Output:
+    //     TCompletionCode            - result of the capture if a trigger fired, *CC_OK* otherwise
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    template <typename ValueGetter>
+    TCompletionCode CFlightRecorder::EvaluateTriggers( const uint32_t reportCount, ValueGetter getValue )
+    {
+        if( !IsStarted() || m_triggers.empty() )
+        {
+            return CC_OK;
+        }
+        if( m_maxCaptureCount != 0 && m_triggeredCaptureCount >= m_maxCaptureCount )
+        {
+            return CC_OK;
+        }
+
+        uint32_t firedIndex = FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER;
+        double   firedValue = 0.0;
+
+        for( uint32_t i = 0; i < m_triggers.size(); ++i )
+        {
+            auto& trigger = m_triggers[i];
+
+            for( uint32_t j = 0; j < reportCount; ++j )
+            {
+                double value     = 0.0;
+                double timestamp = 0.0;
+                if( !getValue( trigger.Params.MetricIndex, j, value ) )
+                {
+                    break;
+                }
+                if( trigger.Params.Type == FLIGHT_RECORDER_TRIGGER_TYPE_RATE && !getValue( m_timestampIndex, j, timestamp ) )
+                {
+                    break;
+                }
+
+                double triggerValue = 0.0;
+                if( IsTriggerMet( trigger, value, timestamp, triggerValue ) && firedIndex == FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER )
+                {
+                    firedIndex = i;
+                    firedValue = triggerValue;
+                }
+            }
+        }
+
+        if( firedIndex == FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER )
+        {
+            return CC_OK;
+        }
+
+        ++m_triggeredCaptureCount;
+        return Dump( firedIndex, firedValue );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     EvaluateTriggers
+    //
+    // Description:
+    //     Evaluates triggers on reports calculated by CalculateMetrics.
+    //
+    // Input:
+    //     const TTypedValue_1_0* reports     - calculated reports
+    //     const uint32_t         reportCount - calculated reports count
+    //     const uint32_t         reportSize  - values of a report, metrics followed by information
+    //
+    // Output:
+    //     TCompletionCode                    - result of the capture if a trigger fired, *CC_OK* otherwise
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CFlightRecorder::EvaluateTriggers( const TTypedValue_1_0* reports, const uint32_t reportCount, const uint32_t reportSize )
+    {
+        return EvaluateTriggers( reportCount,
+            [&]( const uint32_t metricIndex, const uint32_t reportIndex, double& value )
+            {
+                value = GetTypedValueAsDouble( reports[static_cast<size_t>( reportIndex ) * reportSize + metricIndex] );
+                return true;
+            } );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     EvaluateTriggers
+    //
+    // Description:
+    //     Evaluates triggers on reports calculated by CalculateMetricsToColumns.
+    //     Triggers of metrics without an output column are skipped.
+    //
+    // Input:
+    //     const TOutputColumn_1_15* columns      - output columns
+    //     const uint32_t            columnsCount - output columns count
+    //     const uint32_t            reportCount  - calculated reports count
+    //
+    // Output:
+    //     TCompletionCode                        - result of the capture if a trigger fired, *CC_OK* otherwise
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CFlightRecorder::EvaluateTriggers( const TOutputColumn_1_15* columns, const uint32_t columnsCount, const uint32_t reportCount )
+    {
+        return EvaluateTriggers( reportCount,
+            [&]( const uint32_t metricIndex, const uint32_t reportIndex, double& value )
+            {
+                return metricIndex < columnsCount && GetColumnValue( columns[metricIndex], reportIndex, value );
+            } );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     Dump
+    //
+    // Description:
+    //     Writes the ring to the next capture file: capture header, device
+    //     description and raw reports, oldest first. The ring isn't cleared,
+    //     so consecutive captures may overlap.
+    //
+    // Input:
+    //     const uint32_t triggerIndex - fired trigger, FLIGHT_RECORDER_CAPTURE_MANUAL_TRIGGER if none
+    //     const double   triggerValue - value which fired the trigger
+    //
+    // Output:
+    //     TCompletionCode             - result of operation (*CC_OK* is ok)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CFlightRecorder::Dump( const uint32_t triggerIndex, const double triggerValue )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( !IsStarted() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: flight recorder not started" );
+            return CC_ERROR_GENERAL;
+        }
+
+        const std::string fileName = m_captureFilePath + "." + std::to_string( m_captureCount );
+        FILE*             file     = nullptr;
+
+        iu_fopen_s( &file, fileName.c_str(), "wb" );
+        MD_CHECK_PTR_RET_A( adapterId, file, CC_ERROR_FILE_NOT_FOUND );
+
+        TFlightRecorderCaptureHeader_1_15 header = {};
+        header.Magic                             = FLIGHT_RECORDER_CAPTURE_MAGIC;
+        header.Version                           = FLIGHT_RECORDER_CAPTURE_VERSION;
+        header.HeaderSize                        = sizeof( header );
+        header.DeviceBufferSize                  = static_cast<uint32_t>( m_deviceBuffer.size() );
+        header.RawReportSize                     = m_rawReportSize;
+        header.ReportCount                       = m_ringCount;
+        header.NsTimerPeriod                     = m_nsTimerPeriod;
+        header.TriggerIndex                      = triggerIndex;
+        header.TriggerValue                      = triggerValue;
+
+        // Until the ring is full, the oldest report is the first one.
+        const uint32_t oldest     = ( m_ringCount == m_ringCapacity ) ? m_ringHead : 0;
+        const uint32_t firstCount = std::min( m_ringCount, m_ringCapacity - oldest );
+        const size_t   firstSize  = static_cast<size_t>( firstCount ) * m_rawReportSize;
+        const size_t   secondSize = static_cast<size_t>( m_ringCount - firstCount ) * m_rawReportSize;
+
+        const bool written = fwrite( &header, sizeof( header ), 1, file ) == 1
+            && fwrite( m_deviceBuffer.data(), 1, m_deviceBuffer.size(), file ) == m_deviceBuffer.size()
+            && fwrite( m_ring.data() + static_cast<size_t>( oldest ) * m_rawReportSize, 1, firstSize, file ) == firstSize
+            && fwrite( m_ring.data(), 1, secondSize, file ) == secondSize;
+
+        fclose( file );
+
+        if( !written )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: cannot write flight recorder capture: %s", fileName.c_str() );
+            return CC_ERROR_GENERAL;
+        }
+
+        ++m_captureCount;
+
+        MD_LOG_A( adapterId, LOG_INFO, "Flight recorder capture: %s, reports: %u, trigger: %u", fileName.c_str(), m_ringCount, triggerIndex );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     IsTriggerMet
+    //
+    // Description:
+    //     Updates trigger state with the next value. Returns true only when
+    //     the condition starts to be met, so a lasting condition fires once.
+    //     Rate is the value change divided by the gpu timestamp delta of the
+    //     reports, reports with an unchanged timestamp don't update the rate.
+    //
+    // Input:
+    //     TTrigger&    trigger      - trigger to update
+    //     const double value        - metric value of the next report
+    //     const double timestamp    - gpu timestamp in ns of the next report, rate triggers only
+    //     double&      triggerValue - (out) value or rate of change compared by the trigger
+    //
+    // Output:
+    //     bool                      - true if the trigger fires
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CFlightRecorder::IsTriggerMet( TTrigger& trigger, const double value, const double timestamp, double& triggerValue )
+    {
+        bool isMet = trigger.IsMet;
+
+        switch( trigger.Params.Type )
+        {
+            case FLIGHT_RECORDER_TRIGGER_TYPE_RATE:
+                if( !trigger.HasPreviousValue || timestamp > trigger.PreviousTimestamp )
+                {
+                    if( trigger.HasPreviousValue )
+                    {
+                        triggerValue = std::fabs( value - trigger.PreviousValue ) * 1000000000.0 / ( timestamp - trigger.PreviousTimestamp );
+                        isMet        = triggerValue > trigger.Params.Threshold;
+                    }
+
+                    trigger.PreviousValue     = value;
+                    trigger.PreviousTimestamp = timestamp;
+                    trigger.HasPreviousValue  = true;
+                }
+                break;
+
+            case FLIGHT_RECORDER_TRIGGER_TYPE_LOW_WATERMARK:
+                triggerValue = value;
+                isMet        = value < trigger.Watermark;
+                break;
+
+            default:
+                triggerValue = value;
+                isMet        = value > trigger.Watermark;
+                break;
+        }
+
+        const bool fires = isMet && !trigger.IsMet;
+        trigger.IsMet    = isMet;
+        return fires;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CFlightRecorder
+    //
+    // Method:
+    //     GetColumnValue
+    //
+    // Description:
+    //     Reads a value of an output column written by CalculateMetricsToColumns.
+    //
+    // Input:
+    //     const TOutputColumn_1_15& column      - output column
+    //     const uint32_t            reportIndex - report index in the column
+    //     double&                   value       - (out) value
+    //
+    // Output:
+    //     bool                                  - false if the column isn't written
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CFlightRecorder::GetColumnValue( const TOutputColumn_1_15& column, const uint32_t reportIndex, double& value )
+    {
+        if( column.Data == nullptr )
+        {
+            return false;
+        }
+
+        const uint8_t* data = static_cast<const uint8_t*>( column.Data );
+
+        switch( column.ValueType )
+        {
+            case VALUE_TYPE_UINT32:
+            {
+                uint32_t native = 0;
+                memcpy( &native, data + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), sizeof( native ) );
+                value = static_cast<double>( native );
+                return true;
+            }
+            case VALUE_TYPE_UINT64:
+            {
+                uint64_t native = 0;
+                memcpy( &native, data + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), sizeof( native ) );
+                value = static_cast<double>( native );
+                return true;
+            }
+            case VALUE_TYPE_FLOAT:
+            {
+                float native = 0.0f;
+                memcpy( &native, data + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), sizeof( native ) );
+                value = static_cast<double>( native );
+                return true;
+            }
+            case VALUE_TYPE_BOOL:
+            {
+                bool native = false;
+                memcpy( &native, data + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), sizeof( native ) );
+                value = native ? 1.0 : 0.0;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+} // namespace MetricsDiscoveryInternal
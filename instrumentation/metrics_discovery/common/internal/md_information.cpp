@@ -95,9 +95,9 @@ namespace MetricsDiscoveryInternal
 
         m_params.OverflowFunction = other.m_params.OverflowFunction;
 
-        m_availabilityEquation = other.m_availabilityEquation ? new( std::nothrow ) CEquation( *other.m_availabilityEquation ) : nullptr;
-        m_ioReadEquation       = other.m_ioReadEquation ? new( std::nothrow ) CEquation( *other.m_ioReadEquation ) : nullptr;
-        m_queryReadEquation    = other.m_queryReadEquation ? new( std::nothrow ) CEquation( *other.m_queryReadEquation ) : nullptr;
+        m_availabilityEquation = m_device.GetEquationCache().CopyEquation( other.m_availabilityEquation );
+        m_ioReadEquation       = m_device.GetEquationCache().CopyEquation( other.m_ioReadEquation );
+        m_queryReadEquation    = m_device.GetEquationCache().CopyEquation( other.m_queryReadEquation );
 
         m_params.IoReadEquation    = static_cast<IEquation_1_0*>( m_ioReadEquation );
         m_params.QueryReadEquation = static_cast<IEquation_1_0*>( m_queryReadEquation );
@@ -122,9 +122,9 @@ namespace MetricsDiscoveryInternal
         MD_SAFE_DELETE_ARRAY( m_params.LongName );
         MD_SAFE_DELETE_ARRAY( m_params.GroupName );
         MD_SAFE_DELETE_ARRAY( m_params.InfoUnits );
-        MD_SAFE_DELETE( m_availabilityEquation );
-        MD_SAFE_DELETE( m_ioReadEquation );
-        MD_SAFE_DELETE( m_queryReadEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_availabilityEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_ioReadEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_queryReadEquation );
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -260,7 +260,9 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     bool CInformation::IsAggregatable() const
     {
-        return !( m_params.ApiMask & API_TYPE_IOSTREAM ) || std::string_view( m_params.SymbolName ) == "QueryBeginTime";
+        const std::string_view symbolName = m_params.SymbolName;
+
+        return !( m_params.ApiMask & API_TYPE_IOSTREAM ) || symbolName == "QueryBeginTime" || symbolName == "QueryBeginTimeCpu";
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -390,7 +392,8 @@ namespace MetricsDiscoveryInternal
     //     SetInformationValue
     //
     // Description:
-    //     Sets the value for the information as a given equation.
+    //     Sets the value for the information as a given equation. A shared
+    //     equation is copied first, so other information isn't changed.
     //
     // Input:
     //     const uint32_t      value        - information value
@@ -402,17 +405,24 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CInformation::SetInformationValue( const uint32_t value, const TEquationType equationType )
     {
-        CEquation* equation = ( equationType == EQUATION_IO_READ )
-            ? m_ioReadEquation
+        CEquation** equation = ( equationType == EQUATION_IO_READ )
+            ? &m_ioReadEquation
             : ( equationType == EQUATION_QUERY_READ )
-            ? m_queryReadEquation
+            ? &m_queryReadEquation
             : nullptr;
 
         if( equation != nullptr &&
-            equation->GetEquationElementsCount() == 1 &&
-            equation->GetEquationElement( 0 )->Type == EQUATION_ELEM_IMM_UINT64 )
+            *equation != nullptr &&
+            ( *equation )->GetEquationElementsCount() == 1 &&
+            ( *equation )->GetEquationElement( 0 )->Type == EQUATION_ELEM_IMM_UINT64 )
         {
-            equation->GetEquationElement( 0 )->ImmediateUInt64 = value;
+            const TCompletionCode ret = m_device.GetEquationCache().MakeEquationUnique( *equation );
+            MD_CHECK_CC_RET_A( m_device.GetAdapter().GetAdapterId(), ret );
+
+            ( *equation )->GetEquationElement( 0 )->ImmediateUInt64 = value;
+
+            m_params.IoReadEquation    = static_cast<IEquation_1_0*>( m_ioReadEquation );
+            m_params.QueryReadEquation = static_cast<IEquation_1_0*>( m_queryReadEquation );
         }
         else
         {
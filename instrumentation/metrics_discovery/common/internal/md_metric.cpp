@@ -147,11 +147,11 @@ namespace MetricsDiscoveryInternal
         m_params.DeltaFunction     = other.m_params.DeltaFunction;
         m_params.QueryModeMask     = other.m_params.QueryModeMask;
 
-        m_availabilityEquation = ( other.m_availabilityEquation ) ? new( std::nothrow ) CEquation( *other.m_availabilityEquation ) : nullptr;
-        m_ioReadEquation       = ( other.m_ioReadEquation ) ? new( std::nothrow ) CEquation( *other.m_ioReadEquation ) : nullptr;
-        m_queryReadEquation    = ( other.m_queryReadEquation ) ? new( std::nothrow ) CEquation( *other.m_queryReadEquation ) : nullptr;
-        m_normEquation         = ( other.m_normEquation ) ? new( std::nothrow ) CEquation( *other.m_normEquation ) : nullptr;
-        m_maxValueEquation     = ( other.m_maxValueEquation ) ? new( std::nothrow ) CEquation( *other.m_maxValueEquation ) : nullptr;
+        m_availabilityEquation = m_device.GetEquationCache().CopyEquation( other.m_availabilityEquation );
+        m_ioReadEquation       = m_device.GetEquationCache().CopyEquation( other.m_ioReadEquation );
+        m_queryReadEquation    = m_device.GetEquationCache().CopyEquation( other.m_queryReadEquation );
+        m_normEquation         = m_device.GetEquationCache().CopyEquation( other.m_normEquation );
+        m_maxValueEquation     = m_device.GetEquationCache().CopyEquation( other.m_maxValueEquation );
 
         m_params.IoReadEquation    = static_cast<IEquation_1_0*>( m_ioReadEquation );
         m_params.QueryReadEquation = static_cast<IEquation_1_0*>( m_queryReadEquation );
@@ -180,11 +180,11 @@ namespace MetricsDiscoveryInternal
         MD_SAFE_DELETE_ARRAY( m_params.MetricResultUnits );
         MD_SAFE_DELETE_ARRAY( m_params.DxToOglAlias );
         MD_SAFE_DELETE_ARRAY( m_signalName );
-        MD_SAFE_DELETE( m_availabilityEquation );
-        MD_SAFE_DELETE( m_ioReadEquation );
-        MD_SAFE_DELETE( m_queryReadEquation );
-        MD_SAFE_DELETE( m_normEquation );
-        MD_SAFE_DELETE( m_maxValueEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_availabilityEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_ioReadEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_queryReadEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_normEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_maxValueEquation );
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -22,12 +22,15 @@ SPDX-License-Identifier: MIT
 #include "md_metric_prototype.h"
 #include "md_metric_enumerator.h"
 #include "md_metric_prototype_manager.h"
+#include "md_calculation_kernel.h"
 #include "md_metrics_calculator.h"
+#include "md_quantile_sketch.h"
 
 #include "md_calculation.h"
 #include "md_driver_ifc.h"
 #include "md_utils.h"
 
+#include <algorithm>
 #include <cstring>
 #include <unordered_map>
 
@@ -87,6 +90,24 @@ namespace MetricsDiscoveryInternal
         , m_isAggregationRequested( isAggregationRequested )
         , m_isReadRegsCfgSet( false )
         , m_metricsCalculator( new( std::nothrow ) CMetricsCalculator( m_device ) )
+        , m_calculationKernel( new( std::nothrow ) CCalculationKernel( *this ) )
+        , m_contextIdFilter()
+        , m_reportReasonFilter( 0 )
+        , m_reportNumbers()
+        , m_prevReportNumbers()
+        , m_queryPoolApiMask( 0 )
+        , m_queryPoolMetrics()
+        , m_queryPoolReadMetrics()
+        , m_queryPoolLastMetrics()
+        , m_queryPoolNormMetrics()
+        , m_queryPoolDeltaValues()
+        , m_queryPoolValues()
+        , m_columnsReport()
+        , m_gpuTimestampIndex( 0 )
+        , m_cpuTimestampIndex( 0 )
+        , m_areTimestampIndicesValid( false )
+        , m_quantileSketches()
+        , m_quantileSketchMetrics()
         , m_isOam( COAMConcurrentGroup::IsValidSymbolName( concurrentGroup->GetParams()->SymbolName ) )
         , m_isFlexible( false )
         , m_isOpened( false )
@@ -123,6 +144,11 @@ namespace MetricsDiscoveryInternal
         {
             MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Cannot allocate memory for CMetricsCalculator" );
         }
+
+        if( m_calculationKernel == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Cannot allocate memory for CCalculationKernel" );
+        }
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -146,6 +172,7 @@ namespace MetricsDiscoveryInternal
         MD_SAFE_DELETE_ARRAY( m_params.AvailabilityEquation );
 
         ClearCachedMetricsAndInformation();
+        ClearQuantileSketches();
 
         ClearVector( m_metricsVector );
         ClearVector( m_informationVector );
@@ -159,8 +186,9 @@ namespace MetricsDiscoveryInternal
         ClearVector( m_otherMetricsVector );
         ClearVector( m_otherInformationVector );
         MD_SAFE_DELETE( m_metricsCalculator );
+        MD_SAFE_DELETE( m_calculationKernel );
 
-        MD_SAFE_DELETE( m_availabilityEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_availabilityEquation );
         MD_SAFE_DELETE( m_prototypeManager );
 
         DeleteByteArray( m_platformMask, m_device.GetAdapter().GetAdapterId() );
@@ -796,6 +824,91 @@ namespace MetricsDiscoveryInternal
         return CC_OK;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     SetContextFilter
+    //
+    // Description:
+    //     Sets GPU context ids which IO stream reports are calculated by CalculateMetrics.
+    //     Reports of other contexts are skipped before any metric is calculated.
+    //     Context ids are compared with ContextId information values.
+    //
+    // Input:
+    //     const uint32_t* contextIds      - context ids to calculate, can be nullptr if count is 0
+    //     uint32_t        contextIdsCount - context ids count, 0 disables filtering
+    //
+    // Output:
+    //     TCompletionCode                 - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::SetContextFilter( const uint32_t* contextIds, uint32_t contextIdsCount )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( contextIdsCount == 0 )
+        {
+            m_contextIdFilter.clear();
+            MD_LOG_A( adapterId, LOG_DEBUG, "context filtering disabled" );
+            return CC_OK;
+        }
+
+        MD_CHECK_PTR_RET_A( adapterId, contextIds, CC_ERROR_INVALID_PARAMETER );
+
+        if( !HasInformation( "ContextId" ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: context filtering not supported, metric set: %s", m_params.SymbolName );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        m_contextIdFilter.assign( contextIds, contextIds + contextIdsCount );
+        std::sort( m_contextIdFilter.begin(), m_contextIdFilter.end() );
+        m_contextIdFilter.erase( std::unique( m_contextIdFilter.begin(), m_contextIdFilter.end() ), m_contextIdFilter.end() );
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "context filtering enabled, context ids: %u", static_cast<uint32_t>( m_contextIdFilter.size() ) );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     SetReportReasonFilter
+    //
+    // Description:
+    //     Sets report reasons which IO stream reports are calculated by CalculateMetrics,
+    //     e.g. REPORT_REASON_INTERNAL_TIMER to get only timer reports. Other reports are
+    //     skipped before any metric is calculated and included in the next calculated report.
+    //     Report reasons are compared with ReportReason information values.
+    //
+    // Input:
+    //     uint32_t reportReasonMask - TReportReason mask of reports to calculate, 0 disables filtering
+    //
+    // Output:
+    //     TCompletionCode           - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::SetReportReasonFilter( uint32_t reportReasonMask )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( reportReasonMask != 0 && !HasInformation( "ReportReason" ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: report reason filtering not supported, metric set: %s", m_params.SymbolName );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        m_reportReasonFilter = reportReasonMask;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "report reason filter: 0x%x", reportReasonMask );
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1260,7 +1373,8 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_PTR_RET_A( m_device.GetAdapter().GetAdapterId(), information, nullptr );
 
         m_informationVector.push_back( information );
-        m_params.InformationCount = static_cast<uint32_t>( m_informationVector.size() ) + m_concurrentGroup->GetInformationCount();
+        m_params.InformationCount  = static_cast<uint32_t>( m_informationVector.size() ) + m_concurrentGroup->GetInformationCount();
+        m_areTimestampIndicesValid = false;
 
         return information;
     }
@@ -1374,6 +1488,9 @@ namespace MetricsDiscoveryInternal
 
         MD_LOG_ENTER_A( adapterId );
 
+        // Find information used per calculated report once the set is in use.
+        UpdateCpuTimestampIndices();
+
         retVal = m_concurrentGroup->Lock();
         if( retVal == CC_OK && sendConfigFlag )
         {
@@ -2293,6 +2410,9 @@ namespace MetricsDiscoveryInternal
 
         MD_LOG_ENTER_A( adapterId );
 
+        // Metric indices change
+        ClearQuantileSketches();
+
         if( !enable )
         {
             UseApiFilteredVariables( false );
@@ -2339,6 +2459,11 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     void CMetricSet::UpdateMetricIndicesInEquations()
     {
+        if( m_calculationKernel != nullptr )
+        {
+            m_calculationKernel->Invalidate();
+        }
+
         std::unordered_map<std::string, uint32_t> metricsIndexMap( m_params.MetricsCount );
 
         // Initialize metric indices map
@@ -2434,6 +2559,13 @@ namespace MetricsDiscoveryInternal
             m_isFiltered               = false;
         }
 
+        if( m_calculationKernel != nullptr )
+        {
+            m_calculationKernel->Invalidate();
+        }
+
+        m_areTimestampIndicesValid = false;
+
         MD_LOG_A( adapterId, LOG_DEBUG, "Use API filtered variables: %s", enable ? "TRUE" : "FALSE" );
     }
 
@@ -2452,6 +2584,11 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     void CMetricSet::RefreshCachedMetricsAndInformation()
     {
+        if( m_calculationKernel != nullptr )
+        {
+            m_calculationKernel->Invalidate();
+        }
+
         if( m_filteredParams.ApiMask == 0 )
         {
             // Filtering uninitialized, nothing to do
@@ -2561,7 +2698,8 @@ namespace MetricsDiscoveryInternal
     //     TTypedValue_1_0* out                    - (OUT) buffer for calculated reports
     //     uint32_t         outSize                - size of the provided output buffer
     //     uint32_t*        outReportCount         - (OUT - optional) how much reports were calculated and are stored in the out buffer
-    //     bool             enableContextFiltering - if true enable context filtering during calculation
+    //     bool             enableContextFiltering - if true, context ids must be set with SetContextFilter first.
+    //                                               Filter set with SetContextFilter is used in both cases.
     //
     // Output:
     //     TCompletionCode - *CC_OK* means success
@@ -2569,9 +2707,9 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CMetricSet::CalculateMetrics( const uint8_t* rawData, uint32_t rawDataSize, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount, bool enableContextFiltering )
     {
-        if( enableContextFiltering )
+        if( enableContextFiltering && m_contextIdFilter.empty() )
         {
-            MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_ERROR, "error: context filtering not supported" );
+            MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_ERROR, "error: context filter not set" );
             return CC_ERROR_NOT_SUPPORTED;
         }
 
@@ -2683,6 +2821,13 @@ namespace MetricsDiscoveryInternal
         MD_LOG_A( adapterId, LOG_DEBUG, "calculated %u out reports", calculationContext.CommonCalculationContext.OutReportCount );
         MD_LOG_A( adapterId, LOG_DEBUG, "max values%s calculated", outMaxValues ? "" : " not" );
 
+        if( measurementType == MEASUREMENT_TYPE_SNAPSHOT_IO )
+        {
+            CalculateCpuTimestamps( out, calculationContext.CommonCalculationContext.OutReportCount );
+        }
+
+        AddToQuantileSketches( out, calculationContext.CommonCalculationContext.OutReportCount );
+
         if( outReportCount )
         {
             *outReportCount = calculationContext.CommonCalculationContext.OutReportCount;
@@ -2702,41 +2847,133 @@ namespace MetricsDiscoveryInternal
     //     CMetricSet
     //
     // Method:
-    //     CalculateIoMeasurementInformation
+    //     CalculateQueryPool
     //
     // Description:
-    //     Calculates IoMeasurementInformation obtained on every ReadIoStream.
+    //     Calculates many query reports at once, e.g. a whole query pool. Only given metrics
+    //     are calculated, together with metrics their normalization equations depend on.
+    //     Information are not calculated. Calculation plan and buffers are prepared on the
+    //     first call and reused while the requested metrics don't change.
+    //
+    //     If sumReports is true, a single report for the whole pool is returned. Read values
+    //     of all reports are summed and normalized once, in a single pass over reports, so
+    //     ratio and throughput metrics are normalized over the summed deltas. Metrics which
+    //     read equations don't return a delta (timestamps, raw values) are not summed, their
+    //     read values are taken from the last report.
     //
     // Input:
-    //     TTypedValue_1_0* out     - (OUT) buffer for calculated IoMeasurementInformation
-    //     uint32_t         outSize - output buffer size, should be at least
-    //                                IoMeasurementInformation count * sizeof(TTypedValue_1_0)
+    //     const uint8_t*   rawData            - raw query reports
+    //     uint32_t         rawDataSize        - size of raw query reports in bytes
+    //     const uint32_t*  metricIndices      - indices of metrics to calculate in output order,
+    //                                           all metrics are calculated if nullptr
+    //     uint32_t         metricIndicesCount - metric indices count, all metrics are calculated if 0
+    //     bool             sumReports         - if true, a single report summed over all raw reports is calculated
+    //     TTypedValue_1_0* out                - (OUT) buffer for calculated reports, metricIndicesCount values per report
+    //     uint32_t         outSize            - size of the provided output buffer in bytes
+    //     uint32_t*        outReportCount     - (OUT - optional) how much reports were calculated and are stored in the out buffer
     //
     // Output:
     //     TCompletionCode - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CMetricSet::CalculateIoMeasurementInformation( TTypedValue_1_0* out, uint32_t outSize )
+    TCompletionCode CMetricSet::CalculateQueryPool( const uint8_t* rawData, uint32_t rawDataSize, const uint32_t* metricIndices, uint32_t metricIndicesCount, bool sumReports, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount )
     {
         const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
 
         MD_LOG_ENTER_A( adapterId );
 
-        MD_CHECK_PTR_RET_A( adapterId, m_concurrentGroup, CC_ERROR_GENERAL );
+        MD_CHECK_PTR_RET_A( adapterId, rawData, CC_ERROR_INVALID_PARAMETER );
         MD_CHECK_PTR_RET_A( adapterId, out, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( adapterId, m_metricsCalculator, CC_ERROR_GENERAL );
 
-        if( outSize < m_concurrentGroup->GetParams()->IoMeasurementInformationCount * sizeof( TTypedValue_1_0 ) )
+        if( !m_isFiltered )
         {
-            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer has incorrect size" );
-            MD_LOG_A( adapterId, LOG_DEBUG, "outSize: %u", outSize );
+            MD_LOG_A( adapterId, LOG_ERROR, "error: API filtering must be enabled first" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_GENERAL;
+        }
+        if( m_currentParams->ApiMask & API_TYPE_IOSTREAM )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: query pool calculation not supported for IO stream" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        const uint32_t rawReportSize = m_currentParams->QueryReportSize;
+        if( rawReportSize == 0 || rawDataSize % rawReportSize != 0 )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: input buffer has incorrect size" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "rawDataSize: %u, rawReportSize: %u", rawDataSize, rawReportSize );
             MD_LOG_EXIT_A( adapterId );
             return CC_ERROR_INVALID_PARAMETER;
         }
 
-        MD_CHECK_PTR_RET_A( adapterId, m_metricsCalculator, CC_ERROR_GENERAL );
+        if( !IsQueryPoolPlanValid( metricIndices, metricIndicesCount ) )
+        {
+            auto ret = PrepareQueryPoolPlan( metricIndices, metricIndicesCount );
+            if( ret != CC_OK )
+            {
+                MD_LOG_EXIT_A( adapterId );
+                return ret;
+            }
+        }
 
-        m_metricsCalculator->ReadIoMeasurementInformation( *m_concurrentGroup, out );
-        MD_LOG_A( adapterId, LOG_DEBUG, "calculated %u out io information", m_concurrentGroup->GetParams()->IoMeasurementInformationCount );
+        const uint32_t rawReportCount = rawDataSize / rawReportSize;
+        const uint32_t outValuesCount = static_cast<uint32_t>( m_queryPoolMetrics.size() );
+        const uint32_t outCount       = ( sumReports && rawReportCount ) ? 1 : rawReportCount;
+
+        if( static_cast<uint64_t>( outCount ) * outValuesCount * sizeof( TTypedValue_1_0 ) > outSize )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer to small" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "outReportCount: %u, outSize: %u, outValuesCount: %u", outCount, outSize, outValuesCount );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        TTypedValue_1_0* deltaValues = m_queryPoolDeltaValues.data();
+        TTypedValue_1_0* values      = m_queryPoolValues.data();
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "about to calculate %u raw query reports, metrics: %u, sum: %u", rawReportCount, outValuesCount, sumReports );
+
+        for( uint32_t i = 0; i < rawReportCount; ++i )
+        {
+            const uint8_t* rawReport  = rawData + static_cast<size_t>( i ) * rawReportSize;
+            const bool     accumulate = sumReports && i > 0;
+
+            // Non delta values are overwritten by each report, they are read first
+            // because reading without accumulation resets GpuCoreClocks.
+            auto ret = m_queryPoolLastMetrics.empty()
+                ? CC_OK
+                : m_metricsCalculator->ReadMetricsFromQueryReport( rawReport, deltaValues, *this, m_queryPoolLastMetrics, false );
+
+            if( ret == CC_OK )
+            {
+                ret = m_metricsCalculator->ReadMetricsFromQueryReport( rawReport, deltaValues, *this, m_queryPoolReadMetrics, accumulate );
+            }
+
+            if( ret != CC_OK )
+            {
+                MD_LOG_EXIT_A( adapterId );
+                return ret;
+            }
+
+            if( sumReports && i + 1 < rawReportCount )
+            {
+                continue;
+            }
+
+            m_metricsCalculator->NormalizeMetrics( deltaValues, values, *this, m_queryPoolNormMetrics );
+
+            for( const uint32_t metricIndex : m_queryPoolMetrics )
+            {
+                *out++ = values[metricIndex];
+            }
+        }
+
+        if( outReportCount )
+        {
+            *outReportCount = outCount;
+        }
 
         MD_LOG_EXIT_A( adapterId );
         return CC_OK;
@@ -2748,65 +2985,141 @@ namespace MetricsDiscoveryInternal
     //     CMetricSet
     //
     // Method:
-    //     ValidateCalculateMetricsParams
+    //     CalculateMetricsToColumns
     //
     // Description:
-    //     Validates parameters passed to CalculateMetrics.
-    //     Subjects of validation: i.a. input and output buffer alignments, output buffer size.
+    //     Calculates metrics and information as CalculateMetrics does, but writes
+    //     them to typed output columns instead of TTypedValue_1_0 reports. Only
+    //     a single report is kept as TTypedValue_1_0 values, normalization
+    //     equations refer to other metrics of the report. The calculation manager
+    //     writes each report to columns as soon as it's calculated, while it's
+    //     still in cache, so no reports buffer is written and read again.
     //
     // Input:
-    //     uint32_t rawDataSize      - raw report data size
-    //     uint32_t rawReportSize    - size of one individual raw report
-    //     uint32_t outSize          - size of out buffer in bytes
-    //     uint32_t rawReportCount   - raw report count
-    //     uint32_t outMaxValuesSize - size of max values buffer in bytes
+    //     const uint8_t*            rawData        - raw report data
+    //     uint32_t                  rawDataSize    - size of raw report data in bytes
+    //     const TOutputColumn_1_15* columns        - output columns, metrics followed by information
+    //                                                as in a CalculateMetrics report
+    //     uint32_t                  columnsCount   - output columns count, metrics and information
+    //                                                without columns aren't written
+    //     uint32_t                  maxReportCount - how many reports each column can store
+    //     uint32_t*                 outReportCount - (OUT - optional) how much reports were calculated
+    //                                                and are stored in the columns
     //
     // Output:
     //     TCompletionCode - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CMetricSet::ValidateCalculateMetricsParams( uint32_t rawDataSize, uint32_t rawReportSize, uint32_t outSize, uint32_t rawReportCount, uint32_t outMaxValuesSize )
+    TCompletionCode CMetricSet::CalculateMetricsToColumns( const uint8_t* rawData, uint32_t rawDataSize, const TOutputColumn_1_15* columns, uint32_t columnsCount, uint32_t maxReportCount, uint32_t* outReportCount )
     {
-        // Size of one individual calculated report in bytes
-        uint32_t outReportSize = ( m_currentParams->MetricsCount + m_currentParams->InformationCount ) * sizeof( TTypedValue_1_0 );
-        // Size of one individual calculated max values report in bytes
-        uint32_t maxValuesReportSize = m_currentParams->MetricsCount * sizeof( TTypedValue_1_0 );
-
         const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
 
-        MD_ASSERT_A( adapterId, rawReportSize != 0 );
+        MD_LOG_ENTER_A( adapterId );
 
-        if( rawDataSize % rawReportSize != 0 )
+        MD_CHECK_PTR_RET_A( adapterId, rawData, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( adapterId, columns, CC_ERROR_INVALID_PARAMETER );
+
+        if( outReportCount )
         {
-            MD_LOG_A( adapterId, LOG_ERROR, "error: input buffer has incorrect size" );
-            MD_LOG_A( adapterId, LOG_DEBUG, "rawDataSize: %u, rawReportSize: %u", rawDataSize, rawReportSize );
-            return CC_ERROR_INVALID_PARAMETER;
+            *outReportCount = 0;
         }
-        if( outReportSize == 0 )
+
+        if( !rawDataSize )
         {
-            MD_LOG_A( adapterId, LOG_DEBUG, "outReportSize: 0. Nothing to calculate." );
+            MD_LOG_A( adapterId, LOG_DEBUG, "nothing to calculate, rawDataSize: 0" );
+            MD_LOG_EXIT_A( adapterId );
             return CC_OK;
         }
-        if( outSize % outReportSize != 0 )
+
+        if( !m_isFiltered )
         {
-            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer has incorrect size" );
-            MD_LOG_A( adapterId, LOG_DEBUG, "outSize: %u, outReportSize: %u", outSize, outReportSize );
-            return CC_ERROR_INVALID_PARAMETER;
+            MD_LOG_A( adapterId, LOG_ERROR, "error: API filtering must be enabled first" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_GENERAL;
         }
-        if( rawReportCount > ( outSize / outReportSize ) )
+
+        const uint32_t valuesCount = m_currentParams->MetricsCount + m_currentParams->InformationCount;
+
+        if( valuesCount == 0 )
         {
-            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer to small" );
-            MD_LOG_A( adapterId, LOG_DEBUG, "rawReportCount: %u, outSize: %u, outReportSize: %u", rawReportCount, outSize, outReportSize );
+            // May happen when unsupported API is used in MetricSet filtering
+            MD_LOG_A( adapterId, LOG_WARNING, "nothing to calculate, empty MetricSet" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_OK;
+        }
+
+        if( columnsCount > valuesCount || !AreOutputColumnsValid( columns, columnsCount ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid output columns, count: %u, metrics and information: %u", columnsCount, valuesCount );
+            MD_LOG_EXIT_A( adapterId );
             return CC_ERROR_INVALID_PARAMETER;
         }
-        if( outMaxValuesSize && maxValuesReportSize && rawReportCount > ( outMaxValuesSize / maxValuesReportSize ) )
+
+        constexpr uint32_t streamMask = API_TYPE_IOSTREAM;
+
+        const auto     measurementType = ( m_currentParams->ApiMask & streamMask )
+                ? MEASUREMENT_TYPE_SNAPSHOT_IO
+                : MEASUREMENT_TYPE_DELTA_QUERY;
+        const uint32_t rawReportSize   = ( measurementType == MEASUREMENT_TYPE_SNAPSHOT_IO )
+              ? m_currentParams->RawReportSize
+              : m_currentParams->QueryReportSize;
+
+        MD_ASSERT_A( adapterId, rawReportSize != 0 );
+
+        const uint32_t rawReportCount = rawDataSize / rawReportSize;
+
+        if( rawDataSize % rawReportSize != 0 || maxReportCount < rawReportCount )
         {
-            MD_LOG_A( adapterId, LOG_ERROR, "error: maxValues buffer to small" );
-            MD_LOG_A( adapterId, LOG_DEBUG, "rawReportCount: %u, outMaxValuesSize: %u, maxValueReportSize: %u", rawReportCount, outMaxValuesSize, maxValuesReportSize );
+            MD_LOG_A( adapterId, LOG_ERROR, "error: incorrect raw data size or report count" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "rawDataSize: %u, rawReportSize: %u, maxReportCount: %u", rawDataSize, rawReportSize, maxReportCount );
+            MD_LOG_EXIT_A( adapterId );
             return CC_ERROR_INVALID_PARAMETER;
         }
 
-        return CC_OK;
+        m_columnsReport.resize( valuesCount );
+
+        if( measurementType == MEASUREMENT_TYPE_SNAPSHOT_IO )
+        {
+            // Reports are converted one by one, the correlation is updated once.
+            CalculateCpuTimestamps( nullptr, 0 );
+        }
+
+        // Initialize manager and context
+        TCalculationContext  calculationContext = {};
+        CCalculationManager* calculationManager = nullptr;
+
+        InitializeCalculationManager( measurementType, &calculationManager, true );
+        MD_CHECK_PTR_RET_A( adapterId, calculationManager, CC_ERROR_NO_MEMORY );
+
+        auto ret = InitializeCalculationContext( calculationContext, calculationManager, measurementType, m_columnsReport.data(), nullptr, rawData, rawReportCount, true );
+        if( ret == CC_OK )
+        {
+            auto& commonContext = calculationContext.CommonCalculationContext;
+
+            commonContext.OutColumns      = columns;
+            commonContext.OutColumnsCount = columnsCount;
+
+            MD_LOG_A( adapterId, LOG_DEBUG, "about to calculate %u raw reports to %u columns", rawReportCount, columnsCount );
+
+            // CALCULATE METRICS
+            while( calculationManager->CalculateNextReport( calculationContext ) )
+            { // void
+            }
+
+            MD_LOG_A( adapterId, LOG_DEBUG, "calculated %u out reports", commonContext.OutReportCount );
+
+            if( outReportCount )
+            {
+                *outReportCount = commonContext.OutReportCount;
+            }
+
+            InitializeCalculationContext( calculationContext, nullptr, measurementType, nullptr, nullptr, nullptr, 0, false );
+        }
+
+        InitializeCalculationManager( measurementType, &calculationManager, false );
+
+        MD_LOG_EXIT_A( adapterId );
+        return ret;
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -2815,33 +3128,571 @@ namespace MetricsDiscoveryInternal
     //     CMetricSet
     //
     // Method:
-    //     InitializeCalculationManager
+    //     AreOutputColumnsValid
     //
     // Description:
-    //     Creates or destroys CalculationManager adequate to the given measurement type.
+    //     Checks value types and strides of output columns.
     //
     // Input:
-    //     TMeasurementType      measurementType     - type of measurement for which manager will be created
-    //     CCalculationManager** calculationManager  - (OUT) pointer to the newly created CalculationManager, null if error
-    //     bool                  init                - if true initialization,
-    //                                                 if false deinitialization
+    //     const TOutputColumn_1_15* columns      - output columns
+    //     uint32_t                  columnsCount - output columns count
+    //
+    // Output:
+    //     bool - true if all columns are valid
     //
     //////////////////////////////////////////////////////////////////////////////
-    void CMetricSet::InitializeCalculationManager( TMeasurementType measurementType, CCalculationManager** calculationManager, bool init )
+    bool CMetricSet::AreOutputColumnsValid( const TOutputColumn_1_15* columns, uint32_t columnsCount )
     {
-        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
-
-        if( !init )
+        for( uint32_t i = 0; i < columnsCount; ++i )
         {
-            MD_SAFE_DELETE( *calculationManager );
-            MD_LOG_A( adapterId, LOG_DEBUG, "calculation manager deinitialization" );
-            return;
-        }
+            const auto& column    = columns[i];
+            uint32_t    valueSize = 0;
 
-        MD_ASSERT_A( adapterId, *calculationManager == nullptr );
-        switch( measurementType )
-        {
-            case MEASUREMENT_TYPE_DELTA_QUERY:
+            if( column.Data == nullptr )
+            {
+                continue;
+            }
+
+            switch( column.ValueType )
+            {
+                case VALUE_TYPE_UINT32:
+                    valueSize = sizeof( uint32_t );
+                    break;
+
+                case VALUE_TYPE_UINT64:
+                    valueSize = sizeof( uint64_t );
+                    break;
+
+                case VALUE_TYPE_FLOAT:
+                    valueSize = sizeof( float );
+                    break;
+
+                case VALUE_TYPE_BOOL:
+                    valueSize = sizeof( bool );
+                    break;
+
+                default:
+                    MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_ERROR, "error: not supported column value type: %u, column: %u", column.ValueType, i );
+                    return false;
+            }
+
+            if( column.Stride != 0 && column.Stride < valueSize )
+            {
+                MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_ERROR, "error: column stride too small: %u, column: %u", column.Stride, i );
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     WriteReportToColumns
+    //
+    // Description:
+    //     Writes a just calculated report to output columns, converting values
+    //     to column value types. Called by calculation managers per report, so
+    //     cpu timestamps and quantile sketches are handled here as well, the
+    //     timestamp correlation has to be updated before the calculation.
+    //
+    // Input:
+    //     TTypedValue_1_0*          report       - (IN/OUT) calculated report
+    //     uint32_t                  reportIndex  - column index of the report
+    //     const TOutputColumn_1_15* columns      - valid output columns
+    //     uint32_t                  columnsCount - output columns count
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::WriteReportToColumns( TTypedValue_1_0* report, uint32_t reportIndex, const TOutputColumn_1_15* columns, uint32_t columnsCount )
+    {
+        if( m_currentParams->ApiMask & API_TYPE_IOSTREAM )
+        {
+            CalculateCpuTimestamps( report, 1, false );
+        }
+
+        AddToQuantileSketches( report, 1 );
+
+        const auto toUint64 = []( const TTypedValue_1_0& value ) -> uint64_t
+        {
+            switch( value.ValueType )
+            {
+                case VALUE_TYPE_UINT32:
+                    return value.ValueUInt32;
+                case VALUE_TYPE_UINT64:
+                    return value.ValueUInt64;
+                case VALUE_TYPE_FLOAT:
+                    return static_cast<uint64_t>( value.ValueFloat );
+                case VALUE_TYPE_BOOL:
+                    return value.ValueBool;
+                default:
+                    return 0;
+            }
+        };
+
+        const auto toFloat = []( const TTypedValue_1_0& value ) -> float
+        {
+            switch( value.ValueType )
+            {
+                case VALUE_TYPE_UINT32:
+                    return static_cast<float>( value.ValueUInt32 );
+                case VALUE_TYPE_UINT64:
+                    return static_cast<float>( value.ValueUInt64 );
+                case VALUE_TYPE_FLOAT:
+                    return value.ValueFloat;
+                case VALUE_TYPE_BOOL:
+                    return value.ValueBool ? 1.0f : 0.0f;
+                default:
+                    return 0.0f;
+            }
+        };
+
+        for( uint32_t i = 0; i < columnsCount; ++i )
+        {
+            const auto& column = columns[i];
+
+            if( column.Data == nullptr )
+            {
+                continue;
+            }
+
+            const TTypedValue_1_0& value = report[i];
+
+            switch( column.ValueType )
+            {
+                case VALUE_TYPE_UINT32:
+                {
+                    const uint32_t native = static_cast<uint32_t>( toUint64( value ) );
+                    memcpy( static_cast<uint8_t*>( column.Data ) + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), &native, sizeof( native ) );
+                    break;
+                }
+
+                case VALUE_TYPE_UINT64:
+                {
+                    const uint64_t native = toUint64( value );
+                    memcpy( static_cast<uint8_t*>( column.Data ) + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), &native, sizeof( native ) );
+                    break;
+                }
+
+                case VALUE_TYPE_FLOAT:
+                {
+                    const float native = toFloat( value );
+                    memcpy( static_cast<uint8_t*>( column.Data ) + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), &native, sizeof( native ) );
+                    break;
+                }
+
+                case VALUE_TYPE_BOOL:
+                {
+                    const bool native = toFloat( value ) != 0.0f;
+                    memcpy( static_cast<uint8_t*>( column.Data ) + static_cast<size_t>( reportIndex ) * ( column.Stride ? column.Stride : sizeof( native ) ), &native, sizeof( native ) );
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     SetQuantileSketches
+    //
+    // Description:
+    //     Creates empty quantile sketches of given metrics, replacing previous ones.
+    //     Every report calculated by CalculateMetrics or CalculateMetricsToColumns
+    //     adds its metric values to the sketches. Sketches are removed if no metric
+    //     is given or API filtering changes metric indices.
+    //
+    // Input:
+    //     const uint32_t* metricIndices      - metrics to sketch, indices with the current API filtering
+    //     uint32_t        metricIndicesCount - metric indices count, 0 removes sketches
+    //     double          relativeAccuracy   - relative accuracy of quantiles
+    //     uint32_t        maxBucketsCount    - max buckets count of a sketch store
+    //
+    // Output:
+    //     TCompletionCode                    - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::SetQuantileSketches( const uint32_t* metricIndices, uint32_t metricIndicesCount, double relativeAccuracy, uint32_t maxBucketsCount )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        ClearQuantileSketches();
+
+        if( metricIndicesCount == 0 )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "quantile sketches removed" );
+            return CC_OK;
+        }
+
+        MD_CHECK_PTR_RET_A( adapterId, metricIndices, CC_ERROR_INVALID_PARAMETER );
+
+        if( !CQuantileSketch::AreParamsValid( adapterId, relativeAccuracy, maxBucketsCount ) )
+        {
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        for( uint32_t i = 0; i < metricIndicesCount; ++i )
+        {
+            if( metricIndices[i] >= m_currentParams->MetricsCount )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: invalid metric index: %u, metrics count: %u", metricIndices[i], m_currentParams->MetricsCount );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+        }
+
+        m_quantileSketches.assign( m_currentParams->MetricsCount, nullptr );
+
+        for( uint32_t i = 0; i < metricIndicesCount; ++i )
+        {
+            auto& sketch = m_quantileSketches[metricIndices[i]];
+
+            if( sketch == nullptr )
+            {
+                sketch = new( std::nothrow ) CQuantileSketch( adapterId, relativeAccuracy, maxBucketsCount );
+                if( sketch == nullptr )
+                {
+                    MD_LOG_A( adapterId, LOG_ERROR, "error: cannot allocate quantile sketch" );
+                    ClearQuantileSketches();
+                    return CC_ERROR_NO_MEMORY;
+                }
+
+                m_quantileSketchMetrics.push_back( metricIndices[i] );
+            }
+        }
+
+        std::sort( m_quantileSketchMetrics.begin(), m_quantileSketchMetrics.end() );
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "quantile sketches: %u, relative accuracy: %f", static_cast<uint32_t>( m_quantileSketchMetrics.size() ), relativeAccuracy );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     GetQuantileSketch
+    //
+    // Description:
+    //     Returns quantile sketch of a metric, owned by the metric set.
+    //
+    // Input:
+    //     uint32_t metricIndex   - metric index with the current API filtering
+    //
+    // Output:
+    //     IQuantileSketchLatest* - quantile sketch, nullptr if the metric isn't sketched
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    IQuantileSketchLatest* CMetricSet::GetQuantileSketch( uint32_t metricIndex )
+    {
+        return ( metricIndex < m_quantileSketches.size() )
+            ? m_quantileSketches[metricIndex]
+            : nullptr;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     AddToQuantileSketches
+    //
+    // Description:
+    //     Adds metric values of calculated reports to quantile sketches.
+    //
+    // Input:
+    //     const TTypedValue_1_0* reports      - calculated reports, metrics and information
+    //     uint32_t               reportsCount - calculated reports count
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::AddToQuantileSketches( const TTypedValue_1_0* reports, uint32_t reportsCount )
+    {
+        if( m_quantileSketchMetrics.empty() )
+        {
+            return;
+        }
+
+        const uint32_t reportSize = m_currentParams->MetricsCount + m_currentParams->InformationCount;
+
+        for( uint32_t i = 0; i < reportsCount; ++i )
+        {
+            const TTypedValue_1_0* report = reports + static_cast<size_t>( i ) * reportSize;
+
+            for( const uint32_t metricIndex : m_quantileSketchMetrics )
+            {
+                m_quantileSketches[metricIndex]->AddValue( GetTypedValueAsDouble( report[metricIndex] ) );
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     ClearQuantileSketches
+    //
+    // Description:
+    //     Deletes quantile sketches.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::ClearQuantileSketches()
+    {
+        ClearVector( m_quantileSketches );
+        m_quantileSketchMetrics.clear();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     CalculateIoMeasurementInformation
+    //
+    // Description:
+    //     Calculates IoMeasurementInformation obtained on every ReadIoStream.
+    //
+    // Input:
+    //     TTypedValue_1_0* out     - (OUT) buffer for calculated IoMeasurementInformation
+    //     uint32_t         outSize - output buffer size, should be at least
+    //                                IoMeasurementInformation count * sizeof(TTypedValue_1_0)
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::CalculateIoMeasurementInformation( TTypedValue_1_0* out, uint32_t outSize )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        MD_LOG_ENTER_A( adapterId );
+
+        MD_CHECK_PTR_RET_A( adapterId, m_concurrentGroup, CC_ERROR_GENERAL );
+        MD_CHECK_PTR_RET_A( adapterId, out, CC_ERROR_INVALID_PARAMETER );
+
+        if( outSize < m_concurrentGroup->GetParams()->IoMeasurementInformationCount * sizeof( TTypedValue_1_0 ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer has incorrect size" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "outSize: %u", outSize );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        MD_CHECK_PTR_RET_A( adapterId, m_metricsCalculator, CC_ERROR_GENERAL );
+
+        m_metricsCalculator->ReadIoMeasurementInformation( *m_concurrentGroup, out );
+        MD_LOG_A( adapterId, LOG_DEBUG, "calculated %u out io information", m_concurrentGroup->GetParams()->IoMeasurementInformationCount );
+
+        MD_LOG_EXIT_A( adapterId );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     CalculateCpuTimestamps
+    //
+    // Description:
+    //     Fills QueryBeginTimeCpu information of calculated stream reports. Gpu
+    //     timestamps (QueryBeginTime) are converted in one pass with the device
+    //     timestamp correlation, so no driver call is made per report.
+    //     Information indices are found on activation, see UpdateCpuTimestampIndices.
+    //     Reports converted one by one update the correlation only once, calling
+    //     it without reports before the calculation.
+    //
+    // Input:
+    //     TTypedValue_1_0* out               - (in/out) calculated reports
+    //     const uint32_t   outReportCount    - number of calculated reports
+    //     const bool       updateCorrelation - if true, the timestamp correlation is updated first
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::CalculateCpuTimestamps( TTypedValue_1_0* out, const uint32_t outReportCount, const bool updateCorrelation /* = true */ )
+    {
+        const uint32_t metricsCount     = m_currentParams->MetricsCount;
+        const uint32_t informationCount = m_currentParams->InformationCount;
+
+        // Sets calculated without activation, e.g. opened from file.
+        if( !m_areTimestampIndicesValid )
+        {
+            UpdateCpuTimestampIndices();
+        }
+
+        const uint32_t gpuIndex = m_gpuTimestampIndex;
+        const uint32_t cpuIndex = m_cpuTimestampIndex;
+
+        if( gpuIndex == informationCount || cpuIndex == informationCount )
+        {
+            return;
+        }
+
+        auto& timestampCorrelation = m_device.GetTimestampCorrelation();
+
+        if( updateCorrelation && timestampCorrelation.Update() != CC_OK )
+        {
+            MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_DEBUG, "gpu cpu timestamp correlation not available" );
+        }
+
+        if( outReportCount == 0 )
+        {
+            return;
+        }
+
+        timestampCorrelation.ConvertToCpuTimestamps( out, outReportCount, metricsCount + informationCount, metricsCount + gpuIndex, metricsCount + cpuIndex );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     UpdateCpuTimestampIndices
+    //
+    // Description:
+    //     Finds QueryBeginTime and QueryBeginTimeCpu information with the current
+    //     API filtering, so calculations do not look them up by name.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::UpdateCpuTimestampIndices()
+    {
+        const uint32_t informationCount = m_currentParams->InformationCount;
+
+        m_gpuTimestampIndex = informationCount;
+        m_cpuTimestampIndex = informationCount;
+
+        for( uint32_t i = 0; i < informationCount; ++i )
+        {
+            const char* symbolName = GetInformation( i )->GetParams()->SymbolName;
+
+            if( strcmp( symbolName, "QueryBeginTime" ) == 0 )
+            {
+                m_gpuTimestampIndex = i;
+            }
+            else if( strcmp( symbolName, "QueryBeginTimeCpu" ) == 0 )
+            {
+                m_cpuTimestampIndex = i;
+            }
+        }
+
+        m_areTimestampIndicesValid = true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     ValidateCalculateMetricsParams
+    //
+    // Description:
+    //     Validates parameters passed to CalculateMetrics.
+    //     Subjects of validation: i.a. input and output buffer alignments, output buffer size.
+    //
+    // Input:
+    //     uint32_t rawDataSize      - raw report data size
+    //     uint32_t rawReportSize    - size of one individual raw report
+    //     uint32_t outSize          - size of out buffer in bytes
+    //     uint32_t rawReportCount   - raw report count
+    //     uint32_t outMaxValuesSize - size of max values buffer in bytes
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::ValidateCalculateMetricsParams( uint32_t rawDataSize, uint32_t rawReportSize, uint32_t outSize, uint32_t rawReportCount, uint32_t outMaxValuesSize )
+    {
+        // Size of one individual calculated report in bytes
+        uint32_t outReportSize = ( m_currentParams->MetricsCount + m_currentParams->InformationCount ) * sizeof( TTypedValue_1_0 );
+        // Size of one individual calculated max values report in bytes
+        uint32_t maxValuesReportSize = m_currentParams->MetricsCount * sizeof( TTypedValue_1_0 );
+
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        MD_ASSERT_A( adapterId, rawReportSize != 0 );
+
+        if( rawDataSize % rawReportSize != 0 )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: input buffer has incorrect size" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "rawDataSize: %u, rawReportSize: %u", rawDataSize, rawReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( outReportSize == 0 )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "outReportSize: 0. Nothing to calculate." );
+            return CC_OK;
+        }
+        if( outSize % outReportSize != 0 )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer has incorrect size" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "outSize: %u, outReportSize: %u", outSize, outReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( rawReportCount > ( outSize / outReportSize ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer to small" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "rawReportCount: %u, outSize: %u, outReportSize: %u", rawReportCount, outSize, outReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( outMaxValuesSize && maxValuesReportSize && rawReportCount > ( outMaxValuesSize / maxValuesReportSize ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: maxValues buffer to small" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "rawReportCount: %u, outMaxValuesSize: %u, maxValueReportSize: %u", rawReportCount, outMaxValuesSize, maxValuesReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     InitializeCalculationManager
+    //
+    // Description:
+    //     Creates or destroys CalculationManager adequate to the given measurement type.
+    //
+    // Input:
+    //     TMeasurementType      measurementType     - type of measurement for which manager will be created
+    //     CCalculationManager** calculationManager  - (OUT) pointer to the newly created CalculationManager, null if error
+    //     bool                  init                - if true initialization,
+    //                                                 if false deinitialization
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::InitializeCalculationManager( TMeasurementType measurementType, CCalculationManager** calculationManager, bool init )
+    {
+        const uint32_t adapterId = m_device.GetAdapter().GetAdapterId();
+
+        if( !init )
+        {
+            MD_SAFE_DELETE( *calculationManager );
+            MD_LOG_A( adapterId, LOG_DEBUG, "calculation manager deinitialization" );
+            return;
+        }
+
+        MD_ASSERT_A( adapterId, *calculationManager == nullptr );
+        switch( measurementType )
+        {
+            case MEASUREMENT_TYPE_DELTA_QUERY:
                 *calculationManager = new( std::nothrow ) CMetricsCalculationManager<MEASUREMENT_TYPE_DELTA_QUERY>();
                 MD_LOG_A( adapterId, LOG_DEBUG, "query calculation manager created" );
                 return;
@@ -2910,8 +3761,13 @@ namespace MetricsDiscoveryInternal
         context.CommonCalculationContext.RawReportCount = rawReportCount;
         if( measurementType == MEASUREMENT_TYPE_SNAPSHOT_IO )
         {
-            // Not supported
-            context.StreamCalculationContext.DoContextFiltering = false;
+            context.StreamCalculationContext.Kernel             = GetCalculationKernel();
+            context.StreamCalculationContext.DoContextFiltering = !m_contextIdFilter.empty();
+            context.StreamCalculationContext.ContextIds         = m_contextIdFilter.data();
+            context.StreamCalculationContext.ContextIdsCount    = static_cast<uint32_t>( m_contextIdFilter.size() );
+            context.StreamCalculationContext.ReportReasonMask   = m_reportReasonFilter;
+            context.StreamCalculationContext.ReportNumbers      = &m_reportNumbers;
+            context.StreamCalculationContext.PrevReportNumbers  = &m_prevReportNumbers;
         }
         if( calculationManager->PrepareContext( context ) != CC_OK )
         {
@@ -2927,6 +3783,221 @@ namespace MetricsDiscoveryInternal
         return CC_OK;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     IsQueryPoolPlanValid
+    //
+    // Description:
+    //     Checks if the query pool calculation plan was prepared for the given metrics
+    //     and the current API filtering.
+    //
+    // Input:
+    //     const uint32_t* metricIndices      - indices of metrics to calculate, all metrics if nullptr
+    //     uint32_t        metricIndicesCount - metric indices count, all metrics if 0
+    //
+    // Output:
+    //     bool - true if the plan can be reused
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CMetricSet::IsQueryPoolPlanValid( const uint32_t* metricIndices, uint32_t metricIndicesCount )
+    {
+        const uint32_t metricsCount = m_currentParams->MetricsCount;
+
+        if( m_queryPoolApiMask != m_currentParams->ApiMask || m_queryPoolValues.size() != metricsCount || m_queryPoolNormMetrics.empty() )
+        {
+            return false;
+        }
+
+        if( metricIndices == nullptr || metricIndicesCount == 0 )
+        {
+            if( m_queryPoolMetrics.size() != metricsCount )
+            {
+                return false;
+            }
+
+            for( uint32_t i = 0; i < metricsCount; ++i )
+            {
+                if( m_queryPoolMetrics[i] != i )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        return m_queryPoolMetrics.size() == metricIndicesCount && std::equal( m_queryPoolMetrics.begin(), m_queryPoolMetrics.end(), metricIndices );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     PrepareQueryPoolPlan
+    //
+    // Description:
+    //     Prepares the query pool calculation plan: metrics to read and normalize for
+    //     the given metrics and buffers for their values. GpuCoreClocks metric is always
+    //     read, because it's used by standard normalization equations. Metrics to read are
+    //     split by their read equations: deltas may be summed over reports, other values
+    //     (delta function other than DELTA_N_BITS and DELTA_NS_TIME) may not.
+    //
+    // Input:
+    //     const uint32_t* metricIndices      - indices of metrics to calculate, all metrics if nullptr
+    //     uint32_t        metricIndicesCount - metric indices count, all metrics if 0
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::PrepareQueryPoolPlan( const uint32_t* metricIndices, uint32_t metricIndicesCount )
+    {
+        const uint32_t adapterId    = m_device.GetAdapter().GetAdapterId();
+        const uint32_t metricsCount = m_currentParams->MetricsCount;
+
+        m_queryPoolMetrics.clear();
+        m_queryPoolReadMetrics.clear();
+        m_queryPoolLastMetrics.clear();
+        m_queryPoolNormMetrics.clear();
+
+        if( metricIndices == nullptr || metricIndicesCount == 0 )
+        {
+            for( uint32_t i = 0; i < metricsCount; ++i )
+            {
+                m_queryPoolMetrics.push_back( i );
+            }
+        }
+        else
+        {
+            for( uint32_t i = 0; i < metricIndicesCount; ++i )
+            {
+                if( metricIndices[i] >= metricsCount )
+                {
+                    MD_LOG_A( adapterId, LOG_ERROR, "error: incorrect metric index: %u, metrics count: %u", metricIndices[i], metricsCount );
+                    m_queryPoolMetrics.clear();
+                    return CC_ERROR_INVALID_PARAMETER;
+                }
+
+                m_queryPoolMetrics.push_back( metricIndices[i] );
+            }
+        }
+
+        std::vector<bool> readMetrics( metricsCount, false );
+        std::vector<bool> normMetrics( metricsCount, false );
+
+        for( const uint32_t metricIndex : m_queryPoolMetrics )
+        {
+            AddQueryPoolDependencies( metricIndex, readMetrics, normMetrics );
+        }
+
+        for( uint32_t i = 0; i < metricsCount; ++i )
+        {
+            auto metric = GetMetricExplicit( i );
+            MD_CHECK_PTR_RET_A( adapterId, metric, CC_ERROR_GENERAL );
+
+            if( std::string_view( metric->GetParams()->SymbolName ) == "GpuCoreClocks" )
+            {
+                readMetrics[i] = true;
+            }
+            if( readMetrics[i] )
+            {
+                const TDeltaFunctionType deltaFunction = metric->GetParams()->DeltaFunction.FunctionType;
+                const bool               isDelta       = metric->GetParams()->QueryReadEquation == nullptr || deltaFunction == DELTA_N_BITS || deltaFunction == DELTA_NS_TIME;
+
+                if( isDelta )
+                {
+                    m_queryPoolReadMetrics.push_back( i );
+                }
+                else
+                {
+                    m_queryPoolLastMetrics.push_back( i );
+                }
+            }
+            if( normMetrics[i] )
+            {
+                m_queryPoolNormMetrics.push_back( i );
+            }
+        }
+
+        m_queryPoolDeltaValues.assign( metricsCount, TTypedValue_1_0{} );
+        m_queryPoolValues.assign( metricsCount, TTypedValue_1_0{} );
+        m_queryPoolApiMask = m_currentParams->ApiMask;
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "query pool plan, metrics: %u, read: %u, normalized: %u", static_cast<uint32_t>( m_queryPoolMetrics.size() ), static_cast<uint32_t>( m_queryPoolReadMetrics.size() ), static_cast<uint32_t>( m_queryPoolNormMetrics.size() ) );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     AddQueryPoolDependencies
+    //
+    // Description:
+    //     Marks the metric to read and normalize, together with metrics referenced
+    //     by its normalization equation. Referenced counters are only read, referenced
+    //     metrics are normalized as well.
+    //
+    // Input:
+    //     uint32_t           metricIndex - index of the metric
+    //     std::vector<bool>& readMetrics - (IN/OUT) metrics to read
+    //     std::vector<bool>& normMetrics - (IN/OUT) metrics to normalize
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricSet::AddQueryPoolDependencies( uint32_t metricIndex, std::vector<bool>& readMetrics, std::vector<bool>& normMetrics )
+    {
+        if( metricIndex >= normMetrics.size() || normMetrics[metricIndex] )
+        {
+            return;
+        }
+
+        readMetrics[metricIndex] = true;
+        normMetrics[metricIndex] = true;
+
+        auto metric = GetMetricExplicit( metricIndex );
+        if( metric == nullptr || metric->GetParams()->NormEquation == nullptr )
+        {
+            return;
+        }
+
+        auto& equationElements = static_cast<CEquation*>( metric->GetParams()->NormEquation )->GetElementsVector();
+
+        for( auto& element : equationElements )
+        {
+            if( element.MetricIndexInternal < 0 )
+            {
+                continue;
+            }
+
+            const uint32_t index = static_cast<uint32_t>( element.MetricIndexInternal );
+
+            switch( element.Type )
+            {
+                case EQUATION_ELEM_LOCAL_COUNTER_SYMBOL:
+                    if( index < readMetrics.size() )
+                    {
+                        readMetrics[index] = true;
+                    }
+                    break;
+
+                case EQUATION_ELEM_LOCAL_METRIC_SYMBOL:
+                    AddQueryPoolDependencies( index, readMetrics, normMetrics );
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -3078,6 +4149,36 @@ namespace MetricsDiscoveryInternal
         return false;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     AddCpuTimestampInformation
+    //
+    // Description:
+    //     Adds QueryBeginTimeCpu information to io stream metric sets reporting
+    //     gpu timestamp (QueryBeginTime). It is the measurement begin time in
+    //     CLOCK_MONOTONIC domain, calculated in CalculateCpuTimestamps.
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMetricSet::AddCpuTimestampInformation()
+    {
+        if( !( m_params.ApiMask & API_TYPE_IOSTREAM ) || !HasInformation( "QueryBeginTime" ) || HasInformation( "QueryBeginTimeCpu" ) )
+        {
+            return CC_OK;
+        }
+
+        CInformation* information = AddInformation( "QueryBeginTimeCpu", "Query Begin Time CPU", "The measurement begin time in CPU (CLOCK_MONOTONIC) time domain.", "Report Meta Data", API_TYPE_IOSTREAM, INFORMATION_TYPE_TIMESTAMP, "ns", nullptr, m_params.InformationCount );
+        MD_CHECK_PTR_RET_A( m_device.GetAdapter().GetAdapterId(), information, CC_ERROR_NO_MEMORY );
+
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -3098,6 +4199,43 @@ namespace MetricsDiscoveryInternal
         return m_metricsCalculator;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricSet
+    //
+    // Method:
+    //     GetCalculationKernel
+    //
+    // Description:
+    //     Returns calculation kernel of the current metrics, builds it if needed.
+    //
+    // Output:
+    //     CCalculationKernel* - calculation kernel, null if the metric set can't be
+    //                           calculated with a kernel
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CCalculationKernel* CMetricSet::GetCalculationKernel()
+    {
+        if( m_calculationKernel == nullptr || m_metricsCalculator == nullptr )
+        {
+            return nullptr;
+        }
+
+        if( m_calculationKernel->IsValid() && m_calculationKernel->GetMetrics().size() != m_currentParams->MetricsCount )
+        {
+            // Metrics were added since the kernel was built.
+            m_calculationKernel->Invalidate();
+        }
+
+        if( !m_calculationKernel->IsBuilt() )
+        {
+            m_calculationKernel->Build( *m_metricsCalculator );
+        }
+
+        return m_calculationKernel->IsValid() ? m_calculationKernel : nullptr;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
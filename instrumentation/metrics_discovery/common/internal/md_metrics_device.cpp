@@ -15,6 +15,8 @@ SPDX-License-Identifier: MIT
 #include "md_concurrent_group.h"
 #include "md_oa_concurrent_group.h"
 #include "md_oam_concurrent_group.h"
+#include "md_pmu_concurrent_group.h"
+#include "md_fdinfo_concurrent_group.h"
 #include "md_equation.h"
 #include "md_information.h"
 #include "md_metric.h"
@@ -55,8 +57,11 @@ namespace MetricsDiscoveryInternal
         , m_adapter( adapter )
         , m_driverInterface( driverInterface )
         , m_symbolSet( *this, driverInterface )
+        , m_timestampCorrelation( *this )
+        , m_equationCache( *this )
         , m_streamId( -1 )
         , m_streamConfigId( -1 )
+        , m_streamContextDrmFd( -1 )
         , m_subDeviceIndex( subDeviceIndex )
         , m_platformIndex( 0 )
         , m_gtType( GT_TYPE_UNKNOWN )
@@ -442,7 +447,27 @@ namespace MetricsDiscoveryInternal
             return nullptr;
         };
 
-        if( strstr( symbolicName, "OAM" ) != nullptr )
+        if( CPmuConcurrentGroup::IsValidSymbolName( symbolicName ) )
+        {
+            if( !CPmuConcurrentGroup::IsSupported( *this ) )
+            {
+                isSupported = false;
+                return nullptr;
+            }
+
+            group = new( std::nothrow ) CPmuConcurrentGroup( *this, symbolicName, shortName, measurementTypeMask );
+        }
+        else if( CFdinfoConcurrentGroup::IsValidSymbolName( symbolicName ) )
+        {
+            if( !CFdinfoConcurrentGroup::IsSupported( *this ) )
+            {
+                isSupported = false;
+                return nullptr;
+            }
+
+            group = new( std::nothrow ) CFdinfoConcurrentGroup( *this, symbolicName, shortName, measurementTypeMask );
+        }
+        else if( strstr( symbolicName, "OAM" ) != nullptr )
         {
             if( !COAMConcurrentGroup::IsSupported( symbolicName, *this ) )
             {
@@ -1856,6 +1881,46 @@ namespace MetricsDiscoveryInternal
         return m_symbolSet;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsDevice
+    //
+    // Method:
+    //     GetEquationCache
+    //
+    // Description:
+    //     Returns reference to the equation cache.
+    //
+    // Output:
+    //     CEquationCache& - reference to the equation cache
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CEquationCache& CMetricsDevice::GetEquationCache()
+    {
+        return m_equationCache;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsDevice
+    //
+    // Method:
+    //     GetTimestampCorrelation
+    //
+    // Description:
+    //     Returns reference to the gpu / cpu timestamp correlation.
+    //
+    // Output:
+    //     CTimestampCorrelation& - reference to the timestamp correlation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CTimestampCorrelation& CMetricsDevice::GetTimestampCorrelation()
+    {
+        return m_timestampCorrelation;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -2039,6 +2104,26 @@ namespace MetricsDiscoveryInternal
         return m_streamConfigId;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsDevice
+    //
+    // Method:
+    //     GetStreamContextDrmFd
+    //
+    // Description:
+    //     Returns DRM fd owning the context of a single context stream.
+    //
+    // Output:
+    //     int32_t - DRM fd, -1 if stream is system wide.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    int32_t CMetricsDevice::GetStreamContextDrmFd()
+    {
+        return m_streamContextDrmFd;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -2099,6 +2184,26 @@ namespace MetricsDiscoveryInternal
         m_streamConfigId = id;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsDevice
+    //
+    // Method:
+    //     SetStreamContextDrmFd
+    //
+    // Description:
+    //     Sets DRM fd owning the context of a single context stream.
+    //
+    // Input:
+    //     const int32_t fd - DRM fd, -1 if stream is system wide.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMetricsDevice::SetStreamContextDrmFd( const int32_t fd )
+    {
+        m_streamContextDrmFd = fd;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -0,0 +1,1047 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_multi_tile_io_stream.cpp
+
+//     Abstract:   C++ Metrics Discovery internal multi tile io stream implementation
+
+#include "md_multi_tile_io_stream.h"
+#include "md_adapter.h"
+#include "md_metrics_device.h"
+#include "md_metric_set.h"
+#include "md_oa_concurrent_group.h"
+#include "md_driver_ifc.h"
+
+#include "md_utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     CMultiTileIoStream constructor
+    //
+    // Description:
+    //     Constructor. Streams are opened in Open.
+    //
+    // Input:
+    //     CAdapter& adapter - parent adapter
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CMultiTileIoStream::CMultiTileIoStream( CAdapter& adapter )
+        : m_adapter( adapter )
+        , m_params{}
+        , m_devices()
+        , m_metricSets()
+        , m_oaConcurrentGroups()
+        , m_firstTileToRead( 0 )
+        , m_tileWakeups()
+        , m_aggregationTypes()
+        , m_tileRawData()
+        , m_tileValues()
+        , m_tileReportsCount()
+        , m_pendingValuesCount( 0 )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     ~CMultiTileIoStream
+    //
+    // Description:
+    //     Destructor. Metrics sub devices are owned by the adapter, they are
+    //     closed in CAdapter::CloseMultiTileIoStream.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CMultiTileIoStream::~CMultiTileIoStream()
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     GetParams
+    //
+    // Description:
+    //     Returns multi tile io stream params.
+    //
+    // Output:
+    //     TMultiTileIoStreamParamsLatest* - pointer to params
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TMultiTileIoStreamParamsLatest* CMultiTileIoStream::GetParams( void )
+    {
+        return &m_params;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     GetTileMetricsDevice
+    //
+    // Description:
+    //     Returns metrics sub device of the given tile.
+    //
+    // Input:
+    //     uint32_t tileIndex    - tile (sub device) index
+    //
+    // Output:
+    //     IMetricsDeviceLatest* - metrics sub device, nullptr if index is out of range
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    IMetricsDeviceLatest* CMultiTileIoStream::GetTileMetricsDevice( uint32_t tileIndex )
+    {
+        return GetTileDevice( tileIndex );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     GetTileMetricSet
+    //
+    // Description:
+    //     Returns metric set opened on the given tile. Use it to calculate
+    //     reports read from that tile.
+    //
+    // Input:
+    //     uint32_t tileIndex - tile (sub device) index
+    //
+    // Output:
+    //     IMetricSetLatest*  - metric set, nullptr if index is out of range
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    IMetricSetLatest* CMultiTileIoStream::GetTileMetricSet( uint32_t tileIndex )
+    {
+        return ( tileIndex < m_metricSets.size() )
+            ? static_cast<IMetricSetLatest*>( m_metricSets[tileIndex] )
+            : nullptr;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     ReadIoStream
+    //
+    // Description:
+    //     Reads reports of all tiles into one buffer. Reports of a single tile
+    //     are consecutive and keep their order. Every ReadIoStream starts from
+    //     the next tile, so a small buffer is not filled by one tile only.
+    //     Returns *CC_READ_PENDING* if not all data was read. If a tile fails
+    //     after reports of other tiles were read, the read reports are returned
+    //     with *CC_READ_PENDING* and the failing tile is read first next time,
+    //     so its error is reported by the following call.
+    //
+    // Input:
+    //     uint32_t* reportsCount - (in/out) requested number of reports to read / reports read from all tiles
+    //     char*     reportData   - (out) pointer to the read data, RawReportSize bytes per report
+    //     uint32_t* tileIndices  - (out) tile (sub device) index of each read report
+    //     uint32_t  readFlags    - read flags passed to every tile (see TIoReadFlag enum)
+    //
+    // Output:
+    //     TCompletionCode        - *CC_OK* or *CC_READ_PENDING* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMultiTileIoStream::ReadIoStream( uint32_t* reportsCount, char* reportData, uint32_t* tileIndices, uint32_t readFlags )
+    {
+        const uint32_t adapterId = m_adapter.GetAdapterId();
+
+        MD_CHECK_PTR_RET_A( adapterId, reportsCount, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( adapterId, reportData, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( adapterId, tileIndices, CC_ERROR_INVALID_PARAMETER );
+
+        if( m_oaConcurrentGroups.empty() )
+        {
+            *reportsCount = 0;
+            MD_LOG_A( adapterId, LOG_ERROR, "stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        const uint32_t  tilesCount  = m_params.TilesCount;
+        const uint32_t  reportSize  = m_params.RawReportSize;
+        uint32_t        freeReports = *reportsCount;
+        uint32_t        readReports = 0;
+        uint32_t        tilesRead   = 0;
+        TCompletionCode ret         = CC_OK;
+
+        for( ; tilesRead < tilesCount && freeReports > 0; ++tilesRead )
+        {
+            const uint32_t tileIndex   = ( m_firstTileToRead + tilesRead ) % tilesCount;
+            uint32_t       tileReports = freeReports;
+
+            const TCompletionCode tileRet = m_oaConcurrentGroups[tileIndex]->ReadIoStream( &tileReports, reportData + static_cast<size_t>( readReports ) * reportSize, readFlags );
+            if( tileRet != CC_OK && tileRet != CC_READ_PENDING )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Reading stream of tile %u failed", tileIndex );
+
+                // Reports of previous tiles are already in the buffer, do not lose them.
+                if( readReports > 0 )
+                {
+                    m_firstTileToRead = tileIndex;
+                    *reportsCount     = readReports;
+                    return CC_READ_PENDING;
+                }
+
+                ret = tileRet;
+                break;
+            }
+
+            std::fill_n( tileIndices + readReports, tileReports, tileIndex );
+
+            readReports += tileReports;
+            freeReports -= tileReports;
+            ret = ( tileRet == CC_READ_PENDING ) ? CC_READ_PENDING : ret;
+        }
+
+        // Buffer was filled before all tiles were read.
+        if( ret == CC_OK && tilesRead < tilesCount )
+        {
+            ret = CC_READ_PENDING;
+        }
+
+        m_firstTileToRead = ( m_firstTileToRead + 1 ) % tilesCount;
+        *reportsCount     = readReports;
+
+        return ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     WaitForReports
+    //
+    // Description:
+    //     Waits the given number of milliseconds for reports from any tile.
+    //
+    // Input:
+    //     uint32_t milliseconds - number of milliseconds to wait
+    //
+    // Output:
+    //     TCompletionCode       - *CC_OK* if reports of at least one tile are available
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMultiTileIoStream::WaitForReports( uint32_t milliseconds )
+    {
+        const uint32_t    adapterId       = m_adapter.GetAdapterId();
+        CDriverInterface* driverInterface = m_adapter.GetDriverInterface();
+
+        MD_CHECK_PTR_RET_A( adapterId, driverInterface, CC_ERROR_GENERAL );
+
+        if( m_oaConcurrentGroups.empty() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        return driverInterface->WaitForIoStreamReports( m_oaConcurrentGroups, milliseconds );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     GetAggregationType
+    //
+    // Description:
+    //     Returns how the given value of a calculated report is combined over
+    //     tiles in CalculateCardMetrics. Metrics are aggregated according to
+    //     their metric type, information is taken from the first tile.
+    //     Index is the position in the calculated report of the tile metric set,
+    //     so it depends on api filtering.
+    //
+    // Input:
+    //     uint32_t index       - metric index, or MetricsCount + information index
+    //
+    // Output:
+    //     TTileAggregationType - aggregation type, TILE_AGGREGATION_TYPE_LAST if index is out of range
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TTileAggregationType CMultiTileIoStream::GetAggregationType( uint32_t index )
+    {
+        if( m_metricSets.empty() )
+        {
+            return TILE_AGGREGATION_TYPE_LAST;
+        }
+
+        CMetricSet*                   metricSet = m_metricSets[0];
+        const TMetricSetParamsLatest* params    = metricSet->GetParams();
+
+        if( index < params->MetricsCount )
+        {
+            return GetMetricAggregationType( metricSet->GetMetric( index )->GetParams()->MetricType );
+        }
+
+        return ( index < params->MetricsCount + params->InformationCount )
+            ? TILE_AGGREGATION_TYPE_FIRST_TILE
+            : TILE_AGGREGATION_TYPE_LAST;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     CalculateCardMetrics
+    //
+    // Description:
+    //     Calculates card level metrics from reports read with ReadIoStream.
+    //     Reports of each tile are calculated with the tile metric set, then
+    //     calculated reports of all tiles are aligned by gpu timestamp (QueryBeginTime)
+    //     and combined into one report according to GetAggregationType.
+    //     Reports are aligned if their timestamps differ less than half of the
+    //     sampling period. Calculated reports not aligned yet (e.g. a tile read
+    //     less reports in this call) are kept and aligned in the next call.
+    //     A report is skipped only when a newer report of another tile proves
+    //     its counterpart will not come. Reports not fitting into the output
+    //     buffer are kept too, the next call (possibly with no raw reports)
+    //     returns them.
+    //     Output report layout is the same as of GetTileMetricSet( 0 ), all tile
+    //     metric sets have to use the same api filtering.
+    //
+    // Input:
+    //     const char*      reportData     - raw reports read with ReadIoStream
+    //     uint32_t         reportsCount   - number of raw reports
+    //     const uint32_t*  tileIndices    - tile index of each raw report
+    //     TTypedValue_1_0* out            - (out) buffer for calculated card reports
+    //     uint32_t         outSize        - size of the output buffer in bytes
+    //     uint32_t*        outReportCount - (out) number of calculated card reports
+    //
+    // Output:
+    //     TCompletionCode                 - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMultiTileIoStream::CalculateCardMetrics( const char* reportData, uint32_t reportsCount, const uint32_t* tileIndices, TTypedValue_1_0* out, uint32_t outSize, uint32_t* outReportCount )
+    {
+        const uint32_t adapterId = m_adapter.GetAdapterId();
+
+        MD_LOG_ENTER_A( adapterId );
+        MD_CHECK_PTR_RET_A( adapterId, out, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( adapterId, outReportCount, CC_ERROR_INVALID_PARAMETER );
+
+        // Raw reports may be omitted to get kept reports only.
+        if( reportsCount > 0 && ( reportData == nullptr || tileIndices == nullptr ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: raw reports not provided" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        *outReportCount = 0;
+
+        if( m_metricSets.empty() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "stream not opened" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_GENERAL;
+        }
+
+        const TMetricSetParamsLatest* params         = m_metricSets[0]->GetParams();
+        const uint32_t                valuesCount    = params->MetricsCount + params->InformationCount;
+        const uint32_t                outReportSize  = valuesCount * sizeof( TTypedValue_1_0 );
+        uint32_t                      timestampIndex = valuesCount;
+
+        if( valuesCount == 0 )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "nothing to calculate" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_OK;
+        }
+
+        if( outSize < outReportSize )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: output buffer to small" );
+            MD_LOG_A( adapterId, LOG_DEBUG, "outSize: %u, outReportSize: %u", outSize, outReportSize );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        // 1. Validate api filtering of all tiles
+        for( auto metricSet : m_metricSets )
+        {
+            if( metricSet->GetParams()->MetricsCount != params->MetricsCount || metricSet->GetParams()->InformationCount != params->InformationCount )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: tile metric sets use different api filtering" );
+                MD_LOG_EXIT_A( adapterId );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+        }
+
+        // 2. Prepare aggregation types and find gpu timestamp
+        m_aggregationTypes.resize( valuesCount );
+        for( uint32_t i = 0; i < valuesCount; ++i )
+        {
+            m_aggregationTypes[i] = GetAggregationType( i );
+        }
+
+        for( uint32_t i = 0; i < params->InformationCount; ++i )
+        {
+            if( m_metricSets[0]->GetInformation( i )->GetParams()->InfoType == INFORMATION_TYPE_TIMESTAMP )
+            {
+                timestampIndex = params->MetricsCount + i;
+                break;
+            }
+        }
+
+        if( timestampIndex == valuesCount )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: gpu timestamp information not available" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        // 3. Calculate reports of each tile
+        TCompletionCode ret = CalculateTileMetrics( reportData, reportsCount, tileIndices, valuesCount );
+        if( ret != CC_OK )
+        {
+            MD_LOG_EXIT_A( adapterId );
+            return ret;
+        }
+
+        // 4. Align and aggregate reports of all tiles
+        *outReportCount = AlignTileReports( timestampIndex, valuesCount, out, outSize / outReportSize );
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "calculated %u card reports from %u raw reports", *outReportCount, reportsCount );
+        MD_LOG_EXIT_A( adapterId );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     Open
+    //
+    // Description:
+    //     Opens io stream with the given metric set and wake-up on every metrics
+    //     sub device. Timer period and oa buffer size returned by the first tile
+    //     are reported, all tiles are requested with the same values. Already
+    //     opened streams are closed if any tile fails. Wake-up of tile concurrent
+    //     groups is restored when the stream is closed.
+    //
+    // Input:
+    //     const std::vector<CMetricsDevice*>& metricsDevices      - metrics sub devices, indexed by sub device index
+    //     const char*                         concurrentGroupName - oa concurrent group symbol name
+    //     const char*                         metricSetName       - metric set symbol name
+    //     const TIoStreamWakeupMode           wakeupMode          - wake-up mode of all tiles
+    //     const uint32_t                      wakeupReportCount   - wake-up report count, used with IO_STREAM_WAKEUP_MODE_REPORT_COUNT
+    //     uint32_t&                           nsTimerPeriod       - (in/out) sampling period
+    //     uint32_t&                           oaBufferSize        - (in/out) oa buffer size
+    //
+    // Output:
+    //     TCompletionCode                                         - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMultiTileIoStream::Open( const std::vector<CMetricsDevice*>& metricsDevices, const char* concurrentGroupName, const char* metricSetName, const TIoStreamWakeupMode wakeupMode, const uint32_t wakeupReportCount, uint32_t& nsTimerPeriod, uint32_t& oaBufferSize )
+    {
+        const uint32_t adapterId = m_adapter.GetAdapterId();
+
+        MD_LOG_ENTER_A( adapterId );
+        MD_CHECK_PTR_RET_A( adapterId, concurrentGroupName, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET_A( adapterId, metricSetName, CC_ERROR_INVALID_PARAMETER );
+
+        if( !m_oaConcurrentGroups.empty() || metricsDevices.empty() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "Stream already opened or no sub devices given" );
+            MD_LOG_EXIT_A( adapterId );
+            return CC_ERROR_GENERAL;
+        }
+
+        TCompletionCode ret = CC_OK;
+
+        for( uint32_t tileIndex = 0; tileIndex < metricsDevices.size() && ret == CC_OK; ++tileIndex )
+        {
+            CMetricsDevice* device = metricsDevices[tileIndex];
+            if( device == nullptr )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Sub device of tile %u not opened", tileIndex );
+                ret = CC_ERROR_INVALID_PARAMETER;
+                break;
+            }
+
+            // 1. Find the same metric set on the tile
+            CConcurrentGroup* concurrentGroup = device->GetConcurrentGroupByName( concurrentGroupName );
+            CMetricSet*       metricSet       = nullptr;
+
+            if( concurrentGroup == nullptr )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Concurrent group %s not found on tile %u", concurrentGroupName, tileIndex );
+                ret = CC_ERROR_INVALID_PARAMETER;
+                break;
+            }
+
+            // Io stream concurrent groups are oa based. Only oa and oam streams
+            // sample a single tile, pmu and fdinfo streams cover the whole card.
+            if( ( concurrentGroup->GetParams()->MeasurementTypeMask & MEASUREMENT_TYPE_SNAPSHOT_IO ) == 0 )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Concurrent group %s does not support io stream", concurrentGroupName );
+                ret = CC_ERROR_NOT_SUPPORTED;
+                break;
+            }
+
+            auto*             oaConcurrentGroup = static_cast<COAConcurrentGroup*>( concurrentGroup );
+            const TStreamType streamType        = oaConcurrentGroup->GetStreamType();
+
+            if( streamType != STREAM_TYPE_OA && streamType != STREAM_TYPE_OAM )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Concurrent group %s does not provide a tile stream", concurrentGroupName );
+                ret = CC_ERROR_NOT_SUPPORTED;
+                break;
+            }
+
+            for( uint32_t i = 0; i < concurrentGroup->GetParams()->MetricSetsCount; ++i )
+            {
+                CMetricSet* set = static_cast<CMetricSet*>( concurrentGroup->GetMetricSet( i ) );
+
+                if( set != nullptr && strcmp( set->GetParams()->SymbolName, metricSetName ) == 0 )
+                {
+                    metricSet = set;
+                    break;
+                }
+            }
+
+            if( metricSet == nullptr )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Metric set %s not found on tile %u", metricSetName, tileIndex );
+                ret = CC_ERROR_INVALID_PARAMETER;
+                break;
+            }
+
+            if( tileIndex > 0 && metricSet->GetParams()->RawReportSize != m_params.RawReportSize )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Metric set %s report size differs on tile %u", metricSetName, tileIndex );
+                ret = CC_ERROR_GENERAL;
+                break;
+            }
+
+            // 2. Open io stream on the tile with the stream wake-up
+            const TTileWakeup tileWakeup      = { oaConcurrentGroup->GetIoStreamWakeupMode(), oaConcurrentGroup->GetIoStreamWakeupReportCount() };
+            uint32_t          tileTimerPeriod = nsTimerPeriod;
+            uint32_t          tileBufferSize  = oaBufferSize;
+
+            ret = oaConcurrentGroup->SetIoStreamWakeup( wakeupMode, wakeupReportCount );
+            if( ret == CC_OK )
+            {
+                ret = oaConcurrentGroup->OpenIoStream( metricSet, 0, &tileTimerPeriod, &tileBufferSize );
+            }
+            if( ret != CC_OK )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "Opening stream on tile %u failed", tileIndex );
+                oaConcurrentGroup->SetIoStreamWakeup( tileWakeup.Mode, tileWakeup.ReportCount );
+                break;
+            }
+
+            if( tileIndex == 0 )
+            {
+                m_params.RawReportSize = metricSet->GetParams()->RawReportSize;
+                m_params.NsTimerPeriod = tileTimerPeriod;
+                m_params.OaBufferSize  = tileBufferSize;
+            }
+
+            m_devices.push_back( device );
+            m_metricSets.push_back( metricSet );
+            m_oaConcurrentGroups.push_back( oaConcurrentGroup );
+            m_tileWakeups.push_back( tileWakeup );
+        }
+
+        if( ret != CC_OK )
+        {
+            Close();
+            MD_LOG_EXIT_A( adapterId );
+            return ret;
+        }
+
+        m_params.TilesCount = m_oaConcurrentGroups.size();
+        nsTimerPeriod       = m_params.NsTimerPeriod;
+        oaBufferSize        = m_params.OaBufferSize;
+
+        MD_LOG_A( adapterId, LOG_INFO, "Multi tile stream opened on %u tiles, metric set: %s", m_params.TilesCount, metricSetName );
+        MD_LOG_EXIT_A( adapterId );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     Close
+    //
+    // Description:
+    //     Closes io streams of all tiles and restores wake-up of their concurrent
+    //     groups. Every tile is closed even if some of them fail, the first error
+    //     is returned.
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMultiTileIoStream::Close()
+    {
+        TCompletionCode ret = CC_OK;
+
+        for( uint32_t i = 0; i < m_oaConcurrentGroups.size(); ++i )
+        {
+            const TCompletionCode tileRet = m_oaConcurrentGroups[i]->CloseIoStream();
+            if( tileRet == CC_OK )
+            {
+                m_oaConcurrentGroups[i]->SetIoStreamWakeup( m_tileWakeups[i].Mode, m_tileWakeups[i].ReportCount );
+            }
+
+            ret = ( ret == CC_OK ) ? tileRet : ret;
+        }
+
+        m_oaConcurrentGroups.clear();
+        m_tileWakeups.clear();
+        m_metricSets.clear();
+        m_tileValues.clear();
+        m_tileReportsCount.clear();
+        m_pendingValuesCount = 0;
+        m_params.TilesCount  = 0;
+
+        return ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     CalculateTileMetrics
+    //
+    // Description:
+    //     Splits raw reports by tile and calculates them with the tile metric set.
+    //     Calculated reports are appended to reports kept from previous calls
+    //     in m_tileValues, m_tileReportsCount is the count of both. Kept reports
+    //     are discarded if the calculated report layout changed.
+    //
+    // Input:
+    //     const char*     reportData   - raw reports read with ReadIoStream
+    //     const uint32_t  reportsCount - number of raw reports
+    //     const uint32_t* tileIndices  - tile index of each raw report
+    //     const uint32_t  valuesCount  - number of values in a calculated report
+    //
+    // Output:
+    //     TCompletionCode              - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CMultiTileIoStream::CalculateTileMetrics( const char* reportData, const uint32_t reportsCount, const uint32_t* tileIndices, const uint32_t valuesCount )
+    {
+        const uint32_t adapterId  = m_adapter.GetAdapterId();
+        const uint32_t tilesCount = m_params.TilesCount;
+        const uint32_t reportSize = m_params.RawReportSize;
+
+        // 1. Validate tile indices before anything is calculated
+        for( uint32_t i = 0; i < reportsCount; ++i )
+        {
+            if( tileIndices[i] >= tilesCount )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: invalid tile index %u of report %u", tileIndices[i], i );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+        }
+
+        if( m_pendingValuesCount != valuesCount || m_tileValues.size() != tilesCount )
+        {
+            m_tileValues.assign( tilesCount, {} );
+            m_tileReportsCount.assign( tilesCount, 0 );
+            m_pendingValuesCount = valuesCount;
+        }
+
+        m_tileRawData.resize( tilesCount );
+
+        for( auto& rawData : m_tileRawData )
+        {
+            rawData.clear();
+        }
+
+        // 2. Split raw reports by tile, reports of a tile keep their order
+        for( uint32_t i = 0; i < reportsCount; ++i )
+        {
+            const char* report = reportData + static_cast<size_t>( i ) * reportSize;
+
+            m_tileRawData[tileIndices[i]].insert( m_tileRawData[tileIndices[i]].end(), report, report + reportSize );
+        }
+
+        // 3. Calculate each tile after its kept reports
+        for( uint32_t tileIndex = 0; tileIndex < tilesCount; ++tileIndex )
+        {
+            const auto&    rawData         = m_tileRawData[tileIndex];
+            const uint32_t tileReportCount = rawData.size() / reportSize;
+            const size_t   keptValuesCount = static_cast<size_t>( m_tileReportsCount[tileIndex] ) * valuesCount;
+            uint32_t       calculatedCount = 0;
+
+            if( tileReportCount == 0 )
+            {
+                continue;
+            }
+
+            m_tileValues[tileIndex].resize( keptValuesCount + static_cast<size_t>( tileReportCount ) * valuesCount );
+
+            const TCompletionCode ret = m_metricSets[tileIndex]->CalculateMetrics(
+                rawData.data(),
+                rawData.size(),
+                m_tileValues[tileIndex].data() + keptValuesCount,
+                static_cast<uint32_t>( ( m_tileValues[tileIndex].size() - keptValuesCount ) * sizeof( TTypedValue_1_0 ) ),
+                &calculatedCount,
+                nullptr,
+                0 );
+
+            if( ret != CC_OK )
+            {
+                m_tileValues[tileIndex].resize( keptValuesCount );
+                MD_LOG_A( adapterId, LOG_ERROR, "Calculating reports of tile %u failed", tileIndex );
+                return ret;
+            }
+
+            m_tileReportsCount[tileIndex] += calculatedCount;
+            m_tileValues[tileIndex].resize( static_cast<size_t>( m_tileReportsCount[tileIndex] ) * valuesCount );
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     AlignTileReports
+    //
+    // Description:
+    //     Walks calculated reports of all tiles in gpu timestamp order and
+    //     aggregates reports of all tiles with timestamps within the tolerance.
+    //     The oldest report is skipped only if a newer report of another tile
+    //     is out of its tolerance, the other tile has nothing left to match it.
+    //     Walking stops when any tile runs out of reports, the unmatched tail of
+    //     every tile is kept for the next call. Kept reports of a tile are
+    //     limited to what its oa buffer holds, older reports of other tiles
+    //     would be overwritten in the oa buffer before they are read.
+    //
+    // Input:
+    //     const uint32_t   timestampIndex - index of gpu timestamp information in a calculated report
+    //     const uint32_t   valuesCount    - number of values in a calculated report
+    //     TTypedValue_1_0* out            - (out) buffer for card reports
+    //     const uint32_t   outReportsMax  - card reports capacity of the output buffer
+    //
+    // Output:
+    //     uint32_t                        - number of card reports
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CMultiTileIoStream::AlignTileReports( const uint32_t timestampIndex, const uint32_t valuesCount, TTypedValue_1_0* out, const uint32_t outReportsMax )
+    {
+        const uint32_t adapterId  = m_adapter.GetAdapterId();
+        const uint32_t tilesCount = m_params.TilesCount;
+        const uint64_t tolerance  = m_params.NsTimerPeriod / 2;
+
+        auto getTimestamp = [&]( const uint32_t tileIndex, const uint32_t reportIndex )
+        {
+            return m_tileValues[tileIndex][static_cast<size_t>( reportIndex ) * valuesCount + timestampIndex].ValueUInt64;
+        };
+
+        std::vector<uint32_t> tileReports( tilesCount, 0 );
+        uint32_t              outReportCount = 0;
+        uint32_t              skippedCount   = 0;
+
+        while( outReportCount < outReportsMax )
+        {
+            uint32_t oldestTile = 0;
+            uint64_t oldest     = UINT64_MAX;
+            uint64_t newest     = 0;
+            bool     available  = true;
+
+            for( uint32_t tileIndex = 0; tileIndex < tilesCount && available; ++tileIndex )
+            {
+                available = tileReports[tileIndex] < m_tileReportsCount[tileIndex];
+
+                if( available )
+                {
+                    const uint64_t timestamp = getTimestamp( tileIndex, tileReports[tileIndex] );
+
+                    oldestTile = ( timestamp < oldest ) ? tileIndex : oldestTile;
+                    oldest     = std::min( oldest, timestamp );
+                    newest     = std::max( newest, timestamp );
+                }
+            }
+
+            // Wait for reports of the tile which has nothing left.
+            if( !available )
+            {
+                break;
+            }
+
+            if( oldest + tolerance < newest )
+            {
+                ++tileReports[oldestTile];
+                ++skippedCount;
+                continue;
+            }
+
+            AggregateReport( tileReports, valuesCount, out + static_cast<size_t>( outReportCount ) * valuesCount );
+            ++outReportCount;
+
+            for( auto& reportIndex : tileReports )
+            {
+                ++reportIndex;
+            }
+        }
+
+        // Keep the unmatched tail of every tile, bounded by the oa buffer capacity.
+        const uint32_t keptReportsMax = ( m_params.RawReportSize > 0 ) ? m_params.OaBufferSize / m_params.RawReportSize : 0;
+
+        for( uint32_t tileIndex = 0; tileIndex < tilesCount; ++tileIndex )
+        {
+            uint32_t consumed = tileReports[tileIndex];
+
+            if( keptReportsMax > 0 && m_tileReportsCount[tileIndex] - consumed > keptReportsMax )
+            {
+                skippedCount += m_tileReportsCount[tileIndex] - consumed - keptReportsMax;
+                consumed = m_tileReportsCount[tileIndex] - keptReportsMax;
+            }
+
+            auto& values = m_tileValues[tileIndex];
+
+            values.erase( values.begin(), values.begin() + static_cast<size_t>( consumed ) * valuesCount );
+            m_tileReportsCount[tileIndex] -= consumed;
+        }
+
+        if( skippedCount > 0 )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "%u tile reports without a counterpart skipped", skippedCount );
+        }
+
+        return outReportCount;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     AggregateReport
+    //
+    // Description:
+    //     Combines calculated reports of all tiles into one card report.
+    //
+    // Input:
+    //     const std::vector<uint32_t>& tileReports - report index of each tile
+    //     const uint32_t               valuesCount - number of values in a calculated report
+    //     TTypedValue_1_0*             out         - (out) card report
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMultiTileIoStream::AggregateReport( const std::vector<uint32_t>& tileReports, const uint32_t valuesCount, TTypedValue_1_0* out )
+    {
+        const uint32_t tilesCount = m_params.TilesCount;
+
+        std::copy_n( m_tileValues[0].data() + static_cast<size_t>( tileReports[0] ) * valuesCount, valuesCount, out );
+
+        for( uint32_t tileIndex = 1; tileIndex < tilesCount; ++tileIndex )
+        {
+            const TTypedValue_1_0* values = m_tileValues[tileIndex].data() + static_cast<size_t>( tileReports[tileIndex] ) * valuesCount;
+
+            for( uint32_t i = 0; i < valuesCount; ++i )
+            {
+                AggregateValue( out[i], values[i], m_aggregationTypes[i] );
+            }
+        }
+
+        for( uint32_t i = 0; i < valuesCount; ++i )
+        {
+            if( m_aggregationTypes[i] == TILE_AGGREGATION_TYPE_AVERAGE )
+            {
+                DivideValue( out[i], tilesCount );
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     GetMetricAggregationType
+    //
+    // Description:
+    //     Returns cross tile aggregation type for the given metric type.
+    //
+    // Input:
+    //     const TMetricType metricType - metric type
+    //
+    // Output:
+    //     TTileAggregationType         - aggregation type
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TTileAggregationType CMultiTileIoStream::GetMetricAggregationType( const TMetricType metricType )
+    {
+        switch( metricType )
+        {
+            case METRIC_TYPE_EVENT:
+            case METRIC_TYPE_EVENT_WITH_RANGE:
+            case METRIC_TYPE_RAW:
+                return TILE_AGGREGATION_TYPE_SUM;
+
+            case METRIC_TYPE_RATIO:
+                return TILE_AGGREGATION_TYPE_AVERAGE;
+
+            case METRIC_TYPE_DURATION:
+            case METRIC_TYPE_THROUGHPUT:
+            case METRIC_TYPE_TIMESTAMP:
+            case METRIC_TYPE_FLAG:
+                return TILE_AGGREGATION_TYPE_MAX;
+
+            default:
+                return TILE_AGGREGATION_TYPE_FIRST_TILE;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     AggregateValue
+    //
+    // Description:
+    //     Accumulates a value of another tile. Averages are summed here and
+    //     divided in DivideValue. Boolean values are or'ed.
+    //
+    // Input:
+    //     TTypedValue_1_0&           out             - (in/out) accumulated value
+    //     const TTypedValue_1_0&     value           - value of another tile
+    //     const TTileAggregationType aggregationType - aggregation type
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMultiTileIoStream::AggregateValue( TTypedValue_1_0& out, const TTypedValue_1_0& value, const TTileAggregationType aggregationType )
+    {
+        if( aggregationType == TILE_AGGREGATION_TYPE_FIRST_TILE || out.ValueType != value.ValueType )
+        {
+            return;
+        }
+
+        const bool isMax = aggregationType == TILE_AGGREGATION_TYPE_MAX;
+
+        switch( out.ValueType )
+        {
+            case VALUE_TYPE_UINT32:
+                out.ValueUInt32 = isMax ? std::max( out.ValueUInt32, value.ValueUInt32 ) : out.ValueUInt32 + value.ValueUInt32;
+                break;
+
+            case VALUE_TYPE_UINT64:
+                out.ValueUInt64 = isMax ? std::max( out.ValueUInt64, value.ValueUInt64 ) : out.ValueUInt64 + value.ValueUInt64;
+                break;
+
+            case VALUE_TYPE_FLOAT:
+                out.ValueFloat = isMax ? std::max( out.ValueFloat, value.ValueFloat ) : out.ValueFloat + value.ValueFloat;
+                break;
+
+            case VALUE_TYPE_BOOL:
+                out.ValueBool = out.ValueBool || value.ValueBool;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     DivideValue
+    //
+    // Description:
+    //     Divides accumulated value by the number of tiles.
+    //
+    // Input:
+    //     TTypedValue_1_0& out     - (in/out) accumulated value
+    //     const uint32_t   divisor - number of tiles
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CMultiTileIoStream::DivideValue( TTypedValue_1_0& out, const uint32_t divisor )
+    {
+        switch( out.ValueType )
+        {
+            case VALUE_TYPE_UINT32:
+                out.ValueUInt32 /= divisor;
+                break;
+
+            case VALUE_TYPE_UINT64:
+                out.ValueUInt64 /= divisor;
+                break;
+
+            case VALUE_TYPE_FLOAT:
+                out.ValueFloat /= divisor;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMultiTileIoStream
+    //
+    // Method:
+    //     GetTileDevice
+    //
+    // Description:
+    //     Returns metrics sub device of the given tile. Devices are kept after
+    //     Close, so the adapter can close them.
+    //
+    // Input:
+    //     const uint32_t tileIndex - tile (sub device) index
+    //
+    // Output:
+    //     CMetricsDevice*          - metrics sub device, nullptr if index is out of range
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CMetricsDevice* CMultiTileIoStream::GetTileDevice( const uint32_t tileIndex )
+    {
+        return ( tileIndex < m_devices.size() )
+            ? m_devices[tileIndex]
+            : nullptr;
+    }
+} // namespace MetricsDiscoveryInternal
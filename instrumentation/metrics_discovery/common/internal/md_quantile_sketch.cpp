@@ -0,0 +1,800 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_quantile_sketch.cpp
+
+//     Abstract:   C++ Metrics Discovery internal quantile sketch implementation
+
+#include "md_quantile_sketch.h"
+
+#include "md_utils.h"
+
+#include <algorithm>
+#include <cinttypes> // for PRIu64 (printing uint64_t)
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     CQuantileSketch constructor
+    //
+    // Description:
+    //     Constructor. Params have to be validated with AreParamsValid.
+    //
+    // Input:
+    //     const uint32_t adapterId        - adapter id for logging
+    //     const double   relativeAccuracy - relative accuracy of quantiles
+    //     const uint32_t maxBucketsCount  - max buckets count of a store
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CQuantileSketch::CQuantileSketch( const uint32_t adapterId, const double relativeAccuracy, const uint32_t maxBucketsCount )
+        : m_adapterId( adapterId )
+        , m_params{}
+        , m_gamma( ( 1.0 + relativeAccuracy ) / ( 1.0 - relativeAccuracy ) )
+        , m_logGamma( std::log( m_gamma ) )
+        , m_zeroCount( 0 )
+        , m_negative{ 0, {} }
+        , m_positive{ 0, {} }
+    {
+        m_params.RelativeAccuracy = relativeAccuracy;
+        m_params.MaxBucketsCount  = maxBucketsCount;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     CQuantileSketch destructor
+    //
+    // Description:
+    //     Destructor.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CQuantileSketch::~CQuantileSketch()
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     GetParams
+    //
+    // Description:
+    //     Returns sketch params.
+    //
+    // Output:
+    //     TQuantileSketchParamsLatest* - pointer to sketch params
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TQuantileSketchParamsLatest* CQuantileSketch::GetParams( void )
+    {
+        return &m_params;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     Add
+    //
+    // Description:
+    //     Adds a value to the sketch.
+    //
+    // Input:
+    //     double value    - value to add, has to be finite
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CQuantileSketch::Add( double value )
+    {
+        if( !std::isfinite( value ) )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: value isn't finite" );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        AddValue( value );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     GetQuantile
+    //
+    // Description:
+    //     Estimates a quantile of added values. The value of rank
+    //     quantile * ( count - 1 ) is searched from the most negative bucket
+    //     up, its bucket value is returned clamped to the exact min and max.
+    //
+    // Input:
+    //     double  quantile - quantile to estimate, from 0 to 1
+    //     double* value    - [out] estimated quantile
+    //
+    // Output:
+    //     TCompletionCode  - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CQuantileSketch::GetQuantile( double quantile, double* value )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, value, CC_ERROR_INVALID_PARAMETER );
+
+        if( !( quantile >= 0.0 && quantile <= 1.0 ) )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: invalid quantile: %f", quantile );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( m_params.Count == 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: quantile sketch is empty" );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        const double rank     = quantile * static_cast<double>( m_params.Count - 1 );
+        uint64_t     count    = 0;
+        bool         isFound  = false;
+        double       estimate = 0.0;
+
+        for( size_t i = m_negative.Counts.size(); i > 0 && !isFound; --i )
+        {
+            count += m_negative.Counts[i - 1];
+            if( static_cast<double>( count ) > rank )
+            {
+                estimate = -GetBucketValue( m_negative.MinIndex + static_cast<int32_t>( i - 1 ) );
+                isFound  = true;
+            }
+        }
+
+        count += m_zeroCount;
+        if( !isFound && static_cast<double>( count ) > rank )
+        {
+            estimate = 0.0;
+            isFound  = true;
+        }
+
+        for( size_t i = 0; i < m_positive.Counts.size() && !isFound; ++i )
+        {
+            count += m_positive.Counts[i];
+            if( static_cast<double>( count ) > rank )
+            {
+                estimate = GetBucketValue( m_positive.MinIndex + static_cast<int32_t>( i ) );
+                isFound  = true;
+            }
+        }
+
+        if( !isFound )
+        {
+            // Rounding of a rank close to count, the last value
+            estimate = m_params.Max;
+        }
+
+        *value = std::clamp( estimate, m_params.Min, m_params.Max );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     Merge
+    //
+    // Description:
+    //     Adds all values of another sketch with the same relative accuracy.
+    //     Merging a sketch with itself doubles its counts.
+    //
+    // Input:
+    //     IQuantileSketchLatest* sketch - sketch to merge
+    //
+    // Output:
+    //     TCompletionCode               - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CQuantileSketch::Merge( IQuantileSketchLatest* sketch )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, sketch, CC_ERROR_INVALID_PARAMETER );
+
+        auto& source = *static_cast<CQuantileSketch*>( sketch );
+
+        if( source.m_params.RelativeAccuracy != m_params.RelativeAccuracy )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: relative accuracy mismatch: %f, expected: %f", source.m_params.RelativeAccuracy, m_params.RelativeAccuracy );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        if( &source == this )
+        {
+            const TStore negative = m_negative;
+            const TStore positive = m_positive;
+
+            MergeStores( negative, positive, m_zeroCount, m_params.Count, m_params.Min, m_params.Max, m_params.Sum );
+        }
+        else
+        {
+            MergeStores( source.m_negative, source.m_positive, source.m_zeroCount, source.m_params.Count, source.m_params.Min, source.m_params.Max, source.m_params.Sum );
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     MergeFromBuffer
+    //
+    // Description:
+    //     Adds all values of a sketch serialized by WriteToBuffer. The buffer
+    //     is fully validated before the sketch is modified.
+    //
+    // Input:
+    //     const uint8_t* buffer     - serialized sketch
+    //     uint32_t       bufferSize - buffer size
+    //
+    // Output:
+    //     TCompletionCode           - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CQuantileSketch::MergeFromBuffer( const uint8_t* buffer, uint32_t bufferSize )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, buffer, CC_ERROR_INVALID_PARAMETER );
+
+        uint32_t magic            = 0;
+        uint32_t version          = 0;
+        double   relativeAccuracy = 0.0;
+        uint64_t count            = 0;
+        uint64_t zeroCount        = 0;
+        double   min              = 0.0;
+        double   max              = 0.0;
+        double   sum              = 0.0;
+        TStore   negative         = { 0, {} };
+        TStore   positive         = { 0, {} };
+        uint32_t bufferOffset     = 0;
+
+        constexpr uint32_t headerSize = 2 * sizeof( uint32_t ) + sizeof( double ) + 2 * sizeof( uint64_t ) + 3 * sizeof( double );
+
+        if( bufferSize < headerSize )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: quantile sketch buffer too small: %u", bufferSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        const auto read = [&]( auto& value )
+        {
+            ReadLittleEndian( buffer, bufferOffset, value );
+        };
+
+        read( magic );
+        read( version );
+        read( relativeAccuracy );
+        read( count );
+        read( zeroCount );
+        read( min );
+        read( max );
+        read( sum );
+
+        if( magic != BUFFER_MAGIC || version != BUFFER_VERSION )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: invalid quantile sketch buffer, magic: 0x%x, version: %u", magic, version );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( relativeAccuracy != m_params.RelativeAccuracy )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: relative accuracy mismatch: %f, expected: %f", relativeAccuracy, m_params.RelativeAccuracy );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+        if( !ReadStore( buffer, bufferSize, bufferOffset, negative ) || !ReadStore( buffer, bufferSize, bufferOffset, positive ) )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: invalid quantile sketch buffer stores, size: %u", bufferSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        // Counts of a hostile buffer may overflow, the sum must still match count.
+        uint64_t   storesCount      = zeroCount;
+        bool       isCountsOverflow = false;
+        const auto addCounts        = [&]( const TStore& store )
+        {
+            for( const auto bucketCount : store.Counts )
+            {
+                isCountsOverflow |= bucketCount > UINT64_MAX - storesCount;
+                storesCount += bucketCount;
+            }
+        };
+
+        addCounts( negative );
+        addCounts( positive );
+
+        const bool isRangeValid = count == 0 || ( std::isfinite( min ) && std::isfinite( max ) && std::isfinite( sum ) && min <= max );
+
+        if( isCountsOverflow || storesCount != count || !isRangeValid )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: inconsistent quantile sketch buffer, count: %" PRIu64, count );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        MergeStores( negative, positive, zeroCount, count, min, max, sum );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     WriteToBuffer
+    //
+    // Description:
+    //     Serializes the sketch. If buffer is nullptr, only the required
+    //     buffer size is returned.
+    //
+    // Input:
+    //     uint8_t*  buffer     - [out] serialized sketch, may be nullptr
+    //     uint32_t* bufferSize - [in/out] buffer size, required size on output
+    //
+    // Output:
+    //     TCompletionCode      - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CQuantileSketch::WriteToBuffer( uint8_t* buffer, uint32_t* bufferSize )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, bufferSize, CC_ERROR_INVALID_PARAMETER );
+
+        const size_t requiredSize = 2 * sizeof( uint32_t ) + sizeof( double ) + 2 * sizeof( uint64_t ) + 3 * sizeof( double )
+            + 2 * ( sizeof( int32_t ) + sizeof( uint32_t ) )
+            + ( m_negative.Counts.size() + m_positive.Counts.size() ) * sizeof( uint64_t );
+
+        if( buffer == nullptr )
+        {
+            *bufferSize = static_cast<uint32_t>( requiredSize );
+            return CC_OK;
+        }
+        if( *bufferSize < requiredSize )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "error: quantile sketch buffer too small: %u, required: %u", *bufferSize, static_cast<uint32_t>( requiredSize ) );
+            *bufferSize = static_cast<uint32_t>( requiredSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        uint32_t bufferOffset = 0;
+
+        const auto write = [&]( const auto value )
+        {
+            WriteLittleEndian( value, buffer, bufferOffset );
+        };
+
+        write( BUFFER_MAGIC );
+        write( BUFFER_VERSION );
+        write( m_params.RelativeAccuracy );
+        write( m_params.Count );
+        write( m_zeroCount );
+        write( m_params.Min );
+        write( m_params.Max );
+        write( m_params.Sum );
+
+        WriteStore( m_negative, buffer, bufferOffset );
+        WriteStore( m_positive, buffer, bufferOffset );
+
+        *bufferSize = bufferOffset;
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     Reset
+    //
+    // Description:
+    //     Removes all values, allocated buckets are kept.
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CQuantileSketch::Reset( void )
+    {
+        m_params.Count = 0;
+        m_params.Min   = 0.0;
+        m_params.Max   = 0.0;
+        m_params.Sum   = 0.0;
+        m_zeroCount    = 0;
+
+        m_negative.Counts.clear();
+        m_positive.Counts.clear();
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     AddValue
+    //
+    // Description:
+    //     Adds a value to the sketch, values which aren't finite are skipped.
+    //     Used for calculated metrics.
+    //
+    // Input:
+    //     const double value - value to add
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CQuantileSketch::AddValue( const double value )
+    {
+        if( !std::isfinite( value ) )
+        {
+            return;
+        }
+
+        if( value > 0.0 )
+        {
+            AddToStore( m_positive, static_cast<int32_t>( std::ceil( std::log( value ) / m_logGamma ) ), 1 );
+        }
+        else if( value < 0.0 )
+        {
+            AddToStore( m_negative, static_cast<int32_t>( std::ceil( std::log( -value ) / m_logGamma ) ), 1 );
+        }
+        else
+        {
+            ++m_zeroCount;
+        }
+
+        m_params.Min = ( m_params.Count == 0 ) ? value : std::min( m_params.Min, value );
+        m_params.Max = ( m_params.Count == 0 ) ? value : std::max( m_params.Max, value );
+        m_params.Sum += value;
+        ++m_params.Count;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     AreParamsValid
+    //
+    // Description:
+    //     Validates sketch params.
+    //
+    // Input:
+    //     const uint32_t adapterId        - adapter id for logging
+    //     const double   relativeAccuracy - relative accuracy of quantiles
+    //     const uint32_t maxBucketsCount  - max buckets count of a store
+    //
+    // Output:
+    //     bool                            - true if params are valid
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CQuantileSketch::AreParamsValid( const uint32_t adapterId, const double relativeAccuracy, const uint32_t maxBucketsCount )
+    {
+        if( !( relativeAccuracy >= MIN_RELATIVE_ACCURACY && relativeAccuracy < 1.0 ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid quantile sketch relative accuracy: %f, min: %f", relativeAccuracy, MIN_RELATIVE_ACCURACY );
+            return false;
+        }
+        if( maxBucketsCount == 0 || maxBucketsCount > MAX_BUCKETS_COUNT )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "error: invalid quantile sketch max buckets count: %u, max: %u", maxBucketsCount, MAX_BUCKETS_COUNT );
+            return false;
+        }
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     AddToStore
+    //
+    // Description:
+    //     Adds count to a bucket, growing the store if needed. If the store
+    //     would span more than MaxBucketsCount buckets, its lowest buckets are
+    //     collapsed into the lowest kept one.
+    //
+    // Input:
+    //     TStore&        store - store to modify
+    //     int32_t        index - bucket index
+    //     const uint64_t count - count to add
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CQuantileSketch::AddToStore( TStore& store, int32_t index, const uint64_t count )
+    {
+        if( store.Counts.empty() )
+        {
+            store.MinIndex = index;
+            store.Counts.assign( 1, count );
+            return;
+        }
+
+        const int64_t maxIndex    = static_cast<int64_t>( store.MinIndex ) + static_cast<int64_t>( store.Counts.size() ) - 1;
+        const int64_t newMaxIndex = std::max<int64_t>( maxIndex, index );
+        int64_t       newMinIndex = std::min<int64_t>( store.MinIndex, index );
+
+        if( newMaxIndex - newMinIndex + 1 > m_params.MaxBucketsCount )
+        {
+            newMinIndex = newMaxIndex - m_params.MaxBucketsCount + 1;
+            index       = static_cast<int32_t>( std::max<int64_t>( index, newMinIndex ) );
+        }
+
+        if( newMinIndex < store.MinIndex )
+        {
+            store.Counts.insert( store.Counts.begin(), static_cast<size_t>( store.MinIndex - newMinIndex ), 0 );
+        }
+        else if( newMinIndex > store.MinIndex )
+        {
+            const size_t collapsedCount = static_cast<size_t>( std::min<int64_t>( newMinIndex, maxIndex + 1 ) - store.MinIndex );
+            uint64_t     collapsed      = 0;
+
+            for( size_t i = 0; i < collapsedCount; ++i )
+            {
+                collapsed += store.Counts[i];
+            }
+
+            store.Counts.erase( store.Counts.begin(), store.Counts.begin() + collapsedCount );
+            if( store.Counts.empty() )
+            {
+                store.Counts.push_back( 0 );
+            }
+            store.Counts[0] += collapsed;
+        }
+
+        store.MinIndex = static_cast<int32_t>( newMinIndex );
+        store.Counts.resize( static_cast<size_t>( newMaxIndex - newMinIndex + 1 ), 0 );
+        store.Counts[static_cast<size_t>( index - store.MinIndex )] += count;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     MergeStores
+    //
+    // Description:
+    //     Adds bucket counts and summary values of another sketch.
+    //
+    // Input:
+    //     const TStore&  negative  - negative values store
+    //     const TStore&  positive  - positive values store
+    //     const uint64_t zeroCount - zero values count
+    //     const uint64_t count     - values count
+    //     const double   min       - min value
+    //     const double   max       - max value
+    //     const double   sum       - sum of values
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CQuantileSketch::MergeStores( const TStore& negative, const TStore& positive, const uint64_t zeroCount, const uint64_t count, const double min, const double max, const double sum )
+    {
+        if( count == 0 )
+        {
+            return;
+        }
+
+        for( size_t i = 0; i < negative.Counts.size(); ++i )
+        {
+            if( negative.Counts[i] != 0 )
+            {
+                AddToStore( m_negative, negative.MinIndex + static_cast<int32_t>( i ), negative.Counts[i] );
+            }
+        }
+        for( size_t i = 0; i < positive.Counts.size(); ++i )
+        {
+            if( positive.Counts[i] != 0 )
+            {
+                AddToStore( m_positive, positive.MinIndex + static_cast<int32_t>( i ), positive.Counts[i] );
+            }
+        }
+
+        m_zeroCount += zeroCount;
+        m_params.Min = ( m_params.Count == 0 ) ? min : std::min( m_params.Min, min );
+        m_params.Max = ( m_params.Count == 0 ) ? max : std::max( m_params.Max, max );
+        m_params.Sum += sum;
+        m_params.Count += count;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     GetBucketValue
+    //
+    // Description:
+    //     Returns the value representing a bucket ( gamma^(i-1), gamma^i ],
+    //     within relative accuracy of all its values.
+    //
+    // Input:
+    //     const int32_t index - bucket index
+    //
+    // Output:
+    //     double              - bucket value
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    double CQuantileSketch::GetBucketValue( const int32_t index ) const
+    {
+        return 2.0 * std::exp( index * m_logGamma ) / ( m_gamma + 1.0 );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     ReadStore
+    //
+    // Description:
+    //     Reads a serialized store, checking buffer bounds and bucket indices.
+    //
+    // Input:
+    //     const uint8_t* buffer       - serialized sketch
+    //     const uint32_t bufferSize   - buffer size
+    //     uint32_t&      bufferOffset - [in/out] offset of the store
+    //     TStore&        store        - [out] store
+    //
+    // Output:
+    //     bool                        - true if the store is valid
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CQuantileSketch::ReadStore( const uint8_t* buffer, const uint32_t bufferSize, uint32_t& bufferOffset, TStore& store )
+    {
+        uint32_t bucketsCount = 0;
+
+        if( bufferSize - bufferOffset < sizeof( store.MinIndex ) + sizeof( bucketsCount ) )
+        {
+            return false;
+        }
+
+        ReadLittleEndian( buffer, bufferOffset, store.MinIndex );
+        ReadLittleEndian( buffer, bufferOffset, bucketsCount );
+
+        const uint64_t countsSize = static_cast<uint64_t>( bucketsCount ) * sizeof( uint64_t );
+
+        if( bucketsCount > MAX_BUCKETS_COUNT || countsSize > bufferSize - bufferOffset
+            || static_cast<int64_t>( store.MinIndex ) + bucketsCount - 1 > INT32_MAX )
+        {
+            return false;
+        }
+
+        store.Counts.resize( bucketsCount );
+        for( auto& bucketCount : store.Counts )
+        {
+            ReadLittleEndian( buffer, bufferOffset, bucketCount );
+        }
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     WriteStore
+    //
+    // Description:
+    //     Serializes a store, buffer size has to be checked by the caller.
+    //
+    // Input:
+    //     const TStore& store        - store
+    //     uint8_t*      buffer       - [out] serialized sketch
+    //     uint32_t&     bufferOffset - [in/out] offset of the store
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CQuantileSketch::WriteStore( const TStore& store, uint8_t* buffer, uint32_t& bufferOffset )
+    {
+        WriteLittleEndian( store.MinIndex, buffer, bufferOffset );
+        WriteLittleEndian( static_cast<uint32_t>( store.Counts.size() ), buffer, bufferOffset );
+
+        for( const auto bucketCount : store.Counts )
+        {
+            WriteLittleEndian( bucketCount, buffer, bufferOffset );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     ReadLittleEndian
+    //
+    // Description:
+    //     Reads a little-endian integer or double, buffer size has to be checked
+    //     by the caller.
+    //
+    // Input:
+    //     const uint8_t* buffer       - serialized sketch
+    //     uint32_t&      bufferOffset - [in/out] offset of the value
+    //     T&             value        - [out] value
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    void CQuantileSketch::ReadLittleEndian( const uint8_t* buffer, uint32_t& bufferOffset, T& value )
+    {
+        static_assert( ( std::is_integral_v<T> || std::is_same_v<T, double> ) && ( sizeof( T ) == sizeof( uint32_t ) || sizeof( T ) == sizeof( uint64_t ) ) );
+
+        std::conditional_t<sizeof( T ) == sizeof( uint64_t ), uint64_t, uint32_t> bits = 0;
+
+        for( uint32_t i = 0; i < sizeof( bits ); ++i )
+        {
+            bits |= static_cast<decltype( bits )>( buffer[bufferOffset + i] ) << ( 8 * i );
+        }
+        bufferOffset += sizeof( bits );
+
+        iu_memcpy_s( &value, sizeof( value ), &bits, sizeof( bits ) );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CQuantileSketch
+    //
+    // Method:
+    //     WriteLittleEndian
+    //
+    // Description:
+    //     Writes a little-endian integer or double, buffer size has to be
+    //     checked by the caller.
+    //
+    // Input:
+    //     const T   value        - value
+    //     uint8_t*  buffer       - [out] serialized sketch
+    //     uint32_t& bufferOffset - [in/out] offset of the value
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    void CQuantileSketch::WriteLittleEndian( const T value, uint8_t* buffer, uint32_t& bufferOffset )
+    {
+        static_assert( ( std::is_integral_v<T> || std::is_same_v<T, double> ) && ( sizeof( T ) == sizeof( uint32_t ) || sizeof( T ) == sizeof( uint64_t ) ) );
+
+        std::conditional_t<sizeof( T ) == sizeof( uint64_t ), uint64_t, uint32_t> bits = 0;
+
+        iu_memcpy_s( &bits, sizeof( bits ), &value, sizeof( value ) );
+
+        for( uint32_t i = 0; i < sizeof( bits ); ++i )
+        {
+            buffer[bufferOffset + i] = static_cast<uint8_t>( bits >> ( 8 * i ) );
+        }
+        bufferOffset += sizeof( bits );
+    }
+} // namespace MetricsDiscoveryInternal
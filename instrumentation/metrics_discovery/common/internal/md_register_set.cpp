@@ -64,7 +64,7 @@ namespace MetricsDiscoveryInternal
     CRegisterSet::~CRegisterSet()
     {
         ClearList( m_regList );
-        MD_SAFE_DELETE( m_availabilityEquation );
+        m_device.GetEquationCache().ReleaseEquation( m_availabilityEquation );
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -46,6 +46,7 @@ namespace MetricsDiscoveryInternal
         , m_maxL3Node( 0 )
         , m_maxL3BankPerL3Node( 0 )
         , m_maxCopyEngine( 0 )
+        , m_generation( 0 )
     {
         m_symbolMap.reserve( SYMBOLS_MAP_RESERVE );
     }
@@ -101,6 +102,28 @@ namespace MetricsDiscoveryInternal
         return static_cast<uint32_t>( m_symbolMap.size() );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CSymbolSet
+    //
+    // Method:
+    //     GetGeneration
+    //
+    // Description:
+    //     Returns symbol set generation. It changes whenever a symbol is added,
+    //     so results computed from symbol values can be reused while it's
+    //     the same.
+    //
+    // Output:
+    //     uint32_t -  symbol set generation
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CSymbolSet::GetGeneration()
+    {
+        return m_generation;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -237,6 +260,7 @@ namespace MetricsDiscoveryInternal
             symbol->symbol.SymbolTypedValue = typedValue;
         }
         m_symbolMap.emplace( symbol->symbol.SymbolName, symbol );
+        m_generation++;
 
         if( typedValue.ValueType == VALUE_TYPE_BYTEARRAY )
         {
@@ -0,0 +1,321 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_timestamp_correlation.cpp
+
+//     Abstract:   C++ Metrics Discovery internal gpu / cpu timestamp correlation implementation
+
+#include "md_timestamp_correlation.h"
+#include "md_adapter.h"
+#include "md_metrics_device.h"
+
+#include "md_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Method:
+    //     CTimestampCorrelation constructor
+    //
+    // Description:
+    //     Constructor. The first sample is taken on the first Update.
+    //
+    // Input:
+    //     CMetricsDevice& device - parent metrics device
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CTimestampCorrelation::CTimestampCorrelation( CMetricsDevice& device )
+        : m_device( device )
+        , m_mutex()
+        , m_gpuSamples{}
+        , m_cpuSamples{}
+        , m_samplesCount( 0 )
+        , m_nextSample( 0 )
+        , m_lastSampleNs( 0 )
+        , m_lastGpuSample( 0 )
+        , m_gpuWrapNs( 0 )
+        , m_gpuReference( 0 )
+        , m_gpuReferenceWrapped( 0 )
+        , m_cpuReference( 0 )
+        , m_slope( 1.0 )
+        , m_isValid( false )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Method:
+    //     Update
+    //
+    // Description:
+    //     Samples a new (gpu, cpu) timestamp pair and refits the model if the
+    //     sampling period has elapsed since the last sample. Otherwise only
+    //     the steady clock is read, which does not enter the kernel.
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* if the model can be used
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CTimestampCorrelation::Update()
+    {
+        const uint64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_isValid && nowNs - m_lastSampleNs < SAMPLING_PERIOD_NS )
+        {
+            return CC_OK;
+        }
+
+        const TCompletionCode ret = AddSample( nowNs );
+
+        // Keep using the previous model if sampling failed.
+        return m_isValid ? CC_OK : ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Method:
+    //     ConvertToCpuTimestamps
+    //
+    // Description:
+    //     Converts gpu timestamps of calculated reports to cpu timestamps in one
+    //     pass. Cpu timestamps are set to 0 if the model is not available.
+    //     Report timestamps wrap, their distance to the latest sample is taken
+    //     modulo the wrap period, in range of +/- half of the period.
+    //
+    // Input:
+    //     TTypedValue_1_0* reports      - (in/out) calculated reports
+    //     const uint32_t   reportsCount - number of reports
+    //     const uint32_t   reportSize   - number of values in a single report
+    //     const uint32_t   gpuIndex     - index of gpu timestamp (ns) in a report
+    //     const uint32_t   cpuIndex     - index of cpu timestamp (ns) to write in a report
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CTimestampCorrelation::ConvertToCpuTimestamps( TTypedValue_1_0* reports, const uint32_t reportsCount, const uint32_t reportSize, const uint32_t gpuIndex, const uint32_t cpuIndex )
+    {
+        uint64_t gpuReference = 0;
+        uint64_t cpuReference = 0;
+        int64_t  wrap         = 0;
+        double   slope        = 0.0;
+        bool     isValid      = false;
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            gpuReference = m_gpuReferenceWrapped;
+            cpuReference = m_cpuReference;
+            wrap         = static_cast<int64_t>( m_gpuWrapNs );
+            slope        = m_slope;
+            isValid      = m_isValid;
+        }
+
+        for( uint32_t i = 0; i < reportsCount; ++i )
+        {
+            TTypedValue_1_0* report = reports + static_cast<size_t>( i ) * reportSize;
+            int64_t          delta  = static_cast<int64_t>( report[gpuIndex].ValueUInt64 - gpuReference );
+
+            if( wrap > 0 )
+            {
+                delta %= wrap;
+                delta = ( delta >= wrap / 2 ) ? delta - wrap : ( delta < -wrap / 2 ) ? delta + wrap : delta;
+            }
+
+            report[cpuIndex].ValueType   = VALUE_TYPE_UINT64;
+            report[cpuIndex].ValueUInt64 = isValid
+                ? cpuReference + static_cast<uint64_t>( std::llround( static_cast<double>( delta ) * slope ) )
+                : 0;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Method:
+    //     AddSample
+    //
+    // Description:
+    //     Reads gpu and cpu timestamps from the driver, stores them in the ring
+    //     of the last samples and refits the model. The gpu timestamp is extended
+    //     over wraps since the previous sample, the elapsed cpu time tells how
+    //     many wrap periods passed.
+    //
+    // Input:
+    //     const uint64_t nowNs - current steady clock time
+    //
+    // Output:
+    //     TCompletionCode      - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CTimestampCorrelation::AddSample( const uint64_t nowNs )
+    {
+        uint64_t gpuTimestampNs = 0;
+        uint64_t cpuTimestampNs = 0;
+        uint32_t cpuId          = 0;
+
+        const TCompletionCode ret = m_device.GetGpuCpuTimestamps( &gpuTimestampNs, &cpuTimestampNs, &cpuId );
+        if( ret != CC_OK )
+        {
+            MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_DEBUG, "Gpu cpu timestamps not available, result: %u", ret );
+            return ret;
+        }
+
+        uint64_t extendedGpuNs = gpuTimestampNs;
+
+        if( m_samplesCount > 0 )
+        {
+            const uint32_t latest   = ( m_nextSample + SAMPLES_COUNT - 1 ) % SAMPLES_COUNT;
+            const int64_t  cpuDelta = static_cast<int64_t>( cpuTimestampNs - m_cpuSamples[latest] );
+            int64_t        gpuDelta = static_cast<int64_t>( gpuTimestampNs - m_lastGpuSample );
+
+            if( m_gpuWrapNs > 0 )
+            {
+                const int64_t wrap = static_cast<int64_t>( m_gpuWrapNs );
+
+                gpuDelta += std::llround( static_cast<double>( cpuDelta - gpuDelta ) / wrap ) * wrap;
+            }
+
+            // Gpu timestamp may be reset, e.g. after device suspend. Drop older samples then.
+            // Otherwise both clocks advance alike, up to clock drift and sampling latency.
+            if( gpuDelta < 0 || std::llabs( gpuDelta - cpuDelta ) > cpuDelta / MAX_DRIFT_DIVIDER + MAX_SAMPLE_ERROR_NS )
+            {
+                m_samplesCount = 0;
+                m_nextSample   = 0;
+            }
+            else
+            {
+                extendedGpuNs = m_gpuSamples[latest] + gpuDelta;
+            }
+        }
+
+        if( m_samplesCount == 0 )
+        {
+            m_gpuWrapNs = GetGpuWrapPeriod();
+        }
+
+        m_gpuSamples[m_nextSample] = extendedGpuNs;
+        m_cpuSamples[m_nextSample] = cpuTimestampNs;
+        m_nextSample               = ( m_nextSample + 1 ) % SAMPLES_COUNT;
+        m_samplesCount             = std::min( m_samplesCount + 1, SAMPLES_COUNT );
+        m_lastSampleNs             = nowNs;
+        m_lastGpuSample            = gpuTimestampNs;
+
+        FitModel();
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Method:
+    //     FitModel
+    //
+    // Description:
+    //     Fits cpu = cpuReference + ( gpu - gpuReference ) * slope to stored samples
+    //     with least squares. References are the latest sample, so the offset
+    //     is exact at the latest sample and the slope models clock drift.
+    //     Differences are small, so double precision is enough.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CTimestampCorrelation::FitModel()
+    {
+        const uint32_t latest = ( m_nextSample + SAMPLES_COUNT - 1 ) % SAMPLES_COUNT;
+
+        m_gpuReference        = m_gpuSamples[latest];
+        m_gpuReferenceWrapped = m_lastGpuSample;
+        m_cpuReference        = m_cpuSamples[latest];
+        m_slope               = 1.0;
+        m_isValid             = true;
+
+        if( m_samplesCount < 2 )
+        {
+            return;
+        }
+
+        double gpuMean = 0.0;
+        double cpuMean = 0.0;
+
+        for( uint32_t i = 0; i < m_samplesCount; ++i )
+        {
+            gpuMean += static_cast<double>( static_cast<int64_t>( m_gpuSamples[i] - m_gpuReference ) );
+            cpuMean += static_cast<double>( static_cast<int64_t>( m_cpuSamples[i] - m_cpuReference ) );
+        }
+
+        gpuMean /= m_samplesCount;
+        cpuMean /= m_samplesCount;
+
+        double covariance = 0.0;
+        double variance   = 0.0;
+
+        for( uint32_t i = 0; i < m_samplesCount; ++i )
+        {
+            const double gpuDelta = static_cast<double>( static_cast<int64_t>( m_gpuSamples[i] - m_gpuReference ) ) - gpuMean;
+            const double cpuDelta = static_cast<double>( static_cast<int64_t>( m_cpuSamples[i] - m_cpuReference ) ) - cpuMean;
+
+            covariance += gpuDelta * cpuDelta;
+            variance += gpuDelta * gpuDelta;
+        }
+
+        if( variance > 0.0 )
+        {
+            m_slope = covariance / variance;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CTimestampCorrelation
+    //
+    // Method:
+    //     GetGpuWrapPeriod
+    //
+    // Description:
+    //     Returns the period in ns after which gpu timestamps wrap, i.e. the
+    //     highest timestamp (MaxTimestamp) plus one gpu timestamp tick.
+    //
+    // Output:
+    //     uint64_t - wrap period in ns, 0 if unknown
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint64_t CTimestampCorrelation::GetGpuWrapPeriod()
+    {
+        const TTypedValue_1_0* maxTimestamp = m_device.GetGlobalSymbolValueByName( "MaxTimestamp" );
+        const TTypedValue_1_0* frequency    = m_device.GetGlobalSymbolValueByName( "GpuTimestampFrequency" );
+
+        if( maxTimestamp == nullptr || frequency == nullptr || maxTimestamp->ValueUInt64 == 0 || frequency->ValueUInt32 == 0 )
+        {
+            MD_LOG_A( m_device.GetAdapter().GetAdapterId(), LOG_DEBUG, "Gpu timestamp wrap period not available" );
+            return 0;
+        }
+
+        const uint64_t wrapNs = maxTimestamp->ValueUInt64 + MD_SECOND_IN_NS / frequency->ValueUInt32;
+
+        // Timestamps too wide to wrap in practice are used as they are.
+        return ( wrapNs > static_cast<uint64_t>( INT64_MAX ) ) ? 0 : wrapNs;
+    }
+} // namespace MetricsDiscoveryInternal
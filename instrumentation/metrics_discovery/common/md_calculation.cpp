@@ -28,6 +28,12 @@ namespace MetricsDiscoveryInternal
     // Forward declarations //
     template <>
     int32_t CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::GetInformationIndex( const char* symbolName, CMetricSet* metricSet );
+    template <>
+    void CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::FindReportsToCalculate( TCalculationContext& context );
+    template <>
+    bool CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::CalculateNextFilteredReport( TCalculationContext& context );
+    template <>
+    void CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::CalculateReport( TCalculationContext& context );
 
     //////////////////////////////////////////////////////////////////////////////
     //
@@ -107,12 +113,26 @@ namespace MetricsDiscoveryInternal
             sc->ContextIdIdx    = GetInformationIndex( "ContextId", sc->MetricSet );
             sc->ReportReasonIdx = GetInformationIndex( "ReportReason", sc->MetricSet );
 
-            if( sc->DoContextFiltering && sc->ContextIdIdx < 0 )
+            if( sc->DoContextFiltering && ( sc->ContextIdIdx < 0 || sc->ContextIds == nullptr ) )
             {
                 MD_LOG_A( adapterId, LOG_ERROR, "error: can't find required information for context filtering" );
                 MD_LOG_EXIT_A( adapterId );
                 return CC_ERROR_INVALID_PARAMETER;
             }
+
+            if( sc->ReportReasonMask != 0 && sc->ReportReasonIdx < 0 )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: can't find required information for report reason filtering" );
+                MD_LOG_EXIT_A( adapterId );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
+
+            if( ( sc->DoContextFiltering || sc->ReportReasonMask != 0 ) && ( sc->ReportNumbers == nullptr || sc->PrevReportNumbers == nullptr ) )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "error: report filtering buffers not provided" );
+                MD_LOG_EXIT_A( adapterId );
+                return CC_ERROR_INVALID_PARAMETER;
+            }
         }
 
         if( isRawDataProvided )
@@ -133,6 +153,11 @@ namespace MetricsDiscoveryInternal
 
         sc->Calculator->Reset( sc->RawReportSize, sc->MetricsAndInformationCount );
 
+        if( isRawDataProvided && ( sc->DoContextFiltering || sc->ReportReasonMask != 0 ) )
+        {
+            FindReportsToCalculate( context );
+        }
+
         return CC_OK;
     }
 
@@ -194,8 +219,8 @@ namespace MetricsDiscoveryInternal
     // Description:
     //     Calculates a single report for a IoStream measurements using raw data and
     //     other state variables stored in the given calculation context.
-    //     If context filtering is enabled calculation is performed only if starting raw report
-    //     is from appropriate context id.
+    //     If context or report reason filtering is enabled only selected reports
+    //     are calculated, see CalculateNextFilteredReport.
     //
     // Input:
     //     TCalculationContext& context - (IN/OUT) calculation context
@@ -211,6 +236,11 @@ namespace MetricsDiscoveryInternal
         TStreamCalculationContext* sc = &context.StreamCalculationContext;
         MD_CHECK_PTR_RET( sc->Calculator, false );
 
+        if( sc->DoContextFiltering || sc->ReportReasonMask != 0 )
+        {
+            return CalculateNextFilteredReport( context );
+        }
+
         const uint32_t adapterId = sc->Calculator->GetMetricsDevice().GetAdapter().GetAdapterId();
 
         const bool isSavedReport  = sc->Calculator->SavedReportPresent();
@@ -246,27 +276,7 @@ namespace MetricsDiscoveryInternal
             sc->LastRawReportNumber = sc->PrevRawReportNumber + 1;
         }
 
-        // METRICS
-        sc->Calculator->ReadMetricsFromIoReport( sc->LastRawDataPtr, sc->PrevRawDataPtr, sc->DeltaValues, *sc->MetricSet );
-        // NORMALIZATION
-        sc->Calculator->NormalizeMetrics( sc->DeltaValues, sc->OutPtr, *sc->MetricSet );
-        // INFORMATION
-        sc->Calculator->ReadInformation( sc->LastRawDataPtr, sc->OutPtr + sc->MetricSet->GetParams()->MetricsCount, *sc->MetricSet, sc->ContextIdIdx );
-        // MAX VALUES
-        if( sc->OutMaxValues )
-        {
-            sc->Calculator->CalculateMaxValues( sc->DeltaValues, sc->OutPtr, sc->OutMaxValuesPtr, *sc->MetricSet );
-            sc->OutMaxValuesPtr += sc->MetricSet->GetParams()->MetricsCount;
-        }
-
-        // Save calculated report for reuse
-        if( CC_OK != sc->Calculator->SaveCalculatedReport( sc->OutPtr ) )
-        {
-            MD_LOG_A( adapterId, LOG_DEBUG, "Unable to store previous calculated report for reuse." );
-        }
-
-        sc->OutPtr += sc->MetricsAndInformationCount;
-        sc->OutReportCount++;
+        CalculateReport( context );
 
         // Prev is now Last
         sc->PrevRawDataPtr      = sc->LastRawDataPtr;
@@ -341,13 +351,250 @@ namespace MetricsDiscoveryInternal
         }
 
         qc->RawDataPtr += qc->RawReportSize;
-        qc->OutPtr += qc->MetricsAndInformationCount;
+
+        if( qc->OutColumns )
+        {
+            // Out holds the current report only.
+            qc->MetricSet->WriteReportToColumns( qc->OutPtr, qc->OutReportCount, qc->OutColumns, qc->OutColumnsCount );
+        }
+        else
+        {
+            qc->OutPtr += qc->MetricsAndInformationCount;
+        }
 
         qc->OutReportCount++;
 
         return true;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>
+    //
+    // Method:
+    //     FindReportsToCalculate
+    //
+    // Description:
+    //     Finds raw reports to calculate when context or report reason filtering
+    //     is enabled, together with raw reports their deltas start from. Only
+    //     ContextId and ReportReason information are read here, so skipped reports
+    //     never run metric equations.
+    //
+    //     A report is calculated if it is from a given context and its reason is
+    //     in the report reason mask. The delta of a calculated report starts from
+    //     the last calculated report, so reports skipped because of their reason
+    //     are folded into the next calculated one. The delta never starts before
+    //     the last report of another context, so counters gathered while other
+    //     contexts were running are not attributed to the given ones.
+    //
+    //     Both information are read to the output vectors first and then compacted
+    //     in place with a branch-free pass, which the compiler is able to vectorize.
+    //     The write position never passes the read position, so the values not
+    //     read yet are not overwritten.
+    //
+    // Input:
+    //     TCalculationContext& context - (IN/OUT) calculation context
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    template <>
+    void CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::FindReportsToCalculate( TCalculationContext& context )
+    {
+        TStreamCalculationContext* sc                = &context.StreamCalculationContext;
+        std::vector<uint32_t>&     reportNumbers     = *sc->ReportNumbers;
+        std::vector<uint32_t>&     prevReportNumbers = *sc->PrevReportNumbers;
+
+        // The first raw report has no predecessor without the saved one.
+        const bool      isSavedReport    = sc->Calculator->SavedReportPresent();
+        const uint32_t  firstReport      = isSavedReport ? 0 : 1;
+        const uint32_t  candidatesCount  = sc->RawReportCount > firstReport ? sc->RawReportCount - firstReport : 0;
+        const uint32_t  reportReasonMask = sc->ReportReasonMask;
+        const uint32_t  contextIdsCount  = sc->DoContextFiltering ? sc->ContextIdsCount : 0;
+        const uint32_t* contextIds       = sc->ContextIds;
+
+        // Capacity is kept between calculations.
+        reportNumbers.resize( candidatesCount );
+        prevReportNumbers.resize( candidatesCount );
+
+        uint32_t*      contextIdValues    = reportNumbers.data();
+        uint32_t*      reportReasonValues = prevReportNumbers.data();
+        const uint8_t* rawData            = sc->RawData + static_cast<size_t>( firstReport ) * sc->RawReportSize;
+
+        for( uint32_t i = 0; i < candidatesCount; ++i, rawData += sc->RawReportSize )
+        {
+            contextIdValues[i]    = sc->DoContextFiltering ? static_cast<uint32_t>( sc->Calculator->ReadInformationByIndex( rawData, *sc->MetricSet, sc->ContextIdIdx ) ) : 0;
+            reportReasonValues[i] = reportReasonMask ? static_cast<uint32_t>( sc->Calculator->ReadInformationByIndex( rawData, *sc->MetricSet, sc->ReportReasonIdx ) ) : 0;
+        }
+
+        uint32_t matchedCount = 0;
+        uint32_t prevReport   = isSavedReport ? MD_SAVED_REPORT_NUMBER : 0;
+
+        for( uint32_t i = 0; i < candidatesCount; ++i )
+        {
+            const uint32_t reportNumber = i + firstReport;
+            const uint32_t contextId    = contextIdValues[i];
+            const uint32_t reportReason = reportReasonValues[i];
+            bool           isContext    = contextIdsCount == 0;
+
+            for( uint32_t j = 0; j < contextIdsCount; ++j )
+            {
+                isContext |= contextId == contextIds[j];
+            }
+
+            const bool isMatched = isContext && ( reportReasonMask == 0 || ( reportReason & reportReasonMask ) != 0 );
+
+            reportNumbers[matchedCount]     = reportNumber;
+            prevReportNumbers[matchedCount] = prevReport;
+            matchedCount += isMatched;
+
+            // Reports skipped because of their reason are folded into the next delta.
+            prevReport = ( isMatched || !isContext ) ? reportNumber : prevReport;
+        }
+
+        reportNumbers.resize( matchedCount );
+        prevReportNumbers.resize( matchedCount );
+        sc->ReportIndex       = 0;
+        sc->SavedReportNumber = prevReport;
+
+        MD_LOG_A( sc->Calculator->GetMetricsDevice().GetAdapter().GetAdapterId(), LOG_DEBUG, "report filtering: %u of %u raw reports to calculate", matchedCount, sc->RawReportCount );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>
+    //
+    // Method:
+    //     CalculateNextFilteredReport
+    //
+    // Description:
+    //     Calculates the next report found by FindReportsToCalculate, using the
+    //     raw report found for it as the delta start. After the last report, the
+    //     raw report the next delta should start from is saved for the next calculation.
+    //
+    // Input:
+    //     TCalculationContext& context - (IN/OUT) calculation context
+    //
+    // Output:
+    //     bool - true, if report calculated
+    //            false, if not - calculation complete for current context
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    template <>
+    bool CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::CalculateNextFilteredReport( TCalculationContext& context )
+    {
+        TStreamCalculationContext*   sc                = &context.StreamCalculationContext;
+        const std::vector<uint32_t>& reportNumbers     = *sc->ReportNumbers;
+        const std::vector<uint32_t>& prevReportNumbers = *sc->PrevReportNumbers;
+        const uint32_t               adapterId         = sc->Calculator->GetMetricsDevice().GetAdapter().GetAdapterId();
+
+        if( sc->ReportIndex >= reportNumbers.size() )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "Calculation complete" );
+
+            // Saved report is kept if no delta may start after it.
+            if( sc->SavedReportNumber != MD_SAVED_REPORT_NUMBER && sc->SavedReportNumber < sc->RawReportCount &&
+                CC_OK != sc->Calculator->SaveReport( sc->RawData + static_cast<size_t>( sc->SavedReportNumber ) * sc->RawReportSize ) )
+            {
+                MD_LOG_A( adapterId, LOG_DEBUG, "Unable to store last raw report for reuse." );
+            }
+
+            return false;
+        }
+
+        const uint32_t reportNumber     = reportNumbers[sc->ReportIndex];
+        const uint32_t prevReportNumber = prevReportNumbers[sc->ReportIndex];
+        sc->ReportIndex++;
+
+        sc->LastRawDataPtr      = sc->RawData + static_cast<size_t>( reportNumber ) * sc->RawReportSize;
+        sc->LastRawReportNumber = reportNumber;
+        sc->PrevRawReportNumber = prevReportNumber;
+
+        if( prevReportNumber == MD_SAVED_REPORT_NUMBER )
+        {
+            sc->PrevRawDataPtr = sc->Calculator->GetSavedReport();
+            MD_ASSERT_A( adapterId, sc->PrevRawDataPtr != nullptr );
+        }
+        else
+        {
+            sc->PrevRawDataPtr = sc->RawData + static_cast<size_t>( prevReportNumber ) * sc->RawReportSize;
+        }
+
+        // Previous raw report may be skipped, refresh PreviousContextId information.
+        sc->Calculator->ReadContextIdInformation( sc->PrevRawDataPtr, *sc->MetricSet, sc->ContextIdIdx );
+
+        CalculateReport( context );
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>
+    //
+    // Method:
+    //     CalculateReport
+    //
+    // Description:
+    //     Calculates metrics, information and max values for the current
+    //     'Prev' and 'Last' raw reports and moves output pointers forward.
+    //
+    // Input:
+    //     TCalculationContext& context - (IN/OUT) calculation context
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    template <>
+    void CMetricsCalculationManager<MEASUREMENT_TYPE_SNAPSHOT_IO>::CalculateReport( TCalculationContext& context )
+    {
+        TStreamCalculationContext* sc = &context.StreamCalculationContext;
+
+        if( sc->Kernel )
+        {
+            // METRICS
+            sc->Calculator->ReadMetricsFromIoReport( sc->LastRawDataPtr, sc->PrevRawDataPtr, sc->DeltaValues, *sc->Kernel );
+            // NORMALIZATION
+            sc->Calculator->NormalizeMetrics( sc->DeltaValues, sc->OutPtr, *sc->Kernel );
+#if defined( _DEBUG )
+            // Kernel has to give the same results as the interpreter.
+            sc->Calculator->VerifyKernelResults( sc->LastRawDataPtr, sc->PrevRawDataPtr, sc->DeltaValues, sc->OutPtr, *sc->MetricSet );
+#endif
+        }
+        else
+        {
+            // METRICS
+            sc->Calculator->ReadMetricsFromIoReport( sc->LastRawDataPtr, sc->PrevRawDataPtr, sc->DeltaValues, *sc->MetricSet );
+            // NORMALIZATION
+            sc->Calculator->NormalizeMetrics( sc->DeltaValues, sc->OutPtr, *sc->MetricSet );
+        }
+        // INFORMATION
+        sc->Calculator->ReadInformation( sc->LastRawDataPtr, sc->OutPtr + sc->MetricSet->GetParams()->MetricsCount, *sc->MetricSet, sc->ContextIdIdx );
+        // MAX VALUES
+        if( sc->OutMaxValues )
+        {
+            sc->Calculator->CalculateMaxValues( sc->DeltaValues, sc->OutPtr, sc->OutMaxValuesPtr, *sc->MetricSet );
+            sc->OutMaxValuesPtr += sc->MetricSet->GetParams()->MetricsCount;
+        }
+
+        // Save calculated report for reuse
+        if( CC_OK != sc->Calculator->SaveCalculatedReport( sc->OutPtr ) )
+        {
+            MD_LOG_A( sc->Calculator->GetMetricsDevice().GetAdapter().GetAdapterId(), LOG_DEBUG, "Unable to store previous calculated report for reuse." );
+        }
+
+        if( sc->OutColumns )
+        {
+            // Out holds the current report only.
+            sc->MetricSet->WriteReportToColumns( sc->OutPtr, sc->OutReportCount, sc->OutColumns, sc->OutColumnsCount );
+        }
+        else
+        {
+            sc->OutPtr += sc->MetricsAndInformationCount;
+        }
+
+        sc->OutReportCount++;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -56,6 +56,41 @@ extern "C"
         return retVal;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Group:
+    //     API Entry
+    //
+    // Function:
+    //     OpenAdapterGroupFiltered
+    //
+    // Description:
+    //     Opens main MDAPI root object just like OpenAdapterGroup, but only adapters
+    //     matching the given filter are enumerated. Filtered out adapters are never
+    //     opened. The filter is used only when the adapter group is created, if
+    //     an instance was opened before CC_ERROR_INVALID_PARAMETER is returned
+    //     unless the filter type is ADAPTER_FILTER_TYPE_NONE.
+    //
+    // Input:
+    //     const TAdapterFilterLatest* filter       - adapter filter
+    //     IAdapterGroupLatest**       adapterGroup - [out] created / retrieved adapter group
+    //
+    // Output:
+    //     TCompletionCode                          - CC_OK or CC_ALREADY_INITIALIZED means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode OpenAdapterGroupFiltered( const TAdapterFilterLatest* filter, IAdapterGroupLatest** adapterGroup )
+    {
+        MD_LOG_ENTER();
+        MD_CHECK_PTR_RET( filter, CC_ERROR_INVALID_PARAMETER );
+        MD_CHECK_PTR_RET( adapterGroup, CC_ERROR_INVALID_PARAMETER );
+
+        TCompletionCode retVal = CAdapterGroup::Open( (CAdapterGroup**) adapterGroup, filter );
+
+        MD_LOG_EXIT();
+        return retVal;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Group:
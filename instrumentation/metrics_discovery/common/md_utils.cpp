@@ -22,6 +22,7 @@ SPDX-License-Identifier: MIT
 #include "md_register_set.h"
 #include "md_metric_enumerator.h"
 #include "md_metric_prototype.h"
+#include "md_quantile_sketch.h"
 
 #include <cmath>
 #include <cstring>
@@ -151,7 +152,8 @@ namespace MetricsDiscoveryInternal
     //     SetEquation
     //
     // Description:
-    //     Sets the given equation.
+    //     Sets the given equation. Equal equations are shared through
+    //     the device equation cache.
     //
     // Input:
     //     CMetricsDevice& device         - metric device
@@ -166,22 +168,13 @@ namespace MetricsDiscoveryInternal
     {
         TCompletionCode ret = CC_OK;
 
-        // Delete previous equation if any
-        MD_SAFE_DELETE( equation );
+        // Release previous equation if any
+        device.GetEquationCache().ReleaseEquation( equation );
 
         // nullptr is fine condition for "" equations
         if( equationString != nullptr && strcmp( equationString, "" ) != 0 )
         {
-            equation = new( std::nothrow ) CEquation( device );
-            if( equation == nullptr )
-            {
-                ret = CC_ERROR_NO_MEMORY;
-            }
-            else if( !equation->ParseEquationString( equationString ) )
-            {
-                MD_SAFE_DELETE( equation );
-                ret = CC_ERROR_GENERAL;
-            }
+            ret = device.GetEquationCache().GetEquation( equationString, equation );
         }
 
         return ret;
@@ -1518,6 +1511,7 @@ namespace MetricsDiscoveryInternal
     template void ClearVector( std::vector<TArchEvent*>& );
     template void ClearVector( std::vector<THwEvent*>& );
     template void ClearVector( std::vector<TMetricPrototypeOptionDescriptorLatest*>& );
+    template void ClearVector( std::vector<CQuantileSketch*>& );
     template void ClearList( std::list<uint64_t>& );
     template void ClearList( std::list<CRegisterSet*>& );
     template void ClearList( std::list<CMetricSet*>& );
@@ -13,10 +13,16 @@ SPDX-License-Identifier: MIT
 #pragma once
 
 #include "md_driver_ifc.h"
+#include "md_pmu_linux.h"
+#include "md_drm_fdinfo_linux.h"
 
 #include <mutex>
 #include <chrono>
+#include <array>
 #include <vector> // for Query
+#include <string>
+#include <memory>
+#include <unordered_map>
 #include <condition_variable>
 
 //////////////////////////////////////////////////////////////////////////////
@@ -37,6 +43,20 @@ SPDX-License-Identifier: MIT
 //////////////////////////////////////////////////////////////////////////////
 #define MD_TIMESTAMP_LOW_OFFSET 0x2358
 
+//////////////////////////////////////////////////////////////////////////////
+//
+// Description:
+//     Concurrent group lock. The lock is a flock on a per adapter file, released
+//     by the kernel when the owning process exits. Default timeout may be changed
+//     with the environment variable or per concurrent group with SetLockTimeout,
+//     0 means try-lock without waiting.
+//
+//////////////////////////////////////////////////////////////////////////////
+#define MD_CONCURRENT_GROUP_LOCK_DIRECTORY       "/run/lock"
+#define MD_CONCURRENT_GROUP_LOCK_TIMEOUT         "MD_CONCURRENT_GROUP_LOCK_TIMEOUT" // in milliseconds
+#define MD_CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT 1000
+#define MD_CONCURRENT_GROUP_LOCK_BACKOFF_MAX     32 // in milliseconds
+
 //////////////////////////////////////////////////////////////////////////////
 //
 // Description:
@@ -161,6 +181,49 @@ namespace MetricsDiscoveryInternal
         SYS_FS_UNDEFINED,
     } TSysFsType;
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Structure:
+    //     TSysFsFrequency
+    //
+    // Description:
+    //     Min/Max/Boost frequency override values in MHz, written to SysFs together.
+    //     Boost frequency equal to 0 means boost frequency file is not available.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    typedef struct SSysFsFrequency
+    {
+        uint64_t MinFrequency;
+        uint64_t MaxFrequency;
+        uint64_t BoostFrequency;
+    } TSysFsFrequency;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Structure:
+    //     TSysFsFile
+    //
+    // Description:
+    //     Persistent SysFs file descriptor and the mode it was opened with.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    typedef struct SSysFsFile
+    {
+        int32_t Fd;         // -1 if not opened
+        bool    IsWritable; // false if opened for reading only
+    } TSysFsFile;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Typedef:
+    //     TSysFsFiles
+    //
+    // Description:
+    //     Persistent SysFs files of a single (sub)device indexed by TSysFsType.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    typedef std::array<TSysFsFile, SYS_FS_UNDEFINED> TSysFsFiles;
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Struct:
@@ -213,6 +276,53 @@ namespace MetricsDiscoveryInternal
         uint32_t            PlatformVersion;
     } TGfxDeviceInfo;
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Struct:
+    //     TTopologySnapshot
+    //
+    // Description:
+    //     GT topology of a single (sub)device read from the kernel only once.
+    //     Keeps the raw topology query result and values derived from it, which
+    //     are used by all topology dependent device info params. Each value is
+    //     derived on first use, so an unsupported one fails only its params.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    typedef enum ETopologyField
+    {
+        TOPOLOGY_FIELD_SLICE_MASK                  = 1 << 0,
+        TOPOLOGY_FIELD_SUBSLICE_MASK               = 1 << 1,
+        TOPOLOGY_FIELD_EU_CORES_TOTAL_COUNT        = 1 << 2,
+        TOPOLOGY_FIELD_EU_CORES_PER_SUBSLICE_COUNT = 1 << 3,
+    } TTopologyField;
+
+    typedef struct STopologySnapshot
+    {
+        uint32_t             ValidFields; // TTopologyField mask
+        std::vector<uint8_t> QueryData;   // Raw DRM topology query result, layout depends on KMD
+        int32_t              SliceMask;
+        int64_t              SubsliceMask; // Subslice or dual-subslice mask, depends on platform
+        uint32_t             EuCoresTotalCount;
+        uint32_t             EuCoresPerSubsliceCount;
+    } TTopologySnapshot;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Struct:
+    //     TOaStreamOptions
+    //
+    // Description:
+    //     Oa stream options set on the concurrent group before the stream is opened.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    typedef struct SOaStreamOptions
+    {
+        TIoStreamWakeupMode WakeupMode;
+        uint32_t            WakeupReportCount; // IO_STREAM_WAKEUP_MODE_REPORT_COUNT
+        int32_t             ContextDrmFd;      // DRM fd owning the context, -1 means system wide stream
+        uint32_t            ContextId;         // i915 context handle or XE exec queue id
+    } TOaStreamOptions;
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -239,6 +349,65 @@ namespace MetricsDiscoveryInternal
         uint32_t                m_count;
     };
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Description:
+    //     Cross process concurrent group lock. Threads of the same process are
+    //     serialized with a semaphore, processes with a flock on a lock file.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CConcurrentGroupLock
+    {
+    public:
+        CConcurrentGroupLock();
+        ~CConcurrentGroupLock();
+
+        TCompletionCode Lock( const char* name, const uint32_t timeoutMs, const uint32_t adapterId );
+        TCompletionCode Unlock( const uint32_t adapterId );
+        bool            IsUnused();
+
+    private:
+        TCompletionCode OpenLockFile( const char* name, const uint32_t adapterId );
+
+    private:
+        CSemaphore m_localLock;
+        int32_t    m_fd;
+    };
+
+    class CDriverInterfaceLinuxCommon;
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CScopedFrequencyOverride
+    //
+    // Description:
+    //     Frequency override of a single (sub)device. Min/Max/Boost frequency overrides
+    //     read on the first Apply are restored on Restore or destruction.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CScopedFrequencyOverride
+    {
+    public:
+        CScopedFrequencyOverride( CDriverInterfaceLinuxCommon& driverInterface, const uint32_t subDeviceIndex );
+        ~CScopedFrequencyOverride();
+
+        CScopedFrequencyOverride( const CScopedFrequencyOverride& )            = delete;
+        CScopedFrequencyOverride& operator=( const CScopedFrequencyOverride& ) = delete;
+
+        TCompletionCode Apply( const TSysFsFrequency& frequency );
+        TCompletionCode Restore();
+
+    private:
+        CDriverInterfaceLinuxCommon& m_driverInterface;
+        const uint32_t               m_subDeviceIndex;
+        TSysFsFrequency              m_savedFrequency; // Frequency overrides to restore
+        bool                         m_isApplied;
+    };
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -252,17 +421,21 @@ namespace MetricsDiscoveryInternal
     {
     public:
         CAdapterHandleLinux( int32_t adapterHandle );
+        CAdapterHandleLinux( const char* nodePath );
         virtual ~CAdapterHandleLinux();
 
         virtual TCompletionCode Close( const uint32_t adapterId );
         virtual bool            IsValid() const;
 
+        TCompletionCode Open();
+
         operator int() const;
 
     private:
         static constexpr int32_t InvalidValue = -1;
 
-        int32_t m_handle;
+        int32_t     m_handle;
+        std::string m_nodePath; // DRM node opened on demand, empty if handle was passed directly
     };
 
     //////////////////////////////////////////////////////////////////////////////
@@ -276,6 +449,8 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     class CDriverInterfaceLinuxCommon : public CDriverInterface
     {
+        friend class CScopedFrequencyOverride;
+
     public: // Constructor & Destructor
         CDriverInterfaceLinuxCommon( CAdapterHandle& adapterHandle, const TDrmVersion drmVersion );
         virtual ~CDriverInterfaceLinuxCommon();
@@ -288,12 +463,15 @@ namespace MetricsDiscoveryInternal
         static TCompletionCode GetGfxDeviceInfo( int32_t deviceId, TGfxDeviceInfo& gfxDeviceInfo );
         static TAdapterType    GetAdapterType( const TGfxDeviceInfo& gfxDeviceInfo );
         static TDrmVersion     GetDrmVersion( int32_t drmFd );
+        static TDrmVersion     GetDrmVersion( const uint32_t majorNumber, const uint32_t minorNumber );
+        static uint32_t        GetSubDevicesCount( const uint32_t majorNumber, const uint32_t minorNumber, const TGfxDeviceInfo& gfxDeviceInfo );
 
         // Read global symbols per tile.
         virtual TCompletionCode GetEuCoresTotalCount( GTDIDeviceInfoParamExtOut& out, CMetricsDevice& metricsDevice )       = 0;
         virtual TCompletionCode GetEuCoresPerSubsliceCount( GTDIDeviceInfoParamExtOut& out, CMetricsDevice& metricsDevice ) = 0;
         virtual TCompletionCode GetSliceMask( int32_t& sliceMask, CMetricsDevice& metricsDevice )                           = 0;
         virtual TCompletionCode GetSubsliceMask( int64_t& subsliceMask, CMetricsDevice& metricsDevice )                     = 0;
+        TCompletionCode         GetTopologySnapshot( CMetricsDevice& metricsDevice, const TTopologyField field, const TTopologySnapshot*& topology );
 
         // General
         virtual TCompletionCode ForceSupportDisable();
@@ -312,7 +490,8 @@ namespace MetricsDiscoveryInternal
         TCompletionCode         GetOaTimestamp( const uint64_t csTimestamp, uint64_t& oaTimestamp );
 
         // Synchronization
-        virtual TCompletionCode LockConcurrentGroup( const char* name, void** semaphore );
+        virtual TCompletionCode LockConcurrentGroup( const char* name, const uint32_t timeoutMs, void** semaphore );
+        static uint32_t         GetConcurrentGroupLockTimeout();
         virtual TCompletionCode UnlockConcurrentGroup( const char* name, void** semaphore );
 
         // Stream
@@ -321,6 +500,8 @@ namespace MetricsDiscoveryInternal
         virtual TCompletionCode CloseIoStream( COAConcurrentGroup& oaConcurrentGroup );
         virtual TCompletionCode HandleIoStreamExceptions( COAConcurrentGroup& oaConcurrentGroup, const uint32_t processId, uint32_t& reportCount, const GTDIReadCounterStreamExceptions exceptions );
         virtual TCompletionCode WaitForIoStreamReports( COAConcurrentGroup& oaConcurrentGroup, const uint32_t milliseconds );
+        virtual TCompletionCode WaitForIoStreamReports( const std::vector<COAConcurrentGroup*>& oaConcurrentGroups, const uint32_t milliseconds );
+        virtual TCompletionCode GetIoStreamHandle( COAConcurrentGroup& oaConcurrentGroup, int64_t& handle );
         virtual bool            IsIoMeasurementInfoAvailable( const TIoMeasurementInfoType ioMeasurementInfoType );
         virtual bool            IsStreamTypeSupported( const TStreamType streamType );
 
@@ -339,11 +520,14 @@ namespace MetricsDiscoveryInternal
 
     protected:
         // OA
-        virtual TCompletionCode OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType ) = 0;
-        virtual TCompletionCode ReadOaStream( CMetricsDevice& metricsDevice, uint32_t reportSize, uint32_t reportsToRead, char* reportData, uint32_t& readBytes, GTDIReadCounterStreamExceptions& exceptions )                                 = 0;
+        virtual TCompletionCode OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType, const TOaStreamOptions& options ) = 0;
+        virtual TCompletionCode ReadOaStream( CMetricsDevice& metricsDevice, uint32_t reportSize, uint32_t reportsToRead, char* reportData, uint32_t& readBytes, GTDIReadCounterStreamExceptions& exceptions )                                                                  = 0;
         TCompletionCode         CloseOaStream( CMetricsDevice& metricsDevice );
+        TCompletionCode         DuplicateContextDrmFd( const int32_t drmFd, int32_t& contextDrmFd );
         TCompletionCode         WaitForOaStreamReports( CMetricsDevice& metricsDevice, uint32_t timeoutMs );
+        TCompletionCode         WaitForOaStreamReports( const int32_t* streamIds, const uint32_t streamsCount, uint32_t timeoutMs );
         std::string             GenerateQueryGuid( const uint32_t subDeviceIndex );
+
         virtual TCompletionCode AddOaConfig( TRegister** regVector, const uint32_t regCount, const uint32_t subDeviceIndex, const char* requestedGuid, int32_t& addedConfigId ) = 0;
         virtual TCompletionCode RemoveOaConfig( int32_t oaConfigId )                                                                                                            = 0;
         TCompletionCode         RemoveOaConfigQuery( const char* guid );
@@ -353,6 +537,22 @@ namespace MetricsDiscoveryInternal
         virtual TCompletionCode GetOaTimestampFrequency( uint64_t& frequency )  = 0;
         virtual TCompletionCode GetCsTimestampFrequency( uint64_t& frequency )  = 0;
 
+        // PMU
+        TCompletionCode OpenPmuStream( COAConcurrentGroup& oaConcurrentGroup, uint32_t& nsTimerPeriod, uint32_t& bufferSize );
+        TCompletionCode ReadPmuStream( COAConcurrentGroup& oaConcurrentGroup, char* reportData, uint32_t& reportsCount );
+        TCompletionCode ClosePmuStream( COAConcurrentGroup& oaConcurrentGroup );
+        bool            IsPmuAvailable();
+
+        // DRM fdinfo
+        TCompletionCode OpenFdinfoStream( COAConcurrentGroup& oaConcurrentGroup, const uint32_t processId, uint32_t& nsTimerPeriod, uint32_t& bufferSize );
+        TCompletionCode ReadFdinfoStream( COAConcurrentGroup& oaConcurrentGroup, char* reportData, uint32_t& reportsCount );
+        TCompletionCode CloseFdinfoStream( COAConcurrentGroup& oaConcurrentGroup );
+        bool            IsFdinfoAvailable();
+
+        // Timer driven streams (PMU, DRM fdinfo)
+        TCompletionCode OpenStreamTimer( uint32_t& nsTimerPeriod, int32_t& timerFd );
+        TCompletionCode ReadStreamTimer( const int32_t timerFd, bool& isExpired );
+
         // DRM
         bool            InitializeIntelDrm();
         void            DeinitializeIntelDrm();
@@ -360,11 +560,17 @@ namespace MetricsDiscoveryInternal
         TCompletionCode AcquireAdapterId();
 
         // SysFs
-        virtual void    GetSysFsPath( CMetricsDevice& device, const TSysFsType fileType, char* filePath, const uint32_t filePathLength ) = 0;
+        virtual void    GetSysFsPath( const uint32_t subDeviceIndex, const TSysFsType fileType, char* filePath, const uint32_t filePathLength ) = 0;
+        TCompletionCode GetSysFsFile( const uint32_t subDeviceIndex, const TSysFsType fileType, const bool writable, int32_t& fd );
+        void            CloseSysFsFiles();
         TCompletionCode ReadSysFsFile( CMetricsDevice& device, const TSysFsType fileType, uint64_t* readValue );
-        TCompletionCode WriteSysFsFile( CMetricsDevice& device, const TSysFsType fileType, uint64_t value );
+        TCompletionCode ReadSysFsFile( const uint32_t subDeviceIndex, const TSysFsType fileType, uint64_t* readValue );
+        TCompletionCode WriteSysFsFile( const uint32_t subDeviceIndex, const TSysFsType fileType, uint64_t value );
+        TCompletionCode ReadSysFsFrequency( const uint32_t subDeviceIndex, TSysFsFrequency& frequency );
+        TCompletionCode WriteSysFsFrequency( const uint32_t subDeviceIndex, const TSysFsFrequency& frequency );
         TCompletionCode ReadUInt64FromFile( const char* filePath, uint64_t* readValue );
-        TCompletionCode WriteUInt64ToFile( const char* filePath, uint64_t value );
+        TCompletionCode ReadUInt64FromFd( const int32_t fd, uint64_t* readValue );
+        TCompletionCode WriteUInt64ToFd( const int32_t fd, uint64_t value );
 
         // IOCTL
         static int32_t SendIoctl( int32_t drmFd, uint32_t request, void* argument );
@@ -402,6 +608,10 @@ namespace MetricsDiscoveryInternal
         uint32_t GetTimerPeriodExponent( uint32_t nsTimerPeriod );
         uint32_t GetNsTimerPeriod( uint32_t timerPeriodExponent );
         uint32_t CalculateOaBufferSize( const uint32_t requestedBufferSize, CMetricsDevice& metricsDevice );
+        uint32_t CalculateOaWakeupReportCount( const TOaStreamOptions& options, const uint32_t bufferSize, const uint32_t oaReportSize );
+
+        // Topology
+        TTopologySnapshot& GetTopologySnapshotEntry( const uint32_t subDeviceIndex );
 
     protected:
         // Variables
@@ -420,6 +630,26 @@ namespace MetricsDiscoveryInternal
         TGfxDeviceInfo m_CachedGfxDeviceInfo;
         int32_t        m_CachedDeviceId;
         int32_t        m_CachedRevisionId;
+
+        std::vector<TTopologySnapshot> m_CachedTopology; // Indexed by sub device index
+
+        // SysFs
+        std::vector<TSysFsFiles>               m_SysFsFiles;         // Indexed by sub device index
+        std::vector<CScopedFrequencyOverride*> m_FrequencyOverrides; // Indexed by sub device index, nullptr if override is disabled
+
+        // Device info queries and the caches above may be used by sub devices created in parallel
+        std::recursive_mutex m_deviceInfoMutex;
+
+        // PMU, streams of sub devices may be opened in parallel
+        std::string                                                     m_pmuName;           // Empty if engine busyness PMU isn't exposed by the kernel driver
+        bool                                                            m_isPmuNameResolved; //
+        std::unordered_map<int32_t, std::unique_ptr<CPmuEngineSampler>> m_pmuSamplers;       // Indexed by stream id (timerfd)
+        std::mutex                                                      m_pmuMutex;
+
+        // DRM fdinfo, guarded by m_pmuMutex
+        std::string                                                     m_fdinfoPciSlot;    // Empty if DRM client usage stats aren't exposed by the kernel driver
+        bool                                                            m_isFdinfoResolved; //
+        std::unordered_map<int32_t, std::unique_ptr<CDrmFdinfoSampler>> m_fdinfoSamplers;   // Indexed by stream id (timerfd)
     };
 
 } // namespace MetricsDiscoveryInternal
@@ -109,7 +109,7 @@ namespace MetricsDiscoveryInternal
         virtual bool    CreateContext();
 
         // SysFs
-        virtual void GetSysFsPath( CMetricsDevice& device, const TSysFsType fileType, char* filePath, const uint32_t filePathLength );
+        virtual void GetSysFsPath( const uint32_t subDeviceIndex, const TSysFsType fileType, char* filePath, const uint32_t filePathLength );
 
     private:
         // Perf
@@ -118,7 +118,7 @@ namespace MetricsDiscoveryInternal
         void PrintPerfCapabilities();
 
         // OA Stream
-        virtual TCompletionCode OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType );
+        virtual TCompletionCode OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType, const TOaStreamOptions& options );
         virtual TCompletionCode ReadOaStream( CMetricsDevice& metricsDevice, uint32_t reportSize, uint32_t reportsToRead, char* reportData, uint32_t& readBytes, GTDIReadCounterStreamExceptions& exceptions );
         virtual TCompletionCode AddOaConfig( TRegister** regVector, const uint32_t regCount, const uint32_t subDeviceIndex, const char* requestedGuid, int32_t& addedConfigId );
         virtual TCompletionCode RemoveOaConfig( int32_t oaConfigId );
@@ -0,0 +1,131 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_drm_fdinfo_linux.h
+
+//     Abstract:   C++ per process engine utilization sampler based on DRM fdinfo for Linux
+
+#pragma once
+
+#include "md_types.h"
+
+#include <array>
+#include <dirent.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Description:
+    //     Samples engine utilization of DRM clients from /proc/<pid>/fdinfo,
+    //     either of a single process or of all processes. i915 exposes busy
+    //     time in ns per engine class (drm-engine-*), xe exposes client and
+    //     total cycles (drm-cycles-*, drm-total-cycles-*), which are converted
+    //     to ns with the cycles ratio of each sampled interval.
+    //
+    //     Scanning is incremental:
+    //     - fd directories are listed, but only fds not seen before are stat-ed,
+    //     - fdinfo files of DRM clients are kept open and read with pread, up to
+    //       a quarter of RLIMIT_NOFILE, fdinfo files over it are reopened on
+    //       each read,
+    //     - processes denied access to their fd directories are skipped.
+    //     Cached files which aren't DRM clients are rechecked every
+    //     FULL_RESCAN_PERIOD sweeps, in case their fd number got reused. Failed
+    //     opens aren't cached, they are retried in the next sweep.
+    //
+    //     Clients shared by several files or processes (dup, fork) are counted
+    //     once. Usage of a client is counted from the second sweep it's seen in.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CDrmFdinfoSampler
+    {
+    public:
+        // Constructor & Destructor:
+        CDrmFdinfoSampler();
+        ~CDrmFdinfoSampler();
+
+        CDrmFdinfoSampler( const CDrmFdinfoSampler& )            = delete; // Delete copy-constructor
+        CDrmFdinfoSampler& operator=( const CDrmFdinfoSampler& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode Open( const uint32_t adapterId, const std::string& pciSlot, const uint32_t processId, const char* procRoot = "/proc" );
+        TCompletionCode Read( const uint32_t adapterId, TPmuEngineReport& report );
+        void            Close();
+
+        static bool GetPciSlot( const int32_t drmFd, std::string& pciSlot );
+
+    private:
+        // Engine usage of a DRM client, cumulative as in fdinfo:
+        typedef struct SClientUsage
+        {
+            uint64_t                                     ClientId;
+            std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> EngineNs;    // i915: drm-engine-<engine>
+            std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> Cycles;      // xe: drm-cycles-<engine>
+            std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> TotalCycles; // xe: drm-total-cycles-<engine>
+            std::array<uint32_t, PMU_ENGINE_CLASS_COUNT> Capacity;    // drm-engine-capacity-<engine>, 1 if not given
+        } TClientUsage;
+
+        // DRM client state between sweeps:
+        typedef struct SClient
+        {
+            TClientUsage Usage;
+            uint32_t     Sweep; // Last sweep the client was counted in
+        } TClient;
+
+        // Process state between sweeps:
+        typedef struct SProcess
+        {
+            std::unordered_map<int32_t, int32_t> Files;        // fd -> kept open fdinfo fd, FDINFO_NOT_CLIENT or FDINFO_REOPEN
+            uint32_t                             Sweep;        // Last sweep the process was seen in
+            bool                                 IsAccessible; // False if fd directory couldn't be opened
+        } TProcess;
+
+        // Methods:
+        void Sweep( const uint64_t intervalNs );
+        void ScanProcess( const uint32_t processId, const uint64_t intervalNs, const bool isFullRescan );
+        bool ReadFdinfo( const int32_t fdinfoFd, TClientUsage& usage );
+        void AccumulateClient( const TClientUsage& usage, const uint64_t intervalNs );
+        void CloseFdinfo( const int32_t fdinfoFd );
+        void CloseProcessFiles( TProcess& process );
+
+        static uint32_t GetMaxOpenFdinfoCount();
+        static bool     GetEngineClass( const char* name, const size_t length, TPmuEngineClass& engineClass );
+        static uint64_t GetTimeNs();
+
+    private:
+        // Constants:
+        static constexpr uint32_t FULL_RESCAN_PERIOD = 16;
+        static constexpr uint32_t DRM_MAJOR_NUMBER   = 226;
+        static constexpr size_t   FDINFO_MAX_SIZE    = 4096;
+        static constexpr int32_t  FDINFO_NOT_CLIENT  = -1; // Not a DRM client of this device
+        static constexpr int32_t  FDINFO_REOPEN      = -2; // DRM client, fdinfo isn't kept open
+
+        // Variables:
+        DIR*                                       m_procDir;   // Listed to find processes, its fd is used with openat
+        std::string                                m_pciSlot;   // drm-pdev of clients to count
+        uint32_t                                   m_processId; // 0 for all processes
+        uint32_t                                   m_sweep;
+        uint64_t                                   m_startNs;
+        uint64_t                                   m_prevElapsedNs;
+        std::unordered_map<uint32_t, TProcess>     m_processes; // Indexed by pid
+        std::unordered_map<uint64_t, TClient>      m_clients;   // Indexed by drm-client-id
+        uint32_t                                   m_openFdinfoCount;
+        uint32_t                                   m_maxOpenFdinfoCount;
+        std::array<double, PMU_ENGINE_CLASS_COUNT> m_busyNs;
+        std::vector<int32_t>                       m_listedFds; // Reused between processes
+        std::array<char, FDINFO_MAX_SIZE>          m_fdinfoBuffer;
+    };
+} // namespace MetricsDiscoveryInternal
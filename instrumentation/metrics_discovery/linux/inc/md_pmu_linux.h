@@ -0,0 +1,105 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_pmu_linux.h
+
+//     Abstract:   C++ engine busyness sampler based on i915 / xe PMU for Linux
+
+#pragma once
+
+#include "md_types.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace MetricsDiscovery;
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Description:
+    //     Samples engine busyness with the perf events exposed by i915 or xe
+    //     kernel driver PMU. All engine counters are opened as a single perf
+    //     event group, so a sample of all engines costs one read().
+    //
+    //     i915 exposes busy time in ns per engine. xe exposes active and total
+    //     ticks per engine, which are converted to ns with the active / total
+    //     ratio of each sampled interval.
+    //
+    //     Engines are found by probing, instances may be sparse (e.g. vcs0, vcs2)
+    //     and xe media engines may be on another gt.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    class CPmuEngineSampler
+    {
+    public:
+        // Constructor & Destructor:
+        CPmuEngineSampler();
+        ~CPmuEngineSampler();
+
+        CPmuEngineSampler( const CPmuEngineSampler& )            = delete; // Delete copy-constructor
+        CPmuEngineSampler& operator=( const CPmuEngineSampler& ) = delete; // Delete assignment operator
+
+        // Non-API:
+        TCompletionCode Open( const uint32_t adapterId, const std::string& pmuName );
+        TCompletionCode Read( const uint32_t adapterId, TPmuEngineReport& report );
+        void            Close();
+
+        static bool GetPmuName( const int32_t drmCardNumber, std::string& pmuName );
+
+    private:
+        // Counter types:
+        typedef enum ECounterType
+        {
+            COUNTER_TYPE_BUSY,   // i915 busy ns, xe active ticks
+            COUNTER_TYPE_TOTAL,  // xe total ticks
+        } TCounterType;
+
+        // Counter, indexed as values of the group read:
+        typedef struct SCounter
+        {
+            TPmuEngineClass EngineClass;
+            TCounterType    Type;
+        } TCounter;
+
+        // Methods:
+        int32_t         OpenCounter( const uint64_t config, const TPmuEngineClass engineClass, const TCounterType type );
+        void            CloseLastCounter();
+        TCompletionCode OpenI915Counters( const uint32_t adapterId );
+        TCompletionCode OpenXeCounters( const uint32_t adapterId, const std::string& pmuPath );
+
+        static bool ReadSysFsString( const std::string& path, std::string& value );
+        static bool ReadPmuFormatShift( const std::string& pmuPath, const char* field, uint32_t& shift );
+        static bool ReadPmuEventConfig( const std::string& pmuPath, const char* event, uint64_t& config );
+
+    private:
+        // Constants:
+        static constexpr uint32_t MAX_INSTANCE_COUNT = 16;
+        static constexpr uint32_t MAX_GT_COUNT       = 4;
+
+        // Variables:
+        std::vector<int32_t>                         m_fds;        // Group leader first
+        std::vector<TCounter>                        m_counters;   // Indexed as m_fds
+        std::vector<uint64_t>                        m_readBuffer; // Group read: counters count, time enabled, values
+        uint32_t                                     m_pmuType;
+        int32_t                                      m_cpu;
+        bool                                         m_isXe;
+        std::array<uint32_t, PMU_ENGINE_CLASS_COUNT> m_instanceCount;
+
+        // xe only, previous sample to calculate the active / total ratio:
+        uint64_t                                     m_prevElapsedNs;
+        std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> m_prevActiveTicks;
+        std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> m_prevTotalTicks;
+        std::array<double, PMU_ENGINE_CLASS_COUNT>   m_busyNs;
+    };
+} // namespace MetricsDiscoveryInternal
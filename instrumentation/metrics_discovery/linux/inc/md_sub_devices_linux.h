@@ -83,6 +83,7 @@ namespace MetricsDiscoveryInternal
         bool            FindDevice( const CMetricsDevice* metricsDevice );
 
         CMetricsDevice* OpenDevice( const uint32_t index );
+        TCompletionCode OpenDevices( const std::vector<uint32_t>& indices, std::vector<CMetricsDevice*>& metricsDevices );
         CMetricsDevice* OpenDeviceFromFile( const uint32_t index, const char* filename, void* parameters );
         void            SetRootDevice( CMetricsDevice* metricsDevice );
         void            RemoveDevice( const CMetricsDevice* metricsDevice );
@@ -31,9 +31,12 @@ SPDX-License-Identifier: MIT
 #include <iomanip>
 #include <sstream>
 #include <regex>
+#include <thread>
 
 #include <sys/stat.h>
 #include <sys/sysmacros.h> // for major, minor
+#include <sys/file.h>      // for flock
+#include <sys/timerfd.h>   // for pmu stream timer
 #include <fcntl.h>
 #include <dirent.h>
 #include <poll.h>
@@ -195,6 +198,270 @@ namespace MetricsDiscoveryInternal
         return m_count;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Method:
+    //     CConcurrentGroupLock constructor
+    //
+    // Description:
+    //     Creates unlocked concurrent group lock. Lock file is not opened yet.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CConcurrentGroupLock::CConcurrentGroupLock()
+        : m_localLock()
+        , m_fd( -1 )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Method:
+    //     ~CConcurrentGroupLock
+    //
+    // Description:
+    //     Destructor. Closing the lock file releases the flock.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CConcurrentGroupLock::~CConcurrentGroupLock()
+    {
+        if( m_fd != -1 )
+        {
+            close( m_fd );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Method:
+    //     Lock
+    //
+    // Description:
+    //     Acquires the lock, waiting up to *timeoutMs* milliseconds. The lock is
+    //     first taken within the process and then across processes with a flock.
+    //     Timeout equal to 0 means try-lock, i.e. the function returns immediately.
+    //
+    // Input:
+    //     const char*    name      - lock name, unique per concurrent group and adapter
+    //     const uint32_t timeoutMs - maximal time to wait for the lock
+    //     const uint32_t adapterId - adapter id for the purpose of logging
+    //
+    // Output:
+    //     TCompletionCode          - *CC_OK* if succeeded,
+    //                                *CC_CONCURRENT_GROUP_LOCKED* if timeout occurred
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CConcurrentGroupLock::Lock( const char* name, const uint32_t timeoutMs, const uint32_t adapterId )
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeoutMs );
+
+        // 1. Serialize threads of the current process.
+        const bool localLocked = timeoutMs
+            ? m_localLock.WaitFor( timeoutMs )
+            : m_localLock.TryWait();
+
+        if( !localLocked )
+        {
+            MD_LOG_A( adapterId, LOG_DEBUG, "Concurrent group locked by the current process" );
+            return CC_CONCURRENT_GROUP_LOCKED;
+        }
+
+        // 2. Serialize processes.
+        TCompletionCode ret = OpenLockFile( name, adapterId );
+        if( ret != CC_OK )
+        {
+            m_localLock.Notify();
+            return ret;
+        }
+
+        uint32_t backoffMs = 1;
+
+        while( flock( m_fd, LOCK_EX | LOCK_NB ) != 0 )
+        {
+            const int32_t error = errno;
+            if( error == EINTR )
+            {
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+
+            if( error != EWOULDBLOCK || now >= deadline )
+            {
+                ret = ( error == EWOULDBLOCK )
+                    ? CC_CONCURRENT_GROUP_LOCKED
+                    : CC_ERROR_GENERAL;
+
+                if( ret == CC_CONCURRENT_GROUP_LOCKED )
+                {
+                    MD_LOG_A( adapterId, LOG_DEBUG, "Concurrent group locked by another process" );
+                }
+                else
+                {
+                    MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Concurrent group lock failed, errno: %d", error );
+                }
+
+                close( m_fd );
+                m_fd = -1;
+                m_localLock.Notify();
+                return ret;
+            }
+
+            // Back off exponentially to not spin while other process holds the lock.
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>( deadline - now );
+            std::this_thread::sleep_for( std::min( std::chrono::milliseconds( backoffMs ), remaining ) );
+
+            backoffMs = std::min<uint32_t>( backoffMs * 2, MD_CONCURRENT_GROUP_LOCK_BACKOFF_MAX );
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Method:
+    //     Unlock
+    //
+    // Description:
+    //     Releases the lock acquired with Lock.
+    //
+    // Input:
+    //     const uint32_t adapterId - adapter id for the purpose of logging
+    //
+    // Output:
+    //     TCompletionCode          - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CConcurrentGroupLock::Unlock( const uint32_t adapterId )
+    {
+        TCompletionCode ret = CC_OK;
+
+        if( m_fd != -1 )
+        {
+            if( flock( m_fd, LOCK_UN ) != 0 )
+            {
+                MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Concurrent group unlock failed, errno: %d", errno );
+                ret = CC_ERROR_GENERAL;
+            }
+
+            close( m_fd );
+            m_fd = -1;
+        }
+
+        m_localLock.Notify();
+        return ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Method:
+    //     IsUnused
+    //
+    // Description:
+    //     Checks if the lock is neither held nor awaited in the current process.
+    //
+    // Output:
+    //     bool - true if the lock object may be destroyed
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CConcurrentGroupLock::IsUnused()
+    {
+        return m_localLock.GetValue() > 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CConcurrentGroupLock
+    //
+    // Method:
+    //     OpenLockFile
+    //
+    // Description:
+    //     Opens (creates if needed) the lock file of the given name. Read access
+    //     is enough for flock, so lock files created by other users can be used.
+    //     Lock files have to be shared by all users, so they are not placed in
+    //     per user $XDG_RUNTIME_DIR, nor in any other fallback directory.
+    //     An existing file is opened without O_CREAT, which protected_regular
+    //     refuses for files of other users in sticky directories. A missing
+    //     file is created exclusively and made readable by all users, losing
+    //     the creation race means the file exists and is opened again.
+    //
+    // Input:
+    //     const char*    name      - lock name
+    //     const uint32_t adapterId - adapter id for the purpose of logging
+    //
+    // Output:
+    //     TCompletionCode          - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CConcurrentGroupLock::OpenLockFile( const char* name, const uint32_t adapterId )
+    {
+        MD_CHECK_PTR_RET_A( adapterId, name, CC_ERROR_INVALID_PARAMETER );
+
+        const uint32_t maxAttempts                                                 = 3;
+        char           filePath[MD_SEMAPHORE_NAME_MAX_LENGTH + MD_MAX_PATH_LENGTH] = {};
+
+        snprintf( filePath, sizeof( filePath ), "%s/igdmd_%s.lock", MD_CONCURRENT_GROUP_LOCK_DIRECTORY, name );
+
+        // The lock directory is world writable, so links planted there are
+        // not followed and only regular files are used.
+        for( uint32_t i = 0; i < maxAttempts && m_fd == -1; ++i )
+        {
+            m_fd = open( filePath, O_RDONLY | O_CLOEXEC | O_NOFOLLOW );
+            if( m_fd == -1 && errno == ENOENT )
+            {
+                m_fd = open( filePath, O_RDONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0644 );
+                if( m_fd != -1 )
+                {
+                    // Umask may drop read access of other users.
+                    fchmod( m_fd, 0644 );
+                }
+                else if( errno == EEXIST )
+                {
+                    continue;
+                }
+            }
+
+            if( m_fd == -1 )
+            {
+                break;
+            }
+        }
+
+        if( m_fd == -1 )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Cannot open concurrent group lock file %s, errno: %d", filePath, errno );
+            return CC_ERROR_GENERAL;
+        }
+
+        struct stat fileStat = {};
+
+        if( fstat( m_fd, &fileStat ) != 0 || !S_ISREG( fileStat.st_mode ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Lock file %s is not a regular file", filePath );
+            close( m_fd );
+            m_fd = -1;
+            return CC_ERROR_GENERAL;
+        }
+
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -215,6 +482,12 @@ namespace MetricsDiscoveryInternal
         // Initialize DRM.
         CDriverInterface* driverInterface = nullptr;
 
+        // DRM node is opened only when the adapter is used for the first time.
+        if( static_cast<CAdapterHandleLinux&>( adapterHandle ).Open() != CC_OK )
+        {
+            return nullptr;
+        }
+
         switch( CDriverInterfaceLinuxCommon::GetDrmVersion( static_cast<CAdapterHandleLinux&>( adapterHandle ) ) )
         {
             case DRM_VERSION_I915:
@@ -267,6 +540,8 @@ namespace MetricsDiscoveryInternal
     // Description:
     //     Linux implementation of static function GetAvailableAdapters.
     //     Enumerates all available adapters in the system and return Intel ones.
+    //     Adapters are described from sysfs and PCI ids only, DRM nodes are not
+    //     opened here. Adapter handles open them on first use.
     //
     // Input:
     //     std::vector<TAdapterData>& adapters  - [out] available Intel adapters
@@ -301,54 +576,46 @@ namespace MetricsDiscoveryInternal
             }
 
             const drmDevice& device    = *devices[i];
-            int32_t          drmFd     = -1;
+            const char*      nodePath  = nullptr;
             int32_t          minorBase = 0;
 
-            if( IS_DRM_NODE_AVAILABLE( device.available_nodes, DRM_NODE_RENDER ) )
+            // Only check access rights, the node is opened on first adapter use.
+            if( IS_DRM_NODE_AVAILABLE( device.available_nodes, DRM_NODE_RENDER ) &&
+                access( device.nodes[DRM_NODE_RENDER], R_OK | W_OK ) == 0 )
             {
-                MD_LOG( LOG_DEBUG, "Open render node '%s'", device.nodes[DRM_NODE_RENDER] );
-                drmFd     = open( device.nodes[DRM_NODE_RENDER], O_RDWR );
+                nodePath  = device.nodes[DRM_NODE_RENDER];
                 minorBase = DRM_NODE_RENDER * DRM_MAX_DEVICES;
             }
 
-            if( drmFd == -1 && IS_DRM_NODE_AVAILABLE( device.available_nodes, DRM_NODE_PRIMARY ) )
+            if( nodePath == nullptr && IS_DRM_NODE_AVAILABLE( device.available_nodes, DRM_NODE_PRIMARY ) &&
+                access( device.nodes[DRM_NODE_PRIMARY], R_OK | W_OK ) == 0 )
             {
-                MD_LOG( LOG_DEBUG, "Open primary node '%s'", device.nodes[DRM_NODE_PRIMARY] );
-                drmFd     = open( device.nodes[DRM_NODE_PRIMARY], O_RDWR );
+                nodePath  = device.nodes[DRM_NODE_PRIMARY];
                 minorBase = DRM_NODE_PRIMARY * DRM_MAX_DEVICES;
             }
 
-            if( drmFd == -1 )
+            if( nodePath == nullptr )
             {
-                MD_LOG( LOG_ERROR, "ERROR: Failed to open drm device" );
+                MD_LOG( LOG_ERROR, "ERROR: Failed to access drm device" );
                 continue;
             }
 
-            drmVersionPtr deviceVersion = drmGetVersion( drmFd );
+            MD_LOG( LOG_DEBUG, "Found drm node '%s'", nodePath );
 
-            if( deviceVersion == nullptr )
+            // Get system id (major/minor pair)
+            struct stat sbuf = {};
+            if( stat( nodePath, &sbuf ) )
             {
-                MD_LOG( LOG_ERROR, "ERROR: Cannot get version for drm device" );
-
-                close( drmFd );
+                MD_LOG( LOG_ERROR, "ERROR: Cannot get system id" );
                 continue;
             }
 
-            constexpr uint32_t i915NameLength = sizeof( "i915" ) - 1;
-            constexpr uint32_t xeNameLength   = sizeof( "xe" ) - 1;
-
-            if( ( deviceVersion->name_len != i915NameLength || iu_strncmp( deviceVersion->name, "i915", i915NameLength ) ) &&
-                ( deviceVersion->name_len != xeNameLength || iu_strncmp( deviceVersion->name, "xe", xeNameLength ) ) )
+            if( CDriverInterfaceLinuxCommon::GetDrmVersion( major( sbuf.st_rdev ), minor( sbuf.st_rdev ) ) == DRM_VERSION_UNDEFINED )
             {
-                MD_LOG( LOG_DEBUG, "Skip non-Intel device '%s'", ( deviceVersion->name_len && deviceVersion->name ? deviceVersion->name : "" ) );
-
-                drmFreeVersion( deviceVersion );
-                close( drmFd );
+                MD_LOG( LOG_DEBUG, "Skip non-Intel device '%s'", nodePath );
                 continue;
             }
 
-            drmFreeVersion( deviceVersion );
-
             TAdapterData adapter = {};
 
             // Get platform info
@@ -359,28 +626,19 @@ namespace MetricsDiscoveryInternal
             if( ret != CC_OK || gfxDeviceInfo.PlatformIndex == GTDI_PLATFORM_MAX )
             {
                 MD_LOG( LOG_ERROR, "ERROR: Cannot detect platform index" );
-
-                close( drmFd );
                 continue;
             }
 
             adapter.Params.Platform = gfxDeviceInfo.PlatformIndex;
             adapter.Params.Type     = CDriverInterfaceLinuxCommon::GetAdapterType( gfxDeviceInfo );
 
-            // Get system id (major/minor pair)
-            struct stat sbuf = {};
-            if( fstat( drmFd, &sbuf ) )
-            {
-                MD_LOG( LOG_ERROR, "ERROR: Cannot get system id" );
-
-                close( drmFd );
-                continue;
-            }
-
             adapter.Params.SystemId.Type             = ADAPTER_ID_TYPE_MAJOR_MINOR;
             adapter.Params.SystemId.MajorMinor.Major = major( sbuf.st_rdev );
             adapter.Params.SystemId.MajorMinor.Minor = minor( sbuf.st_rdev ) - minorBase;
 
+            // Sub devices are enumerated on first adapter use, until then the count comes from sysfs.
+            adapter.Params.SubDevicesCount = CDriverInterfaceLinuxCommon::GetSubDevicesCount( major( sbuf.st_rdev ), minor( sbuf.st_rdev ), gfxDeviceInfo );
+
             // Set capabilities
             adapter.Params.CapabilityMask = IS_DRM_NODE_AVAILABLE( device.available_nodes, DRM_NODE_RENDER )
                 ? ADAPTER_CAPABILITY_RENDER_SUPPORTED
@@ -398,17 +656,15 @@ namespace MetricsDiscoveryInternal
                 adapter.Params.SubVendorId = device.deviceinfo.pci->subvendor_id;
                 adapter.Params.DeviceId    = device.deviceinfo.pci->device_id;
 
-                const char* deviceName   = drmGetDeviceNameFromFd2( drmFd );
-                adapter.Params.ShortName = GetCopiedCString( deviceName, IU_ADAPTER_ID_UNKNOWN );
-                drmFree( (void*) deviceName );
+                adapter.Params.ShortName = GetCopiedCString( nodePath, IU_ADAPTER_ID_UNKNOWN );
             }
 
-            adapter.Handle = new( std::nothrow ) CAdapterHandleLinux( drmFd ); // Important: adapterData.Handle has to be deleted later!
+            adapter.Handle = new( std::nothrow ) CAdapterHandleLinux( nodePath ); // Important: adapterData.Handle has to be deleted later!
             if( adapter.Handle == nullptr )
             {
                 MD_LOG( LOG_ERROR, "ERROR: Cannot create adapter handle" );
 
-                close( drmFd );
+                MD_SAFE_DELETE_ARRAY( adapter.Params.ShortName );
                 continue;
             }
 
@@ -462,6 +718,110 @@ namespace MetricsDiscoveryInternal
         return false;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CScopedFrequencyOverride
+    //
+    // Method:
+    //     CScopedFrequencyOverride constructor
+    //
+    // Description:
+    //     Creates frequency override of the given (sub)device. Frequency is not
+    //     changed until Apply is called.
+    //
+    // Input:
+    //     CDriverInterfaceLinuxCommon& driverInterface - driver interface
+    //     const uint32_t               subDeviceIndex  - sub device index
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CScopedFrequencyOverride::CScopedFrequencyOverride( CDriverInterfaceLinuxCommon& driverInterface, const uint32_t subDeviceIndex )
+        : m_driverInterface( driverInterface )
+        , m_subDeviceIndex( subDeviceIndex )
+        , m_savedFrequency{}
+        , m_isApplied( false )
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CScopedFrequencyOverride
+    //
+    // Method:
+    //     ~CScopedFrequencyOverride
+    //
+    // Description:
+    //     Destructor. Restores frequency overrides saved on the first Apply.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CScopedFrequencyOverride::~CScopedFrequencyOverride()
+    {
+        Restore();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CScopedFrequencyOverride
+    //
+    // Method:
+    //     Apply
+    //
+    // Description:
+    //     Sets the given frequency overrides. Frequency overrides set before the
+    //     first call are saved to be restored later.
+    //
+    // Input:
+    //     const TSysFsFrequency& frequency - frequency overrides to set
+    //
+    // Output:
+    //     TCompletionCode                  - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CScopedFrequencyOverride::Apply( const TSysFsFrequency& frequency )
+    {
+        if( !m_isApplied )
+        {
+            TCompletionCode ret = m_driverInterface.ReadSysFsFrequency( m_subDeviceIndex, m_savedFrequency );
+            MD_CHECK_CC_RET_A( m_driverInterface.m_adapterId, ret );
+
+            m_isApplied = true;
+
+            MD_LOG_A( m_driverInterface.m_adapterId, LOG_DEBUG, "Saved frequency overrides, min: %" PRIu64 ", max: %" PRIu64 ", boost: %" PRIu64 " MHz", m_savedFrequency.MinFrequency, m_savedFrequency.MaxFrequency, m_savedFrequency.BoostFrequency );
+        }
+
+        return m_driverInterface.WriteSysFsFrequency( m_subDeviceIndex, frequency );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CScopedFrequencyOverride
+    //
+    // Method:
+    //     Restore
+    //
+    // Description:
+    //     Restores frequency overrides saved on the first Apply. Does nothing
+    //     if frequency overrides were not applied.
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CScopedFrequencyOverride::Restore()
+    {
+        if( !m_isApplied )
+        {
+            return CC_OK;
+        }
+
+        m_isApplied = false;
+
+        return m_driverInterface.WriteSysFsFrequency( m_subDeviceIndex, m_savedFrequency );
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -484,6 +844,16 @@ namespace MetricsDiscoveryInternal
         , m_CachedGfxDeviceInfo{ GTDI_PLATFORM_MAX, GFX_GTTYPE_UNDEFINED, 0, 0 }
         , m_CachedDeviceId( -1 )
         , m_CachedRevisionId( -1 )
+        , m_CachedTopology()
+        , m_SysFsFiles()
+        , m_FrequencyOverrides()
+        , m_pmuName()
+        , m_isPmuNameResolved( false )
+        , m_pmuSamplers()
+        , m_pmuMutex()
+        , m_fdinfoPciSlot()
+        , m_isFdinfoResolved( false )
+        , m_fdinfoSamplers()
     {
     }
 
@@ -515,11 +885,19 @@ namespace MetricsDiscoveryInternal
     //     DeleteContext
     //
     // Description:
-    //     Deletes driver context. Closes Perf stream if opened and closes DRM.
+    //     Deletes driver context. Restores overridden frequencies, closes SysFs
+    //     files, Perf stream if opened and closes DRM.
     //
     //////////////////////////////////////////////////////////////////////////////
     void CDriverInterfaceLinuxCommon::DeleteContext()
     {
+        for( auto& frequencyOverride : m_FrequencyOverrides )
+        {
+            MD_SAFE_DELETE( frequencyOverride );
+        }
+        m_FrequencyOverrides.clear();
+
+        CloseSysFsFiles();
         DeinitializeIntelDrm();
     }
 
@@ -590,9 +968,12 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CDriverInterfaceLinuxCommon::SendDeviceInfoParamEscape( GTDI_DEVICE_PARAM param, GTDIDeviceInfoParamExtOut& out, CMetricsDevice& metricsDevice )
     {
-        TCompletionCode       ret           = CC_OK;
-        GTDI_PLATFORM_INDEX   platformId    = GTDI_PLATFORM_MAX;
-        const TGfxDeviceInfo* gfxDeviceInfo = nullptr;
+        TCompletionCode          ret           = CC_OK;
+        GTDI_PLATFORM_INDEX      platformId    = GTDI_PLATFORM_MAX;
+        const TGfxDeviceInfo*    gfxDeviceInfo = nullptr;
+        const TTopologySnapshot* topology      = nullptr;
+
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
 
         ret = GetGfxDeviceInfo( gfxDeviceInfo );
         MD_CHECK_CC_RET_A( m_adapterId, ret );
@@ -602,15 +983,21 @@ namespace MetricsDiscoveryInternal
         {
             case GTDI_DEVICE_PARAM_EU_CORES_TOTAL_COUNT:
             {
-                ret = GetEuCoresTotalCount( out, metricsDevice );
+                ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_EU_CORES_TOTAL_COUNT, topology );
                 MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+                out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
+                out.ValueUint32 = topology->EuCoresTotalCount;
                 break;
             }
 
             case GTDI_DEVICE_PARAM_EU_CORES_PER_SUBSLICE_COUNT:
             {
-                ret = GetEuCoresPerSubsliceCount( out, metricsDevice );
+                ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_EU_CORES_PER_SUBSLICE_COUNT, topology );
                 MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+                out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
+                out.ValueUint32 = topology->EuCoresPerSubsliceCount;
                 break;
             }
 
@@ -621,13 +1008,11 @@ namespace MetricsDiscoveryInternal
 
                 if( IsDualSubsliceSupported() )
                 {
-                    int64_t dualSubsliceMask = 0;
-
-                    ret = GetSubsliceMask( dualSubsliceMask, metricsDevice );
+                    ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SUBSLICE_MASK, topology );
                     MD_CHECK_CC_RET_A( m_adapterId, ret );
 
                     out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
-                    out.ValueUint32 = CalculateEnabledBits( dualSubsliceMask );
+                    out.ValueUint32 = CalculateEnabledBits( topology->SubsliceMask );
                 }
                 else
                 {
@@ -639,13 +1024,11 @@ namespace MetricsDiscoveryInternal
             case GTDI_DEVICE_PARAM_SUBSLICES_TOTAL_COUNT:
             case GTDI_DEVICE_PARAM_SAMPLERS_COUNT:
             {
-                int64_t subsliceMask = 0;
-
-                ret = GetSubsliceMask( subsliceMask, metricsDevice );
+                ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SUBSLICE_MASK, topology );
                 MD_CHECK_CC_RET_A( m_adapterId, ret );
 
                 out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
-                out.ValueUint32 = CalculateEnabledBits( subsliceMask );
+                out.ValueUint32 = CalculateEnabledBits( topology->SubsliceMask );
 
                 if( IsDualSubsliceSupported() && param != GTDI_DEVICE_PARAM_SAMPLERS_COUNT )
                 {
@@ -656,13 +1039,11 @@ namespace MetricsDiscoveryInternal
 
             case GTDI_DEVICE_PARAM_SLICES_COUNT:
             {
-                int32_t sliceMask = 0;
-
-                ret = GetSliceMask( sliceMask, metricsDevice );
+                ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SLICE_MASK, topology );
                 MD_CHECK_CC_RET_A( m_adapterId, ret );
 
                 out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
-                out.ValueUint32 = CalculateEnabledBits( static_cast<uint64_t>( sliceMask ), static_cast<uint64_t>( 0xFFFFFFFF ) );
+                out.ValueUint32 = CalculateEnabledBits( static_cast<uint64_t>( topology->SliceMask ), static_cast<uint64_t>( 0xFFFFFFFF ) );
                 MD_ASSERT_A( m_adapterId, out.ValueUint32 <= MD_MAX_SLICE );
                 break;
             }
@@ -690,13 +1071,11 @@ namespace MetricsDiscoveryInternal
 
             case GTDI_DEVICE_PARAM_NUMBER_OF_RENDER_OUTPUT_UNITS:
             {
-                int32_t sliceMask = 0;
-
-                ret = GetSliceMask( sliceMask, metricsDevice );
+                ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SLICE_MASK, topology );
                 MD_CHECK_CC_RET_A( m_adapterId, ret );
 
                 out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
-                out.ValueUint32 = MD_NUM_PIXELS_OUT_PER_CLOCK * CalculateEnabledBits( static_cast<uint64_t>( sliceMask ) ); // pixels_out_per_clock * sliceCount
+                out.ValueUint32 = MD_NUM_PIXELS_OUT_PER_CLOCK * CalculateEnabledBits( static_cast<uint64_t>( topology->SliceMask ) ); // pixels_out_per_clock * sliceCount
                 break;
             }
 
@@ -725,11 +1104,10 @@ namespace MetricsDiscoveryInternal
                 }
                 else
                 {
-                    int64_t subSliceMask = 0;
-                    ret                  = GetSubsliceMask( subSliceMask, metricsDevice );
+                    ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SUBSLICE_MASK, topology );
                     MD_CHECK_CC_RET( ret );
 
-                    out.ValueUint64 = static_cast<uint64_t>( subSliceMask );
+                    out.ValueUint64 = static_cast<uint64_t>( topology->SubsliceMask );
                 }
 
                 break;
@@ -743,11 +1121,10 @@ namespace MetricsDiscoveryInternal
                 if( IsDualSubsliceSupported() )
                 {
                     // Return value is a mask of enabled dual subslices
-                    int64_t dualSubsliceMask = 0;
-                    ret                      = GetSubsliceMask( dualSubsliceMask, metricsDevice );
+                    ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SUBSLICE_MASK, topology );
                     MD_CHECK_CC_RET_A( m_adapterId, ret );
 
-                    out.ValueUint64 = static_cast<uint64_t>( dualSubsliceMask );
+                    out.ValueUint64 = static_cast<uint64_t>( topology->SubsliceMask );
                 }
                 else
                 {
@@ -758,13 +1135,11 @@ namespace MetricsDiscoveryInternal
 
             case GTDI_DEVICE_PARAM_SLICES_MASK:
             {
-                int32_t sliceMask = 0;
-
-                ret = GetSliceMask( sliceMask, metricsDevice );
+                ret = GetTopologySnapshot( metricsDevice, TOPOLOGY_FIELD_SLICE_MASK, topology );
                 MD_CHECK_CC_RET_A( m_adapterId, ret );
 
                 out.ValueType   = GTDI_DEVICE_PARAM_VALUE_TYPE_UINT32;
-                out.ValueUint32 = sliceMask;
+                out.ValueUint32 = topology->SliceMask;
 
                 break;
             }
@@ -1460,51 +1835,74 @@ namespace MetricsDiscoveryInternal
     //     LockConcurrentGroup
     //
     // Description:
-    //     Locks concurrent group of given name. Creates semaphore and waits up to 1s if
-    //     needed.
-    //     ! On Linux name isn't used, only semaphore pointer. !
+    //     Locks concurrent group of given name across all processes. Creates the lock
+    //     and waits up to the given timeout if needed.
+    //     The lock is released by the kernel if the owning process exits.
     //
     // Input:
-    //     const char* name        - concurrent group name
-    //     void**      semaphore   - (IN/OUT) pointer to the semaphore
+    //     const char*    name      - concurrent group name
+    //     const uint32_t timeoutMs - timeout in milliseconds or CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT
+    //     void**         semaphore - (IN/OUT) pointer to the concurrent group lock
     //
     // Output:
-    //     TCompletionCode         - *CC_OK* means succeess
+    //     TCompletionCode          - *CC_OK* means succeess
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CDriverInterfaceLinuxCommon::LockConcurrentGroup( const char* name, void** semaphore )
+    TCompletionCode CDriverInterfaceLinuxCommon::LockConcurrentGroup( const char* name, const uint32_t timeoutMs, void** semaphore )
     {
         MD_CHECK_PTR_RET_A( m_adapterId, semaphore, CC_ERROR_INVALID_PARAMETER );
 
-        TCompletionCode retVal = CC_OK;
-
         if( *semaphore == nullptr )
         {
-            if( SemaphoreCreate( name, semaphore, m_adapterId ) != CC_OK )
-            {
-                MD_LOG_A( m_adapterId, LOG_ERROR, "Creating semaphore failed" );
-                return CC_ERROR_GENERAL;
-            }
+            *semaphore = new( std::nothrow ) CConcurrentGroupLock();
+            MD_CHECK_PTR_RET_A( m_adapterId, *semaphore, CC_ERROR_NO_MEMORY );
         }
 
-        TSemaphoreWaitResult result = SemaphoreWait( 1000L, *semaphore, m_adapterId ); // Wait 1 sec
-        switch( result )
+        auto lock = static_cast<CConcurrentGroupLock*>( *semaphore );
+
+        return lock->Lock( name, ( timeoutMs == CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT ) ? GetConcurrentGroupLockTimeout() : timeoutMs, m_adapterId );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetConcurrentGroupLockTimeout
+    //
+    // Description:
+    //     Returns default concurrent group lock timeout, 1s. May be changed with
+    //     MD_CONCURRENT_GROUP_LOCK_TIMEOUT environment variable (in milliseconds),
+    //     0 turns the lock into try-lock. Overridden by SetLockTimeout.
+    //
+    // Output:
+    //     uint32_t - lock timeout in milliseconds
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CDriverInterfaceLinuxCommon::GetConcurrentGroupLockTimeout()
+    {
+        uint32_t    timeoutMs = MD_CONCURRENT_GROUP_LOCK_TIMEOUT_DEFAULT;
+        const char* value     = iu_dupenv_s( MD_CONCURRENT_GROUP_LOCK_TIMEOUT );
+
+        if( value != nullptr )
         {
-            case WAIT_RESULT_SUCCESSFUL: // The semaphore object was signaled
-                retVal = CC_OK;
-                break;
+            char*          end    = nullptr;
+            const uint64_t parsed = strtoull( value, &end, 10 );
 
-            case WAIT_RESULT_TIMEOUT: // A time-out occurred
-                retVal = CC_CONCURRENT_GROUP_LOCKED;
-                MD_LOG_A( m_adapterId, LOG_DEBUG, "Concurrent group locked" );
-                break;
+            if( end != value && *end == '\0' && parsed <= UINT32_MAX )
+            {
+                timeoutMs = static_cast<uint32_t>( parsed );
+            }
+            else
+            {
+                MD_LOG( LOG_WARNING, "Invalid %s value: %s", MD_CONCURRENT_GROUP_LOCK_TIMEOUT, value );
+            }
 
-            default:
-                retVal = CC_ERROR_GENERAL;
-                break;
+            free( (void*) value );
         }
 
-        return retVal;
+        return timeoutMs;
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -1517,11 +1915,11 @@ namespace MetricsDiscoveryInternal
     //
     // Description:
     //     Unlocks concurrent group of given name.
-    //     ! On Linux name isn't used, only semaphore pointer. !
+    //     ! On Linux name isn't used, only lock pointer. !
     //
     // Input:
     //     const char*     name        - name of the ConcurrentGroup
-    //     void**          semaphore   - (IN/OUT) pointer to the semaphore
+    //     void**          semaphore   - (IN/OUT) pointer to the concurrent group lock
     //
     // Output:
     //     TCompletionCode             - *CC_OK* means succeess
@@ -1532,12 +1930,21 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_PTR_RET_A( m_adapterId, semaphore, CC_ERROR_INVALID_PARAMETER );
         MD_CHECK_PTR_RET_A( m_adapterId, *semaphore, CC_ERROR_INVALID_PARAMETER );
 
-        if( SemaphoreRelease( semaphore, m_adapterId ) != CC_OK )
+        auto lock = static_cast<CConcurrentGroupLock*>( *semaphore );
+
+        if( lock->Unlock( m_adapterId ) != CC_OK )
         {
-            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Releasing semaphore failed" );
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Releasing concurrent group lock failed" );
             return CC_ERROR_GENERAL;
         }
 
+        if( lock->IsUnused() )
+        {
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "destroying concurrent group lock" );
+            MD_SAFE_DELETE( lock );
+            *semaphore = nullptr;
+        }
+
         return CC_OK;
     }
 
@@ -1576,6 +1983,15 @@ namespace MetricsDiscoveryInternal
             return CC_ERROR_NOT_SUPPORTED;
         }
 
+        if( oaConcurrentGroup.GetStreamType() == STREAM_TYPE_PMU )
+        {
+            return OpenPmuStream( oaConcurrentGroup, nsTimerPeriod, bufferSize );
+        }
+        if( oaConcurrentGroup.GetStreamType() == STREAM_TYPE_FDINFO )
+        {
+            return OpenFdinfoStream( oaConcurrentGroup, processId, nsTimerPeriod, bufferSize );
+        }
+
         // 1. ACTIVATE
         auto ret = metricSet->ActivateInternal( false, false );
         MD_CHECK_CC_RET_A( m_adapterId, ret );
@@ -1589,6 +2005,12 @@ namespace MetricsDiscoveryInternal
         int32_t        oaMetricSetId       = -1;
         uint32_t       regCount            = 0;
         TRegister**    regVector           = metricSet->GetStartConfiguration( regCount );
+        auto           options             = TOaStreamOptions{};
+
+        options.WakeupMode        = oaConcurrentGroup.GetIoStreamWakeupMode();
+        options.WakeupReportCount = oaConcurrentGroup.GetIoStreamWakeupReportCount();
+        options.ContextDrmFd      = -1;
+        options.ContextId         = oaConcurrentGroup.GetIoStreamContextId();
 
         if( oaReportType == static_cast<uint32_t>( -1 ) )
         {
@@ -1596,6 +2018,17 @@ namespace MetricsDiscoveryInternal
             goto deactivate;
         }
 
+        // Context DRM fd is duplicated and kept until the stream is closed, so the caller
+        // closing its fd doesn't destroy the context while the stream is opened.
+        if( oaConcurrentGroup.GetIoStreamContextDrmHandle() >= 0 )
+        {
+            ret = DuplicateContextDrmFd( static_cast<int32_t>( oaConcurrentGroup.GetIoStreamContextDrmHandle() ), options.ContextDrmFd );
+            if( ret != CC_OK )
+            {
+                goto deactivate;
+            }
+        }
+
         // 3. ADD HW CONFIG
         ret = AddOaConfig( regVector, regCount, metricsDevice.GetSubDeviceIndex(), nullptr, oaMetricSetId );
         if( ret != CC_OK )
@@ -1605,7 +2038,7 @@ namespace MetricsDiscoveryInternal
         MD_ASSERT_A( m_adapterId, oaMetricSetId != -1 );
 
         // 4. OPEN STREAM
-        ret = OpenOaStream( metricsDevice, oaMetricSetId, oaReportType, oaReportSize, timerPeriodExponent, bufferSize, oaConcurrentGroup.GetOaBufferType() );
+        ret = OpenOaStream( metricsDevice, oaMetricSetId, oaReportType, oaReportSize, timerPeriodExponent, bufferSize, oaConcurrentGroup.GetOaBufferType(), options );
         if( ret != CC_OK )
         {
             goto remove_config;
@@ -1621,6 +2054,7 @@ namespace MetricsDiscoveryInternal
         }
 
         metricsDevice.SetStreamConfigId( oaMetricSetId ); // Remember oa config id so it could be removed from the kernel on CloseIoStream
+        metricsDevice.SetStreamContextDrmFd( options.ContextDrmFd );
 
         MD_LOG_A( m_adapterId, LOG_DEBUG, "Oa stream opened with metricSetId: %d, periodNs: %u, exponent: %u, bufferSize: %u", oaMetricSetId, nsTimerPeriod, timerPeriodExponent, bufferSize );
         return CC_OK;
@@ -1629,6 +2063,10 @@ namespace MetricsDiscoveryInternal
         RemoveOaConfig( oaMetricSetId );
     deactivate:
         metricSet->Deactivate();
+        if( options.ContextDrmFd >= 0 )
+        {
+            close( options.ContextDrmFd );
+        }
         return ret;
     }
 
@@ -1661,6 +2099,15 @@ namespace MetricsDiscoveryInternal
             return CC_ERROR_NOT_SUPPORTED;
         }
 
+        if( oaConcurrentGroup.GetStreamType() == STREAM_TYPE_PMU )
+        {
+            return ReadPmuStream( oaConcurrentGroup, reportData, reportsCount );
+        }
+        if( oaConcurrentGroup.GetStreamType() == STREAM_TYPE_FDINFO )
+        {
+            return ReadFdinfoStream( oaConcurrentGroup, reportData, reportsCount );
+        }
+
         auto& device    = oaConcurrentGroup.GetMetricsDevice();
         auto  metricSet = oaConcurrentGroup.GetIoMetricSet();
 
@@ -1719,6 +2166,15 @@ namespace MetricsDiscoveryInternal
             return CC_ERROR_NOT_SUPPORTED;
         }
 
+        if( oaConcurrentGroup.GetStreamType() == STREAM_TYPE_PMU )
+        {
+            return ClosePmuStream( oaConcurrentGroup );
+        }
+        if( oaConcurrentGroup.GetStreamType() == STREAM_TYPE_FDINFO )
+        {
+            return CloseFdinfoStream( oaConcurrentGroup );
+        }
+
         auto& metricsDevice = oaConcurrentGroup.GetMetricsDevice();
         auto  metricSet     = oaConcurrentGroup.GetIoMetricSet();
 
@@ -1800,6 +2256,84 @@ namespace MetricsDiscoveryInternal
 
         return WaitForOaStreamReports( oaConcurrentGroup.GetMetricsDevice(), milliseconds );
     }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     WaitForIoStreamReports
+    //
+    // Description:
+    //     Waits the given number of milliseconds for reports from any of the given
+    //     IoStreams. All streams are polled at once.
+    //
+    // Input:
+    //     const std::vector<COAConcurrentGroup*>& oaConcurrentGroups - oa concurrent groups with opened streams
+    //     uint32_t                                milliseconds       - number of milliseconds to wait
+    //
+    // Output:
+    //     TCompletionCode                                            - *CC_OK* means succeess (reports available)
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::WaitForIoStreamReports( const std::vector<COAConcurrentGroup*>& oaConcurrentGroups, const uint32_t milliseconds )
+    {
+        std::vector<int32_t> streamIds;
+        streamIds.reserve( oaConcurrentGroups.size() );
+
+        for( auto oaConcurrentGroup : oaConcurrentGroups )
+        {
+            MD_CHECK_PTR_RET_A( m_adapterId, oaConcurrentGroup, CC_ERROR_INVALID_PARAMETER );
+
+            if( !IsStreamTypeSupported( oaConcurrentGroup->GetStreamType() ) )
+            {
+                return CC_ERROR_NOT_SUPPORTED;
+            }
+
+            streamIds.push_back( oaConcurrentGroup->GetMetricsDevice().GetStreamId() );
+        }
+
+        return WaitForOaStreamReports( streamIds.data(), streamIds.size(), milliseconds );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetIoStreamHandle
+    //
+    // Description:
+    //     Returns the file descriptor of the opened IoStream. It's opened as non-blocking
+    //     and readable (POLLIN) when reports are available, so it can be polled by the user.
+    //
+    // Input:
+    //     COAConcurrentGroup& oaConcurrentGroup - oa concurrent group
+    //     int64_t&            handle            - (out) stream file descriptor
+    //
+    // Output:
+    //     TCompletionCode                       - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::GetIoStreamHandle( COAConcurrentGroup& oaConcurrentGroup, int64_t& handle )
+    {
+        if( !IsStreamTypeSupported( oaConcurrentGroup.GetStreamType() ) )
+        {
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        const int32_t streamId = oaConcurrentGroup.GetMetricsDevice().GetStreamId();
+        if( streamId < 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        handle = streamId;
+        return CC_OK;
+    }
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -1851,6 +2385,10 @@ namespace MetricsDiscoveryInternal
             case STREAM_TYPE_OA:
             case STREAM_TYPE_OAM:
                 return true;
+            case STREAM_TYPE_PMU:
+                return IsPmuAvailable();
+            case STREAM_TYPE_FDINFO:
+                return IsFdinfoAvailable();
             default:
                 MD_LOG_A( m_adapterId, LOG_ERROR, "Error: Given stream type is not supported: %d", static_cast<uint32_t>( streamType ) );
                 return false;
@@ -1867,6 +2405,8 @@ namespace MetricsDiscoveryInternal
     //
     // Description:
     //     Enables / disables frequency override using CoreU function.
+    //     Frequency overrides set before the override was enabled are restored
+    //     when it's disabled, or when the driver context is deleted.
     //
     // Input:
     //     CMetricsDevice&                        device - a reference to device
@@ -1883,11 +2423,12 @@ namespace MetricsDiscoveryInternal
             MD_LOG_A( m_adapterId, LOG_WARNING, "Pid ignored, frequency override supported only in global mode (Pid = 0)" );
         }
 
-        uint64_t minFrequency        = 0;
-        uint64_t maxFrequency        = 0;
-        uint64_t minFrequencyToSet   = 0;
-        uint64_t maxFrequencyToSet   = 0;
-        uint64_t boostFrequencyToSet = 0;
+        const uint32_t                        subDeviceIndex = device.GetSubDeviceIndex();
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
+        uint64_t        minFrequency = 0;
+        uint64_t        maxFrequency = 0;
+        TSysFsFrequency frequency    = {};
 
         // Boost frequency needs to be remembered at the beginning for disable
         uint64_t* boostFrequencyPtr = ( m_CachedBoostFrequency ) ? nullptr : &m_CachedBoostFrequency;
@@ -1898,55 +2439,61 @@ namespace MetricsDiscoveryInternal
 
         MD_LOG_A( m_adapterId, LOG_DEBUG, "MinFreq: %llu, MaxFreq: %llu, BoostFreq: %llu MHz", minFrequency, maxFrequency, m_CachedBoostFrequency );
 
+        if( subDeviceIndex >= m_FrequencyOverrides.size() )
+        {
+            m_FrequencyOverrides.resize( subDeviceIndex + 1, nullptr );
+        }
+
+        auto& frequencyOverride = m_FrequencyOverrides[subDeviceIndex];
+
         // 2. Decide frequency values to be set (e.g. check range)
         if( params.Enable )
         {
             if( params.FrequencyMhz == 0 )
             {
                 MD_LOG_A( m_adapterId, LOG_DEBUG, "Using MaxFrequency as a default value (%llu MHz)", maxFrequency );
-                maxFrequencyToSet   = maxFrequency;
-                minFrequencyToSet   = maxFrequency;
-                boostFrequencyToSet = maxFrequency;
+                frequency.MinFrequency = maxFrequency;
             }
             else if( params.FrequencyMhz >= minFrequency && params.FrequencyMhz <= maxFrequency )
             {
                 MD_LOG_A( m_adapterId, LOG_DEBUG, "Setting frequency to %u MHz", params.FrequencyMhz );
-                maxFrequencyToSet   = params.FrequencyMhz;
-                minFrequencyToSet   = params.FrequencyMhz;
-                boostFrequencyToSet = params.FrequencyMhz;
+                frequency.MinFrequency = params.FrequencyMhz;
             }
             else
             {
                 MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Invalid frequency (%u MHz), should be in range [%llu, %llu]", params.FrequencyMhz, minFrequency, maxFrequency );
-                ret = CC_ERROR_INVALID_PARAMETER;
+                return CC_ERROR_INVALID_PARAMETER;
             }
-        }
-        else
-        {
-            MD_LOG_A( m_adapterId, LOG_DEBUG, "Disabling frequency override" );
-            minFrequencyToSet   = minFrequency;
-            maxFrequencyToSet   = maxFrequency;
-            boostFrequencyToSet = m_CachedBoostFrequency;
-        }
 
-        // 3. Request frequency change (set frequency override)
-        if( ret == CC_OK )
-        {
-            ret = WriteSysFsFile( device, SYS_FS_MIN_FREQ_OV, minFrequencyToSet );
-            MD_CHECK_CC_RET_A( m_adapterId, ret );
-
-            ret = WriteSysFsFile( device, SYS_FS_MAX_FREQ_OV, maxFrequencyToSet );
-            MD_CHECK_CC_RET_A( m_adapterId, ret );
+            frequency.MaxFrequency   = frequency.MinFrequency;
+            frequency.BoostFrequency = m_CachedBoostFrequency ? frequency.MinFrequency : 0;
 
-            // If boost frequency file available
-            if( m_CachedBoostFrequency )
+            // 3. Request frequency change, frequency overrides set before are saved on the first one
+            if( frequencyOverride == nullptr )
             {
-                ret = WriteSysFsFile( device, SYS_FS_BOOST_FREQ_OV, boostFrequencyToSet );
-                MD_CHECK_CC_RET_A( m_adapterId, ret );
+                frequencyOverride = new( std::nothrow ) CScopedFrequencyOverride( *this, subDeviceIndex );
+                MD_CHECK_PTR_RET_A( m_adapterId, frequencyOverride, CC_ERROR_NO_MEMORY );
             }
+
+            return frequencyOverride->Apply( frequency );
         }
 
-        return ret;
+        MD_LOG_A( m_adapterId, LOG_DEBUG, "Disabling frequency override" );
+
+        // 3. Restore frequency overrides saved when override was enabled
+        if( frequencyOverride != nullptr )
+        {
+            ret = frequencyOverride->Restore();
+            MD_SAFE_DELETE( frequencyOverride );
+            return ret;
+        }
+
+        // Override was not enabled by this library instance, use the whole frequency range
+        frequency.MinFrequency   = minFrequency;
+        frequency.MaxFrequency   = maxFrequency;
+        frequency.BoostFrequency = m_CachedBoostFrequency;
+
+        return WriteSysFsFrequency( subDeviceIndex, frequency );
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -2070,6 +2617,55 @@ namespace MetricsDiscoveryInternal
             close( id );
             metricsDevice.SetStreamId( -1 );
         }
+
+        const int32_t contextDrmFd = metricsDevice.GetStreamContextDrmFd();
+        if( contextDrmFd >= 0 )
+        {
+            close( contextDrmFd );
+            metricsDevice.SetStreamContextDrmFd( -1 );
+        }
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     DuplicateContextDrmFd
+    //
+    // Description:
+    //     Checks that a DRM fd given for a single context stream belongs to the
+    //     same device as this adapter, render and primary nodes are both accepted,
+    //     and duplicates it.
+    //
+    // Input:
+    //     const int32_t drmFd        - DRM fd owning the context
+    //     int32_t&      contextDrmFd - (out) duplicated fd, has to be closed
+    //
+    // Output:
+    //     TCompletionCode            - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::DuplicateContextDrmFd( const int32_t drmFd, int32_t& contextDrmFd )
+    {
+        contextDrmFd = -1;
+
+        const int32_t cardNumber = GetDrmCardNumber( drmFd );
+        if( cardNumber < 0 || cardNumber != m_DrmCardNumber )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Context drm fd %d doesn't belong to this adapter, card: %d, expected card: %d", drmFd, cardNumber, m_DrmCardNumber );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        contextDrmFd = fcntl( drmFd, F_DUPFD_CLOEXEC, 0 );
+        if( contextDrmFd < 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to duplicate context drm fd %d, errno: %d (%s)", drmFd, errno, strerror( errno ) );
+            return CC_ERROR_GENERAL;
+        }
+
         return CC_OK;
     }
 
@@ -2096,16 +2692,48 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CDriverInterfaceLinuxCommon::WaitForOaStreamReports( CMetricsDevice& metricsDevice, uint32_t timeoutMs )
     {
-        TCompletionCode retVal     = CC_OK;
-        pollfd          pollParams = {};
+        const int32_t streamId = metricsDevice.GetStreamId();
+
+        return WaitForOaStreamReports( &streamId, 1, timeoutMs );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     WaitForOaStreamReports
+    //
+    // Description:
+    //     Wait for any data available in any of the previously opened oa streams.
+    //
+    // Input:
+    //     const int32_t* streamIds    - oa stream file descriptors
+    //     const uint32_t streamsCount - oa streams count
+    //     uint32_t       timeoutMs    - wait timeout in milliseconds
+    //
+    // Output:
+    //     TCompletionCode             - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::WaitForOaStreamReports( const int32_t* streamIds, const uint32_t streamsCount, uint32_t timeoutMs )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, streamIds, CC_ERROR_INVALID_PARAMETER );
 
-        pollParams.fd      = metricsDevice.GetStreamId();
-        pollParams.revents = 0;
-        pollParams.events  = POLLIN;
+        TCompletionCode     retVal = CC_OK;
+        std::vector<pollfd> pollParams( streamsCount );
+
+        for( uint32_t i = 0; i < streamsCount; ++i )
+        {
+            pollParams[i].fd      = streamIds[i];
+            pollParams[i].revents = 0;
+            pollParams[i].events  = POLLIN;
+        }
 
         MD_LOG_A( m_adapterId, LOG_DEBUG, "Waiting %d ms", timeoutMs );
 
-        int32_t pollResult = poll( &pollParams, 1, timeoutMs );
+        int32_t pollResult = poll( pollParams.data(), streamsCount, timeoutMs );
         if( pollResult > 0 )
         {
             // OK, can read
@@ -2137,41 +2765,64 @@ namespace MetricsDiscoveryInternal
     //     CDriverInterfaceLinuxCommon
     //
     // Method:
-    //     GenerateQueryGUID
+    //     OpenPmuStream
     //
     // Description:
-    //     Generates query oa guid for given subDeviceIndex.
+    //     Opens engine busyness counters on the kernel driver PMU. There is no
+    //     hardware sampling, so no oa config is added and metric set isn't activated.
+    //     Counters are read on timerfd expirations, timerfd is used as the stream id,
+    //     so stream can be waited for and polled like the oa stream.
     //
     // Input:
-    //     const uint32_t subDeviceIndex - sub device index
+    //     COAConcurrentGroup& oaConcurrentGroup - pmu concurrent group
+    //     uint32_t&           nsTimerPeriod     - (in/out) requested/set sampling period time in nanoseconds
+    //     uint32_t&           bufferSize        - (out) buffer size in bytes, a single report
     //
     // Output:
-    //     std::string                   - generated guid
+    //     TCompletionCode                       - *CC_OK* means succeess
     //
     //////////////////////////////////////////////////////////////////////////////
-    std::string CDriverInterfaceLinuxCommon::GenerateQueryGuid( const uint32_t subDeviceIndex )
+    TCompletionCode CDriverInterfaceLinuxCommon::OpenPmuStream( COAConcurrentGroup& oaConcurrentGroup, uint32_t& nsTimerPeriod, uint32_t& bufferSize )
     {
-        const std::string valueToReplace    = "42a7";
-        const uint32_t    maxSubDeviceIndex = std::pow( 2, valueToReplace.length() * 4 ) - 1;
+        auto& metricsDevice = oaConcurrentGroup.GetMetricsDevice();
+        auto  metricSet     = oaConcurrentGroup.GetIoMetricSet();
 
-        if( subDeviceIndex > maxSubDeviceIndex )
+        MD_CHECK_PTR_RET_A( m_adapterId, metricSet, CC_ERROR_INVALID_PARAMETER );
+
+        if( metricSet->GetReportType() != OA_REPORT_TYPE_PMU_ENGINE_SAMPLE || metricSet->GetParams()->RawReportSize != sizeof( TPmuEngineReport ) )
         {
-            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Invalid sub device index" );
-            return "";
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Unexpected pmu report type: %u, size: %u", metricSet->GetReportType(), metricSet->GetParams()->RawReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
         }
 
-        std::string defaultGuid( MD_PERF_GUID_FOR_QUERY );
-
-        if( subDeviceIndex == 0 || subDeviceIndex == MD_ROOT_DEVICE_INDEX )
+        if( metricsDevice.GetStreamId() >= 0 )
         {
-            return defaultGuid;
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Stream already opened" );
+            return CC_ERROR_GENERAL;
         }
 
-        std::stringstream stream;
-        stream << std::setfill( '0' ) << std::setw( valueToReplace.length() ) << std::hex << subDeviceIndex;
-        std::string subDeviceIndexHexString( stream.str() );
+        std::unique_ptr<CPmuEngineSampler> sampler( new( std::nothrow ) CPmuEngineSampler() );
+        MD_CHECK_PTR_RET_A( m_adapterId, sampler, CC_ERROR_NO_MEMORY );
 
-        return std::regex_replace( defaultGuid, std::regex( valueToReplace ), subDeviceIndexHexString.c_str() );
+        TCompletionCode ret = sampler->Open( m_adapterId, m_pmuName );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        int32_t timerFd = -1;
+
+        ret = OpenStreamTimer( nsTimerPeriod, timerFd );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        // Reports aren't buffered, the last sample is read on timer expiration.
+        bufferSize = sizeof( TPmuEngineReport );
+
+        {
+            std::lock_guard<std::mutex> lock( m_pmuMutex );
+            m_pmuSamplers[timerFd] = std::move( sampler );
+        }
+        metricsDevice.SetStreamId( timerFd );
+
+        MD_LOG_A( m_adapterId, LOG_DEBUG, "Pmu stream opened, fd: %d, periodNs: %u", timerFd, nsTimerPeriod );
+        return CC_OK;
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -2180,44 +2831,501 @@ namespace MetricsDiscoveryInternal
     //     CDriverInterfaceLinuxCommon
     //
     // Method:
-    //     RemoveOaConfigQuery
+    //     ReadPmuStream
     //
     // Description:
-    //     Removes OA config previously added under MD_PERF_GUID_FOR_QUERY from i915 Perf or XE OA (if exists).
-    //     Query oa config has to be removed e.g. in case when measuring different sets or previous execution crash.
+    //     Reads a pmu report if the timer expired since the last read. Expirations
+    //     missed in between are merged into one report, values are cumulative, so
+    //     deltas stay correct.
     //
     // Input:
-    //     const char* guid - configuration guid
+    //     COAConcurrentGroup& oaConcurrentGroup - pmu concurrent group
+    //     char*               reportData        - (out) pointer to the read data
+    //     uint32_t&           reportsCount      - (in/out) reports read/to read from the stream
     //
     // Output:
-    //     TCompletionCode - *CC_OK* means success
+    //     TCompletionCode                       - *CC_OK* means succeess
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CDriverInterfaceLinuxCommon::RemoveOaConfigQuery( const char* guid )
+    TCompletionCode CDriverInterfaceLinuxCommon::ReadPmuStream( COAConcurrentGroup& oaConcurrentGroup, char* reportData, uint32_t& reportsCount )
     {
-        if( !OaMetricSetExists( guid ) )
-        {
-            MD_LOG_A( m_adapterId, LOG_DEBUG, "Oa configuration with query guid doesn't exist" );
-            return CC_OK;
-        }
+        MD_CHECK_PTR_RET_A( m_adapterId, reportData, CC_ERROR_INVALID_PARAMETER );
+
+        const int32_t      streamId = oaConcurrentGroup.GetMetricsDevice().GetStreamId();
+        CPmuEngineSampler* sampler  = nullptr;
 
-        int32_t         existingConfigId = -1;
-        TCompletionCode ret              = GetOaMetricSetId( guid, existingConfigId );
-        if( ret == CC_OK )
         {
-            MD_LOG_A( m_adapterId, LOG_DEBUG, "Removing oa config with query guid: %s, id: %d", guid, existingConfigId );
+            std::lock_guard<std::mutex> lock( m_pmuMutex );
 
-            ret = RemoveOaConfig( existingConfigId );
-            if( ret == CC_OK )
-            {
-                // Remove from remembered oa configs
-                m_AddedOaConfigs.erase( std::remove( m_AddedOaConfigs.begin(), m_AddedOaConfigs.end(), existingConfigId ), m_AddedOaConfigs.end() );
-            }
-            else
+            auto iterator = m_pmuSamplers.find( streamId );
+            if( iterator != m_pmuSamplers.end() )
             {
-                MD_LOG_A( m_adapterId, LOG_WARNING, "WARNING: Removing oa configuration with query guid failed, id: %d", existingConfigId );
+                sampler = iterator->second.get();
             }
-            existingConfigId = -1;
+        }
+
+        if( sampler == nullptr )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        bool            isExpired = false;
+        TCompletionCode ret       = ReadStreamTimer( streamId, isExpired );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        if( !isExpired )
+        {
+            reportsCount = 0;
+            return CC_OK;
+        }
+
+        TPmuEngineReport report = {};
+
+        ret = sampler->Read( m_adapterId, report );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        memcpy( reportData, &report, sizeof( report ) );
+        reportsCount = 1;
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     ClosePmuStream
+    //
+    // Description:
+    //     Closes pmu counters and the stream timer.
+    //
+    // Input:
+    //     COAConcurrentGroup& oaConcurrentGroup - pmu concurrent group
+    //
+    // Output:
+    //     TCompletionCode                       - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::ClosePmuStream( COAConcurrentGroup& oaConcurrentGroup )
+    {
+        auto& metricsDevice = oaConcurrentGroup.GetMetricsDevice();
+
+        {
+            std::lock_guard<std::mutex> lock( m_pmuMutex );
+            m_pmuSamplers.erase( metricsDevice.GetStreamId() );
+        }
+
+        return CloseOaStream( metricsDevice );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     IsPmuAvailable
+    //
+    // Description:
+    //     Returns true if the kernel driver exposes engine busyness PMU. PMU name
+    //     is looked up once and cached.
+    //
+    // Output:
+    //     bool - *true* if available
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CDriverInterfaceLinuxCommon::IsPmuAvailable()
+    {
+        std::lock_guard<std::mutex> lock( m_pmuMutex );
+
+        if( !m_isPmuNameResolved )
+        {
+            m_isPmuNameResolved = true;
+
+            if( CPmuEngineSampler::GetPmuName( m_DrmCardNumber, m_pmuName ) )
+            {
+                MD_LOG_A( m_adapterId, LOG_DEBUG, "Engine busyness PMU: %s", m_pmuName.c_str() );
+            }
+            else
+            {
+                MD_LOG_A( m_adapterId, LOG_INFO, "Engine busyness PMU not found for card: %d", m_DrmCardNumber );
+            }
+        }
+
+        return !m_pmuName.empty();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     OpenFdinfoStream
+    //
+    // Description:
+    //     Opens a DRM fdinfo sampler of the given process or of all processes.
+    //     Like the pmu stream, it doesn't program hardware and is read on timerfd
+    //     expirations, timerfd is used as the stream id.
+    //
+    // Input:
+    //     COAConcurrentGroup& oaConcurrentGroup - fdinfo concurrent group
+    //     const uint32_t      processId         - process to sample, 0 for all processes
+    //     uint32_t&           nsTimerPeriod     - (in/out) requested/set sampling period time in nanoseconds
+    //     uint32_t&           bufferSize        - (out) buffer size in bytes, a single report
+    //
+    // Output:
+    //     TCompletionCode                       - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::OpenFdinfoStream( COAConcurrentGroup& oaConcurrentGroup, const uint32_t processId, uint32_t& nsTimerPeriod, uint32_t& bufferSize )
+    {
+        auto& metricsDevice = oaConcurrentGroup.GetMetricsDevice();
+        auto  metricSet     = oaConcurrentGroup.GetIoMetricSet();
+
+        MD_CHECK_PTR_RET_A( m_adapterId, metricSet, CC_ERROR_INVALID_PARAMETER );
+
+        if( metricSet->GetReportType() != OA_REPORT_TYPE_PMU_ENGINE_SAMPLE || metricSet->GetParams()->RawReportSize != sizeof( TPmuEngineReport ) )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Unexpected fdinfo report type: %u, size: %u", metricSet->GetReportType(), metricSet->GetParams()->RawReportSize );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        if( metricsDevice.GetStreamId() >= 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Stream already opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        std::unique_ptr<CDrmFdinfoSampler> sampler( new( std::nothrow ) CDrmFdinfoSampler() );
+        MD_CHECK_PTR_RET_A( m_adapterId, sampler, CC_ERROR_NO_MEMORY );
+
+        TCompletionCode ret = sampler->Open( m_adapterId, m_fdinfoPciSlot, processId );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        int32_t timerFd = -1;
+
+        ret = OpenStreamTimer( nsTimerPeriod, timerFd );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        // Reports aren't buffered, processes are swept on timer expiration.
+        bufferSize = sizeof( TPmuEngineReport );
+
+        {
+            std::lock_guard<std::mutex> lock( m_pmuMutex );
+            m_fdinfoSamplers[timerFd] = std::move( sampler );
+        }
+        metricsDevice.SetStreamId( timerFd );
+
+        MD_LOG_A( m_adapterId, LOG_DEBUG, "Fdinfo stream opened, fd: %d, pid: %u, periodNs: %u", timerFd, processId, nsTimerPeriod );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     ReadFdinfoStream
+    //
+    // Description:
+    //     Sweeps processes and reads a report if the timer expired since the last
+    //     read. Values are cumulative, so merged expirations keep deltas correct.
+    //
+    // Input:
+    //     COAConcurrentGroup& oaConcurrentGroup - fdinfo concurrent group
+    //     char*               reportData        - (out) pointer to the read data
+    //     uint32_t&           reportsCount      - (in/out) reports read/to read from the stream
+    //
+    // Output:
+    //     TCompletionCode                       - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::ReadFdinfoStream( COAConcurrentGroup& oaConcurrentGroup, char* reportData, uint32_t& reportsCount )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, reportData, CC_ERROR_INVALID_PARAMETER );
+
+        const int32_t      streamId = oaConcurrentGroup.GetMetricsDevice().GetStreamId();
+        CDrmFdinfoSampler* sampler  = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock( m_pmuMutex );
+
+            auto iterator = m_fdinfoSamplers.find( streamId );
+            if( iterator != m_fdinfoSamplers.end() )
+            {
+                sampler = iterator->second.get();
+            }
+        }
+
+        if( sampler == nullptr )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Stream not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        bool            isExpired = false;
+        TCompletionCode ret       = ReadStreamTimer( streamId, isExpired );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        if( !isExpired )
+        {
+            reportsCount = 0;
+            return CC_OK;
+        }
+
+        TPmuEngineReport report = {};
+
+        ret = sampler->Read( m_adapterId, report );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        memcpy( reportData, &report, sizeof( report ) );
+        reportsCount = 1;
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     CloseFdinfoStream
+    //
+    // Description:
+    //     Closes the fdinfo sampler and the stream timer.
+    //
+    // Input:
+    //     COAConcurrentGroup& oaConcurrentGroup - fdinfo concurrent group
+    //
+    // Output:
+    //     TCompletionCode                       - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::CloseFdinfoStream( COAConcurrentGroup& oaConcurrentGroup )
+    {
+        auto& metricsDevice = oaConcurrentGroup.GetMetricsDevice();
+
+        {
+            std::lock_guard<std::mutex> lock( m_pmuMutex );
+            m_fdinfoSamplers.erase( metricsDevice.GetStreamId() );
+        }
+
+        return CloseOaStream( metricsDevice );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     IsFdinfoAvailable
+    //
+    // Description:
+    //     Returns true if the kernel driver exposes DRM client usage stats in fdinfo,
+    //     checked once on the DRM file of this adapter.
+    //
+    // Output:
+    //     bool - *true* if available
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CDriverInterfaceLinuxCommon::IsFdinfoAvailable()
+    {
+        std::lock_guard<std::mutex> lock( m_pmuMutex );
+
+        if( !m_isFdinfoResolved )
+        {
+            m_isFdinfoResolved = true;
+
+            if( CDrmFdinfoSampler::GetPciSlot( m_DrmDeviceHandle, m_fdinfoPciSlot ) )
+            {
+                MD_LOG_A( m_adapterId, LOG_DEBUG, "DRM client usage stats available, pdev: %s", m_fdinfoPciSlot.c_str() );
+            }
+            else
+            {
+                m_fdinfoPciSlot.clear();
+                MD_LOG_A( m_adapterId, LOG_INFO, "DRM client usage stats not available for card: %d", m_DrmCardNumber );
+            }
+        }
+
+        return !m_fdinfoPciSlot.empty();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     OpenStreamTimer
+    //
+    // Description:
+    //     Creates a periodic non-blocking timerfd for streams sampled in user space.
+    //
+    // Input:
+    //     uint32_t& nsTimerPeriod - (in/out) requested/set timer period in nanoseconds, at least 1 ms
+    //     int32_t&  timerFd       - (out) timer file descriptor
+    //
+    // Output:
+    //     TCompletionCode         - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::OpenStreamTimer( uint32_t& nsTimerPeriod, int32_t& timerFd )
+    {
+        constexpr uint32_t minTimerPeriodNs = 1000000;
+
+        timerFd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+        if( timerFd < 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to create timer, error: %d (%s)", errno, strerror( errno ) );
+            return CC_ERROR_GENERAL;
+        }
+
+        nsTimerPeriod = std::max( nsTimerPeriod, minTimerPeriodNs );
+
+        itimerspec timerSpec          = {};
+        timerSpec.it_interval.tv_sec  = nsTimerPeriod / MD_NSEC_PER_SEC;
+        timerSpec.it_interval.tv_nsec = nsTimerPeriod % MD_NSEC_PER_SEC;
+        timerSpec.it_value            = timerSpec.it_interval;
+
+        if( timerfd_settime( timerFd, 0, &timerSpec, nullptr ) != 0 )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to set timer, error: %d (%s)", errno, strerror( errno ) );
+            close( timerFd );
+            timerFd = -1;
+            return CC_ERROR_GENERAL;
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     ReadStreamTimer
+    //
+    // Description:
+    //     Consumes timer expirations since the last read, without blocking.
+    //
+    // Input:
+    //     const int32_t timerFd   - timer file descriptor
+    //     bool&         isExpired - (out) true if the timer expired since the last read
+    //
+    // Output:
+    //     TCompletionCode         - *CC_OK* means succeess
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::ReadStreamTimer( const int32_t timerFd, bool& isExpired )
+    {
+        uint64_t expirations = 0;
+
+        isExpired = read( timerFd, &expirations, sizeof( expirations ) ) == sizeof( expirations );
+
+        if( !isExpired && errno != EAGAIN )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to read timer, error: %d (%s)", errno, strerror( errno ) );
+            return CC_ERROR_GENERAL;
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GenerateQueryGUID
+    //
+    // Description:
+    //     Generates query oa guid for given subDeviceIndex.
+    //
+    // Input:
+    //     const uint32_t subDeviceIndex - sub device index
+    //
+    // Output:
+    //     std::string                   - generated guid
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    std::string CDriverInterfaceLinuxCommon::GenerateQueryGuid( const uint32_t subDeviceIndex )
+    {
+        const std::string valueToReplace    = "42a7";
+        const uint32_t    maxSubDeviceIndex = std::pow( 2, valueToReplace.length() * 4 ) - 1;
+
+        if( subDeviceIndex > maxSubDeviceIndex )
+        {
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Invalid sub device index" );
+            return "";
+        }
+
+        std::string defaultGuid( MD_PERF_GUID_FOR_QUERY );
+
+        if( subDeviceIndex == 0 || subDeviceIndex == MD_ROOT_DEVICE_INDEX )
+        {
+            return defaultGuid;
+        }
+
+        std::stringstream stream;
+        stream << std::setfill( '0' ) << std::setw( valueToReplace.length() ) << std::hex << subDeviceIndex;
+        std::string subDeviceIndexHexString( stream.str() );
+
+        return std::regex_replace( defaultGuid, std::regex( valueToReplace ), subDeviceIndexHexString.c_str() );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     RemoveOaConfigQuery
+    //
+    // Description:
+    //     Removes OA config previously added under MD_PERF_GUID_FOR_QUERY from i915 Perf or XE OA (if exists).
+    //     Query oa config has to be removed e.g. in case when measuring different sets or previous execution crash.
+    //
+    // Input:
+    //     const char* guid - configuration guid
+    //
+    // Output:
+    //     TCompletionCode - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::RemoveOaConfigQuery( const char* guid )
+    {
+        if( !OaMetricSetExists( guid ) )
+        {
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "Oa configuration with query guid doesn't exist" );
+            return CC_OK;
+        }
+
+        int32_t         existingConfigId = -1;
+        TCompletionCode ret              = GetOaMetricSetId( guid, existingConfigId );
+        if( ret == CC_OK )
+        {
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "Removing oa config with query guid: %s, id: %d", guid, existingConfigId );
+
+            ret = RemoveOaConfig( existingConfigId );
+            if( ret == CC_OK )
+            {
+                // Remove from remembered oa configs
+                m_AddedOaConfigs.erase( std::remove( m_AddedOaConfigs.begin(), m_AddedOaConfigs.end(), existingConfigId ), m_AddedOaConfigs.end() );
+            }
+            else
+            {
+                MD_LOG_A( m_adapterId, LOG_WARNING, "WARNING: Removing oa configuration with query guid failed, id: %d", existingConfigId );
+            }
+            existingConfigId = -1;
         }
 
         return ret;
@@ -2431,6 +3539,136 @@ namespace MetricsDiscoveryInternal
         return CC_ERROR_GENERAL;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetSysFsFile
+    //
+    // Description:
+    //     Returns a file descriptor of the given SysFs file. Files are opened on
+    //     first use and kept open until the driver context is deleted, so the path
+    //     is built once. Frequency override files are opened for reading and
+    //     writing if permissions allow it, other files for reading only.
+    //     A file kept open for reading only is reopened when writing is requested,
+    //     so a write fails with access denied instead of using a read only fd.
+    //     The returned fd may be closed by a reopen or CloseSysFsFiles, so callers
+    //     have to hold the device info lock until they finish using it.
+    //
+    // Input:
+    //     const uint32_t   subDeviceIndex - sub device index
+    //     const TSysFsType fileType       - type of SysFs file
+    //     const bool       writable       - true if the file descriptor is used for writing
+    //     int32_t&         fd             - (OUT) file descriptor
+    //
+    // Output:
+    //     TCompletionCode                 - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::GetSysFsFile( const uint32_t subDeviceIndex, const TSysFsType fileType, const bool writable, int32_t& fd )
+    {
+        MD_ASSERT_A( m_adapterId, m_DrmCardNumber >= 0 );
+
+        if( fileType >= SYS_FS_UNDEFINED )
+        {
+            MD_ASSERT_A( m_adapterId, false );
+            return CC_ERROR_INVALID_PARAMETER;
+        }
+
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
+        if( subDeviceIndex >= m_SysFsFiles.size() )
+        {
+            TSysFsFiles files;
+            files.fill( TSysFsFile{ -1, false } );
+
+            m_SysFsFiles.resize( subDeviceIndex + 1, files );
+        }
+
+        TSysFsFile& file = m_SysFsFiles[subDeviceIndex][fileType];
+
+        if( file.Fd < 0 || ( writable && !file.IsWritable ) )
+        {
+            char filePath[MD_MAX_PATH_LENGTH] = { 0 };
+
+            GetSysFsPath( subDeviceIndex, fileType, filePath, MD_MAX_PATH_LENGTH );
+
+            const bool isOverride = ( fileType == SYS_FS_MIN_FREQ_OV || fileType == SYS_FS_MAX_FREQ_OV || fileType == SYS_FS_BOOST_FREQ_OV );
+
+            int32_t newFd = ( isOverride || writable )
+                ? open( filePath, O_RDWR | O_CLOEXEC )
+                : -1;
+
+            const bool isWritable = newFd >= 0;
+
+            if( !isWritable && writable )
+            {
+                // Keep the read only file, a later write may try again.
+                const int32_t error = errno;
+
+                MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to open %s for writing, error: %d (%s)", filePath, error, strerror( error ) );
+                return ( error == EACCES || error == EPERM ) ? CC_ERROR_ACCESS_DENIED : CC_ERROR_FILE_NOT_FOUND;
+            }
+
+            if( !isWritable && file.Fd < 0 )
+            {
+                // Override files are writable only with sufficient permissions
+                newFd = open( filePath, O_RDONLY | O_CLOEXEC );
+
+                if( newFd < 0 )
+                {
+                    MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to open %s, error: %d (%s)", filePath, errno, strerror( errno ) );
+                    return CC_ERROR_FILE_NOT_FOUND;
+                }
+            }
+
+            if( file.Fd >= 0 )
+            {
+                close( file.Fd );
+            }
+
+            file.Fd         = newFd;
+            file.IsWritable = isWritable;
+        }
+
+        fd = file.Fd;
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     CloseSysFsFiles
+    //
+    // Description:
+    //     Closes all SysFs files opened by GetSysFsFile.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDriverInterfaceLinuxCommon::CloseSysFsFiles()
+    {
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
+        for( auto& files : m_SysFsFiles )
+        {
+            for( auto& file : files )
+            {
+                if( file.Fd >= 0 )
+                {
+                    close( file.Fd );
+                    file.Fd         = -1;
+                    file.IsWritable = false;
+                }
+            }
+        }
+
+        m_SysFsFiles.clear();
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -2444,23 +3682,51 @@ namespace MetricsDiscoveryInternal
     //     based on DRM card number.
     //
     // Input:
-    //     CMetricsDevice&  device   - a reference to device
-    //     const TSysFsType fileType - type of SysFs file to write
-    //     uint64_t         value    - value to write
+    //     CMetricsDevice&  device    - a reference to device
+    //     const TSysFsType fileType  - type of SysFs file to read
+    //     uint64_t*        readValue - (OUT) read value
     //
     // Output:
-    //     TCompletionCode           - *CC_OK* means success
+    //     TCompletionCode            - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CDriverInterfaceLinuxCommon::ReadSysFsFile( CMetricsDevice& device, const TSysFsType fileType, uint64_t* readValue )
     {
-        MD_ASSERT_A( m_adapterId, m_DrmCardNumber >= 0 );
+        return ReadSysFsFile( device.GetSubDeviceIndex(), fileType, readValue );
+    }
 
-        char filePath[MD_MAX_PATH_LENGTH] = { 0 };
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     ReadSysFsFile
+    //
+    // Description:
+    //     Reads a 64-bit unsigned value from the given SysFs file of the given
+    //     sub device using persistent file descriptor.
+    //
+    // Input:
+    //     const uint32_t   subDeviceIndex - sub device index
+    //     const TSysFsType fileType       - type of SysFs file to read
+    //     uint64_t*        readValue      - (OUT) read value
+    //
+    // Output:
+    //     TCompletionCode                 - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::ReadSysFsFile( const uint32_t subDeviceIndex, const TSysFsType fileType, uint64_t* readValue )
+    {
+        int32_t fd = -1;
+
+        // Held across the read, so the fd is not closed by a concurrent reopen.
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
 
-        GetSysFsPath( device, fileType, filePath, MD_MAX_PATH_LENGTH );
+        TCompletionCode ret = GetSysFsFile( subDeviceIndex, fileType, false, fd );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
 
-        return ReadUInt64FromFile( filePath, readValue );
+        return ReadUInt64FromFd( fd, readValue );
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -2472,27 +3738,122 @@ namespace MetricsDiscoveryInternal
     //     WriteSysFsFile
     //
     // Description:
-    //     Writes a 64-bit unsigned value the the given SysFs file. SysFs path is
-    //     based on DRM card number.
+    //     Writes a 64-bit unsigned value to the given SysFs file of the given
+    //     sub device using persistent file descriptor.
     //
     // Input:
-    //     CMetricsDevice&  device   - a reference to device
-    //     const TSysFsType fileType - type of SysFs file to write
-    //     uint64_t         value    - value to write
+    //     const uint32_t   subDeviceIndex - sub device index
+    //     const TSysFsType fileType       - type of SysFs file to write
+    //     uint64_t         value          - value to write
     //
     // Output:
-    //     TCompletionCode           - *CC_OK* means success
+    //     TCompletionCode                 - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CDriverInterfaceLinuxCommon::WriteSysFsFile( CMetricsDevice& device, const TSysFsType fileType, uint64_t value )
+    TCompletionCode CDriverInterfaceLinuxCommon::WriteSysFsFile( const uint32_t subDeviceIndex, const TSysFsType fileType, uint64_t value )
     {
-        MD_ASSERT_A( m_adapterId, m_DrmCardNumber >= 0 );
+        int32_t fd = -1;
+
+        // Held across the write, so the fd is not closed by a concurrent reopen.
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
+        TCompletionCode ret = GetSysFsFile( subDeviceIndex, fileType, true, fd );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        return WriteUInt64ToFd( fd, value );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     ReadSysFsFrequency
+    //
+    // Description:
+    //     Reads currently set Min/Max/Boost frequency overrides. Boost frequency
+    //     is read only if boost frequency file is available.
+    //
+    // Input:
+    //     const uint32_t   subDeviceIndex - sub device index
+    //     TSysFsFrequency& frequency      - (OUT) frequency overrides
+    //
+    // Output:
+    //     TCompletionCode                 - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::ReadSysFsFrequency( const uint32_t subDeviceIndex, TSysFsFrequency& frequency )
+    {
+        frequency = {};
+
+        TCompletionCode ret = ReadSysFsFile( subDeviceIndex, SYS_FS_MIN_FREQ_OV, &frequency.MinFrequency );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        ret = ReadSysFsFile( subDeviceIndex, SYS_FS_MAX_FREQ_OV, &frequency.MaxFrequency );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        if( m_CachedBoostFrequency )
+        {
+            ret = ReadSysFsFile( subDeviceIndex, SYS_FS_BOOST_FREQ_OV, &frequency.BoostFrequency );
+            MD_CHECK_CC_RET_A( m_adapterId, ret );
+        }
 
-        char filePath[MD_MAX_PATH_LENGTH] = { 0 };
+        return CC_OK;
+    }
 
-        GetSysFsPath( device, fileType, filePath, MD_MAX_PATH_LENGTH );
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     WriteSysFsFrequency
+    //
+    // Description:
+    //     Writes Min/Max/Boost frequency overrides together. KMD rejects a min
+    //     frequency above the current max frequency (and vice versa), so the order
+    //     of writes depends on the current max frequency override: max is written
+    //     first if the new min frequency exceeds it, min otherwise. Boost frequency
+    //     is written last, only if boost frequency file is available.
+    //
+    // Input:
+    //     const uint32_t         subDeviceIndex - sub device index
+    //     const TSysFsFrequency& frequency      - frequency overrides to write
+    //
+    // Output:
+    //     TCompletionCode                       - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::WriteSysFsFrequency( const uint32_t subDeviceIndex, const TSysFsFrequency& frequency )
+    {
+        uint64_t currentMaxFrequency = 0;
+
+        TCompletionCode ret = ReadSysFsFile( subDeviceIndex, SYS_FS_MAX_FREQ_OV, &currentMaxFrequency );
+        MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+        const bool isMaxFirst = frequency.MinFrequency > currentMaxFrequency;
+
+        const std::array<std::pair<TSysFsType, uint64_t>, 2> writes = {
+            isMaxFirst ? std::make_pair( SYS_FS_MAX_FREQ_OV, frequency.MaxFrequency ) : std::make_pair( SYS_FS_MIN_FREQ_OV, frequency.MinFrequency ),
+            isMaxFirst ? std::make_pair( SYS_FS_MIN_FREQ_OV, frequency.MinFrequency ) : std::make_pair( SYS_FS_MAX_FREQ_OV, frequency.MaxFrequency )
+        };
+
+        for( const auto& write : writes )
+        {
+            ret = WriteSysFsFile( subDeviceIndex, write.first, write.second );
+            MD_CHECK_CC_RET_A( m_adapterId, ret );
+        }
+
+        // If boost frequency file available
+        if( frequency.BoostFrequency )
+        {
+            ret = WriteSysFsFile( subDeviceIndex, SYS_FS_BOOST_FREQ_OV, frequency.BoostFrequency );
+            MD_CHECK_CC_RET_A( m_adapterId, ret );
+        }
 
-        return WriteUInt64ToFile( filePath, value );
+        MD_LOG_A( m_adapterId, LOG_DEBUG, "Frequency overrides set, min: %" PRIu64 ", max: %" PRIu64 ", boost: %" PRIu64 " MHz", frequency.MinFrequency, frequency.MaxFrequency, frequency.BoostFrequency );
+        return CC_OK;
     }
 
     //////////////////////////////////////////////////////////////////////////////
@@ -2518,9 +3879,6 @@ namespace MetricsDiscoveryInternal
     TCompletionCode CDriverInterfaceLinuxCommon::ReadUInt64FromFile( const char* filePath, uint64_t* readValue )
     {
         MD_CHECK_PTR_RET_A( m_adapterId, filePath, CC_ERROR_INVALID_PARAMETER );
-        MD_CHECK_PTR_RET_A( m_adapterId, readValue, CC_ERROR_INVALID_PARAMETER );
-
-        char buffer[32] = { 0 };
 
         int32_t fd = open( filePath, O_RDONLY );
         if( fd < 0 )
@@ -2529,9 +3887,40 @@ namespace MetricsDiscoveryInternal
             return CC_ERROR_FILE_NOT_FOUND;
         }
 
-        int32_t readBytes = read( fd, buffer, sizeof( buffer ) - 1 );
+        TCompletionCode ret = ReadUInt64FromFd( fd, readValue );
         close( fd );
 
+        return ret;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     ReadUInt64FromFd
+    //
+    // Description:
+    //     Reads 64-bit unsigned value from the given file descriptor. Reads from
+    //     the beginning of the file, so SysFs files may be read many times using
+    //     the same file descriptor.
+    //
+    // Input:
+    //     const int32_t fd        - file descriptor to read the value from
+    //     uint64_t*     readValue - (OUT) read value, not changed in case of error.
+    //
+    // Output:
+    //     TCompletionCode         - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::ReadUInt64FromFd( const int32_t fd, uint64_t* readValue )
+    {
+        MD_CHECK_PTR_RET_A( m_adapterId, readValue, CC_ERROR_INVALID_PARAMETER );
+
+        char buffer[32] = { 0 };
+
+        int32_t readBytes = pread( fd, buffer, sizeof( buffer ) - 1, 0 );
         if( readBytes < 0 )
         {
             MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Read negative number of bytes, error: %d (%s)", errno, strerror( errno ) );
@@ -2550,24 +3939,23 @@ namespace MetricsDiscoveryInternal
     //     CDriverInterfaceLinuxCommon
     //
     // Method:
-    //     WriteUInt64ToFile
+    //     WriteUInt64ToFd
     //
     // Description:
-    //     Writes 64-bit unsigned value to the given file.
-    //     Based on GpuTop read_file_uint64().
+    //     Writes 64-bit unsigned value to the given file descriptor. Writes to
+    //     the beginning of the file, so SysFs files may be written many times
+    //     using the same file descriptor.
     //
     // Input:
-    //     const char* filePath - file to write the value
-    //     uint64_t    value    - value to write
+    //     const int32_t fd    - file descriptor to write the value
+    //     uint64_t      value - value to write
     //
     // Output:
-    //     TCompletionCode      - *CC_OK* means success
+    //     TCompletionCode     - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CDriverInterfaceLinuxCommon::WriteUInt64ToFile( const char* filePath, uint64_t value )
+    TCompletionCode CDriverInterfaceLinuxCommon::WriteUInt64ToFd( const int32_t fd, uint64_t value )
     {
-        MD_CHECK_PTR_RET_A( m_adapterId, filePath, CC_ERROR_INVALID_PARAMETER );
-
         char buffer[32] = { 0 };
 
         int32_t length = snprintf( buffer, sizeof( buffer ), "%" PRIu64, value ); // Note: length does not contain null-terminating character
@@ -2577,19 +3965,10 @@ namespace MetricsDiscoveryInternal
             return CC_ERROR_GENERAL;
         }
 
-        int32_t fd = open( filePath, O_WRONLY );
-        if( fd < 0 )
-        {
-            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to open %s, error: %d (%s)", filePath, errno, strerror( errno ) );
-            return CC_ERROR_FILE_NOT_FOUND;
-        }
-
-        int32_t writeBytes = write( fd, buffer, length + 1 );
-        close( fd );
-
+        int32_t writeBytes = pwrite( fd, buffer, length + 1, 0 );
         if( writeBytes < length )
         {
-            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to write %s, error: %d (%s)", filePath, errno, strerror( errno ) );
+            MD_LOG_A( m_adapterId, LOG_ERROR, "ERROR: Failed to write %" PRIu64 ", error: %d (%s)", value, errno, strerror( errno ) );
             return CC_ERROR_GENERAL;
         }
 
@@ -2744,6 +4123,156 @@ namespace MetricsDiscoveryInternal
         return DRM_VERSION_UNDEFINED;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetDrmVersion
+    //
+    // Description:
+    //     Returns DRM version based on the kernel driver bound to the device,
+    //     read from sysfs. Does not require DRM node to be opened.
+    //
+    // Input:
+    //     const uint32_t majorNumber - DRM node major number
+    //     const uint32_t minorNumber - DRM node minor number
+    //
+    // Output:
+    //     TDrmVersion                - DRM version
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TDrmVersion CDriverInterfaceLinuxCommon::GetDrmVersion( const uint32_t majorNumber, const uint32_t minorNumber )
+    {
+        char driverLinkPath[MD_MAX_PATH_LENGTH] = { 0 };
+        char driverPath[MD_MAX_PATH_LENGTH]     = { 0 };
+
+        snprintf( driverLinkPath, sizeof( driverLinkPath ), "/sys/dev/char/%u:%u/device/driver", majorNumber, minorNumber );
+
+        const ssize_t length = readlink( driverLinkPath, driverPath, sizeof( driverPath ) - 1 );
+        if( length <= 0 )
+        {
+            return DRM_VERSION_UNDEFINED;
+        }
+
+        std::string_view driverName( driverPath, length );
+        driverName.remove_prefix( driverName.find_last_of( '/' ) + 1 );
+
+        if( driverName == "i915" )
+        {
+            return DRM_VERSION_I915;
+        }
+        else if( driverName == "xe" )
+        {
+            return DRM_VERSION_XE;
+        }
+
+        return DRM_VERSION_UNDEFINED;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetSubDevicesCount
+    //
+    // Description:
+    //     Returns sub devices count of the device read from sysfs, so adapter
+    //     params can be filled without opening DRM node. Xe exposes a tileN
+    //     directory per tile. I915 exposes a gtN directory per tile only on
+    //     multi tile platforms, the other platforms with sub device support
+    //     have a single one and the rest report none, the same as sub devices
+    //     enumeration does.
+    //
+    // Input:
+    //     const uint32_t        majorNumber   - DRM node major number
+    //     const uint32_t        minorNumber   - DRM node minor number
+    //     const TGfxDeviceInfo& gfxDeviceInfo - gfx device info
+    //
+    // Output:
+    //     uint32_t                            - sub devices count
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CDriverInterfaceLinuxCommon::GetSubDevicesCount( const uint32_t majorNumber, const uint32_t minorNumber, const TGfxDeviceInfo& gfxDeviceInfo )
+    {
+        const TDrmVersion drmVersion = GetDrmVersion( majorNumber, minorNumber );
+        const bool        isXe       = drmVersion == DRM_VERSION_XE;
+
+        if( !isXe && !IsPlatformMatch( gfxDeviceInfo.PlatformIndex, GENERATION_ACM, GENERATION_PVC, GENERATION_MTL, GENERATION_ARL ) )
+        {
+            return 0;
+        }
+
+        if( !isXe && !IsPlatformMatch( gfxDeviceInfo.PlatformIndex, GENERATION_PVC ) )
+        {
+            return 1;
+        }
+
+        // Returns the number of <prefix><number> entries in the directory.
+        auto countEntries = []( const char* directoryPath, const std::string_view prefix ) -> uint32_t
+        {
+            uint32_t count     = 0;
+            DIR*     directory = opendir( directoryPath );
+
+            if( directory == nullptr )
+            {
+                return 0;
+            }
+
+            while( const dirent* entry = readdir( directory ) )
+            {
+                const std::string_view name( entry->d_name );
+
+                if( name.size() > prefix.size() && name.compare( 0, prefix.size(), prefix ) == 0 &&
+                    std::all_of( name.begin() + prefix.size(), name.end(), []( const char c ) { return c >= '0' && c <= '9'; } ) )
+                {
+                    ++count;
+                }
+            }
+
+            closedir( directory );
+
+            return count;
+        };
+
+        char     path[MD_MAX_PATH_LENGTH] = { 0 };
+        uint32_t count                    = 0;
+
+        if( isXe )
+        {
+            snprintf( path, sizeof( path ), "/sys/dev/char/%u:%u/device", majorNumber, minorNumber );
+            count = countEntries( path, "tile" );
+        }
+        else
+        {
+            snprintf( path, sizeof( path ), "/sys/dev/char/%u:%u/device/drm", majorNumber, minorNumber );
+
+            DIR* directory = opendir( path );
+            if( directory != nullptr )
+            {
+                while( const dirent* entry = readdir( directory ) )
+                {
+                    if( strncmp( entry->d_name, "card", 4 ) == 0 )
+                    {
+                        char gtPath[MD_MAX_PATH_LENGTH] = { 0 };
+                        snprintf( gtPath, sizeof( gtPath ), "%s/%s/gt", path, entry->d_name );
+
+                        count = countEntries( gtPath, "gt" );
+                        break;
+                    }
+                }
+
+                closedir( directory );
+            }
+        }
+
+        // Device without the sysfs entries has a single tile.
+        return std::max<uint32_t>( count, 1 );
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -2756,7 +4285,9 @@ namespace MetricsDiscoveryInternal
     //     Returns gfx device info structure, based on DeviceId read from kernel.
     //     Gfx device info is used for e.g. ChipsetId and Platform matching or
     //     getting timestamp frequency.
-    //     Struct is obtained only once and cached for later use.
+    //     Struct is obtained only once and cached for later use. The cache is
+    //     filled under the device info lock, metric trees of sub devices may be
+    //     created in parallel.
     //
     // Input:
     //     const gfx_device_info*& gfxDeviceInfo - (OUT) gfx device info structure
@@ -2767,6 +4298,8 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CDriverInterfaceLinuxCommon::GetGfxDeviceInfo( const TGfxDeviceInfo*& gfxDeviceInfo )
     {
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
         // Get gfxDeviceInfo if not cached already
         if( m_CachedGfxDeviceInfo.PlatformIndex == GTDI_PLATFORM_MAX )
         {
@@ -2813,6 +4346,8 @@ namespace MetricsDiscoveryInternal
     {
         TCompletionCode ret = CC_ERROR_GENERAL; // Error if all parameters nullptr
 
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
         // Read minimum frequency
         if( minFrequency )
         {
@@ -3544,6 +5079,150 @@ namespace MetricsDiscoveryInternal
         return std::pow( 2, std::floor( log2( requestedBufferSize ) ) );
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     CalculateOaWakeupReportCount
+    //
+    // Description:
+    //     Returns the number of reports the kernel waits for before waking up
+    //     a reader, based on the requested wake-up mode. The value is limited
+    //     to the oa buffer capacity.
+    //
+    // Input:
+    //     const TOaStreamOptions& options      - oa stream options
+    //     const uint32_t          bufferSize   - oa buffer size in bytes
+    //     const uint32_t          oaReportSize - oa report size in bytes
+    //
+    // Output:
+    //     uint32_t                             - number of reports
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CDriverInterfaceLinuxCommon::CalculateOaWakeupReportCount( const TOaStreamOptions& options, const uint32_t bufferSize, const uint32_t oaReportSize )
+    {
+        const uint32_t bufferSizeInReports = std::max<uint32_t>( bufferSize / oaReportSize, 1 );
+
+        switch( options.WakeupMode )
+        {
+            case IO_STREAM_WAKEUP_MODE_LATENCY:
+                return 1;
+
+            case IO_STREAM_WAKEUP_MODE_THROUGHPUT:
+                return std::max<uint32_t>( bufferSizeInReports / 4 * 3, 1 );
+
+            case IO_STREAM_WAKEUP_MODE_REPORT_COUNT:
+                if( options.WakeupReportCount > bufferSizeInReports )
+                {
+                    MD_LOG_A( m_adapterId, LOG_WARNING, "Wake-up report count %u exceeds oa buffer capacity, %u is used", options.WakeupReportCount, bufferSizeInReports );
+                    return bufferSizeInReports;
+                }
+                return std::max<uint32_t>( options.WakeupReportCount, 1 );
+
+            case IO_STREAM_WAKEUP_MODE_DEFAULT:
+            default:
+                return std::max<uint32_t>( bufferSizeInReports / 2, 1 );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetTopologySnapshotEntry
+    //
+    // Description:
+    //     Returns topology cache entry for the given sub device. Entries are
+    //     created on demand and invalid until filled by GetTopologySnapshot.
+    //
+    // Input:
+    //     const uint32_t subDeviceIndex - sub device index
+    //
+    // Output:
+    //     TTopologySnapshot&            - topology cache entry
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TTopologySnapshot& CDriverInterfaceLinuxCommon::GetTopologySnapshotEntry( const uint32_t subDeviceIndex )
+    {
+        if( subDeviceIndex >= m_CachedTopology.size() )
+        {
+            m_CachedTopology.resize( subDeviceIndex + 1, TTopologySnapshot{} );
+        }
+
+        return m_CachedTopology[subDeviceIndex];
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDriverInterfaceLinuxCommon
+    //
+    // Method:
+    //     GetTopologySnapshot
+    //
+    // Description:
+    //     Returns GT topology of the given (sub)device with the given field valid.
+    //     Topology is read from the kernel with a single topology query on first
+    //     use, each field is derived from it on its first use. A failed field
+    //     isn't cached and doesn't affect the other fields.
+    //
+    // Input:
+    //     CMetricsDevice&           metricsDevice - metrics device
+    //     const TTopologyField      field         - field to be valid
+    //     const TTopologySnapshot*& topology      - (OUT) topology snapshot
+    //
+    // Output:
+    //     TCompletionCode                         - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDriverInterfaceLinuxCommon::GetTopologySnapshot( CMetricsDevice& metricsDevice, const TTopologyField field, const TTopologySnapshot*& topology )
+    {
+        TCompletionCode    ret      = CC_OK;
+        TTopologySnapshot& snapshot = GetTopologySnapshotEntry( metricsDevice.GetSubDeviceIndex() );
+
+        if( ( snapshot.ValidFields & field ) == 0 )
+        {
+            auto out = GTDIDeviceInfoParamExtOut();
+
+            // Raw topology query result is stored in the snapshot by the first getter,
+            // the remaining ones decode it without calling the kernel again.
+            switch( field )
+            {
+                case TOPOLOGY_FIELD_SLICE_MASK:
+                    ret = GetSliceMask( snapshot.SliceMask, metricsDevice );
+                    break;
+
+                case TOPOLOGY_FIELD_SUBSLICE_MASK:
+                    ret = GetSubsliceMask( snapshot.SubsliceMask, metricsDevice );
+                    break;
+
+                case TOPOLOGY_FIELD_EU_CORES_TOTAL_COUNT:
+                    ret                        = GetEuCoresTotalCount( out, metricsDevice );
+                    snapshot.EuCoresTotalCount = out.ValueUint32;
+                    break;
+
+                case TOPOLOGY_FIELD_EU_CORES_PER_SUBSLICE_COUNT:
+                    ret                              = GetEuCoresPerSubsliceCount( out, metricsDevice );
+                    snapshot.EuCoresPerSubsliceCount = out.ValueUint32;
+                    break;
+
+                default:
+                    ret = CC_ERROR_INVALID_PARAMETER;
+                    break;
+            }
+            MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+            snapshot.ValidFields |= field;
+        }
+
+        topology = &snapshot;
+        return ret;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
@@ -3561,6 +5240,28 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     CAdapterHandleLinux::CAdapterHandleLinux( int32_t adapterHandle )
         : m_handle( adapterHandle )
+        , m_nodePath()
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapterHandleLinux
+    //
+    // Method:
+    //     CAdapterHandleLinux
+    //
+    // Description:
+    //     Constructor. DRM node is not opened until Open is called.
+    //
+    // Input:
+    //     const char* nodePath - DRM node path, e.g. /dev/dri/renderD128
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CAdapterHandleLinux::CAdapterHandleLinux( const char* nodePath )
+        : m_handle( InvalidValue )
+        , m_nodePath( nodePath ? nodePath : "" )
     {
     }
 
@@ -3634,6 +5335,46 @@ namespace MetricsDiscoveryInternal
         return m_handle != InvalidValue;
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CAdapterHandleLinux
+    //
+    // Method:
+    //     Open
+    //
+    // Description:
+    //     Opens DRM node given in the constructor, if not opened yet.
+    //
+    // Output:
+    //     TCompletionCode - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CAdapterHandleLinux::Open()
+    {
+        if( IsValid() )
+        {
+            return CC_OK;
+        }
+
+        if( m_nodePath.empty() )
+        {
+            MD_LOG( LOG_ERROR, "ERROR: Adapter handle without drm node" );
+            return CC_ERROR_GENERAL;
+        }
+
+        MD_LOG( LOG_DEBUG, "Open drm node '%s'", m_nodePath.c_str() );
+
+        m_handle = open( m_nodePath.c_str(), O_RDWR );
+        if( m_handle == InvalidValue )
+        {
+            MD_LOG( LOG_ERROR, "ERROR: Failed to open drm node '%s', errno: %d", m_nodePath.c_str(), errno );
+            return CC_ERROR_GENERAL;
+        }
+
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class:
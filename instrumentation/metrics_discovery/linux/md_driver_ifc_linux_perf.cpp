@@ -160,12 +160,13 @@ namespace MetricsDiscoveryInternal
     //     Returns a path to a given system file.
     //
     // Input:
-    //     CMetricsDevice& device - (IN)  metrics device
-    //     const char* fileName   - (IN)  a system file name
-    //     const char* filePath   - (OUT) a path to the system file
+    //     const uint32_t subDeviceIndex - (IN)  sub device index, not used
+    //     const TSysFsType fileType     - (IN)  a system file type
+    //     char* filePath                - (OUT) a path to the system file
+    //     const uint32_t filePathLength - (IN)  file path buffer size
     //
     //////////////////////////////////////////////////////////////////////////////
-    void CDriverInterfaceLinuxPerf::GetSysFsPath( CMetricsDevice& device, const TSysFsType fileType, char* filePath, const uint32_t filePathLength )
+    void CDriverInterfaceLinuxPerf::GetSysFsPath( [[maybe_unused]] const uint32_t subDeviceIndex, const TSysFsType fileType, char* filePath, const uint32_t filePathLength )
     {
         const char* fileName = "";
 
@@ -815,12 +816,13 @@ namespace MetricsDiscoveryInternal
     //     uint32_t                  timerPeriodExponent - timer period exponent
     //     uint32_t                  bufferSize          - oa buffer size
     //     const GTDI_OA_BUFFER_TYPE oaBufferType        - oa buffer type
+    //     const TOaStreamOptions&   options             - oa stream options
     //
     // Output:
     //     TCompletionCode                               - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CDriverInterfaceLinuxPerf::OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType )
+    TCompletionCode CDriverInterfaceLinuxPerf::OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType, const TOaStreamOptions& options )
     {
         TCompletionCode       ret                    = CC_ERROR_GENERAL;
         int32_t               oaRevision             = -1;
@@ -828,6 +830,7 @@ namespace MetricsDiscoveryInternal
         uint32_t              requiredEngineInstance = -1;
         const bool            isOamRequested         = IsOamRequested( oaReportType );
         const uint32_t        subDeviceIndex         = metricsDevice.GetSubDeviceIndex();
+        const int32_t         drmFd                  = ( options.ContextDrmFd >= 0 ) ? options.ContextDrmFd : static_cast<int32_t>( m_DrmDeviceHandle );
         auto                  subDevices             = metricsDevice.GetAdapter().GetSubDevices();
         auto                  engine                 = TEngineParamsLatest{};
         auto                  param                  = drm_i915_perf_open_param{};
@@ -871,14 +874,27 @@ namespace MetricsDiscoveryInternal
             MD_LOG_A( m_adapterId, LOG_DEBUG, "Cannot set oa buffer size. Current perf revision is %d. Required is %d.", m_cachedPerfRevision, MD_SET_OA_BUFFER_SIZE_PERF_REVISION_MIN_VERSION );
         }
 
-        // Half-full buffer interrupt.
+        // Wake-up watermark, half-full buffer by default.
         if( m_perfCapabilities.IsOaNotifyNumReportsSupported )
         {
-            const uint32_t halfSizeInReports = bufferSize / 2 / oaReportSize;
+            const uint32_t notifyNumReports = CalculateOaWakeupReportCount( options, bufferSize, oaReportSize );
 
-            addProperty( PRELIM_DRM_I915_PERF_PROP_OA_NOTIFY_NUM_REPORTS, halfSizeInReports );
+            addProperty( PRELIM_DRM_I915_PERF_PROP_OA_NOTIFY_NUM_REPORTS, notifyNumReports );
 
-            MD_LOG_A( m_adapterId, LOG_DEBUG, "Notify num reports is %u", halfSizeInReports );
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "Notify num reports is %u", notifyNumReports );
+        }
+        else if( options.WakeupMode != IO_STREAM_WAKEUP_MODE_DEFAULT )
+        {
+            MD_LOG_A( m_adapterId, LOG_WARNING, "Cannot set wake-up mode %u. Current perf revision is %d. Required is %d.", options.WakeupMode, m_cachedPerfRevision, MD_SET_OA_NOTIFY_NUM_REPORTS_PERF_REVISION_MIN_VERSION );
+        }
+
+        // Single context stream, reports of other contexts are dropped by the kernel.
+        // The context handle is looked up in the DRM fd the stream is opened with.
+        if( options.ContextDrmFd >= 0 )
+        {
+            addProperty( DRM_I915_PERF_PROP_CTX_HANDLE, options.ContextId );
+
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "Context handle is %u, drm fd: %d", options.ContextId, options.ContextDrmFd );
         }
 
         if( IsSubDeviceSupported() )
@@ -932,7 +948,7 @@ namespace MetricsDiscoveryInternal
 
             MD_LOG_A( m_adapterId, LOG_DEBUG, "Opening i915 Perf stream with params: oaMetricSetId: %u, oaReportType: %u, timerPeriodExponent: %u, bufferSize: %u", oaMetricSetId, oaReportType, timerPeriodExponent, bufferSize );
 
-            oaEventFd = SendIoctl( m_DrmDeviceHandle, DRM_IOCTL_I915_PERF_OPEN, &param );
+            oaEventFd = SendIoctl( drmFd, DRM_IOCTL_I915_PERF_OPEN, &param );
         }
         while( oaEventFd == -1 && UpdateTbsEngineParams( metricsDevice, properties ) == CC_OK );
 
@@ -1505,6 +1521,7 @@ namespace MetricsDiscoveryInternal
     //
     // Description:
     //     Allows to query drm to obtain query information per subdevice.
+    //     Query result is cached in the sub device topology snapshot.
     //
     // Input:
     //     std::vector<uint8_t>&    buffer         - [In/Out] data
@@ -1520,11 +1537,24 @@ namespace MetricsDiscoveryInternal
         TCompletionCode       ret           = GetGfxDeviceInfo( gfxDeviceInfo );
         MD_CHECK_CC_RET_A( m_adapterId, ret );
 
-        const uint32_t subDeviceIndex = metricsDevice.GetSubDeviceIndex();
+        const uint32_t        subDeviceIndex = metricsDevice.GetSubDeviceIndex();
+        std::vector<uint8_t>& cachedData     = GetTopologySnapshotEntry( subDeviceIndex ).QueryData;
+
+        // Topology does not change at runtime, so the kernel is queried only once.
+        if( cachedData.size() )
+        {
+            buffer = cachedData;
+            return CC_OK;
+        }
+
         // For root device we don't need prelim function and can use GetQueryTopologyInfo
         if( subDeviceIndex == 0 )
         {
-            return GetQueryTopologyInfo( buffer );
+            ret = GetQueryTopologyInfo( buffer );
+            MD_CHECK_CC_RET_A( m_adapterId, ret );
+
+            cachedData = buffer;
+            return CC_OK;
         }
 
         auto subDevices = metricsDevice.GetAdapter().GetSubDevices();
@@ -1554,6 +1584,7 @@ namespace MetricsDiscoveryInternal
         MD_CHECK_CC_RET_A( m_adapterId, ret );
         MD_CHECK_CC_RET_A( m_adapterId, buffer.size() ? CC_OK : CC_ERROR_GENERAL );
 
+        cachedData = buffer;
         return CC_OK;
     }
 
@@ -1875,6 +1906,8 @@ namespace MetricsDiscoveryInternal
     {
         TCompletionCode ret = CC_OK;
 
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
         if( m_CachedDeviceId == -1 )
         {
             ret = SendGetParamIoctl( m_DrmDeviceHandle, I915_PARAM_CHIPSET_ID, m_CachedDeviceId );
@@ -1911,6 +1944,8 @@ namespace MetricsDiscoveryInternal
     {
         TCompletionCode ret = CC_OK;
 
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
         if( m_CachedRevisionId == -1 )
         {
             ret = SendGetParamIoctl( m_DrmDeviceHandle, I915_PARAM_REVISION, m_CachedRevisionId );
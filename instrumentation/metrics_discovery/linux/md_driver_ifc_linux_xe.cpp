@@ -138,17 +138,17 @@ namespace MetricsDiscoveryInternal
     //     Returns a path to a given system file.
     //
     // Input:
-    //     CMetricsDevice& metricsDevice - (IN)  metrics device
-    //     const char* fileName          - (IN)  a system file name
-    //     const char* filePath          - (OUT) a path to the system file
+    //     const uint32_t subDeviceIndex - (IN)  sub device index
+    //     const TSysFsType fileType     - (IN)  a system file type
+    //     char* filePath                - (OUT) a path to the system file
+    //     const uint32_t filePathLength - (IN)  file path buffer size
     //
     //////////////////////////////////////////////////////////////////////////////
-    void CDriverInterfaceLinuxXe::GetSysFsPath( CMetricsDevice& metricsDevice, const TSysFsType fileType, char* filePath, const uint32_t filePathLength )
+    void CDriverInterfaceLinuxXe::GetSysFsPath( const uint32_t subDeviceIndex, const TSysFsType fileType, char* filePath, const uint32_t filePathLength )
     {
-        const uint32_t subDeviceIndex = metricsDevice.GetSubDeviceIndex();
-        const uint32_t gt             = 0;
-        const uint32_t freq           = 0;
-        const char*    fileName       = "";
+        const uint32_t gt       = 0;
+        const uint32_t freq     = 0;
+        const char*    fileName = "";
 
         switch( fileType )
         {
@@ -479,12 +479,13 @@ namespace MetricsDiscoveryInternal
     //     uint32_t                  timerPeriodExponent - timer period exponent
     //     uint32_t                  bufferSize          - oa buffer size
     //     const GTDI_OA_BUFFER_TYPE oaBufferType        - oa buffer type
+    //     const TOaStreamOptions&   options             - oa stream options
     //
     // Output:
     //     TCompletionCode                               - *CC_OK* means success
     //
     //////////////////////////////////////////////////////////////////////////////
-    TCompletionCode CDriverInterfaceLinuxXe::OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType )
+    TCompletionCode CDriverInterfaceLinuxXe::OpenOaStream( CMetricsDevice& metricsDevice, uint32_t oaMetricSetId, uint32_t oaReportType, uint32_t oaReportSize, uint32_t timerPeriodExponent, uint32_t bufferSize, const GTDI_OA_BUFFER_TYPE oaBufferType, const TOaStreamOptions& options )
     {
         TCompletionCode         ret                                                                          = CC_ERROR_GENERAL;
         int32_t                 oaEventFd                                                                    = -1;
@@ -538,14 +539,27 @@ namespace MetricsDiscoveryInternal
             MD_LOG_A( m_adapterId, LOG_DEBUG, "Cannot set oa buffer size. Configurable OA buffer size is not available." );
         }
 
-        // Half-full buffer interrupt.
+        // Wake-up watermark, half-full buffer by default.
         if( m_xeObservationCapabilities.IsOaNotifyNumReportsSupported )
         {
-            const uint32_t halfSizeInReports = bufferSize / 2 / oaReportSize;
+            const uint32_t waitNumReports = CalculateOaWakeupReportCount( options, bufferSize, oaReportSize );
+
+            addProperty( DRM_XE_OA_PROPERTY_WAIT_NUM_REPORTS, waitNumReports );
 
-            addProperty( DRM_XE_OA_PROPERTY_WAIT_NUM_REPORTS, halfSizeInReports );
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "Number of reports KMD needs to wait before unblocking is %u", waitNumReports );
+        }
+        else if( options.WakeupMode != IO_STREAM_WAKEUP_MODE_DEFAULT )
+        {
+            MD_LOG_A( m_adapterId, LOG_WARNING, "Cannot set wake-up mode %u. Wait num reports is not available.", options.WakeupMode );
+        }
+
+        // Single exec queue stream, reports of other exec queues are dropped by the kernel.
+        // The exec queue id is looked up in the DRM fd the stream is opened with.
+        if( options.ContextDrmFd >= 0 )
+        {
+            addProperty( DRM_XE_OA_PROPERTY_EXEC_QUEUE_ID, options.ContextId );
 
-            MD_LOG_A( m_adapterId, LOG_DEBUG, "Number of reports KMD needs to wait before unblocking is %u", halfSizeInReports );
+            MD_LOG_A( m_adapterId, LOG_DEBUG, "Exec queue id is %u, drm fd: %d", options.ContextId, options.ContextDrmFd );
         }
 
         param.observation_type = DRM_XE_OBSERVATION_TYPE_OA;
@@ -554,7 +568,7 @@ namespace MetricsDiscoveryInternal
 
         MD_LOG_A( m_adapterId, LOG_DEBUG, "Opening XE OA stream with params: oaMetricSetId: %u, oaReportType: %u, timerPeriodExponent: %u, bufferSize: %u", oaMetricSetId, oaReportType, timerPeriodExponent, bufferSize );
 
-        oaEventFd = SendIoctl( m_DrmDeviceHandle, DRM_IOCTL_XE_OBSERVATION, &param );
+        oaEventFd = SendIoctl( ( options.ContextDrmFd >= 0 ) ? options.ContextDrmFd : static_cast<int32_t>( m_DrmDeviceHandle ), DRM_IOCTL_XE_OBSERVATION, &param );
 
         if( oaEventFd == -1 )
         {
@@ -1060,6 +1074,7 @@ namespace MetricsDiscoveryInternal
     //
     // Description:
     //     Allows to query drm to obtain query information per subdevice.
+    //     Query result is cached in the sub device topology snapshot.
     //
     // Input:
     //     std::vector<uint8_t>&    buffer         - [In/Out] data
@@ -1071,11 +1086,21 @@ namespace MetricsDiscoveryInternal
     //////////////////////////////////////////////////////////////////////////////
     TCompletionCode CDriverInterfaceLinuxXe::GetGeometryTopology( std::vector<uint8_t>& buffer, CMetricsDevice& metricsDevice )
     {
+        std::vector<uint8_t>& cachedData = GetTopologySnapshotEntry( metricsDevice.GetSubDeviceIndex() ).QueryData;
+
+        // Topology does not change at runtime, so the kernel is queried only once.
+        if( cachedData.size() )
+        {
+            buffer = cachedData;
+            return CC_OK;
+        }
+
         TCompletionCode ret = QueryDrm( DRM_XE_DEVICE_QUERY_GT_TOPOLOGY, buffer );
 
         MD_CHECK_CC_RET_A( m_adapterId, ret );
         MD_CHECK_CC_RET_A( m_adapterId, buffer.size() ? CC_OK : CC_ERROR_GENERAL );
 
+        cachedData = buffer;
         return CC_OK;
     }
 
@@ -1338,6 +1363,8 @@ namespace MetricsDiscoveryInternal
     {
         TCompletionCode ret = CC_OK;
 
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
         if( m_CachedDeviceId == -1 )
         {
             std::vector<uint8_t> buffer = {};
@@ -1385,6 +1412,8 @@ namespace MetricsDiscoveryInternal
     {
         TCompletionCode ret = CC_OK;
 
+        std::lock_guard<std::recursive_mutex> lock( m_deviceInfoMutex );
+
         if( m_CachedRevisionId == -1 )
         {
             std::vector<uint8_t> buffer = {};
@@ -0,0 +1,813 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_drm_fdinfo_linux.cpp
+
+//     Abstract:   C++ per process engine utilization sampler based on DRM fdinfo implementation for Linux
+
+#include "md_drm_fdinfo_linux.h"
+#include "md_utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string_view>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MetricsDiscoveryInternal
+{
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     CDrmFdinfoSampler constructor
+    //
+    // Description:
+    //     Constructor. Sampler is opened with Open().
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CDrmFdinfoSampler::CDrmFdinfoSampler()
+        : m_procDir( nullptr )
+        , m_pciSlot()
+        , m_processId( 0 )
+        , m_sweep( 0 )
+        , m_startNs( 0 )
+        , m_prevElapsedNs( 0 )
+        , m_processes()
+        , m_clients()
+        , m_openFdinfoCount( 0 )
+        , m_maxOpenFdinfoCount( 0 )
+        , m_busyNs{}
+        , m_listedFds()
+        , m_fdinfoBuffer{}
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     CDrmFdinfoSampler destructor
+    //
+    // Description:
+    //     Destructor. Closes kept open files.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CDrmFdinfoSampler::~CDrmFdinfoSampler()
+    {
+        Close();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     Open
+    //
+    // Description:
+    //     Opens the proc directory and makes the first sweep, which is the reference
+    //     for usage counted by the following reads. Another proc root with
+    //     <pid>/fd and <pid>/fdinfo entries may be given, e.g. a generated tree.
+    //
+    // Input:
+    //     const uint32_t     adapterId - adapter id for logging
+    //     const std::string& pciSlot   - pci slot of the device, see GetPciSlot
+    //     const uint32_t     processId - process to sample, 0 for all processes
+    //     const char*        procRoot  - proc directory, "/proc" by default
+    //
+    // Output:
+    //     TCompletionCode              - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDrmFdinfoSampler::Open( const uint32_t adapterId, const std::string& pciSlot, const uint32_t processId, const char* procRoot )
+    {
+        MD_CHECK_PTR_RET_A( adapterId, procRoot, CC_ERROR_INVALID_PARAMETER );
+
+        Close();
+
+        m_procDir = opendir( procRoot );
+        if( m_procDir == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Cannot open %s, error: %d (%s)", procRoot, errno, strerror( errno ) );
+            return CC_ERROR_FILE_NOT_FOUND;
+        }
+
+        m_pciSlot            = pciSlot;
+        m_processId          = processId;
+        m_startNs            = GetTimeNs();
+        m_maxOpenFdinfoCount = GetMaxOpenFdinfoCount();
+
+        Sweep( 0 );
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "DRM fdinfo sampler opened, pid: %u, processes: %u, clients: %u, max open fdinfo files: %u", processId, static_cast<uint32_t>( m_processes.size() ), static_cast<uint32_t>( m_clients.size() ), m_maxOpenFdinfoCount );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     Read
+    //
+    // Description:
+    //     Sweeps processes and fills the report with cumulative elapsed time and
+    //     busy time of the sampled clients, divided by engine class capacity.
+    //
+    // Input:
+    //     const uint32_t    adapterId - adapter id for logging
+    //     TPmuEngineReport& report    - (out) sampled report
+    //
+    // Output:
+    //     TCompletionCode             - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CDrmFdinfoSampler::Read( const uint32_t adapterId, TPmuEngineReport& report )
+    {
+        if( m_procDir == nullptr )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: DRM fdinfo sampler not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        const uint64_t elapsedNs = GetTimeNs() - m_startNs;
+
+        Sweep( elapsedNs - m_prevElapsedNs );
+
+        m_prevElapsedNs  = elapsedNs;
+        report.ElapsedNs = elapsedNs;
+
+        for( uint32_t engineClass = 0; engineClass < PMU_ENGINE_CLASS_COUNT; ++engineClass )
+        {
+            report.BusyNs[engineClass] = static_cast<uint64_t>( m_busyNs[engineClass] );
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     Close
+    //
+    // Description:
+    //     Closes kept open files and clears the sampled state.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDrmFdinfoSampler::Close()
+    {
+        for( auto& process : m_processes )
+        {
+            CloseProcessFiles( process.second );
+        }
+
+        if( m_procDir != nullptr )
+        {
+            closedir( m_procDir );
+            m_procDir = nullptr;
+        }
+
+        m_processes.clear();
+        m_clients.clear();
+        m_busyNs.fill( 0.0 );
+        m_sweep           = 0;
+        m_prevElapsedNs   = 0;
+        m_openFdinfoCount = 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     GetPciSlot
+    //
+    // Description:
+    //     Returns pci slot (drm-pdev) of the device from fdinfo of the given DRM
+    //     file opened by this process. Fails if the kernel driver doesn't expose
+    //     DRM client usage stats.
+    //
+    // Input:
+    //     const int32_t drmFd   - DRM file descriptor
+    //     std::string&  pciSlot - (out) pci slot, e.g. 0000:00:02.0
+    //
+    // Output:
+    //     bool                  - true if DRM client usage stats are available
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CDrmFdinfoSampler::GetPciSlot( const int32_t drmFd, std::string& pciSlot )
+    {
+        const std::string path = "/proc/self/fdinfo/" + std::to_string( drmFd );
+        char              buffer[FDINFO_MAX_SIZE];
+
+        const int32_t fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if( fd < 0 )
+        {
+            return false;
+        }
+
+        const ssize_t size = read( fd, buffer, sizeof( buffer ) - 1 );
+        close( fd );
+
+        if( size <= 0 )
+        {
+            return false;
+        }
+        buffer[size] = '\0';
+
+        const char* clientId = strstr( buffer, "drm-client-id:" );
+        const char* pdev     = strstr( buffer, "drm-pdev:" );
+        if( clientId == nullptr || pdev == nullptr )
+        {
+            return false;
+        }
+
+        pdev += sizeof( "drm-pdev:" ) - 1;
+        pdev += strspn( pdev, " \t" );
+        pciSlot.assign( pdev, strcspn( pdev, " \t\n" ) );
+
+        return !pciSlot.empty();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     Sweep
+    //
+    // Description:
+    //     Scans the sampled process or all processes listed in proc, accumulates
+    //     usage of their clients and drops state of exited processes and closed
+    //     clients.
+    //
+    // Input:
+    //     const uint64_t intervalNs - time since the previous sweep
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDrmFdinfoSampler::Sweep( const uint64_t intervalNs )
+    {
+        ++m_sweep;
+
+        const bool isFullRescan = ( m_sweep % FULL_RESCAN_PERIOD ) == 0;
+
+        if( m_processId != 0 )
+        {
+            ScanProcess( m_processId, intervalNs, isFullRescan );
+        }
+        else
+        {
+            rewinddir( m_procDir );
+
+            while( const dirent* entry = readdir( m_procDir ) )
+            {
+                // Processes are the numeric entries.
+                char*         end       = nullptr;
+                const int64_t processId = strtol( entry->d_name, &end, 10 );
+                if( end == entry->d_name || *end != '\0' || processId <= 0 )
+                {
+                    continue;
+                }
+
+                ScanProcess( static_cast<uint32_t>( processId ), intervalNs, isFullRescan );
+            }
+        }
+
+        for( auto iterator = m_processes.begin(); iterator != m_processes.end(); )
+        {
+            if( iterator->second.Sweep != m_sweep )
+            {
+                CloseProcessFiles( iterator->second );
+                iterator = m_processes.erase( iterator );
+            }
+            else
+            {
+                ++iterator;
+            }
+        }
+
+        for( auto iterator = m_clients.begin(); iterator != m_clients.end(); )
+        {
+            iterator = ( iterator->second.Sweep != m_sweep ) ? m_clients.erase( iterator ) : std::next( iterator );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     ScanProcess
+    //
+    // Description:
+    //     Lists fds of the process, checks only the ones not seen before if they
+    //     are DRM files and keeps their fdinfo open while under the open files
+    //     bound. Then reads fdinfo of all DRM clients of the process. A kept open
+    //     fdinfo refers to the fd number, so a closed or reused fd is noticed by
+    //     its read. Files which failed to be checked aren't cached, so they are
+    //     checked again in the next sweep.
+    //
+    // Input:
+    //     const uint32_t processId    - process to scan
+    //     const uint64_t intervalNs   - time since the previous sweep
+    //     const bool     isFullRescan - true to recheck files which aren't DRM clients
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDrmFdinfoSampler::ScanProcess( const uint32_t processId, const uint64_t intervalNs, const bool isFullRescan )
+    {
+        auto  emplaced = m_processes.try_emplace( processId );
+        auto& process  = emplaced.first->second;
+
+        if( emplaced.second )
+        {
+            process.IsAccessible = true;
+        }
+
+        process.Sweep = m_sweep;
+
+        if( !process.IsAccessible && !isFullRescan )
+        {
+            return;
+        }
+
+        char path[64] = {};
+        snprintf( path, sizeof( path ), "%u/fd", processId );
+
+        const int32_t procFd  = dirfd( m_procDir );
+        const int32_t fdDirFd = openat( procFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+        DIR*          fdDir   = ( fdDirFd >= 0 ) ? fdopendir( fdDirFd ) : nullptr;
+
+        if( fdDir == nullptr )
+        {
+            // Only other users' processes without ptrace access are skipped until
+            // the full rescan, other errors (e.g. out of fds) are transient.
+            process.IsAccessible = errno != EACCES && errno != EPERM;
+
+            if( fdDirFd >= 0 )
+            {
+                close( fdDirFd );
+            }
+            CloseProcessFiles( process );
+            return;
+        }
+
+        process.IsAccessible = true;
+
+        if( isFullRescan )
+        {
+            for( auto iterator = process.Files.begin(); iterator != process.Files.end(); )
+            {
+                iterator = ( iterator->second == FDINFO_NOT_CLIENT ) ? process.Files.erase( iterator ) : std::next( iterator );
+            }
+        }
+
+        m_listedFds.clear();
+
+        while( const dirent* entry = readdir( fdDir ) )
+        {
+            char*         end = nullptr;
+            const int32_t fd  = static_cast<int32_t>( strtol( entry->d_name, &end, 10 ) );
+            if( end == entry->d_name || *end != '\0' )
+            {
+                continue;
+            }
+
+            m_listedFds.push_back( fd );
+
+            if( process.Files.find( fd ) != process.Files.end() )
+            {
+                continue;
+            }
+
+            // New file, only DRM character devices are inspected further.
+            struct stat fileStat = {};
+
+            if( fstatat( fdDirFd, entry->d_name, &fileStat, 0 ) != 0 )
+            {
+                continue;
+            }
+
+            if( !S_ISCHR( fileStat.st_mode ) || major( fileStat.st_rdev ) != DRM_MAJOR_NUMBER )
+            {
+                process.Files.emplace( fd, FDINFO_NOT_CLIENT );
+                continue;
+            }
+
+            if( m_openFdinfoCount >= m_maxOpenFdinfoCount )
+            {
+                process.Files.emplace( fd, FDINFO_REOPEN );
+                continue;
+            }
+
+            snprintf( path, sizeof( path ), "%u/fdinfo/%d", processId, fd );
+
+            const int32_t fdinfoFd = openat( procFd, path, O_RDONLY | O_CLOEXEC );
+            if( fdinfoFd >= 0 )
+            {
+                ++m_openFdinfoCount;
+                process.Files.emplace( fd, fdinfoFd );
+            }
+        }
+
+        closedir( fdDir );
+
+        // Forget closed files.
+        if( process.Files.size() != m_listedFds.size() )
+        {
+            std::sort( m_listedFds.begin(), m_listedFds.end() );
+
+            for( auto iterator = process.Files.begin(); iterator != process.Files.end(); )
+            {
+                if( !std::binary_search( m_listedFds.begin(), m_listedFds.end(), iterator->first ) )
+                {
+                    CloseFdinfo( iterator->second );
+                    iterator = process.Files.erase( iterator );
+                }
+                else
+                {
+                    ++iterator;
+                }
+            }
+        }
+
+        for( auto& file : process.Files )
+        {
+            if( file.second == FDINFO_NOT_CLIENT )
+            {
+                continue;
+            }
+
+            const bool isKeptOpen = file.second >= 0;
+            int32_t    fdinfoFd   = file.second;
+
+            if( !isKeptOpen )
+            {
+                snprintf( path, sizeof( path ), "%u/fdinfo/%d", processId, file.first );
+
+                fdinfoFd = openat( procFd, path, O_RDONLY | O_CLOEXEC );
+                if( fdinfoFd < 0 )
+                {
+                    // Retried in the next sweep, a closed fd is forgotten by its listing.
+                    continue;
+                }
+            }
+
+            TClientUsage usage    = {};
+            const bool   isClient = ReadFdinfo( fdinfoFd, usage );
+
+            if( isClient )
+            {
+                AccumulateClient( usage, intervalNs );
+            }
+
+            if( !isKeptOpen )
+            {
+                close( fdinfoFd );
+            }
+            else if( !isClient )
+            {
+                CloseFdinfo( fdinfoFd );
+            }
+
+            if( !isClient )
+            {
+                // Not a DRM client of this device (anymore).
+                file.second = FDINFO_NOT_CLIENT;
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     ReadFdinfo
+    //
+    // Description:
+    //     Reads and parses usage stats of a DRM client from its kept open fdinfo.
+    //
+    // Input:
+    //     const int32_t fdinfoFd - fdinfo file descriptor
+    //     TClientUsage& usage    - (out) client usage
+    //
+    // Output:
+    //     bool                   - true if the file is a DRM client of this device
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CDrmFdinfoSampler::ReadFdinfo( const int32_t fdinfoFd, TClientUsage& usage )
+    {
+        const ssize_t size = pread( fdinfoFd, m_fdinfoBuffer.data(), m_fdinfoBuffer.size() - 1, 0 );
+        if( size <= 0 )
+        {
+            return false;
+        }
+        m_fdinfoBuffer[size] = '\0';
+
+        constexpr std::string_view capacityKey    = "drm-engine-capacity-";
+        constexpr std::string_view engineKey      = "drm-engine-";
+        constexpr std::string_view totalCyclesKey = "drm-total-cycles-";
+        constexpr std::string_view cyclesKey      = "drm-cycles-";
+
+        bool isClient = false;
+        bool isDevice = false;
+
+        usage.Capacity.fill( 1 );
+
+        for( char* line = m_fdinfoBuffer.data(); line != nullptr && *line != '\0'; )
+        {
+            char* lineEnd = strchr( line, '\n' );
+            if( lineEnd != nullptr )
+            {
+                *lineEnd = '\0';
+            }
+
+            const char* separator = strchr( line, ':' );
+            if( separator != nullptr )
+            {
+                const std::string_view key( line, separator - line );
+                const char*            value = separator + 1 + strspn( separator + 1, " \t" );
+                TPmuEngineClass        engineClass;
+
+                if( key == "drm-client-id" )
+                {
+                    usage.ClientId = strtoull( value, nullptr, 10 );
+                    isClient       = true;
+                }
+                else if( key == "drm-pdev" )
+                {
+                    isDevice = m_pciSlot.compare( 0, std::string::npos, value, strcspn( value, " \t" ) ) == 0;
+                }
+                else if( key.compare( 0, capacityKey.size(), capacityKey ) == 0 )
+                {
+                    if( GetEngineClass( line + capacityKey.size(), key.size() - capacityKey.size(), engineClass ) )
+                    {
+                        usage.Capacity[engineClass] = std::max<uint32_t>( 1, strtoul( value, nullptr, 10 ) );
+                    }
+                }
+                else if( key.compare( 0, engineKey.size(), engineKey ) == 0 )
+                {
+                    if( GetEngineClass( line + engineKey.size(), key.size() - engineKey.size(), engineClass ) )
+                    {
+                        usage.EngineNs[engineClass] = strtoull( value, nullptr, 10 );
+                    }
+                }
+                else if( key.compare( 0, totalCyclesKey.size(), totalCyclesKey ) == 0 )
+                {
+                    if( GetEngineClass( line + totalCyclesKey.size(), key.size() - totalCyclesKey.size(), engineClass ) )
+                    {
+                        usage.TotalCycles[engineClass] = strtoull( value, nullptr, 10 );
+                    }
+                }
+                else if( key.compare( 0, cyclesKey.size(), cyclesKey ) == 0 )
+                {
+                    if( GetEngineClass( line + cyclesKey.size(), key.size() - cyclesKey.size(), engineClass ) )
+                    {
+                        usage.Cycles[engineClass] = strtoull( value, nullptr, 10 );
+                    }
+                }
+            }
+
+            line = ( lineEnd != nullptr ) ? lineEnd + 1 : nullptr;
+        }
+
+        return isClient && isDevice;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     AccumulateClient
+    //
+    // Description:
+    //     Adds usage of the client since the previous sweep to the busy time.
+    //     A client seen for the first time is only the reference, clients seen
+    //     through several files in this sweep are counted once.
+    //
+    // Input:
+    //     const TClientUsage& usage      - current client usage
+    //     const uint64_t      intervalNs - time since the previous sweep
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDrmFdinfoSampler::AccumulateClient( const TClientUsage& usage, const uint64_t intervalNs )
+    {
+        auto  emplaced = m_clients.try_emplace( usage.ClientId );
+        auto& client   = emplaced.first->second;
+
+        if( client.Sweep == m_sweep )
+        {
+            return;
+        }
+
+        if( !emplaced.second )
+        {
+            const TClientUsage& prev = client.Usage;
+
+            for( uint32_t engineClass = 0; engineClass < PMU_ENGINE_CLASS_COUNT; ++engineClass )
+            {
+                const double capacity = static_cast<double>( usage.Capacity[engineClass] );
+
+                if( usage.EngineNs[engineClass] > prev.EngineNs[engineClass] )
+                {
+                    m_busyNs[engineClass] += static_cast<double>( usage.EngineNs[engineClass] - prev.EngineNs[engineClass] ) / capacity;
+                }
+
+                if( usage.TotalCycles[engineClass] > prev.TotalCycles[engineClass] && usage.Cycles[engineClass] > prev.Cycles[engineClass] )
+                {
+                    const double cycles      = static_cast<double>( usage.Cycles[engineClass] - prev.Cycles[engineClass] );
+                    const double totalCycles = static_cast<double>( usage.TotalCycles[engineClass] - prev.TotalCycles[engineClass] );
+                    const double ratio       = std::min( 1.0, cycles / totalCycles / capacity );
+                    m_busyNs[engineClass] += ratio * static_cast<double>( intervalNs );
+                }
+            }
+        }
+
+        client.Usage = usage;
+        client.Sweep = m_sweep;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     CloseProcessFiles
+    //
+    // Description:
+    //     Closes kept open fdinfo files of the process and forgets its files.
+    //
+    // Input:
+    //     TProcess& process - process state
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDrmFdinfoSampler::CloseProcessFiles( TProcess& process )
+    {
+        for( const auto& file : process.Files )
+        {
+            CloseFdinfo( file.second );
+        }
+
+        process.Files.clear();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     CloseFdinfo
+    //
+    // Description:
+    //     Closes a kept open fdinfo file, does nothing for FDINFO_NOT_CLIENT
+    //     and FDINFO_REOPEN.
+    //
+    // Input:
+    //     const int32_t fdinfoFd - fdinfo file descriptor
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CDrmFdinfoSampler::CloseFdinfo( const int32_t fdinfoFd )
+    {
+        if( fdinfoFd >= 0 )
+        {
+            close( fdinfoFd );
+            --m_openFdinfoCount;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     GetMaxOpenFdinfoCount
+    //
+    // Description:
+    //     Returns how many fdinfo files may be kept open, a quarter of the soft
+    //     RLIMIT_NOFILE, so the application keeps most of its fds.
+    //
+    // Output:
+    //     uint32_t - max kept open fdinfo files count
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint32_t CDrmFdinfoSampler::GetMaxOpenFdinfoCount()
+    {
+        constexpr uint32_t defaultOpenFilesLimit = 1024;
+
+        rlimit limit = {};
+        if( getrlimit( RLIMIT_NOFILE, &limit ) != 0 || limit.rlim_cur == RLIM_INFINITY )
+        {
+            limit.rlim_cur = defaultOpenFilesLimit;
+        }
+
+        return static_cast<uint32_t>( std::min<rlim_t>( limit.rlim_cur, UINT32_MAX ) / 4 );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     GetEngineClass
+    //
+    // Description:
+    //     Returns engine class of the fdinfo engine name, i915 uses names
+    //     like 'video-enhance', xe uses names like 'vecs'.
+    //
+    // Input:
+    //     const char*      name        - engine name, not null terminated
+    //     const size_t     length      - engine name length
+    //     TPmuEngineClass& engineClass - (out) engine class
+    //
+    // Output:
+    //     bool                         - true if known
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CDrmFdinfoSampler::GetEngineClass( const char* name, const size_t length, TPmuEngineClass& engineClass )
+    {
+        static const struct
+        {
+            std::string_view Name;
+            TPmuEngineClass  EngineClass;
+        } engineNames[] = {
+            { "render", PMU_ENGINE_CLASS_RENDER },
+            { "rcs", PMU_ENGINE_CLASS_RENDER },
+            { "copy", PMU_ENGINE_CLASS_COPY },
+            { "bcs", PMU_ENGINE_CLASS_COPY },
+            { "video", PMU_ENGINE_CLASS_VIDEO },
+            { "vcs", PMU_ENGINE_CLASS_VIDEO },
+            { "video-enhance", PMU_ENGINE_CLASS_VIDEO_ENHANCE },
+            { "vecs", PMU_ENGINE_CLASS_VIDEO_ENHANCE },
+            { "compute", PMU_ENGINE_CLASS_COMPUTE },
+            { "ccs", PMU_ENGINE_CLASS_COMPUTE },
+        };
+
+        const std::string_view engineName( name, length );
+
+        for( const auto& entry : engineNames )
+        {
+            if( entry.Name == engineName )
+            {
+                engineClass = entry.EngineClass;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CDrmFdinfoSampler
+    //
+    // Method:
+    //     GetTimeNs
+    //
+    // Description:
+    //     Returns monotonic time in ns.
+    //
+    // Output:
+    //     uint64_t - time in ns
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    uint64_t CDrmFdinfoSampler::GetTimeNs()
+    {
+        timespec time = {};
+        clock_gettime( CLOCK_MONOTONIC, &time );
+
+        return static_cast<uint64_t>( time.tv_sec ) * MD_NSEC_PER_SEC + static_cast<uint64_t>( time.tv_nsec );
+    }
+
+} // namespace MetricsDiscoveryInternal
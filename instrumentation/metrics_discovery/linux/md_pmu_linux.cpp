@@ -0,0 +1,590 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2025 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//     File Name:  md_pmu_linux.cpp
+
+//     Abstract:   C++ engine busyness sampler based on i915 / xe PMU implementation for Linux
+
+#include "md_pmu_linux.h"
+#include "md_utils.h"
+
+#include "i915_drm.h"
+#include "xe_drm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/perf_event.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace MetricsDiscoveryInternal
+{
+    // Engine classes are reported in the same order as i915 and xe uapi engine classes.
+    static_assert( PMU_ENGINE_CLASS_RENDER == static_cast<uint32_t>( I915_ENGINE_CLASS_RENDER ) && PMU_ENGINE_CLASS_RENDER == DRM_XE_ENGINE_CLASS_RENDER );
+    static_assert( PMU_ENGINE_CLASS_COPY == static_cast<uint32_t>( I915_ENGINE_CLASS_COPY ) && PMU_ENGINE_CLASS_COPY == DRM_XE_ENGINE_CLASS_COPY );
+    static_assert( PMU_ENGINE_CLASS_VIDEO == static_cast<uint32_t>( I915_ENGINE_CLASS_VIDEO ) && PMU_ENGINE_CLASS_VIDEO == DRM_XE_ENGINE_CLASS_VIDEO_DECODE );
+    static_assert( PMU_ENGINE_CLASS_VIDEO_ENHANCE == static_cast<uint32_t>( I915_ENGINE_CLASS_VIDEO_ENHANCE ) && PMU_ENGINE_CLASS_VIDEO_ENHANCE == DRM_XE_ENGINE_CLASS_VIDEO_ENHANCE );
+    static_assert( PMU_ENGINE_CLASS_COMPUTE == static_cast<uint32_t>( I915_ENGINE_CLASS_COMPUTE ) && PMU_ENGINE_CLASS_COMPUTE == DRM_XE_ENGINE_CLASS_COMPUTE );
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     CPmuEngineSampler constructor
+    //
+    // Description:
+    //     Constructor. Counters are opened with Open().
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CPmuEngineSampler::CPmuEngineSampler()
+        : m_fds()
+        , m_counters()
+        , m_readBuffer()
+        , m_pmuType( 0 )
+        , m_cpu( 0 )
+        , m_isXe( false )
+        , m_instanceCount{}
+        , m_prevElapsedNs( 0 )
+        , m_prevActiveTicks{}
+        , m_prevTotalTicks{}
+        , m_busyNs{}
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     CPmuEngineSampler destructor
+    //
+    // Description:
+    //     Destructor. Closes opened counters.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    CPmuEngineSampler::~CPmuEngineSampler()
+    {
+        Close();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     Open
+    //
+    // Description:
+    //     Opens busyness counters of all engines found on the given PMU as
+    //     a single perf event group.
+    //
+    // Input:
+    //     const uint32_t     adapterId - adapter id for logging
+    //     const std::string& pmuName   - PMU name, see GetPmuName
+    //
+    // Output:
+    //     TCompletionCode              - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CPmuEngineSampler::Open( const uint32_t adapterId, const std::string& pmuName )
+    {
+        Close();
+
+        const std::string pmuPath = "/sys/bus/event_source/devices/" + pmuName;
+        std::string       value;
+
+        if( !ReadSysFsString( pmuPath + "/type", value ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Cannot read %s PMU type", pmuName.c_str() );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+        m_pmuType = static_cast<uint32_t>( strtoul( value.c_str(), nullptr, 0 ) );
+
+        // Uncore PMU, counters have to be opened on the cpu given in the cpumask.
+        m_cpu = ReadSysFsString( pmuPath + "/cpumask", value ) ? static_cast<int32_t>( strtol( value.c_str(), nullptr, 10 ) ) : 0;
+        m_isXe = pmuName.compare( 0, 2, "xe" ) == 0;
+
+        const TCompletionCode ret = m_isXe ? OpenXeCounters( adapterId, pmuPath ) : OpenI915Counters( adapterId );
+        if( ret != CC_OK )
+        {
+            Close();
+            return ret;
+        }
+
+        m_readBuffer.resize( 2 + m_fds.size() );
+
+        MD_LOG_A( adapterId, LOG_DEBUG, "%s PMU opened, type: %u, cpu: %d, counters: %u", pmuName.c_str(), m_pmuType, m_cpu, static_cast<uint32_t>( m_fds.size() ) );
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     Read
+    //
+    // Description:
+    //     Reads all engine counters with one group read and fills the report
+    //     with cumulative elapsed time and busy time averaged over engine instances.
+    //
+    // Input:
+    //     const uint32_t    adapterId - adapter id for logging
+    //     TPmuEngineReport& report    - (out) sampled report
+    //
+    // Output:
+    //     TCompletionCode             - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CPmuEngineSampler::Read( const uint32_t adapterId, TPmuEngineReport& report )
+    {
+        if( m_fds.empty() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: PMU not opened" );
+            return CC_ERROR_GENERAL;
+        }
+
+        // Group read format: counters count, time enabled, counter values.
+        const ssize_t bytesToRead = m_readBuffer.size() * sizeof( uint64_t );
+        const ssize_t readBytes   = read( m_fds[0], m_readBuffer.data(), bytesToRead );
+        if( readBytes != bytesToRead || m_readBuffer[0] != m_fds.size() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: PMU read failed, read bytes: %d, error: %d (%s)", static_cast<int32_t>( readBytes ), errno, strerror( errno ) );
+            return CC_ERROR_GENERAL;
+        }
+
+        const uint64_t  elapsedNs = m_readBuffer[1];
+        const uint64_t* values    = &m_readBuffer[2];
+
+        std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> busy  = {};
+        std::array<uint64_t, PMU_ENGINE_CLASS_COUNT> total = {};
+
+        for( size_t i = 0; i < m_counters.size(); ++i )
+        {
+            auto& sum = ( m_counters[i].Type == COUNTER_TYPE_BUSY ) ? busy : total;
+            sum[m_counters[i].EngineClass] += values[i];
+        }
+
+        report.ElapsedNs = elapsedNs;
+
+        for( uint32_t engineClass = 0; engineClass < PMU_ENGINE_CLASS_COUNT; ++engineClass )
+        {
+            if( m_instanceCount[engineClass] == 0 )
+            {
+                report.BusyNs[engineClass] = 0;
+            }
+            else if( !m_isXe )
+            {
+                report.BusyNs[engineClass] = busy[engineClass] / m_instanceCount[engineClass];
+            }
+            else
+            {
+                // Ratio of sums is the average, total ticks are the same for all instances.
+                const uint64_t activeTicks = busy[engineClass] - m_prevActiveTicks[engineClass];
+                const uint64_t totalTicks  = total[engineClass] - m_prevTotalTicks[engineClass];
+
+                if( totalTicks != 0 )
+                {
+                    const double ratio = std::min( 1.0, static_cast<double>( activeTicks ) / static_cast<double>( totalTicks ) );
+                    m_busyNs[engineClass] += ratio * static_cast<double>( elapsedNs - m_prevElapsedNs );
+                }
+
+                m_prevActiveTicks[engineClass] = busy[engineClass];
+                m_prevTotalTicks[engineClass]  = total[engineClass];
+                report.BusyNs[engineClass]     = static_cast<uint64_t>( m_busyNs[engineClass] );
+            }
+        }
+
+        m_prevElapsedNs = elapsedNs;
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     Close
+    //
+    // Description:
+    //     Closes opened counters, group members before the leader.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CPmuEngineSampler::Close()
+    {
+        while( !m_fds.empty() )
+        {
+            CloseLastCounter();
+        }
+
+        m_readBuffer.clear();
+        m_instanceCount.fill( 0 );
+        m_prevActiveTicks.fill( 0 );
+        m_prevTotalTicks.fill( 0 );
+        m_busyNs.fill( 0.0 );
+        m_prevElapsedNs = 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     GetPmuName
+    //
+    // Description:
+    //     Returns name of the PMU registered by the kernel driver of the given
+    //     DRM card. It's <driver>_<pci slot> with ':' replaced by '_', e.g.
+    //     xe_0000_03_00.0, except integrated i915 which uses just 'i915'.
+    //
+    // Input:
+    //     const int32_t drmCardNumber - DRM card number
+    //     std::string&  pmuName       - (out) PMU name
+    //
+    // Output:
+    //     bool                        - true if found
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CPmuEngineSampler::GetPmuName( const int32_t drmCardNumber, std::string& pmuName )
+    {
+        const std::string devicePath = "/sys/class/drm/card" + std::to_string( drmCardNumber ) + "/device";
+        char              resolvedPath[PATH_MAX] = {};
+        char              driverPath[PATH_MAX]   = {};
+
+        const ssize_t length = readlink( ( devicePath + "/driver" ).c_str(), driverPath, sizeof( driverPath ) - 1 );
+        if( length <= 0 || realpath( devicePath.c_str(), resolvedPath ) == nullptr )
+        {
+            return false;
+        }
+
+        std::string driverName( driverPath, length );
+        std::string pciSlot( resolvedPath );
+
+        driverName.erase( 0, driverName.find_last_of( '/' ) + 1 );
+        pciSlot.erase( 0, pciSlot.find_last_of( '/' ) + 1 );
+        std::replace( pciSlot.begin(), pciSlot.end(), ':', '_' );
+
+        for( const auto& name : { driverName + "_" + pciSlot, driverName } )
+        {
+            if( access( ( "/sys/bus/event_source/devices/" + name + "/type" ).c_str(), R_OK ) == 0 )
+            {
+                pmuName = name;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     OpenCounter
+    //
+    // Description:
+    //     Opens a counter in the perf event group, the first one is the group leader.
+    //
+    // Input:
+    //     const uint64_t        config      - perf event config
+    //     const TPmuEngineClass engineClass - engine class of the counter
+    //     const TCounterType    type        - counter type
+    //
+    // Output:
+    //     int32_t                           - 0 if opened, errno otherwise
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    int32_t CPmuEngineSampler::OpenCounter( const uint64_t config, const TPmuEngineClass engineClass, const TCounterType type )
+    {
+        perf_event_attr attributes = {};
+        attributes.type            = m_pmuType;
+        attributes.size            = sizeof( attributes );
+        attributes.config          = config;
+        attributes.read_format     = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED;
+
+        const int32_t groupFd = m_fds.empty() ? -1 : m_fds[0];
+        const int32_t fd      = static_cast<int32_t>( syscall( __NR_perf_event_open, &attributes, -1, m_cpu, groupFd, PERF_FLAG_FD_CLOEXEC ) );
+        if( fd < 0 )
+        {
+            return errno;
+        }
+
+        m_fds.push_back( fd );
+        m_counters.push_back( TCounter{ engineClass, type } );
+        return 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     CloseLastCounter
+    //
+    // Description:
+    //     Closes the last opened counter and removes it from the group.
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    void CPmuEngineSampler::CloseLastCounter()
+    {
+        close( m_fds.back() );
+        m_fds.pop_back();
+        m_counters.pop_back();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     OpenI915Counters
+    //
+    // Description:
+    //     Opens i915 engine busy counters, busy time is in ns.
+    //
+    // Input:
+    //     const uint32_t adapterId - adapter id for logging
+    //
+    // Output:
+    //     TCompletionCode          - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CPmuEngineSampler::OpenI915Counters( const uint32_t adapterId )
+    {
+        for( uint32_t engineClass = 0; engineClass < PMU_ENGINE_CLASS_COUNT; ++engineClass )
+        {
+            for( uint32_t instance = 0; instance < MAX_INSTANCE_COUNT; ++instance )
+            {
+                const int32_t error = OpenCounter( __I915_PMU_ENGINE( engineClass, instance, I915_SAMPLE_BUSY ), static_cast<TPmuEngineClass>( engineClass ), COUNTER_TYPE_BUSY );
+                if( error == EACCES || error == EPERM )
+                {
+                    MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Access to i915 PMU denied, CAP_PERFMON or perf_event_paranoid <= 0 is required" );
+                    return CC_ERROR_ACCESS_DENIED;
+                }
+                if( error == 0 )
+                {
+                    ++m_instanceCount[engineClass];
+                }
+            }
+        }
+
+        if( m_fds.empty() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: No engine busy counters found on i915 PMU" );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     OpenXeCounters
+    //
+    // Description:
+    //     Opens xe engine active and total ticks counters on all gts. Config
+    //     layout is read from PMU format files.
+    //
+    // Input:
+    //     const uint32_t     adapterId - adapter id for logging
+    //     const std::string& pmuPath   - PMU sysfs directory
+    //
+    // Output:
+    //     TCompletionCode              - *CC_OK* means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CPmuEngineSampler::OpenXeCounters( const uint32_t adapterId, const std::string& pmuPath )
+    {
+        uint32_t gtShift       = 0;
+        uint32_t classShift    = 0;
+        uint32_t instanceShift = 0;
+        uint64_t activeEvent   = 0;
+        uint64_t totalEvent    = 0;
+
+        if( !ReadPmuFormatShift( pmuPath, "gt", gtShift ) ||
+            !ReadPmuFormatShift( pmuPath, "engine_class", classShift ) ||
+            !ReadPmuFormatShift( pmuPath, "engine_instance", instanceShift ) ||
+            !ReadPmuEventConfig( pmuPath, "engine-active-ticks", activeEvent ) ||
+            !ReadPmuEventConfig( pmuPath, "engine-total-ticks", totalEvent ) )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Engine ticks events are not exposed by xe PMU" );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        for( uint64_t gt = 0; gt < MAX_GT_COUNT; ++gt )
+        {
+            for( uint32_t engineClass = 0; engineClass < PMU_ENGINE_CLASS_COUNT; ++engineClass )
+            {
+                for( uint64_t instance = 0; instance < MAX_INSTANCE_COUNT; ++instance )
+                {
+                    const uint64_t engineConfig = ( gt << gtShift ) | ( static_cast<uint64_t>( engineClass ) << classShift ) | ( instance << instanceShift );
+                    const auto     pmuClass     = static_cast<TPmuEngineClass>( engineClass );
+
+                    int32_t error = OpenCounter( activeEvent | engineConfig, pmuClass, COUNTER_TYPE_BUSY );
+                    if( error == 0 )
+                    {
+                        error = OpenCounter( totalEvent | engineConfig, pmuClass, COUNTER_TYPE_TOTAL );
+                        if( error != 0 )
+                        {
+                            CloseLastCounter();
+                        }
+                    }
+                    if( error == EACCES || error == EPERM )
+                    {
+                        MD_LOG_A( adapterId, LOG_ERROR, "ERROR: Access to xe PMU denied, CAP_PERFMON or perf_event_paranoid <= 0 is required" );
+                        return CC_ERROR_ACCESS_DENIED;
+                    }
+                    if( error == 0 )
+                    {
+                        ++m_instanceCount[engineClass];
+                    }
+                }
+            }
+        }
+
+        if( m_fds.empty() )
+        {
+            MD_LOG_A( adapterId, LOG_ERROR, "ERROR: No engine ticks counters found on xe PMU" );
+            return CC_ERROR_NOT_SUPPORTED;
+        }
+
+        return CC_OK;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     ReadSysFsString
+    //
+    // Description:
+    //     Reads the first line of the given sysfs file.
+    //
+    // Input:
+    //     const std::string& path  - file path
+    //     std::string&       value - (out) read line
+    //
+    // Output:
+    //     bool                     - true if read
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CPmuEngineSampler::ReadSysFsString( const std::string& path, std::string& value )
+    {
+        const int32_t fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if( fd < 0 )
+        {
+            return false;
+        }
+
+        char          buffer[256] = {};
+        const ssize_t readBytes   = read( fd, buffer, sizeof( buffer ) - 1 );
+        close( fd );
+
+        if( readBytes <= 0 )
+        {
+            return false;
+        }
+
+        value.assign( buffer, strcspn( buffer, "\n" ) );
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     ReadPmuFormatShift
+    //
+    // Description:
+    //     Reads the first config bit of the given PMU format field, e.g. 60 for
+    //     'config:60-63'.
+    //
+    // Input:
+    //     const std::string& pmuPath - PMU sysfs directory
+    //     const char*        field   - format field name
+    //     uint32_t&          shift   - (out) first config bit of the field
+    //
+    // Output:
+    //     bool                       - true if read
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CPmuEngineSampler::ReadPmuFormatShift( const std::string& pmuPath, const char* field, uint32_t& shift )
+    {
+        std::string value;
+        if( !ReadSysFsString( pmuPath + "/format/" + field, value ) || value.compare( 0, 7, "config:" ) != 0 )
+        {
+            return false;
+        }
+
+        shift = static_cast<uint32_t>( strtoul( value.c_str() + 7, nullptr, 10 ) );
+        return shift < 64;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CPmuEngineSampler
+    //
+    // Method:
+    //     ReadPmuEventConfig
+    //
+    // Description:
+    //     Reads config of the given PMU event, e.g. 0x02 for 'event=0x02'.
+    //
+    // Input:
+    //     const std::string& pmuPath - PMU sysfs directory
+    //     const char*        event   - event name
+    //     uint64_t&          config  - (out) event config
+    //
+    // Output:
+    //     bool                       - true if read
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    bool CPmuEngineSampler::ReadPmuEventConfig( const std::string& pmuPath, const char* event, uint64_t& config )
+    {
+        std::string value;
+        if( !ReadSysFsString( pmuPath + "/events/" + event, value ) )
+        {
+            return false;
+        }
+
+        const size_t position = value.find( '=' );
+        if( position == std::string::npos )
+        {
+            return false;
+        }
+
+        config = strtoull( value.c_str() + position + 1, nullptr, 0 );
+        return true;
+    }
+
+} // namespace MetricsDiscoveryInternal
@@ -556,6 +556,51 @@ namespace MetricsDiscoveryInternal
         return m_subDevices[index];
     }
 
+    //////////////////////////////////////////////////////////////////////////////
+    //
+    // Class:
+    //     CSubDevices
+    //
+    // Method:
+    //     OpenDevices
+    //
+    // Description:
+    //     Opens several metrics sub devices at once. Sub devices are created
+    //     concurrently, see CAdapter::OpenMetricsDevicesByIndex.
+    //
+    // Input:
+    //     const std::vector<uint32_t>&  indices        - sub device indices
+    //     std::vector<CMetricsDevice*>& metricsDevices - [out] opened metrics sub devices, in indices order
+    //
+    // Output:
+    //     TCompletionCode                              - CC_OK means success
+    //
+    //////////////////////////////////////////////////////////////////////////////
+    TCompletionCode CSubDevices::OpenDevices( const std::vector<uint32_t>& indices, std::vector<CMetricsDevice*>& metricsDevices )
+    {
+        const uint32_t adapterId = m_adapter.GetAdapterId();
+
+        for( const auto index : indices )
+        {
+            MD_CHECK_CC_RET_A( adapterId, ( index < m_subDevices.size() ) ? CC_OK : CC_ERROR_INVALID_PARAMETER );
+        }
+
+        // Open metrics devices and set sub device indices
+        // Devices opened before a failure are stored too, so they can be closed.
+        TCompletionCode ret = m_adapter.OpenMetricsDevicesByIndex( metricsDevices, indices );
+
+        for( size_t i = 0; i < metricsDevices.size(); ++i )
+        {
+            if( metricsDevices[i] && m_subDevices[indices[i]] == nullptr )
+            {
+                m_subDevices[indices[i]] = metricsDevices[i];
+            }
+        }
+
+        MD_CHECK_CC_RET_A( adapterId, ret );
+        return CC_OK;
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     //
     // Class: